@@ -48,6 +48,9 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace opentxs
 {
@@ -82,6 +85,18 @@ public:
         const Identifier& accountID,
         const std::uint32_t index,
         const BIP44Chain chain) const;
+    /** Find the chain and index of an allocated address
+     *
+     *  \param[in] address The encoded address string
+     *  \param[out] index The index of the address on its chain
+     *  \param[out] chain The chain the address was allocated from
+     */
+    bool LookupAddress(
+        const Identifier& nymID,
+        const Identifier& accountID,
+        const std::string& address,
+        std::uint32_t& index,
+        BIP44Chain& chain) const;
     Identifier NewAccount(
         const Identifier& nymID,
         const BlockchainAccountType standard,
@@ -106,6 +121,24 @@ private:
     typedef std::map<Identifier, std::mutex> IDLock;
     friend class OT;
 
+    /** Lookup tables for the addresses of one account
+     *
+     *  Built from the account the first time it is needed and kept up to
+     *  date by every change made through this class. An account whose
+     *  revision no longer matches is indexed again from scratch.
+     */
+    struct AddressIndex {
+        bool valid_{false};
+        std::uint64_t revision_{0};
+        /** chain and index -> position in the account's address list */
+        std::unordered_map<std::uint64_t, int> position_{};
+        /** address string -> chain and index */
+        std::unordered_map<std::string, std::uint64_t> address_{};
+        /** chain and index -> txids of incoming transactions */
+        std::unordered_map<std::uint64_t, std::unordered_set<std::string>>
+            incoming_{};
+    };
+
     Activity& activity_;
     CryptoEngine& crypto_;
     Storage& storage_;
@@ -113,6 +146,12 @@ private:
     mutable std::mutex lock_;
     mutable IDLock nym_lock_;
     mutable IDLock account_lock_;
+    mutable std::map<Identifier, AddressIndex> address_index_;
+
+    static std::uint64_t address_key(
+        const BIP44Chain chain,
+        const std::uint32_t index);
+
     proto::Bip44Address& add_address(
         const std::uint32_t index,
         proto::Bip44Account& account,
@@ -127,7 +166,12 @@ private:
     proto::Bip44Address& find_address(
         const std::uint32_t index,
         const BIP44Chain chain,
+        const AddressIndex& addressIndex,
         proto::Bip44Account& account) const;
+    AddressIndex& index_account(
+        const Lock& lock,
+        const Identifier& accountID,
+        const proto::Bip44Account& account) const;
     void init_path(
         const std::string& root,
         const proto::ContactItemType chain,
@@ -143,6 +187,17 @@ private:
         const proto::Bip44Address& address,
         const std::string& fromContact,
         const std::string& toContact) const;
+    bool store_incoming(
+        const Identifier& nymID,
+        const Identifier& accountID,
+        const std::uint32_t index,
+        const BIP44Chain chain,
+        const proto::BlockchainTransaction& transaction) const;
+    bool store_outgoing(
+        const Identifier& senderNymID,
+        const Identifier& accountID,
+        const Identifier& recipientContactID,
+        const proto::BlockchainTransaction& transaction) const;
 
     Blockchain(
         Activity& activity,
@@ -82,6 +82,20 @@ public:
         OT_ASSERT(locked_save_callback_);
     }
 
+    /** The unlocked callback runs after the save callback, once the mutex
+     *  has been released */
+    Editor(
+        std::mutex& objectMutex,
+        C* object,
+        LockedSave save,
+        UnlockedSave unlocked)
+        : Editor(objectMutex, object, save)
+    {
+        unlocked_save_callback_.reset(new UnlockedSave(unlocked));
+
+        OT_ASSERT(unlocked_save_callback_);
+    }
+
     Editor(C* object, UnlockedSave save)
         : object_(object)
         , locked_(false)
@@ -117,6 +131,11 @@ public:
             auto& callback = *locked_save_callback_;
             callback(object_, *object_lock_);
             object_lock_->unlock();
+
+            if (unlocked_save_callback_) {
+                auto& unlocked = *unlocked_save_callback_;
+                unlocked(object_);
+            }
         } else {
             auto& callback = *unlocked_save_callback_;
             callback(object_);
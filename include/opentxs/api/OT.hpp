@@ -46,16 +46,21 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <thread>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -83,6 +88,7 @@ class OT
 {
 public:
     typedef std::function<void()> PeriodicTask;
+    typedef std::function<void(const std::size_t)> ParallelTask;
 
 private:
     friend class AppLoader;
@@ -92,7 +98,22 @@ private:
     /** Last performed, Interval, Task */
     typedef std::tuple<time64_t, time64_t, PeriodicTask> TaskItem;
     typedef std::list<TaskItem> TaskList;
+
+    /** A batch of independent calls shared by the task workers and the thread
+     *  which submitted it */
+    struct ParallelJob {
+        ParallelTask task_;
+        std::size_t count_{0};
+        std::atomic<std::size_t> next_{0};
+        std::atomic<std::size_t> finished_{0};
+        std::mutex lock_;
+        std::condition_variable done_;
+    };
     typedef std::map<std::string, std::unique_ptr<Settings>> ConfigMap;
+    /** id, hash */
+    typedef std::map<std::string, std::string> PublishList;
+    typedef std::function<bool(const std::string&, const std::string&)>
+        PublishFilter;
 
     static OT* instance_pointer_;
 
@@ -104,6 +125,7 @@ private:
     std::int64_t server_refresh_interval_{0};
     std::int64_t unit_publish_interval_{0};
     std::int64_t unit_refresh_interval_{0};
+    std::int64_t context_flush_interval_{0};
     const OTPassword word_list_{};
     const OTPassword passphrase_{};
     const std::string primary_storage_plugin_{};
@@ -112,6 +134,17 @@ private:
     mutable std::mutex config_lock_;
     mutable std::mutex task_list_lock_;
     mutable TaskList periodic_task_list;
+    mutable std::mutex task_queue_lock_;
+    mutable std::condition_variable task_queue_signal_;
+    std::deque<const TaskItem*> task_queue_;
+    mutable std::deque<std::shared_ptr<ParallelJob>> job_queue_;
+    std::set<const TaskItem*> active_tasks_;
+    std::vector<std::unique_ptr<std::thread>> task_workers_;
+    std::mutex publish_lock_;
+    /** type + id, (hash, time of last publish) */
+    std::map<std::string, std::pair<std::string, time64_t>> published_;
+    std::atomic<std::uint64_t> dht_published_;
+    std::atomic<std::uint64_t> dht_skipped_;
     mutable std::atomic<bool> shutdown_;
     std::unique_ptr<class Activity> activity_;
     std::unique_ptr<Api> api_;
@@ -141,6 +174,7 @@ private:
         const std::string& backupDirectory = "",
         const std::string& encryptedDirectory = "");
     static void Cleanup();
+    static void run_job(ParallelJob& job);
 
     explicit OT(
         const bool recover,
@@ -172,7 +206,13 @@ private:
     void Init_ZMQ();
     void Init();
     void Periodic();
+    PublishFilter publish_filter(const std::string& type, PublishList& pending);
+    void published(
+        const std::string& type,
+        const std::string& id,
+        const PublishList& pending);
     void recover();
+    void RunTasks();
     void set_storage_encryption();
     void Shutdown();
     void start();
@@ -191,7 +231,20 @@ public:
     CryptoEngine& Crypto() const;
     Storage& DB() const;
     Dht& DHT() const;
+    /** Number of objects the periodic tasks have published to the DHT */
+    std::uint64_t DHTPublished() const;
+    /** Number of objects the periodic tasks did not need to publish because
+     *  they were unchanged since they were last published */
+    std::uint64_t DHTSkipped() const;
     class Identity& Identity() const;
+    /** Calls task once for each index in [0, count) and returns after every
+     *  call has finished. The calls are shared between the task workers and
+     *  the calling thread, so they must not depend on each other. Batches
+     *  smaller than threshold run on the calling thread alone. */
+    void Parallel(
+        const std::size_t count,
+        const ParallelTask& task,
+        const std::size_t threshold = 2) const;
     class ZMQ& ZMQ() const;
 
     /** Adds a task to the periodic task list with the specified interval. By
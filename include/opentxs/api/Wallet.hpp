@@ -44,6 +44,7 @@
 #include "opentxs/core/contract/UnitDefinition.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Nym.hpp"
+#include "opentxs/core/util/Journal.hpp"
 #include "opentxs/core/Types.hpp"
 #include "opentxs/storage/Storage.hpp"
 
@@ -106,9 +107,24 @@ private:
     std::mutex context_map_lock_;
     mutable std::mutex peer_map_lock_;
     mutable std::map<std::string, std::mutex> peer_lock_;
+    mutable std::mutex context_journal_lock_;
+    mutable std::unique_ptr<Journal> context_journal_;
+    /** Contexts whose latest state is only in the journal */
+    mutable std::map<ContextID, std::weak_ptr<class Context>> dirty_contexts_;
+    /** Serialized contexts read from the journal at startup, which have not
+     *  been stored yet */
+    std::map<ContextID, std::string> recovered_contexts_;
 
     std::mutex& peer_lock(const std::string& nymID) const;
+    bool journal_context(
+        const std::unique_lock<std::mutex>& lock,
+        class Context& context) const;
+    void recover_contexts();
     void save(class Context* context) const;
+    void start_context_journal(const std::string& path);
+    bool store_context(
+        const std::unique_lock<std::mutex>& lock,
+        class Context& context) const;
 
     std::shared_ptr<class Context> context(
         const Identifier& localNymID,
@@ -218,6 +234,14 @@ public:
         const Identifier& localNymID,
         const Identifier& remoteID);
 
+    /**   Sign and store every context modified since the last flush
+     *
+     *    Only does work if deferred context persistence is enabled, in which
+     *    case edits are appended to a journal and only written to storage by
+     *    this method.
+     */
+    void FlushContexts();
+
     /**   Obtain a smart pointer to an instantiated nym.
      *
      *    The smart pointer will not be initialized if the object does not
@@ -4159,6 +4159,12 @@ public:
         const std::string& NOTARY_ID,
         const std::string& NYM_ID) const;
 
+    //! Retrieves the notary's latency statistics. (Admin nym only.)
+    // The JSON report is in the payload of the reply.
+    EXPORT int32_t getStatistics(
+        const std::string& NOTARY_ID,
+        const std::string& NYM_ID) const;
+
     //! Gets all offers for a specific market and their details (up until
     // maximum depth)
     // Returns int32_t:
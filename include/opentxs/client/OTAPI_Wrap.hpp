@@ -3987,6 +3987,12 @@ public:
         const std::string& NOTARY_ID,
         const std::string& NYM_ID);
 
+    //! Retrieves the notary's latency statistics. (Admin nym only.)
+    // The JSON report is in the payload of the reply.
+    EXPORT static int32_t getStatistics(
+        const std::string& NOTARY_ID,
+        const std::string& NYM_ID);
+
     //! Gets all offers for a specific market and their details (up until
     // maximum depth)
     // Returns int32_t:
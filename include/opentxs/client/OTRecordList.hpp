@@ -41,17 +41,23 @@
 
 #include "opentxs/client/OTRecord.hpp"
 #include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Ledger.hpp"
 
 #include <stdint.h>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace opentxs
 {
 
+class Nym;
+class OTWallet;
+
 /** For address book lookups. Your client app inherits this and provides addr
  * storage/lookup through this simple interface. OTRecordList then calls it. */
 class OTNameLookup
@@ -89,6 +95,13 @@ public:
         const std::string p_txn_contents,
         int64_t lTransactionNum,
         int64_t lTransNumForDisplay) const;
+    // Called at the end of OTRecordList::Populate with the (sorted) indices of
+    // the records which are new or different since the previous Populate, and
+    // the number of previous records which are gone. Records which did not
+    // change keep the same OTRecord instance across calls to Populate.
+    EXPORT virtual void notifyOfChangedRecords(
+        const std::vector<int32_t>& changed,
+        int32_t nRemoved) const;
 };
 
 /*
@@ -177,6 +190,46 @@ class OTRecordList
     static const std::string s_blank;
     static const std::string s_message_type;
 
+    // A box as it was loaded by the last Populate. If the file hasn't changed
+    // since then, the parsed (and possibly verified) ledger is reused.
+    struct BoxSnapshot {
+        Ledger::ledgerType m_Type{Ledger::error_state};
+        Identifier m_NotaryID;
+        Identifier m_NymID;
+        Identifier m_AccountID;
+        const Nym* m_pNym{nullptr};
+        std::string m_strRawFile;
+        bool m_bVerified{false};
+        std::shared_ptr<Ledger> m_pBox;
+    };
+    typedef std::map<std::string, BoxSnapshot> map_of_boxes;  // by path
+    map_of_boxes m_boxes;
+
+    static const char* box_folder(const Ledger::ledgerType theType);
+    static std::string box_path(
+        const Ledger::ledgerType theType,
+        const Identifier& theNotaryID,
+        const Identifier& theAccountID);
+    static void load_box(
+        BoxSnapshot& theBox,
+        bool bVerify,
+        std::mutex& storageLock);
+    static bool same_record(const OTRecord& lhs, const OTRecord& rhs);
+
+    void add_box(
+        map_of_boxes& theBoxes,
+        const Ledger::ledgerType theType,
+        const Identifier& theNotaryID,
+        const Identifier& theNymID,
+        const Identifier& theAccountID,
+        const Nym* pNym);
+    std::shared_ptr<Ledger> get_box(
+        const Ledger::ledgerType theType,
+        const Identifier& theNotaryID,
+        const Identifier& theAccountID) const;
+    void load_boxes(OTWallet& theWallet);
+    void notify_changes(const vec_OTRecordList& previous);
+
 public:  // ADDRESS BOOK CALLBACK
     static bool setAddrBookCaller(OTLookupCaller& theCaller);
     static OTLookupCaller* getAddrBookCaller();
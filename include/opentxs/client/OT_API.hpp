@@ -1225,6 +1225,8 @@ public:
                                               // threshold price here.
     EXPORT int32_t
     getMarketList(const Identifier& NOTARY_ID, const Identifier& NYM_ID) const;
+    EXPORT int32_t
+    getStatistics(const Identifier& NOTARY_ID, const Identifier& NYM_ID) const;
     EXPORT int32_t getMarketOffers(
         const Identifier& NOTARY_ID,
         const Identifier& NYM_ID,
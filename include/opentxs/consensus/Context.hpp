@@ -57,7 +57,8 @@ class Nym;
 class TransactionStatement;
 class Wallet;
 
-class Context : public Signable
+class Context : public Signable,
+                public std::enable_shared_from_this<Context>
 {
 public:
     std::set<RequestNumber> AcknowledgedNumbers() const;
@@ -39,6 +39,7 @@
 #ifndef OPENTXS_CORE_CONTRACT_HPP
 #define OPENTXS_CORE_CONTRACT_HPP
 
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Nym.hpp"
@@ -52,6 +53,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace irr
 {
@@ -146,6 +148,12 @@ protected:
     EXPORT virtual int32_t ProcessXMLNode(irr::io::IrrXMLReader*& xml);
 
 public:
+    /** Calls VerifySignature(theNym) on each contract, spread across the OT
+     * task workers. Returns true only if every contract verifies. */
+    EXPORT static bool VerifySignatures(
+        const std::vector<const Contract*>& contracts,
+        const Nym& theNym);
+
     /** Used by OTTransactionType::Factory and OTToken::Factory. In both cases,
      * it takes the input string, trims it, and if it's armored, it unarmors it,
      * with the result going into strOutput. On success, bool is returned, and
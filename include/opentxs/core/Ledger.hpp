@@ -82,6 +82,14 @@ private:
     mapOfTransactions m_mapTransactions; // a ledger contains a map of
                                          // transactions.
 
+    // When set, box ledgers store their abbreviated records as a single
+    // packed binary field instead of one XML element per receipt. (The
+    // notary sets this from its config; see SetPackedRecords.)
+    static bool __packed_records;
+
+    bool m_bPackedRecords{false}; // This box was loaded in packed form, so
+                                  // it's saved back the same way.
+
 protected:
     // return -1 if error, 0 if nothing, and 1 if the node was processed.
     int32_t ProcessXMLNode(irr::io::IrrXMLReader*& xml) override;
@@ -132,6 +140,9 @@ public:
         return m_bLoadedLegacyData;
     }
 
+    static bool GetPackedRecords() { return __packed_records; }
+    static void SetPackedRecords(bool bPacked) { __packed_records = bPacked; }
+
     // This function assumes that this is an INBOX.
     // If you don't use an INBOX to call this method, then it will return
     // nullptr immediately. If you DO use an inbox, then it will create a
@@ -42,11 +42,18 @@
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/String.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <deque>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 #if defined(unix) || defined(__unix__) || defined(__unix) ||                   \
     defined(__APPLE__) || defined(linux) || defined(__linux) ||                \
@@ -58,11 +65,21 @@
 #define PREDEF_MODE_DEBUG 1
 #endif
 
+/** Streams a log message only if the stream's level is enabled. Unlike
+ *  streaming directly, the arguments are not evaluated at all when the
+ *  message would be filtered, so use it for arguments which are expensive to
+ *  construct:
+ *
+ *      OT_LOG(otInfo) << String(request) << std::endl;
+ */
+#define OT_LOG(stream)                                                         \
+    if (!(stream).Enabled()) {                                                 \
+    } else                                                                     \
+        (stream)
+
 namespace opentxs
 {
 
-typedef std::deque<String*> dequeOfStrings;
-
 class OTLogStream;
 class Settings;
 
@@ -87,23 +104,36 @@ OTLOG_IMPORT extern OTLogStream otLog3;  // logs using OTLog::vOutput(3)
 OTLOG_IMPORT extern OTLogStream otLog4;  // logs using OTLog::vOutput(4)
 OTLOG_IMPORT extern OTLogStream otLog5;  // logs using OTLog::vOutput(5)
 
+/** Each thread accumulates its own copy of a line until it reaches a newline,
+ *  so concurrent writers do not interleave partial lines. */
 class OTLogStream : public std::ostream, std::streambuf
 {
 private:
     int logLevel{0};
-    int next{0};
-    char* pBuffer{nullptr};
+
+    std::string& buffer() const;
+    void send(std::string& line) const;
 
 public:
     explicit OTLogStream(int _logLevel);
     ~OTLogStream();
 
+    /** True if messages written to this stream would be logged */
+    bool Enabled() const;
+
     virtual int overflow(int c) override;
+    virtual std::streamsize xsputn(const char* s, std::streamsize n) override;
 };
 
 class Log
 {
 private:
+    /** Node of the queue between logging threads and the writer thread */
+    struct LogLine {
+        std::string text_{};
+        LogLine* next_{nullptr};
+    };
+
     static Log* pLogger;
     static const String m_strVersion;
     static const String m_strPathSeparator;
@@ -115,7 +145,23 @@ private:
     String m_strThreadContext{""};
     String m_strLogFileName{""};
     String m_strLogFilePath{""};
-    dequeOfStrings logDeque{};
+    /** Most recent messages, newest at memlog_head_. Slots are reused so the
+     *  allocation is bounded by the ring size. */
+    std::mutex memlog_lock_;
+    std::vector<std::string> memlog_;
+    std::size_t memlog_head_{0};
+    std::size_t memlog_size_{0};
+    /** Lines waiting for the writer thread, newest first. Pushed without
+     *  locking by any thread, taken all at once by the writer. */
+    std::atomic<LogLine*> pending_{nullptr};
+    std::atomic<bool> running_{false};
+    /** Threads currently between checking running_ and pushing a line */
+    std::atomic<std::size_t> producers_{0};
+    std::mutex writer_lock_;
+    std::mutex signal_lock_;
+    std::condition_variable signal_;
+    std::unique_ptr<std::thread> writer_;
+    std::ofstream log_file_;
 
     /** For things that represent internal inconsistency in the code. Normally
      * should NEVER happen even with bad input from user. (Don't call this
@@ -123,12 +169,21 @@ private:
     static Assert::fpt_Assert_sz_n_sz(logAssert);
     static bool CheckLogger(Log* pLogger);
 
+    std::size_t memlog_index(std::size_t position) const;
+    void enqueue(const char* text);
+    void start_writer();
+    void stop_writer();
+    bool try_enqueue(const String& text);
+    void write_pending();
+    void writer();
+
     Log(Settings& config);
     Log() = delete;
     Log(const Log&) = delete;
     Log(Log&&) = delete;
     Log& operator=(const Log&) = delete;
     Log& operator=(Log&&) = delete;
+    ~Log();
 
 public:
     /** now the logger checks the global config file itself for the
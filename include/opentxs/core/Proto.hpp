@@ -48,7 +48,9 @@
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/Data.hpp"
 
+#include <cstdint>
 #include <iostream>
+#include <string>
 
 namespace opentxs
 {
@@ -71,14 +73,15 @@ Data ProtoAsData(const T& serialized)
 template<class T>
 std::string ProtoAsString(const T& serialized)
 {
-    auto size = serialized.ByteSize();
-    char* protoArray = new char [size];
+    const auto size = serialized.ByteSize();
+    std::string serializedData(size, '\0');
 
-    OT_ASSERT_MSG(nullptr != protoArray, "protoArray failed to dynamically allocate.");
+    if (0 < size) {
+        // ByteSize() cached the sizes of every nested message
+        serialized.SerializeWithCachedSizesToArray(
+            reinterpret_cast<std::uint8_t*>(&serializedData[0]));
+    }
 
-    serialized.SerializeToArray(protoArray, size);
-    std::string serializedData(protoArray, size);
-    delete[] protoArray;
     return serializedData;
 }
 
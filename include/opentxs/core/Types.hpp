@@ -398,6 +398,9 @@ enum class MessageType : std::uint8_t {
 
     addClaim = 59,
     addClaimR = 60,
+
+    getStatistics = 61,
+    getStatisticsR = 62,
 };
 
 enum class ThreadStatus : std::uint8_t {
@@ -0,0 +1,123 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_CONTRACT_ACCOUNTINDEX_HPP
+#define OPENTXS_CORE_CONTRACT_ACCOUNTINDEX_HPP
+
+#include "opentxs/core/util/Journal.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace opentxs
+{
+
+/** The IDs of every user account of one unit definition, used when paying
+ *  dividends.
+ *
+ *  The IDs are kept sorted in memory and saved as a log of additions and
+ *  removals, so registering or deleting an account appends one line instead
+ *  of rewriting the whole list. The log is rewritten once most of its lines
+ *  are obsolete. An old <unit>.a account records file is imported the first
+ *  time the index for that unit is loaded. */
+class AccountIndex
+{
+public:
+    /** Returns the index for a unit definition, loading it if no other
+     *  caller is using it */
+    EXPORT static std::shared_ptr<AccountIndex> Get(const std::string& unitID);
+
+    /** Returns true if the account is in the index afterwards */
+    EXPORT bool Add(const std::string& accountID);
+    /** Returns true if the account is not in the index afterwards */
+    EXPORT bool Erase(const std::string& accountID);
+    EXPORT bool Exists(const std::string& accountID) const;
+    /** False if the log could not be read in full. The index is then empty,
+     *  refuses changes, and leaves the log as it was. */
+    EXPORT bool Loaded() const;
+    EXPORT std::size_t Size() const;
+    /** Calls visitor with each account ID, in order, until it returns false
+     *
+     *  The index is not locked while visitor runs, so accounts may be added
+     *  or erased during the visit.
+     *
+     *  Returns false without visiting anything if the index is not loaded.
+     *
+     *  \param[in] afterAccountID if set, only IDs which sort after it are
+     *                            visited
+     */
+    EXPORT bool Visit(
+        const std::function<bool(const std::string&)>& visitor,
+        const std::string& afterAccountID = "") const;
+
+    EXPORT ~AccountIndex() = default;
+
+private:
+    typedef std::unique_lock<std::mutex> Lock;
+
+    static std::mutex map_lock_;
+    static std::map<std::string, std::weak_ptr<AccountIndex>> map_;
+
+    const std::string unit_id_;
+    const std::string file_;
+    mutable std::mutex lock_;
+    std::set<std::string> accounts_;
+    std::unique_ptr<Journal> log_;
+    bool loaded_{false};
+
+    bool append(const Lock& lock, const char op, const std::string& accountID);
+    bool compact(const Lock& lock);
+    bool import_records(const Lock& lock);
+    bool load(const Lock& lock);
+    bool open(const Lock& lock);
+    bool path(std::string& output) const;
+
+    explicit AccountIndex(const std::string& unitID);
+    AccountIndex() = delete;
+    AccountIndex(const AccountIndex&) = delete;
+    AccountIndex(AccountIndex&&) = delete;
+    AccountIndex& operator=(const AccountIndex&) = delete;
+    AccountIndex& operator=(AccountIndex&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_CONTRACT_ACCOUNTINDEX_HPP
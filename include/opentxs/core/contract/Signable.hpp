@@ -79,6 +79,14 @@ protected:
         const Lock& lock,
         const proto::Signature& signature) const;
     bool verify_write_lock(const Lock& lock) const;
+    /** Check the process-wide memo for a previous successful verification
+     *
+     *  Only valid for contracts whose signed form is the ID version plus
+     *  id_, and only consulted when id_ matches the contents.
+     */
+    bool verified(const Lock& lock, const proto::Signature& signature) const;
+    void set_verified(const Lock& lock, const proto::Signature& signature)
+        const;
 
     /** Calculate and unconditionally set id_ */
     bool CalculateID(const Lock& lock);
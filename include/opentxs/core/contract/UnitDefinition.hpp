@@ -135,7 +135,9 @@ public:
     // removes the account from the list. (When account is deleted.)
     EXPORT bool EraseAccountRecord(const Identifier& theAcctID) const;
 
-    EXPORT bool VisitAccountRecords(AccountVisitor& visitor) const;
+    EXPORT bool VisitAccountRecords(
+        AccountVisitor& visitor,
+        const std::string& afterAccountID = "") const;
 
     EXPORT static std::string formatLongAmount(
         int64_t lValue, int32_t nFactor = 100, int32_t nPower = 2,
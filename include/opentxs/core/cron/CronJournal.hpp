@@ -0,0 +1,115 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_CRON_CRONJOURNAL_HPP
+#define OPENTXS_CORE_CRON_CRONJOURNAL_HPP
+
+#include "opentxs/core/util/Journal.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace opentxs
+{
+
+class Nym;
+
+/** Changes made to the cron file or a market file since it was last saved
+ *
+ *  Saving either file re-serializes and re-signs everything in it, so each
+ *  change is instead appended to a journal beside the file as one line, and
+ *  the file itself is only saved as a periodic snapshot.
+ *
+ *  Every snapshot starts a new generation, and each record is tagged with
+ *  the generation it follows. Records left over from before the most recent
+ *  snapshot are skipped when the journal is replayed. Each line is signed by
+ *  the server nym, and a line whose signature does not verify is never
+ *  replayed.
+ */
+class CronJournal
+{
+public:
+    typedef std::function<bool(const std::string& record)> Replayer;
+
+    /** \param[in] file name of the journal inside folder
+     *  \param[in] signer the server nym, which must outlive the journal */
+    CronJournal(
+        const std::string& folder,
+        const std::string& file,
+        const Nym& signer);
+
+    /** Appends one record, which must not contain a line break */
+    bool Append(const std::int64_t generation, const std::string& record);
+    /** Discards every record. Call once a snapshot has been saved. */
+    bool Clear();
+    /** Calls replayer with each record of the generation, in order
+     *
+     *  Stops and returns false at the first line which is invalid or
+     *  unsigned, or whose call to replayer fails, so the records after it
+     *  are never replayed. The caller must then discard whatever it has
+     *  replayed. A copy of the journal is kept beside it with a ".failed"
+     *  suffix so that clearing the journal does not lose the records.
+     */
+    bool Replay(const std::int64_t generation, const Replayer& replayer);
+    /** Number of lines in the journal, including obsolete ones */
+    std::size_t Size();
+
+    ~CronJournal() = default;
+
+private:
+    const std::string folder_;
+    const std::string file_;
+    const Nym& signer_;
+    std::unique_ptr<Journal> log_;
+
+    bool open();
+    bool path(std::string& output) const;
+    bool sign(const std::string& line, std::string& signature) const;
+    bool verify(const std::string& line, const std::string& signature) const;
+
+    CronJournal() = delete;
+    CronJournal(const CronJournal&) = delete;
+    CronJournal(CronJournal&&) = delete;
+    CronJournal& operator=(const CronJournal&) = delete;
+    CronJournal& operator=(CronJournal&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_CRON_CRONJOURNAL_HPP
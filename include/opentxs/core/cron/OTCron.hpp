@@ -39,11 +39,15 @@
 #ifndef OPENTXS_CORE_CRON_OTCRON_HPP
 #define OPENTXS_CORE_CRON_OTCRON_HPP
 
+#include "opentxs/core/cron/CronJournal.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/StringUtils.hpp"
 #include "opentxs/core/util/Timer.hpp"
 #include "opentxs/core/Contract.hpp"
 
+#include <memory>
+#include <string>
+
 namespace opentxs
 {
 
@@ -83,6 +87,15 @@ private:
     bool m_bIsActivated{false};
     // I'll need this for later.
     Nym* m_pServerNym{nullptr};
+    // Changes since the cron file was last saved. Created on first use.
+    std::unique_ptr<CronJournal> m_pJournal;
+    // Incremented by each save of the cron file.
+    int64_t m_lJournalGeneration{0};
+    // Set when the last LoadCron failed to replay its journal, or a market's.
+    bool m_bJournalFailed{false};
+    // Transaction numbers taken and added since the last journal record.
+    int64_t m_lNumbersTaken{0};
+    listOfLongNumbers m_listNumbersAdded;
     // Number of transaction numbers Cron  will grab for itself, when it gets
     // low, before each round.
     static int32_t __trans_refill_amount;
@@ -91,9 +104,18 @@ private:
     // Int. The maximum number of cron items any given Nym can have
     // active at the same time.
     static int32_t __cron_max_items_per_nym;
+    // Journal records allowed before the cron file is saved again. 0 saves
+    // the cron file after every change.
+    static int32_t __cron_journal_records;
 
     static Timer tCron;
 
+    bool erase_item(int64_t lTransactionNum);
+    bool journal(const std::string& strType, const std::string& strArgs);
+    CronJournal& journal_file();
+    bool load_item(const String& strData, time64_t tDateAdded);
+    bool replay(const std::string& strRecord);
+
 public:
     static int32_t GetCronMsBetweenProcess()
     {
@@ -114,6 +136,11 @@ public:
     {
         __cron_max_items_per_nym = nMax;
     }
+    static int32_t GetCronJournalRecords() { return __cron_journal_records; }
+    static void SetCronJournalRecords(int32_t nRecords)
+    {
+        __cron_journal_records = nRecords;
+    }
     inline bool IsActivated() const { return m_bIsActivated; }
     inline bool ActivateCron()
     {
@@ -148,6 +175,9 @@ public:
     /** This is informational only. It returns OTStorage-type data objects,
      * packed in a string. */
     EXPORT bool GetMarketList(OTASCIIArmor& ascOutput, int32_t& nMarketCount);
+    /** Every value GetMarketList reports, without packing anything. Whenever
+     * this is unchanged, so is the market list. */
+    EXPORT std::string GetMarketListState();
     EXPORT bool GetNym_OfferList(
         OTASCIIArmor& ascOutput,
         const Identifier& NYM_ID,
@@ -186,8 +216,20 @@ public:
     }
     inline Nym* GetServerNym() const { return m_pServerNym; }
 
+    /** Loads the cron file, then replays the changes journaled since it was
+     * saved. If a journal fails to replay, nothing is kept loaded. */
     EXPORT bool LoadCron();
+    /** True if the last LoadCron failed because the cron journal, or the
+     * journal of one of its markets, could not be replayed in full. */
+    inline bool JournalFailed() const { return m_bJournalFailed; }
+    /** Signs and saves the whole cron file, and clears the journal. */
     EXPORT bool SaveCron();
+    /** Journals the current state of an item which is already on Cron. Call
+     * this instead of SaveCron after an item has changed. */
+    EXPORT bool SaveCronItem(OTCronItem& theItem);
+    /** Journals the transaction numbers taken and added since the last
+     * record, if any. */
+    EXPORT bool SaveTransactionNumbers();
 
     EXPORT OTCron();
     explicit OTCron(const Identifier& NOTARY_ID);
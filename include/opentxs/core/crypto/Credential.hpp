@@ -40,6 +40,7 @@
 #define OPENTXS_CORE_CRYPTO_CREDENTIAL_HPP
 
 #include "opentxs/core/contract/Signable.hpp"
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
@@ -147,7 +148,9 @@ private:
     std::string Name() const override { return String(id_).Get(); }
     bool VerifyMasterID() const;
     bool VerifyNymID() const;
-    bool verify_master_signature(const Lock& lock) const;
+    bool verify_master_signature(
+        const Lock& lock,
+        CryptoAsymmetric::VerificationBatch* batch) const;
 
 protected:
     proto::CredentialType type_ = proto::CREDTYPE_ERROR;
@@ -162,7 +165,11 @@ protected:
         const SerializationModeFlag asPrivate,
         const SerializationSignatureFlag asSigned) const;
     bool validate(const Lock& lock) const override;
-    virtual bool verify_internally(const Lock& lock) const;
+    /** When batch is not null, signature checks are queued on it rather than
+     *  performed, and only the non-cryptographic checks decide the result. */
+    virtual bool verify_internally(
+        const Lock& lock,
+        CryptoAsymmetric::VerificationBatch* batch) const;
 
     bool AddMasterSignature(const Lock& lock);
     virtual bool New(const NymParameters& nymParameters);
@@ -201,15 +208,20 @@ public:
         std::unique_ptr<proto::VerificationSet>& verificationSet) const;
 
     bool Validate() const;
+    /** Validates everything except the signatures, which are queued on batch
+     *  for CryptoAsymmetric::BatchVerify. */
+    bool Validate(CryptoAsymmetric::VerificationBatch& batch) const;
     virtual bool Verify(
         const Data& plaintext,
         const proto::Signature& sig,
-        const proto::KeyRole key = proto::KEYROLE_SIGN) const;
+        const proto::KeyRole key = proto::KEYROLE_SIGN,
+        CryptoAsymmetric::VerificationBatch* batch = nullptr) const;
     virtual bool Verify(
         const proto::Credential& credential,
         const proto::CredentialRole& role,
         const Identifier& masterID,
-        const proto::Signature& masterSig) const;
+        const proto::Signature& masterSig,
+        CryptoAsymmetric::VerificationBatch* batch = nullptr) const;
     virtual bool TransportKey(Data& publicKey, OTPassword& privateKey) const;
 
     virtual ~Credential() = default;
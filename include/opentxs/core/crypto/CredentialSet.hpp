@@ -217,6 +217,10 @@ public:
         bool bShowRevoked = false,
         bool bValid = true) const;
     EXPORT bool VerifyInternally() const;
+    /** Like VerifyInternally, but the signature checks are queued on batch
+     *  for CryptoAsymmetric::BatchVerify instead of being performed here. */
+    EXPORT bool VerifyInternally(
+        CryptoAsymmetric::VerificationBatch& batch) const;
     EXPORT const MasterCredential& GetMasterCredential() const
     {
         return *m_MasterCredential;
@@ -39,17 +39,19 @@
 #ifndef OPENTXS_CORE_CRYPTO_CRYPTOASYMMETRIC_HPP
 #define OPENTXS_CORE_CRYPTO_CRYPTOASYMMETRIC_HPP
 
+#include "opentxs/core/Data.hpp"
 #include "opentxs/core/Proto.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/core/Types.hpp"
 
 #include <set>
+#include <string>
+#include <vector>
 
 namespace opentxs
 {
 
 class OTAsymmetricKey;
-class Data;
 class OTPassword;
 class OTPasswordData;
 class OTSignature;
@@ -60,10 +62,42 @@ class CryptoAsymmetric
 {
 
 public:
+    /** One independent (key, plaintext, signature) check for BatchVerify.
+     *  The key is not owned and must outlive the batch. */
+    struct Verification {
+        const OTAsymmetricKey* key_{nullptr};
+        Data plaintext_;
+        Data signature_;
+        proto::HashType hash_{proto::HASHTYPE_ERROR};
+        /** Logged by BatchVerify if this check fails */
+        std::string failure_;
+        bool valid_{false};
+    };
+    typedef std::vector<Verification> VerificationBatch;
 
     static proto::AsymmetricKeyType CurveToKeyType(const EcdsaCurve& curve);
     static EcdsaCurve KeyTypeToCurve(const proto::AsymmetricKeyType& type);
 
+    /** Checks every signature in the batch on the OT task workers, each
+     *  through VerifyMemoized(). Sets valid_ on each item and returns true only if
+     *  all of them verified. */
+    static bool BatchVerify(VerificationBatch& batch);
+    /** Sets the failure message of the checks added to batch since it held
+     *  start items. Does nothing if batch is nullptr. */
+    static void DescribeFailures(
+        VerificationBatch* batch,
+        const std::size_t start,
+        const std::string& message);
+    /** Verifies one signature with the engine belonging to theKey. A check
+     *  which already succeeded in this process is answered from
+     *  SignatureMemo. Both the single and the batched paths use this. */
+    static bool VerifyMemoized(
+        const Data& plaintext,
+        const OTAsymmetricKey& theKey,
+        const Data& signature,
+        const proto::HashType hashType,
+        const OTPasswordData* pPWData = nullptr);
+
     bool SignContract(
         const String& strContractUnsigned,
         const OTAsymmetricKey& theKey,
@@ -59,6 +59,7 @@ class CryptoHashEngine;
 class CryptoSymmetric;
 class CryptoSymmetricEngine;
 class CryptoUtil;
+class EphemeralKeyPool;
 class Libsecp256k1;
 class Libsodium;
 class OpenSSL;
@@ -107,6 +108,7 @@ private:
     std::unique_ptr<CryptoEncodingEngine> encode_;
     std::unique_ptr<CryptoHashEngine> hash_;
     std::unique_ptr<CryptoSymmetricEngine> symmetric_;
+    std::unique_ptr<EphemeralKeyPool> ephemeral_;
 
     void init_default_key(const Lock& lock) const;
 
@@ -150,6 +152,9 @@ public:
     EXPORT CryptoAsymmetric& SECP256K1() const;
 #endif
 
+    // Single-use keypairs for ECDH
+    EXPORT const EphemeralKeyPool& Ephemeral() const;
+
     // Symmetric encryption engines
     EXPORT CryptoSymmetricEngine& Symmetric() const;
 
@@ -114,6 +114,16 @@ public:
         const OTPasswordData& passwordData,
         SymmetricKey& sessionKey,
         OTPassword& newKeyPassword) const;
+    /** Wrap an unlocked session key to one recipient
+     *
+     *  Takes the ephemeral private key as a raw secret, so sealing to several
+     *  recipients does not decrypt it once per recipient.
+     */
+    bool EncryptSessionKeyECDH(
+        const OTPassword& privateKey,
+        const AsymmetricKeyEC& publicKey,
+        SymmetricKey& sessionKey,
+        OTPassword& newKeyPassword) const;
     virtual bool ExportECPrivatekey(
         const OTPassword& privkey,
         const OTPasswordData& password,
@@ -0,0 +1,127 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_CRYPTO_EPHEMERALKEYPOOL_HPP
+#define OPENTXS_CORE_CRYPTO_EPHEMERALKEYPOOL_HPP
+
+#include "opentxs/core/Proto.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Number of ready keypairs to keep on hand for each curve
+#define OT_EPHEMERAL_KEY_POOL_SIZE 32
+
+namespace opentxs
+{
+
+class CryptoEngine;
+class Data;
+class Ecdsa;
+class OTPassword;
+
+/** Pre-generated, single-use EC keypairs for ECDH key agreement
+ *
+ *  Sealing a letter needs a fresh ephemeral keypair for every curve used by
+ *  its recipients. The pool generates them on a background thread so the
+ *  sealing thread only has to pop one. If a pool runs dry a keypair is
+ *  generated inline, so callers never wait for the refill thread.
+ *
+ *  Keys are handed out as raw secrets and never serialized or encrypted,
+ *  since they are discarded as soon as the letter is sealed.
+ */
+class EphemeralKeyPool
+{
+private:
+    friend class CryptoEngine;
+    typedef std::unique_lock<std::mutex> Lock;
+
+    struct Keypair {
+        std::unique_ptr<OTPassword> private_{nullptr};
+        std::unique_ptr<Data> public_{nullptr};
+    };
+
+    typedef std::deque<Keypair> Pool;
+
+    const std::map<proto::AsymmetricKeyType, const Ecdsa*> engines_;
+    const std::size_t target_{OT_EPHEMERAL_KEY_POOL_SIZE};
+    mutable std::mutex lock_;
+    mutable std::condition_variable signal_;
+    mutable std::map<proto::AsymmetricKeyType, Pool> pools_;
+    mutable std::atomic<bool> running_;
+    mutable std::atomic<bool> shutdown_;
+    mutable std::unique_ptr<std::thread> refill_thread_;
+
+    bool generate(const proto::AsymmetricKeyType type, Keypair& keypair)
+        const;
+    bool needs_refill(const Lock& lock) const;
+    void refill() const;
+    void start(const Lock& lock) const;
+    void Stop();
+
+    EphemeralKeyPool(
+        const std::map<proto::AsymmetricKeyType, const Ecdsa*>& engines);
+    EphemeralKeyPool() = delete;
+    EphemeralKeyPool(const EphemeralKeyPool&) = delete;
+    EphemeralKeyPool(EphemeralKeyPool&&) = delete;
+    EphemeralKeyPool& operator=(const EphemeralKeyPool&) = delete;
+    EphemeralKeyPool& operator=(EphemeralKeyPool&&) = delete;
+
+public:
+    /** Remove an unused keypair from the pool
+     *
+     *  \param[in] type The curve of the requested keypair
+     *  \param[out] privateKey The private key, in the format expected by
+     *                         Ecdsa::ECDH
+     *  \param[out] publicKey The corresponding public key
+     */
+    EXPORT bool Take(
+        const proto::AsymmetricKeyType type,
+        OTPassword& privateKey,
+        Data& publicKey) const;
+
+    ~EphemeralKeyPool();
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_CRYPTO_EPHEMERALKEYPOOL_HPP
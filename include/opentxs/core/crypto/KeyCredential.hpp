@@ -104,8 +104,11 @@ private:
     bool VerifySig(
         const Lock& lock,
         const proto::Signature& sig,
-        const CredentialModeFlag asPrivate = PRIVATE_VERSION) const;
-    bool VerifySignedBySelf(const Lock& lock) const;
+        const CredentialModeFlag asPrivate = PRIVATE_VERSION,
+        CryptoAsymmetric::VerificationBatch* batch = nullptr) const;
+    bool VerifySignedBySelf(
+        const Lock& lock,
+        CryptoAsymmetric::VerificationBatch* batch) const;
 
 #if OT_CRYPTO_SUPPORTED_KEY_HD
     std::shared_ptr<OTKeypair> DeriveHDKeypair(
@@ -123,7 +126,9 @@ protected:
         const Lock& lock,
         const SerializationModeFlag asPrivate,
         const SerializationSignatureFlag asSigned) const override;
-    bool verify_internally(const Lock& lock) const override;
+    bool verify_internally(
+        const Lock& lock,
+        CryptoAsymmetric::VerificationBatch* batch) const override;
 
     bool New(const NymParameters& nymParameters) override;
     virtual bool SelfSign(
@@ -157,7 +162,8 @@ public:
     bool Verify(
         const Data& plaintext,
         const proto::Signature& sig,
-        const proto::KeyRole key = proto::KEYROLE_SIGN) const override;
+        const proto::KeyRole key = proto::KEYROLE_SIGN,
+        CryptoAsymmetric::VerificationBatch* batch = nullptr) const override;
     bool TransportKey(Data& publicKey, OTPassword& privateKey) const override;
 
     virtual ~KeyCredential() = default;
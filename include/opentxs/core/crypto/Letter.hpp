@@ -54,6 +54,7 @@ class AsymmetricKeyEC;
 class Nym;
 class OTPasswordData;
 class Data;
+class SymmetricKey;
 
 typedef std::list<symmetricEnvelope> listOfSessionKeys;
 typedef std::map<proto::AsymmetricKeyType, std::string> listOfEphemeralKeys;
@@ -65,6 +66,11 @@ typedef std::multimap<std::string, const AsymmetricKeyEC*> mapOfECKeys;
 class Letter
 {
 private:
+    static bool AddECRecipients(
+        const proto::AsymmetricKeyType type,
+        const mapOfECKeys& recipients,
+        SymmetricKey& sessionKey,
+        proto::Envelope& envelope);
     static bool AddRSARecipients(
         const mapOfAsymmetricKeys& recipients,
         const SymmetricKey& sessionKey,
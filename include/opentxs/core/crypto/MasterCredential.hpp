@@ -89,7 +89,9 @@ private:  // Private prevents erroneous use by other classes.
         const SerializationModeFlag asPrivate,
         const SerializationSignatureFlag asSigned) const override;
     bool verify_against_source(const Lock& lock) const;
-    bool verify_internally(const Lock& lock) const override;
+    bool verify_internally(
+        const Lock& lock,
+        CryptoAsymmetric::VerificationBatch* batch) const override;
 
     bool New(const NymParameters& nymParameters) override;
 
@@ -113,7 +115,8 @@ public:
         const proto::Credential& credential,
         const proto::CredentialRole& role,
         const Identifier& masterID,
-        const proto::Signature& masterSig) const override;
+        const proto::Signature& masterSig,
+        CryptoAsymmetric::VerificationBatch* batch = nullptr) const override;
 
     virtual ~MasterCredential() = default;
 };
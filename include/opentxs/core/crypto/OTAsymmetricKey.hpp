@@ -284,6 +284,11 @@ public:
     virtual serializedAsymmetricKey Serialize() const;
     virtual bool Verify(const Data& plaintext, const proto::Signature& sig)
         const;
+    /** Queues the check on batch instead of performing it immediately. */
+    bool Verify(
+        const Data& plaintext,
+        const proto::Signature& sig,
+        CryptoAsymmetric::VerificationBatch& batch) const;
     virtual proto::HashType SigHashType() const
     {
         return CryptoEngine::StandardHash;
@@ -43,6 +43,8 @@
 
 #include "OTAsymmetricKeyOpenSSL.hpp"
 
+#include <mutex>
+
 extern "C" {
 #include <openssl/pem.h>
 #include <openssl/evp.h>
@@ -96,6 +98,10 @@ private:
     EVP_PKEY* m_pKey{nullptr}; // Instantiated form of key. (For private keys especially,
                       // we don't want it instantiated for any longer than
                       // absolutely necessary, when we have to use it.)
+    // GetKey() may release m_pKey when the key timer expires. Callers hold
+    // this lock from GetKey() until they are finished with the pointer it
+    // returned, so that another thread can not free it underneath them.
+    std::mutex lock_;
     // PRIVATE METHODS
     EVP_PKEY* InstantiateKey(const OTPasswordData* pPWData = nullptr);
     EVP_PKEY* InstantiatePublicKey(const OTPasswordData* pPWData = nullptr);
@@ -118,6 +118,10 @@ public:
 
     serializedAsymmetricKey Serialize(bool privateKey = false) const;
     bool Verify(const Data& plaintext, const proto::Signature& sig) const;
+    bool Verify(
+        const Data& plaintext,
+        const proto::Signature& sig,
+        CryptoAsymmetric::VerificationBatch& batch) const;
     bool TransportKey(Data& publicKey, OTPassword& privateKey) const;
 
     template<class C>
@@ -0,0 +1,105 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_CRYPTO_SIGNATUREMEMO_HPP
+#define OPENTXS_CORE_CRYPTO_SIGNATUREMEMO_HPP
+
+#include "opentxs/core/Identifier.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <utility>
+
+// Maximum number of verified signatures remembered by the process
+#define OT_SIGNATURE_MEMO_SIZE 16384
+
+namespace opentxs
+{
+
+/** Process-wide record of signatures which have already verified
+ *
+ *  A signature over immutable content verifies the same way every time, so
+ *  once a contract signature has been checked the result can be reused by
+ *  every later load of the same contract. Entries are keyed by the identifier
+ *  of the signed content and a digest of the signature together with the key
+ *  that verified it.
+ *
+ *  Only successful verifications are recorded. The oldest entries are
+ *  forgotten once OT_SIGNATURE_MEMO_SIZE is reached.
+ */
+class SignatureMemo
+{
+private:
+    typedef std::unique_lock<std::mutex> Lock;
+    typedef std::pair<Identifier, Identifier> Key;
+
+    static std::mutex lock_;
+    static std::set<Key> verified_;
+    static std::deque<Key> order_;
+
+    SignatureMemo() = delete;
+    SignatureMemo(const SignatureMemo&) = delete;
+    SignatureMemo(SignatureMemo&&) = delete;
+    SignatureMemo& operator=(const SignatureMemo&) = delete;
+    SignatureMemo& operator=(SignatureMemo&&) = delete;
+
+public:
+    /** Returns true if this signature has already been verified
+     *
+     *  \param[in] contract The identifier of the signed content
+     *  \param[in] signature A digest of the signature and the verifying key
+     */
+    EXPORT static bool Check(
+        const Identifier& contract,
+        const Identifier& signature);
+    /** Forget all verified signatures */
+    EXPORT static void Clear();
+    /** Record a successful verification
+     *
+     *  \param[in] contract The identifier of the signed content
+     *  \param[in] signature A digest of the signature and the verifying key
+     */
+    EXPORT static void Insert(
+        const Identifier& contract,
+        const Identifier& signature);
+    EXPORT static std::size_t Size();
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_CRYPTO_SIGNATUREMEMO_HPP
@@ -177,6 +177,15 @@ public:
         const OTPasswordData& oldPassword,
         const OTPassword& newPassword);
 
+    /** Re-encrypt an already unlocked key to a new password
+     *
+     *  Avoids deriving the old password again when one key is wrapped to
+     *  several passwords in a row.
+     *
+     *  \param[in] newPassword The password to encrypt the key with
+     */
+    bool ChangePassword(const OTPassword& newPassword);
+
     /** Decrypt ciphertext using the symmetric key
      *
      *  \param[in] ciphertext The data to be decrypted
@@ -60,7 +60,9 @@ private:
         const Lock& lock,
         const SerializationModeFlag asPrivate,
         const SerializationSignatureFlag asSigned) const override;
-    bool verify_internally(const Lock& lock) const override;
+    bool verify_internally(
+        const Lock& lock,
+        CryptoAsymmetric::VerificationBatch* batch) const override;
 
     VerificationCredential(
         CredentialSet& parent,
@@ -53,6 +53,8 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
 
 namespace opentxs
@@ -81,6 +83,15 @@ typedef std::multimap<int64_t, OTOffer*> mapOfOffers;
 // The same offers are also mapped (uniquely) to transaction number.
 typedef std::map<int64_t, OTOffer*> mapOfOffersTrnsNum;
 
+// Aggregated depth of one side of the book at a single price.
+struct OTPriceLevel {
+    int64_t m_lOfferCount{0};
+    int64_t m_lAmountAvailable{0};
+};
+
+// One entry per distinct price limit that has at least one resting offer.
+typedef std::map<int64_t, OTPriceLevel> mapOfPriceLevels;
+
 class OTMarket : public Contract
 {
 private: // Private prevents erroneous use by other classes.
@@ -97,6 +108,29 @@ private:
     mapOfOffersTrnsNum m_mapOffers; // All of the offers on a single list,
                                     // ordered by transaction number.
 
+    mapOfPriceLevels m_mapBidLevels; // Bid depth, aggregated per price.
+    mapOfPriceLevels m_mapAskLevels; // Ask depth, aggregated per price.
+
+    // Transaction numbers of resting offers, indexed by the owner's Nym ID.
+    // Offers loaded from the market file do not know their trade (and thus
+    // their Nym) until cron links them, so those wait on m_setUnindexedOffers
+    // until the next per-Nym query picks them up.
+    std::map<std::string, std::set<int64_t>> m_mapNymOffers;
+    std::set<int64_t> m_setUnindexedOffers;
+
+    // Bumped whenever the order book changes. The serialized offer lists
+    // returned by GetOfferList are cached against it.
+    int64_t m_lVersion{0};
+    int64_t m_lOfferListVersion{-1};
+    std::map<int64_t, std::pair<int32_t, std::string>> m_mapOfferListCache;
+
+    // Changes since the market file was last saved. Created on first use.
+    std::unique_ptr<CronJournal> m_pJournal;
+    // Incremented by each save of the market file.
+    int64_t m_lJournalGeneration{0};
+    // Set when the last LoadMarket failed to replay the journal.
+    bool m_bJournalFailed{false};
+
     Identifier m_NOTARY_ID; // Always store this in any object that's
                             // associated with a specific server.
 
@@ -145,6 +179,17 @@ private:
                                 Account& p3, bool b3, const int64_t& a3,
                                 Account& p4, bool b4, const int64_t& a4);
 
+    void add_to_price_level(OTOffer& theOffer);
+    void remove_from_price_level(OTOffer& theOffer);
+    void offer_filled(OTOffer& theOffer, const int64_t& lAmount);
+    void index_nym_offers();
+    bool journal(const std::string& strType, const std::string& strArgs);
+    CronJournal& journal_file();
+    OTOffer* load_offer(const std::string& strArmored);
+    bool remove_offer(const int64_t& lTransactionNum);
+    bool replay(const std::string& strRecord);
+    bool save_trade_list();
+
 public:
     bool ValidateOfferForMarket(OTOffer& theOffer, String* pReason = nullptr);
 
@@ -236,6 +281,13 @@ public:
         return m_strLastSaleDate;
     }
     int64_t GetTotalAvailableAssets();
+    // Aggregated depth at a given price. (Zero if nothing rests there.)
+    int64_t GetBidDepth(const int64_t& lPrice) const;
+    int64_t GetAskDepth(const int64_t& lPrice) const;
+    inline const int64_t& GetVersion() const
+    {
+        return m_lVersion;
+    }
     OTMarket();
     OTMarket(const char* szFilename);
     OTMarket(const Identifier& NOTARY_ID,
@@ -254,8 +306,19 @@ public:
     {
         return m_pCron;
     }
+    /** Loads the market file, then replays the changes journaled since it
+     * was saved. */
     bool LoadMarket();
+    /** True if the last LoadMarket failed because the journal could not be
+     * replayed in full. The market must then be discarded. */
+    inline bool JournalFailed() const { return m_bJournalFailed; }
+    /** Signs and saves the whole market file, and clears the journal. */
     bool SaveMarket();
+    /** Journals the current state of an offer which is already on the
+     * market. Call this instead of SaveMarket after an offer has changed. */
+    bool SaveOffer(OTOffer& theOffer);
+    /** Journals two offers which have just traded, and the new last sale. */
+    bool SaveTrade(OTOffer& theOffer, OTOffer& theOtherOffer);
 
     void InitMarket();
 
@@ -48,6 +48,7 @@
 #include "opentxs/core/Instrument.hpp"
 
 #include <stdint.h>
+#include <string>
 
 namespace opentxs
 {
@@ -107,6 +108,9 @@ NOTARY_ID; }
 / TO dates.
      */
     time64_t m_tDateAddedToMarket{0};
+    // Armored copy of the signed offer, as OTMarket writes it into the
+    // market file. Cleared whenever the offer is re-signed.
+    std::string m_strArmored;
 
     bool isPowerOfTen(const int64_t& x);
 
@@ -257,6 +261,11 @@ public:
                                                   // GetNymOfferList.
     EXPORT void SetDateAddedToMarket(time64_t tDate); // Used in OTCron when
                                                       // adding/loading offers.
+    // Armoring (compress + base64) dominates the cost of saving a market,
+    // and most offers don't change between saves.
+    EXPORT const std::string& GetArmored(); // Used in OTMarket::UpdateContents
+    EXPORT void SetArmored(const std::string& strArmored); // Used by OTMarket
+                                                           // when loading.
     EXPORT OTOffer(); // The constructor contains the 3 variables needed to
                       // identify any market.
     EXPORT OTOffer(const Identifier& NOTARY_ID,
@@ -41,12 +41,15 @@
 
 #include "opentxs/core/OTTransaction.hpp"
 
+#include <cstddef>
 #include <cstdint>
 
 namespace opentxs
 {
 
+class Data;
 class String;
+class Tag;
 class OTTransaction;
 class Ledger;
 class Identifier;
@@ -72,6 +75,31 @@ int32_t LoadAbbreviatedRecord(irr::io::IrrXMLReader*& xml,
                               bool& bReplyTransSuccess,
                               NumList* pNumList = nullptr);
 
+// Packs the abbreviated records in records (as written by the
+// SaveAbbreviated*Record methods) into a versioned binary form. The layout is
+// fixed width and big-endian, so the same box always packs to the same bytes.
+bool PackAbbreviatedRecords(const Tag& records, Data& output);
+
+// Reads the next packed record starting at offset, and advances offset past
+// it. The version header is consumed when offset is 0.
+// Returns 1 if success, -1 if error.
+int32_t UnpackAbbreviatedRecord(const Data& input,
+                                std::size_t& offset,
+                                int64_t& lNumberOfOrigin,
+                                int& theOriginType,
+                                int64_t& lTransactionNum,
+                                int64_t& lInRefTo,
+                                int64_t& lInRefDisplay,
+                                time64_t& the_DATE_SIGNED,
+                                int& theType,
+                                String& strHash,
+                                int64_t& lAdjustment,
+                                int64_t& lDisplayValue,
+                                int64_t& lClosingNum,
+                                int64_t& lRequestNum,
+                                bool& bReplyTransSuccess,
+                                NumList* pNumList = nullptr);
+
 EXPORT bool VerifyBoxReceiptExists(
     const Identifier& NOTARY_ID, const Identifier& NYM_ID,
     const Identifier& ACCOUNT_ID, // If for Nymbox (vs inbox/outbox) then
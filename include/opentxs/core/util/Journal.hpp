@@ -0,0 +1,108 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_UTIL_JOURNAL_HPP
+#define OPENTXS_CORE_UTIL_JOURNAL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace opentxs
+{
+
+/** An append-only file of records, one per line
+ *
+ *  Each record is on disk by the time Append returns. A record which was cut
+ *  short when the process stopped is removed from the end of the file when
+ *  the journal is opened, so later records never run into it.
+ *
+ *  Journals are not thread safe. Callers serialize access to them.
+ */
+class Journal
+{
+public:
+    typedef std::function<bool(const std::string& record)> Reader;
+
+    /** \param[in] path full path of the journal file. Its folder must exist
+     *                  before the journal is used. */
+    EXPORT explicit Journal(const std::string& path);
+
+    /** Appends one record, which must not contain a line break */
+    EXPORT bool Append(const std::string& record);
+    /** Calls reader with each record, in order
+     *
+     *  Returns false if the file could not be read, or as soon as a call to
+     *  reader fails. The records after that one are not read.
+     */
+    EXPORT bool Read(const Reader& reader);
+    /** Replaces the journal with the records
+     *
+     *  The new journal is written beside the old one and renamed over it, so
+     *  an interruption leaves one or the other.
+     */
+    EXPORT bool Rewrite(const std::vector<std::string>& records);
+    /** Number of records in the file */
+    EXPORT std::size_t Size();
+
+    EXPORT ~Journal();
+
+private:
+    const std::string path_;
+    int fd_{-1};
+    /** Bytes of complete records in the file */
+    std::int64_t length_{0};
+    std::size_t records_{0};
+
+    static bool read_file(const int fd, std::string& output);
+    static bool sync_folder(const std::string& path);
+    static bool write_all(const int fd, const std::string& data);
+
+    void close();
+    bool open();
+
+    Journal() = delete;
+    Journal(const Journal&) = delete;
+    Journal(Journal&&) = delete;
+    Journal& operator=(const Journal&) = delete;
+    Journal& operator=(Journal&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_UTIL_JOURNAL_HPP
@@ -39,10 +39,12 @@
 #ifndef CLASS_TAG_HEADER
 #define CLASS_TAG_HEADER
 
+#include <cstddef>
 #include <string>
 #include <map>
 #include <vector>
 #include <memory>
+#include <utility>
 
 namespace opentxs
 {
@@ -61,6 +63,8 @@ private:
     map_strings attributes_;
     vector_tags tags_;
 
+    void write(std::string& str_output) const;
+
 public:
     const std::string& name() const
     {
@@ -104,10 +108,58 @@ public:
 
     Tag(const std::string& str_name, const char* sztext);
 
+    /** Number of bytes outputXML will append */
+    std::size_t size() const;
+
     void output(std::string& str_output) const;
     void outputXML(std::string& str_output) const;
 };
 
+/** Writes the same XML as Tag::output straight into a string, without
+ *  building a tree of Tag objects first.
+ *
+ *  Open an element, add its attributes in any order, then give it either
+ *  text or child elements before closing it. Elements left open are closed
+ *  by the destructor.
+ */
+class TagWriter
+{
+public:
+    /** \param[in] reserve expected number of bytes to be written */
+    explicit TagWriter(std::string& output, const std::size_t reserve = 0);
+
+    void Open(const std::string& name);
+    void Attribute(const std::string& name, const std::string& value);
+    void Attribute(const std::string& name, const char* value);
+    /** Sets the text of the open element, which must not have children */
+    void Text(const std::string& text);
+    /** Same as Tag::add_tag(name, text) */
+    void Leaf(const std::string& name, const std::string& text);
+    /** Writes an existing tree as a child of the open element */
+    void Write(const Tag& tag);
+    void Close();
+
+    ~TagWriter();
+
+private:
+    struct Element {
+        std::string name_;
+        bool content_{false};
+    };
+
+    std::string& output_;
+    /** Attributes of the innermost element until its start tag is written */
+    std::vector<std::pair<std::string, std::string>> attributes_;
+    std::vector<Element> open_;
+    bool started_{true};
+
+    void start(const bool empty);
+
+    TagWriter() = delete;
+    TagWriter(const TagWriter&) = delete;
+    TagWriter& operator=(const TagWriter&) = delete;
+};
+
 } // namespace opentxs
 
 #endif // CLASS_TAG_HEADER
@@ -39,20 +39,41 @@
 #ifndef OPENTXS_STORAGE_STORAGEDRIVER_HPP
 #define OPENTXS_STORAGE_STORAGEDRIVER_HPP
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 
+namespace google
+{
+namespace protobuf
+{
+class MessageLite;
+}  // namespace protobuf
+}  // namespace google
+
 namespace opentxs
 {
 class StorageDriver
 {
 public:
+    /** Receives a borrowed view of a stored value. The view is only valid
+     *  until the reader returns, which lets a backend hand out its own buffer
+     *  instead of copying it. */
+    typedef std::function<bool(const void* data, const std::size_t size)>
+        ValueReader;
+
     virtual bool EmptyBucket(const bool bucket) const = 0;
 
     virtual bool Load(
         const std::string& key,
         const bool checking,
         std::string& value) const = 0;
+    /** Returns false if the value was not found or the reader rejected it */
+    virtual bool Load(
+        const std::string& key,
+        const bool checking,
+        const ValueReader& reader) const = 0;
     virtual bool LoadFromBucket(
         const std::string& key,
         std::string& value,
@@ -78,6 +99,13 @@ public:
         std::shared_ptr<T>& serialized,
         const bool checking = false) const;
 
+    /** Read-only variant which may share the object with other callers */
+    template <class T>
+    bool LoadProto(
+        const std::string& hash,
+        std::shared_ptr<const T>& serialized,
+        const bool checking = false) const;
+
     template <class T>
     bool StoreProto(const T& data, std::string& key, std::string& plaintext)
         const;
@@ -89,8 +117,24 @@ public:
     bool StoreProto(const T& data) const;
 
 protected:
+    typedef std::shared_ptr<const ::google::protobuf::MessageLite> CachedProto;
+
     StorageDriver() = default;
 
+    /** Objects are addressed by the hash of their contents, so a validated
+     *  object never needs to be parsed again. Drivers which keep a cache
+     *  override these. */
+    virtual CachedProto cached_proto(const std::string&) const
+    {
+        return nullptr;
+    }
+    virtual void cache_proto(
+        const std::string&,
+        const CachedProto&,
+        const std::size_t) const
+    {
+    }
+
 private:
     StorageDriver(const StorageDriver&) = delete;
     StorageDriver(StorageDriver&&) = delete;
@@ -41,6 +41,7 @@
 
 #include "opentxs/network/ZMQ.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -67,6 +68,9 @@ private:
     zsock_t* zmqSocket_;
     zactor_t* zmqAuth_;
     zpoller_t* zmqPoller_;
+    // Number of consecutive requests that were already waiting when the
+    // previous reply was sent.
+    std::uint64_t backlog_{0};
 };
 
 } // namespace opentxs
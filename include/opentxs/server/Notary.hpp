@@ -39,11 +39,14 @@
 #ifndef OPENTXS_SERVER_NOTARY_HPP
 #define OPENTXS_SERVER_NOTARY_HPP
 
+#include <vector>
+
 namespace opentxs
 {
 
 class Account;
 class ClientContext;
+class Contract;
 class Nym;
 class OTServer;
 class OTTransaction;
@@ -117,6 +120,10 @@ private:
         OTTransaction& tranOut,
         bool& outSuccess);
 
+    // Signs each contract with the server nym, then saves it internally.
+    // Duplicate and null entries are skipped.
+    void sign(const std::vector<Contract*>& contracts) const;
+
     Notary() = delete;
     Notary(const Notary&) = delete;
     Notary(Notary&&) = delete;
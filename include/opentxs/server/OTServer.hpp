@@ -48,6 +48,7 @@
 #include "opentxs/server/Transactor.hpp"
 #include "opentxs/server/Notary.hpp"
 #include "opentxs/server/MainFile.hpp"
+#include "opentxs/server/ServerStatistics.hpp"
 #include "opentxs/server/UserCommandProcessor.hpp"
 
 #include <cstddef>
@@ -55,6 +56,7 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace opentxs
 {
@@ -72,6 +74,7 @@ class OTServer
     friend class MainFile;
     friend class PayDividendVisitor;
     friend class Notary;
+    friend class ReplyMessage;
 
 public:
     EXPORT OTServer();
@@ -96,6 +99,14 @@ private:
     std::pair<std::string, std::string> parse_seed_backup(
         const std::string& input) const;
 
+    bool instrument_notice(
+        const Identifier& senderNymID,
+        const Identifier& recipientNymID,
+        OTTransaction::transactionType transactionType,
+        const String& message,
+        const char* command,
+        Message& output) const;
+
     void CreateMainFile(
         bool& mainFileExists,
         std::map<std::string, std::string>& args);
@@ -115,6 +126,14 @@ private:
         const Identifier& recipientNymID,
         OTTransaction::transactionType transactionType,
         const Message& msg);
+    // When references is not empty, the record for each message is in
+    // reference to the matching number instead of to itself.
+    bool DropMessagesToNymbox(
+        const Identifier& notaryID,
+        const Identifier& recipientNymID,
+        OTTransaction::transactionType transactionType,
+        const std::vector<const Message*>& messages,
+        const std::vector<int64_t>& references = {});
     bool SendInstrumentToNym(
         const Identifier& notaryID,
         const Identifier& senderNymID,
@@ -136,6 +155,7 @@ private:
     const std::uint32_t MIN_TCP_PORT = 1024;
     const std::uint32_t MAX_TCP_PORT = 63356;
 
+    ServerStatistics statistics_;
     MainFile mainFile_;
     Notary notary_;
     Transactor transactor_;
@@ -42,12 +42,17 @@
 #include "opentxs/core/AccountVisitor.hpp"
 
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace opentxs
 {
 
 class Account;
 class Identifier;
+class Message;
 class OTServer;
 class String;
 
@@ -76,6 +81,34 @@ class PayDividendVisitor : public AccountVisitor
     int64_t m_lAmountReturned{0}; // as we pay each voucher out, we keep a running
                                // count.
 
+    // One shareholder payment, prepared in batches so that vouchers can be
+    // signed in parallel and nymbox notices written once per recipient.
+    struct Payout {
+        std::string account_{};
+        Identifier recipient_{};
+        int64_t amount_{0};
+        int64_t number_{0};
+        std::shared_ptr<Message> notice_{nullptr};
+    };
+
+    std::vector<Payout> m_pending{};
+    // Set when the progress of this payout is being saved so it can be
+    // resumed after an interruption. (See Checkpoint and Resume.)
+    std::string m_strSharesInstrumentDefinitionID{};
+    int64_t m_lTotalCost{0};
+    std::string m_strLastAccount{};
+
+    std::string checkpoint_file() const;
+    bool delivered(const Identifier& nymID, int64_t number) const;
+    void prepare(Payout& payout, std::mutex& noticeLock) const;
+    void resume(const std::string& inflight);
+    bool return_voucher(
+        const Identifier& recipient,
+        int64_t amount,
+        int64_t number);
+    bool save_checkpoint(const std::vector<Payout>& inflight) const;
+    bool send(std::vector<Payout>& batch);
+
 public:
     PayDividendVisitor(const Identifier& theNotaryID,
                        const Identifier& theNymID,
@@ -119,6 +152,19 @@ public:
         return m_lAmountReturned;
     }
 
+    // Saves the payout parameters, and after each batch the last account
+    // paid, so that Resume can finish the payout if the server stops.
+    bool Checkpoint(
+        const Identifier& theSharesInstrumentDefinitionID,
+        int64_t lTotalCost);
+    // Sends vouchers for any shareholders still waiting in the current batch.
+    bool Flush();
+    // Flushes, returns anything not paid out to the payer (if resuming), and
+    // removes the checkpoint.
+    bool Finish(bool bReturnLeftovers = false);
+    // Finishes any payouts which were interrupted before they completed.
+    static void Resume(OTServer& theServer);
+
     bool Trigger(Account& theAccount) override;
 };
 
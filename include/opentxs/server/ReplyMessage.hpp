@@ -92,7 +92,9 @@ public:
     bool SetPayload(const Data& payload);
     void SetPayload(const OTASCIIArmor& payload);
     bool SetPayload2(const String& payload);
+    void SetPayload2(const OTASCIIArmor& payload);
     bool SetPayload3(const String& payload);
+    void SetPayload3(const OTASCIIArmor& payload);
     void SetRequestNumber(const RequestNumber number);
     void SetSuccess(const bool success);
     void SetTargetNym(const String& nymID);
@@ -77,6 +77,16 @@ struct ServerSettings
         __heartbeat_ms_between_beats = value;
     }
 
+    static int64_t GetStatisticsInterval()
+    {
+        return __statistics_interval;
+    }
+
+    static void SetStatisticsInterval(int64_t value)
+    {
+        __statistics_interval = value;
+    }
+
     static const std::string& GetOverrideNymID()
     {
         return __override_nym_id;
@@ -92,6 +102,9 @@ struct ServerSettings
     static int32_t __heartbeat_no_requests;
     static int32_t __heartbeat_ms_between_beats;
 
+    // Seconds between writes of the statistics file. (0 disables it.)
+    static int64_t __statistics_interval;
+
     // The Nym who's allowed to do certain commands even if they are turned off.
     static std::string __override_nym_id;
     // Are usage credits REQUIRED in order to use this server?
@@ -150,6 +163,8 @@ struct ServerSettings
     static bool __cmd_register_contract;
 
     static bool __cmd_request_admin;
+
+    static bool __cmd_get_statistics;
 };
 
 } // namespace opentxs
@@ -0,0 +1,169 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_SERVER_SERVERSTATISTICS_HPP
+#define OPENTXS_SERVER_SERVERSTATISTICS_HPP
+
+#include "opentxs/core/Types.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace opentxs
+{
+
+// Latency and load counters for the notary. Every counter is an atomic, so
+// any thread may record into it without taking a lock.
+class ServerStatistics
+{
+public:
+    enum class Phase : std::uint8_t {
+        dearmor = 0,
+        parse = 1,
+        verify = 2,
+        context = 3,
+        notarize = 4,
+        sign = 5,
+        persist = 6,
+        armor = 7,
+    };
+
+    // Records the time from construction to destruction as one sample of the
+    // given phase.
+    class Timer
+    {
+    public:
+        Timer(ServerStatistics& statistics, const Phase phase);
+        ~Timer();
+
+    private:
+        ServerStatistics& statistics_;
+        const Phase phase_;
+        const std::chrono::steady_clock::time_point start_;
+
+        Timer() = delete;
+        Timer(const Timer&) = delete;
+        Timer(Timer&&) = delete;
+        Timer& operator=(const Timer&) = delete;
+        Timer& operator=(Timer&&) = delete;
+    };
+
+    ServerStatistics();
+
+    void Command(
+        const MessageType type,
+        const std::chrono::steady_clock::duration elapsed,
+        const bool success);
+    void QueueDepth(const std::uint64_t depth);
+    void Record(
+        const Phase phase,
+        const std::chrono::steady_clock::duration elapsed);
+
+    // JSON summary of everything recorded since startup
+    std::string Report() const;
+    // Writes Report() to the statistics file if the configured interval has
+    // passed since the last write.
+    void Write();
+
+    ~ServerStatistics() = default;
+
+private:
+    // Log-linear (HDR-style) histogram: values below 16 are exact, larger
+    // values fall into one of 8 sub-buckets per power of two, which bounds
+    // the relative error at 12.5%.
+    class Histogram
+    {
+    public:
+        Histogram();
+
+        void Record(const std::uint64_t value);
+        std::uint64_t Count() const { return count_.load(); }
+        std::uint64_t Max() const { return max_.load(); }
+        std::uint64_t Percentile(const double percentile) const;
+        std::uint64_t Sum() const { return sum_.load(); }
+
+    private:
+        static const std::size_t buckets_{496};
+
+        std::array<std::atomic<std::uint64_t>, buckets_> bucket_;
+        std::atomic<std::uint64_t> count_;
+        std::atomic<std::uint64_t> sum_;
+        std::atomic<std::uint64_t> max_;
+
+        static std::size_t index(const std::uint64_t value);
+        static std::uint64_t upper(const std::size_t index);
+
+        Histogram(const Histogram&) = delete;
+        Histogram(Histogram&&) = delete;
+        Histogram& operator=(const Histogram&) = delete;
+        Histogram& operator=(Histogram&&) = delete;
+    };
+
+    static const std::size_t message_types_{
+        static_cast<std::size_t>(MessageType::getStatisticsR) + 1};
+    static const std::size_t phases_{
+        static_cast<std::size_t>(Phase::armor) + 1};
+
+    std::array<Histogram, message_types_> commands_;
+    std::array<std::atomic<std::uint64_t>, message_types_> failures_;
+    std::array<Histogram, phases_> phase_;
+    Histogram queue_;
+    const std::chrono::steady_clock::time_point started_;
+    std::chrono::steady_clock::time_point last_write_;
+
+    static void histogram(
+        std::string& output,
+        const std::string& name,
+        const Histogram& histogram,
+        const std::uint64_t failures);
+    static std::uint64_t micros(
+        const std::chrono::steady_clock::duration elapsed);
+    static std::string phase_name(const std::size_t phase);
+
+    ServerStatistics(const ServerStatistics&) = delete;
+    ServerStatistics(ServerStatistics&&) = delete;
+    ServerStatistics& operator=(const ServerStatistics&) = delete;
+    ServerStatistics& operator=(ServerStatistics&&) = delete;
+};
+}  // namespace opentxs
+
+#endif  // OPENTXS_SERVER_SERVERSTATISTICS_HPP
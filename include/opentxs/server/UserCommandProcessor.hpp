@@ -41,8 +41,13 @@
 
 #include "opentxs/core/Types.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 
 namespace opentxs
 {
@@ -108,7 +113,38 @@ private:
         std::size_t counter_{0};
     };
 
+    // The serialized payload of a read-only reply, together with a digest of
+    // the stored state it was built from. Only the outer message, which
+    // carries the request number, has to be rebuilt and signed while that
+    // state holds.
+    struct CachedReply {
+        std::string state_;
+        std::string payload_;
+        std::string payload2_;
+        std::string payload3_;
+        std::string hash_;
+        std::string hash2_;
+        std::int64_t depth_{0};
+        // Set if the signatures of the stored state were checked before the
+        // reply was cached
+        bool verified_{false};
+
+        std::size_t size() const
+        {
+            return state_.size() + payload_.size() + payload2_.size() +
+                   payload3_.size() + hash_.size() + hash2_.size();
+        }
+    };
+    /** Cache keys, most recently used first */
+    typedef std::list<std::string> ReplyLRU;
+
     OTServer* server_{nullptr};
+    mutable std::mutex reply_cache_lock_;
+    mutable ReplyLRU reply_lru_;
+    mutable std::map<std::string, std::pair<CachedReply, ReplyLRU::iterator>>
+        reply_cache_;
+    /** Total size of the cached replies, in bytes */
+    mutable std::size_t reply_cache_bytes_{0};
 
     bool add_numbers_to_nymbox(
         const TransactionNumber transactionNumber,
@@ -123,6 +159,11 @@ private:
         const Message& msgIn,
         const RequestNumber& correctNumber) const;
     bool check_usage_credits(ReplyMessage& reply) const;
+    bool cached_reply(
+        const std::string& key,
+        const std::string& state,
+        CachedReply& output) const;
+    void cache_reply(const std::string& key, const CachedReply& reply) const;
     bool cmd_add_claim(ReplyMessage& reply) const;
     bool cmd_check_nym(ReplyMessage& reply) const;
     bool cmd_delete_asset_account(ReplyMessage& reply) const;
@@ -141,6 +182,7 @@ private:
     // Get the offers that a specific Nym has placed on a specific market.
     bool cmd_get_nymbox(ReplyMessage& reply) const;
     bool cmd_get_request_number(ReplyMessage& reply) const;
+    bool cmd_get_statistics(ReplyMessage& reply) const;
     bool cmd_get_transaction_numbers(ReplyMessage& reply) const;
     bool cmd_issue_basket(ReplyMessage& reply) const;
     bool cmd_notarize_transaction(ReplyMessage& reply) const;
@@ -186,11 +228,19 @@ private:
         const Identifier& serverID,
         const Nym& serverNym,
         const bool verifyAccount) const;
+    static std::string reply_key(
+        const MessageType type,
+        const Identifier& nymID,
+        const String& objectID);
     bool reregister_nym(ReplyMessage& reply) const;
     bool save_box(const Nym& nym, Ledger& box) const;
     bool save_inbox(const Nym& nym, Identifier& hash, Ledger& inbox) const;
     bool save_nymbox(const Nym& nym, Identifier& hash, Ledger& nymbox) const;
     bool save_outbox(const Nym& nym, Identifier& hash, Ledger& outbox) const;
+    static std::string stored_state(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two = "");
     bool send_message_to_nym(
         const Identifier& notaryID,
         const Identifier& senderNymID,
@@ -46,8 +46,10 @@
 #include "opentxs/storage/StorageConfig.hpp"
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <ctime>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <limits>
@@ -77,6 +79,9 @@ class Root;
 typedef std::function<void(const proto::CredentialIndex&)> NymLambda;
 typedef std::function<void(const proto::ServerContract&)> ServerLambda;
 typedef std::function<void(const proto::UnitDefinition&)> UnitLambda;
+/** Called with the id and hash of each object before it is loaded. Return
+ *  false to skip loading the object. */
+typedef std::function<bool(const std::string&, const std::string&)> MapFilter;
 
 // Content-aware storage module for opentxs
 //
@@ -117,6 +122,31 @@ private:
      */
     typedef std::map<std::string, Metadata> Index;
 
+    enum class ReplicationType : std::uint8_t {
+        OBJECT = 0,
+        ROOT = 1,
+        EMPTY_BUCKET = 2,
+    };
+
+    /** A write which has been applied to the primary plugin but not yet to
+     *  the backup plugins */
+    struct Replication {
+        ReplicationType type_{ReplicationType::OBJECT};
+        std::string key_{};
+        std::string value_{};
+        bool bucket_{false};
+    };
+
+    /** Least recently used cache key first */
+    typedef std::list<std::string> CacheOrder;
+
+    /** A decoded and validated object, and its serialized size */
+    struct CachedObject {
+        CachedProto object_{nullptr};
+        std::size_t size_{0};
+        CacheOrder::iterator position_{};
+    };
+
     CryptoEngine& crypto_;
     std::uint32_t version_{0};
     std::int64_t gc_interval_{std::numeric_limits<int64_t>::max()};
@@ -125,15 +155,45 @@ private:
     std::vector<std::unique_ptr<StoragePlugin>> backup_plugins_;
     mutable std::atomic<bool> primary_bucket_;
     std::vector<std::thread> background_threads_;
+    mutable std::mutex commit_lock_;
+    std::condition_variable commit_signal_;
+    /** Number of tree updates made so far */
+    std::atomic<std::uint64_t> updates_;
+    /** Number of tree updates included in the stored root */
+    std::uint64_t committed_{0};
+    bool committing_{false};
+    mutable std::mutex replication_lock_;
+    mutable std::condition_variable replication_signal_;
+    mutable std::deque<Replication> replication_queue_;
+    /** Most recent root hash written to every backup plugin */
+    mutable std::string replicated_root_;
+    std::atomic<bool> replicating_;
+    std::unique_ptr<std::thread> replication_thread_;
+    mutable std::mutex object_cache_lock_;
+    mutable std::map<std::string, CachedObject> object_cache_;
+    mutable CacheOrder object_cache_order_;
+    mutable std::size_t object_cache_bytes_{0};
+    mutable std::atomic<std::uint64_t> object_cache_hits_;
+    mutable std::atomic<std::uint64_t> object_cache_misses_;
 
+    CachedProto cached_proto(const std::string& key) const override;
+    void cache_proto(
+        const std::string& key,
+        const CachedProto& object,
+        const std::size_t size) const override;
     void Cleanup_Storage();
     void CollectGarbage();
+    bool commit(const std::uint64_t update);
     bool EmptyBucket(const bool bucket) const override;
     void InitBackup();
     void InitEncryptedBackup(std::unique_ptr<SymmetricKey>& key);
     void InitPlugins();
     bool Load(const std::string& key, const bool checking, std::string& value)
         const override;
+    bool Load(
+        const std::string& key,
+        const bool checking,
+        const ValueReader& reader) const override;
     bool LoadFromBucket(
         const std::string& key,
         std::string& value,
@@ -143,6 +203,11 @@ private:
     const storage::Root& Meta() const;
     bool Migrate(const std::string& key, const StorageDriver& to)
         const override;
+    void replicate(Replication&& item) const;
+    void replication_worker();
+    void start_replication();
+    void stop_replication();
+    void write_replicas(const std::deque<Replication>& batch) const;
     bool Store(
         const std::string& key,
         const std::string& value,
@@ -152,10 +217,7 @@ private:
     bool verify_write_lock(const std::unique_lock<std::mutex>& lock) const;
 
     Editor<storage::Root> mutable_Meta();
-    void RunMapPublicNyms(NymLambda lambda);
-    void RunMapServers(ServerLambda lambda);
-    void RunMapUnits(UnitLambda lambda);
-    void save(storage::Root* in, const Lock& lock);
+    std::uint64_t save(storage::Root* in, const Lock& lock);
     void synchronize_plugins();
     void synchronize_root();
 
@@ -180,6 +242,17 @@ protected:
 
 public:
     static const std::uint32_t HASH_TYPE;
+
+    /** Make several updates, storing the new root once at the end
+     *
+     *  Updates made by other threads while the batch runs may be committed
+     *  before it finishes, so this does not make the updates atomic.
+     *
+     *  \param[in] updates performs the updates through this Storage object
+     *  \returns the value returned by updates, or false if the new root
+     *           could not be stored
+     */
+    bool Batch(const std::function<bool()>& updates);
     std::set<std::string> BlockchainAccountList(
         const std::string& nymID,
         const proto::ContactItemType type);
@@ -219,10 +292,19 @@ public:
         const std::string& id,
         std::shared_ptr<proto::Context>& context,
         const bool checking = false);  // If true, suppress "not found" errors
+    bool Load(
+        const std::string& nym,
+        const std::string& id,
+        std::shared_ptr<const proto::Context>& context,
+        const bool checking = false);  // If true, suppress "not found" errors
     bool Load(
         const std::string& id,
         std::shared_ptr<proto::Credential>& cred,
         const bool checking = false);  // If true, suppress "not found" errors
+    bool Load(
+        const std::string& id,
+        std::shared_ptr<const proto::Credential>& cred,
+        const bool checking = false);  // If true, suppress "not found" errors
     bool Load(
         const std::string& id,
         std::shared_ptr<proto::CredentialIndex>& nym,
@@ -283,9 +365,9 @@ public:
         std::shared_ptr<proto::UnitDefinition>& contract,
         std::string& alias,
         const bool checking = false);  // If true, suppress "not found" errors
-    void MapPublicNyms(NymLambda& lambda);
-    void MapServers(ServerLambda& lambda);
-    void MapUnitDefinitions(UnitLambda& lambda);
+    void MapPublicNyms(NymLambda& lambda, const MapFilter& filter = {});
+    void MapServers(ServerLambda& lambda, const MapFilter& filter = {});
+    void MapUnitDefinitions(UnitLambda& lambda, const MapFilter& filter = {});
     bool MoveThreadItem(
         const std::string& nymId,
         const std::string& fromThreadID,
@@ -293,6 +375,12 @@ public:
         const std::string& itemID);
     ObjectList NymBoxList(const std::string& nymID, const StorageBox box) const;
     ObjectList NymList() const;
+    /** Number of loads answered from the decoded object cache */
+    std::uint64_t ObjectCacheHits() const;
+    /** Number of loads which had to read and validate an object */
+    std::uint64_t ObjectCacheMisses() const;
+    /** Serialized size of the objects currently cached, in bytes */
+    std::size_t ObjectCacheSize() const;
     bool RemoveNymBoxItem(
         const std::string& nymID,
         const StorageBox box,
@@ -303,6 +391,8 @@ public:
         const std::string& nymId,
         const std::string& threadId,
         const std::string& newID);
+    /** Most recent root hash which every backup plugin has received */
+    std::string ReplicatedRoot() const;
     void RunGC();
     std::string ServerAlias(const std::string& id);
     ObjectList ServerList() const;
@@ -61,6 +61,8 @@ public:
     bool auto_publish_servers_ = true;
     bool auto_publish_units_ = true;
     std::int64_t gc_interval_ = 60 * 60 * 24 * 30;
+    /** Upper bound on the serialized size of cached decoded objects */
+    std::int64_t object_cache_size_ = 1024 * 1024 * 32;
     std::string path_{};
     InsertCB dht_callback_{};
 
@@ -78,6 +80,9 @@ public:
     std::string fs_root_file_ = "root";
     std::string fs_backup_directory_{""};
     std::string fs_encrypted_backup_directory_{""};
+    /** Number of open descriptors the filesystem drivers keep for recently
+     *  read objects. 0 disables the cache. */
+    std::int64_t fs_fd_cache_{0};
 #endif
 
 #ifdef OT_STORAGE_SQLITE
@@ -46,6 +46,7 @@
 
 #include <atomic>
 #include <string>
+#include <typeinfo>
 
 namespace opentxs
 {
@@ -58,6 +59,10 @@ public:
 
     bool Load(const std::string& key, const bool checking, std::string& value)
         const override;
+    bool Load(
+        const std::string& key,
+        const bool checking,
+        const ValueReader& reader) const override;
     bool LoadFromBucket(
         const std::string& key,
         std::string& value,
@@ -89,6 +94,13 @@ protected:
         std::atomic<bool>& bucket);
     StoragePlugin_impl() = delete;
 
+    /** Drivers which can expose a stored value without copying it override
+     *  this. The default reads the value into a string first. */
+    virtual bool ReadFromBucket(
+        const std::string& key,
+        const ValueReader& reader,
+        const bool bucket) const;
+
 private:
     const Digest& digest_;
     std::atomic<bool>& current_bucket_;
@@ -105,26 +117,66 @@ bool StorageDriver::LoadProto(
     std::shared_ptr<T>& serialized,
     const bool checking) const
 {
-    std::string raw;
-    const bool loaded = Load(hash, checking, raw);
+    std::shared_ptr<const T> shared;
+    const bool loaded = LoadProto<T>(hash, shared, checking);
+
+    // The caller may modify its copy, so it can't be the cached object
+    if (loaded) {
+        serialized.reset(new T(*shared));
+    }
+
+    return loaded;
+}
+
+template <class T>
+bool StorageDriver::LoadProto(
+    const std::string& hash,
+    std::shared_ptr<const T>& serialized,
+    const bool checking) const
+{
+    // The same bytes can be a valid encoding of more than one message type
+    const std::string key = std::string(typeid(T).name()) + ":" + hash;
+    auto cached = cached_proto(key);
+
+    if (cached) {
+        serialized = std::static_pointer_cast<const T>(cached);
+
+        return true;
+    }
+
+    // Parse straight from the driver's buffer
+    auto output = std::make_shared<T>();
+    std::size_t size{0};
+    const bool loaded = Load(
+        hash,
+        checking,
+        [&output, &size](const void* data, const std::size_t bytes) -> bool {
+            size = bytes;
+
+            return output->ParseFromArray(data, static_cast<int>(bytes));
+        });
     bool valid = false;
 
     if (loaded) {
-        serialized.reset(new T);
-        serialized->ParseFromArray(raw.data(), raw.size());
-        valid = proto::Validate<T>(*serialized, VERBOSE);
+        valid = proto::Validate<T>(*output, VERBOSE);
+
+        if (valid) {
+            cache_proto(key, output, size);
+        }
+
+        serialized = output;
     }
 
     if (!valid) {
-        if (loaded) {
+        if (0 < size) {
             otErr << "Specified object was located but could not be "
                   << "validated." << std::endl
                   << "Hash: " << hash << std::endl
-                  << "Size: " << raw.size() << std::endl;
+                  << "Size: " << size << std::endl;
         } else {
             otWarn << "Specified object is missing." << std::endl
                    << "Hash: " << hash << std::endl
-                   << "Size: " << raw.size() << std::endl;
+                   << "Size: " << size << std::endl;
         }
     }
 
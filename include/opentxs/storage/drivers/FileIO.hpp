@@ -0,0 +1,143 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_STORAGE_FILEIO_HPP
+#define OPENTXS_STORAGE_FILEIO_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace opentxs
+{
+namespace storage
+{
+
+/** Reads and writes whole files for the filesystem storage drivers
+ *
+ *  Files are read from a descriptor straight into the output string, or
+ *  handed to a reader callback without an intermediate copy. Writes
+ *  go to a temporary file which is flushed to disk and then renamed over the
+ *  target, so a reader never sees a partial file.
+ *
+ *  Descriptors for recently read files may be kept open. Only use the cache
+ *  for files whose contents never change once written, such as objects named
+ *  by their hash.
+ */
+class FileIO
+{
+public:
+    typedef std::function<bool(const void* data, const std::size_t size)>
+        Reader;
+
+    /** \param[in] cacheSize number of descriptors to keep open, or 0 */
+    explicit FileIO(const std::int64_t cacheSize = 0);
+
+    /** Closes every cached descriptor. Call this after moving or deleting
+     *  files which may have been read. */
+    void Clear() const;
+    /** Returns false if the file does not exist or is empty */
+    bool Read(
+        const std::string& filename,
+        std::string& output,
+        const bool cache = false) const;
+    /** Passes the contents of the file to reader
+     *
+     *  Large files are mapped into memory instead of being copied. The
+     *  buffer is only valid for the duration of the call.
+     *
+     *  Returns false if the file does not exist, is empty, or if reader
+     *  returns false
+     */
+    bool Read(
+        const std::string& filename,
+        const Reader& reader,
+        const bool cache = false) const;
+    /** Flushes the folders of every file written since the last call to disk
+     */
+    bool Sync() const;
+    /** \param[in] sync flush the folders of every earlier file to disk
+     *                  before this one replaces the target, then flush its
+     *                  own folder. Use for files which refer to other files.
+     */
+    bool Write(
+        const std::string& filename,
+        const std::string& contents,
+        const bool sync = false) const;
+
+    ~FileIO();
+
+private:
+    class Descriptor;
+
+    typedef std::shared_ptr<Descriptor> FD;
+    typedef std::list<std::string> CacheOrder;
+
+    struct CachedFD {
+        FD fd_{nullptr};
+        CacheOrder::iterator position_{};
+    };
+
+    const std::size_t cache_size_{0};
+    mutable std::atomic<std::uint64_t> counter_{0};
+    mutable std::mutex cache_lock_;
+    /** Least recently used first */
+    mutable CacheOrder cache_order_;
+    mutable std::map<std::string, CachedFD> cache_;
+    mutable std::mutex folder_lock_;
+    /** Folders with renamed entries which have not been flushed */
+    mutable std::set<std::string> dirty_folders_;
+
+    void forget(const std::string& filename) const;
+    FD open(const std::string& filename, const bool cache) const;
+
+    FileIO(const FileIO&) = delete;
+    FileIO(FileIO&&) = delete;
+    FileIO& operator=(const FileIO&) = delete;
+    FileIO& operator=(FileIO&&) = delete;
+};
+}  // namespace storage
+}  // namespace opentxs
+#endif  // OPENTXS_STORAGE_FILEIO_HPP
@@ -39,6 +39,7 @@
 #ifndef OPENTXS_STORAGE_STORAGEFS_HPP
 #define OPENTXS_STORAGE_STORAGEFS_HPP
 
+#include "opentxs/storage/drivers/FileIO.hpp"
 #include "opentxs/storage/StoragePlugin.hpp"
 
 namespace opentxs
@@ -58,6 +59,7 @@ private:
     friend class Storage;
 
     std::string folder_;
+    storage::FileIO io_;
 
     std::string GetBucketName(const bool bucket) const;
 
@@ -77,6 +79,12 @@ private:
     StorageFS& operator=(const StorageFS&) = delete;
     StorageFS& operator=(StorageFS&&) = delete;
 
+protected:
+    bool ReadFromBucket(
+        const std::string& key,
+        const ValueReader& reader,
+        const bool bucket) const override;
+
 public:
     std::string LoadRoot() const override;
     bool StoreRoot(const std::string& hash) const override;
@@ -39,10 +39,14 @@
 #ifndef OPENTXS_STORAGE_STORAGEFSARCHIVE_HPP
 #define OPENTXS_STORAGE_STORAGEFSARCHIVE_HPP
 
+#include "opentxs/storage/drivers/FileIO.hpp"
 #include "opentxs/storage/StoragePlugin.hpp"
 
 #include <atomic>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 
 namespace opentxs
 {
@@ -82,13 +86,22 @@ private:
     const std::unique_ptr<SymmetricKey> encryption_key_;
     const bool encrypted_{false};
     std::atomic<bool> ready_{false};
+    mutable std::mutex folder_lock_;
+    /** Subdirectories known to exist */
+    mutable std::set<std::string> folders_;
+    storage::FileIO io_;
 
-    std::string calculate_path(const std::string& key) const;
-    std::string decrypt(const std::string&& ciphertext) const;
+    std::string calculate_path(const std::string& key, std::string& folder)
+        const;
+    void create_folder(const std::string& folder) const;
+    std::string decrypt(std::string&& ciphertext) const;
     std::string encrypt(const std::string& plaintext) const;
-    std::string read_file(const std::string& filename) const;
-    bool write_file(const std::string& filename, const std::string& contents)
+    std::string read_file(const std::string& filename, const bool cache)
         const;
+    bool write_file(
+        const std::string& filename,
+        const std::string& contents,
+        const bool sync) const;
 
     void Init_StorageFSArchive();
     void Cleanup_StorageFSArchive();
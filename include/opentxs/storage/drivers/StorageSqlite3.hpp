@@ -71,6 +71,10 @@ private:
         const std::string& key,
         const std::string& tablename,
         std::string& value) const;
+    bool Select(
+        const std::string& key,
+        const std::string& tablename,
+        const ValueReader& reader) const;
     bool Upsert(
         const std::string& key,
         const std::string& tablename,
@@ -91,6 +95,12 @@ private:
     StorageSqlite3& operator=(const StorageSqlite3&) = delete;
     StorageSqlite3& operator=(StorageSqlite3&&) = delete;
 
+protected:
+    bool ReadFromBucket(
+        const std::string& key,
+        const ValueReader& reader,
+        const bool bucket) const override;
+
 public:
     std::string LoadRoot() const override;
     bool StoreRoot(const std::string& hash) const override;
@@ -72,6 +72,11 @@ public:
         std::shared_ptr<proto::Context>& output,
         std::string& alias,
         const bool checking) const;
+    bool Load(
+        const std::string& id,
+        std::shared_ptr<const proto::Context>& output,
+        std::string& alias,
+        const bool checking) const;
 
     bool Delete(const std::string& id);
     bool Store(const proto::Context& data, const std::string& alias);
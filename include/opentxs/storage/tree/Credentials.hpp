@@ -75,6 +75,10 @@ public:
         const std::string& id,
         std::shared_ptr<proto::Credential>& output,
         const bool checking) const;
+    bool Load(
+        const std::string& id,
+        std::shared_ptr<const proto::Credential>& output,
+        const bool checking) const;
 
     bool Delete(const std::string& id);
     bool SetAlias(const std::string& id, const std::string& alias);
@@ -129,24 +129,31 @@ protected:
 
         alias = std::get<1>(it->second);
 
-        return driver_.LoadProto<T>(std::get<0>(it->second), output, checking);
+        return driver_.LoadProto(std::get<0>(it->second), output, checking);
     }
 
     template <class T>
-    void map(const std::function<void(const T&)> input) const
+    void map(
+        const std::function<void(const T&)> input,
+        const std::function<bool(const std::string&, const std::string&)>&
+            filter = {}) const
     {
         std::unique_lock<std::mutex> lock(write_lock_);
         const auto copy = item_map_;
-        write_lock_.unlock();
+        lock.unlock();
 
         for (const auto& it : copy) {
             const auto& hash = std::get<0>(it.second);
-            std::shared_ptr<T> serialized;
+            std::shared_ptr<const T> serialized;
 
             if (Node::BLANK_HASH == hash) {
                 continue;
             }
 
+            if (filter && (false == filter(it.first, hash))) {
+                continue;
+            }
+
             if (driver_.LoadProto<T>(hash, serialized, false)) {
                 input(*serialized);
             }
@@ -168,9 +175,9 @@ protected:
         // hasn't been updated
         // ...so we have to load the object just to be sure
         if (0 == revision) {
-            std::shared_ptr<T> existing{nullptr};
+            std::shared_ptr<const T> existing{nullptr};
 
-            if (false == driver_.LoadProto(hash, existing, false)) {
+            if (false == driver_.LoadProto<T>(hash, existing, false)) {
                 otErr << method << __FUNCTION__ << ": Unable to load object."
                       << std::endl;
 
@@ -215,7 +222,11 @@ protected:
         std::string& output,
         std::string& alias,
         const bool checking) const;
-    bool migrate(const std::string& hash, const StorageDriver& to) const;
+    bool migrate(
+        const std::string& hash,
+        const StorageDriver& to,
+        const bool incremental) const;
+    bool migrated(const std::string& hash, const StorageDriver& to) const;
     virtual bool save(const std::unique_lock<std::mutex>& lock) const = 0;
     void serialize_index(
         const std::string& id,
@@ -243,7 +254,17 @@ protected:
 
 public:
     ObjectList List() const;
-    virtual bool Migrate(const StorageDriver& to) const;
+    /** Copy this node and everything it references to another driver
+     *
+     *  In incremental mode, objects already present in the destination are
+     *  skipped, along with everything they reference. Objects are always
+     *  written after the objects they reference, so a node which is present
+     *  implies its whole subtree is. This is not safe for moving objects
+     *  between buckets of the same driver.
+     */
+    virtual bool Migrate(
+        const StorageDriver& to,
+        const bool incremental = false) const;
     std::string Root() const;
 
     virtual ~Node() = default;
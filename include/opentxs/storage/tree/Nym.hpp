@@ -196,7 +196,8 @@ public:
         std::shared_ptr<proto::CredentialIndex>& output,
         std::string& alias,
         const bool checking) const;
-    bool Migrate(const StorageDriver& to) const override;
+    bool Migrate(const StorageDriver& to, const bool incremental = false)
+        const override;
 
     bool SetAlias(const std::string& alias);
     bool Store(
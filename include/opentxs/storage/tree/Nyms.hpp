@@ -80,12 +80,13 @@ private:
 
 public:
     bool Exists(const std::string& id) const;
-    void Map(NymLambda lambda) const;
+    void Map(NymLambda lambda, const MapFilter& filter = {}) const;
     const class Nym& Nym(const std::string& id) const;
 
     Editor<class Nym> mutable_Nym(const std::string& id);
 
-    bool Migrate(const StorageDriver& to) const override;
+    bool Migrate(const StorageDriver& to, const bool incremental = false)
+        const override;
 
     ~Nyms() = default;
 };
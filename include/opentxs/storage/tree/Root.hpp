@@ -73,6 +73,8 @@ private:
     mutable std::atomic<bool> gc_resume_;
     mutable std::atomic<std::uint64_t> last_gc_;
     mutable std::atomic<std::uint64_t> sequence_;
+    /** The tree has changed since the root object was last stored */
+    mutable std::atomic<bool> dirty_;
     mutable std::mutex gc_lock_;
     mutable std::unique_ptr<std::thread> gc_thread_;
 
@@ -85,6 +87,7 @@ private:
 
     void cleanup() const;
     void collect_garbage(const StorageDriver* to) const;
+    bool commit(std::string& hash) const;
     void init(const std::string& hash) override;
     bool save(const std::unique_lock<std::mutex>& lock) const override;
     void save(class Tree* tree, const Lock& lock);
@@ -105,7 +108,8 @@ public:
 
     Editor<class Tree> mutable_Tree();
 
-    bool Migrate(const StorageDriver& to) const override;
+    bool Migrate(const StorageDriver& to, const bool incremental = false)
+        const override;
     std::uint64_t Sequence() const;
 
     ~Root() = default;
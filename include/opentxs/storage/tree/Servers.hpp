@@ -75,7 +75,7 @@ public:
         std::shared_ptr<proto::ServerContract>& output,
         std::string& alias,
         const bool checking) const;
-    void Map(ServerLambda lambda) const;
+    void Map(ServerLambda lambda, const MapFilter& filter = {}) const;
 
     bool Delete(const std::string& id);
     bool SetAlias(const std::string& id, const std::string& alias);
@@ -105,7 +105,8 @@ public:
     bool Check(const std::string& id) const;
     std::string ID() const;
     proto::StorageThread Items() const;
-    bool Migrate(const StorageDriver& to) const override;
+    bool Migrate(const StorageDriver& to, const bool incremental = false)
+        const override;
     std::size_t UnreadCount() const;
 
     bool Add(
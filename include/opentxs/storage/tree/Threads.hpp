@@ -97,7 +97,8 @@ private:
 
 public:
     bool Exists(const std::string& id) const;
-    bool Migrate(const StorageDriver& to) const override;
+    bool Migrate(const StorageDriver& to, const bool incremental = false)
+        const override;
     const class Thread& Thread(const std::string& id) const;
 
     std::string Create(
@@ -138,7 +138,8 @@ public:
     Editor<Servers> mutable_Servers();
     Editor<Units> mutable_Units();
 
-    bool Migrate(const StorageDriver& to) const override;
+    bool Migrate(const StorageDriver& to, const bool incremental = false)
+        const override;
 
     ~Tree() = default;
 };
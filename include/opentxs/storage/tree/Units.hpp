@@ -73,7 +73,7 @@ public:
         std::shared_ptr<proto::UnitDefinition>& output,
         std::string& alias,
         const bool checking) const;
-    void Map(UnitLambda lambda) const;
+    void Map(UnitLambda lambda, const MapFilter& filter = {}) const;
 
     bool Delete(const std::string& id);
     bool SetAlias(const std::string& id, const std::string& alias);
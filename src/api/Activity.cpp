@@ -342,20 +342,26 @@ ObjectList Activity::Threads(const Identifier& nym) const
     const std::string nymID = String(nym).Get();
     auto output = storage_.ThreadList(nymID);
 
-    for (auto& it : output) {
-        const auto& threadID = it.first;
-        auto& label = it.second;
-        auto contact = contact_.Contact(Identifier(threadID));
-
-        if (contact) {
-            const auto& name = contact->Label();
-
-            if (label != name) {
-                storage_.SetThreadAlias(nymID, threadID, name);
-                label = name;
+    // Labels brought in line with the contacts are stored under one root
+    // commit
+    storage_.Batch([&]() -> bool {
+        for (auto& it : output) {
+            const auto& threadID = it.first;
+            auto& label = it.second;
+            auto contact = contact_.Contact(Identifier(threadID));
+
+            if (contact) {
+                const auto& name = contact->Label();
+
+                if (label != name) {
+                    storage_.SetThreadAlias(nymID, threadID, name);
+                    label = name;
+                }
             }
         }
-    }
+
+        return true;
+    });
 
     return output;
 }
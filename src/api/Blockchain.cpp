@@ -92,6 +92,7 @@ Blockchain::Blockchain(
     , lock_()
     , nym_lock_()
     , account_lock_()
+    , address_index_()
 {
 }
 
@@ -147,6 +148,13 @@ proto::Bip44Address& Blockchain::add_address(
     }
 }
 
+std::uint64_t Blockchain::address_key(
+    const BIP44Chain chain,
+    const std::uint32_t index)
+{
+    return (static_cast<std::uint64_t>(chain) << 32) | index;
+}
+
 std::uint8_t Blockchain::address_prefix(const proto::ContactItemType type) const
 {
     switch (type) {
@@ -207,6 +215,7 @@ std::unique_ptr<proto::Bip44Address> Blockchain::AllocateAddress(
         return output;
     }
 
+    auto& addressIndex = index_account(accountLock, accountID, *account);
     const auto& type = account->type();
     const auto index =
         chain ? account->internalindex() : account->externalindex();
@@ -227,11 +236,18 @@ std::unique_ptr<proto::Bip44Address> Blockchain::AllocateAddress(
     otErr << OT_METHOD << __FUNCTION__ << ": Address " << newAddress.address()
           << " allocated." << std::endl;
     newAddress.set_label(label);
+    const auto key = address_key(chain, index);
+    const auto position = chain ? account->internaladdress_size()
+                                : account->externaladdress_size();
+    addressIndex.position_[key] = position - 1;
+    addressIndex.address_[newAddress.address()] = key;
+    addressIndex.revision_ = account->revision();
     const auto saved = storage_.Store(sNymID, type, *account);
 
     if (false == saved) {
         otErr << OT_METHOD << __FUNCTION__ << ": Failed to save account."
               << std::endl;
+        addressIndex.valid_ = false;
 
         return output;
     }
@@ -273,7 +289,8 @@ bool Blockchain::AssignAddress(
         return false;
     }
 
-    auto& address = find_address(index, chain, *account);
+    auto& addressIndex = index_account(accountLock, accountID, *account);
+    auto& address = find_address(index, chain, addressIndex, *account);
     const auto& existing = address.contact();
 
     if (false == existing.empty()) {
@@ -282,8 +299,14 @@ bool Blockchain::AssignAddress(
 
     address.set_contact(sContactID);
     account->set_revision(account->revision() + 1);
+    addressIndex.revision_ = account->revision();
+    const auto saved = storage_.Store(sNymID, type, *account);
 
-    return storage_.Store(sNymID, type, *account);
+    if (false == saved) {
+        addressIndex.valid_ = false;
+    }
+
+    return saved;
 }
 
 Bip44Type Blockchain::bip44_type(const proto::ContactItemType type) const
@@ -418,30 +441,60 @@ std::string Blockchain::calculate_address(
 proto::Bip44Address& Blockchain::find_address(
     const std::uint32_t index,
     const BIP44Chain chain,
+    const AddressIndex& addressIndex,
     proto::Bip44Account& account) const
 {
-    // TODO: determine if we can prove the addresses were inserted in index
-    // order. Then we don't need to do a linear search here.
-    // Perhaps opentxs-proto should fail validation for improperly sorted
-    // Bip44Accounts
+    const auto it = addressIndex.position_.find(address_key(chain, index));
+
+    OT_ASSERT(addressIndex.position_.end() != it);
 
     if (chain) {
-        for (auto& address : *account.mutable_internaladdress()) {
-            if (address.index() == index) {
 
-                return address;
-            }
-        }
-    } else {
-        for (auto& address : *account.mutable_externaladdress()) {
-            if (address.index() == index) {
+        return *account.mutable_internaladdress(it->second);
+    }
+
+    return *account.mutable_externaladdress(it->second);
+}
+
+// Addresses are not guaranteed to be stored in index order, so the positions
+// are recorded rather than assumed.
+Blockchain::AddressIndex& Blockchain::index_account(
+    const Lock&,
+    const Identifier& accountID,
+    const proto::Bip44Account& account) const
+{
+    Lock mapLock(lock_);
+    auto& output = address_index_[accountID];
+    mapLock.unlock();
 
-                return address;
+    if (output.valid_ && (output.revision_ == account.revision())) {
+
+        return output;
+    }
+
+    output = AddressIndex{};
+    auto index = [&output, &account](const BIP44Chain chain) {
+        const auto& list =
+            chain ? account.internaladdress() : account.externaladdress();
+        int position{0};
+
+        for (const auto& address : list) {
+            const auto key = address_key(chain, address.index());
+            output.position_[key] = position++;
+            output.address_[address.address()] = key;
+            auto& incoming = output.incoming_[key];
+
+            for (const auto& txid : address.incoming()) {
+                incoming.insert(txid);
             }
         }
-    }
+    };
+    index(INTERNAL_CHAIN);
+    index(EXTERNAL_CHAIN);
+    output.revision_ = account.revision();
+    output.valid_ = true;
 
-    OT_FAIL;
+    return output;
 }
 
 void Blockchain::init_path(
@@ -515,12 +568,47 @@ std::unique_ptr<proto::Bip44Address> Blockchain::LoadAddress(
         return output;
     }
 
-    auto& address = find_address(index, chain, *account);
+    auto& addressIndex = index_account(accountLock, accountID, *account);
+    auto& address = find_address(index, chain, addressIndex, *account);
     output.reset(new proto::Bip44Address(address));
 
     return output;
 }
 
+bool Blockchain::LookupAddress(
+    const Identifier& nymID,
+    const Identifier& accountID,
+    const std::string& address,
+    std::uint32_t& index,
+    BIP44Chain& chain) const
+{
+    LOCK_ACCOUNT()
+
+    const std::string sNymID = String(nymID).Get();
+    const std::string sAccountID = String(accountID).Get();
+    auto account = load_account(accountLock, sNymID, sAccountID);
+
+    if (false == bool(account)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Account does not exist."
+              << std::endl;
+
+        return false;
+    }
+
+    const auto& addressIndex = index_account(accountLock, accountID, *account);
+    const auto it = addressIndex.address_.find(address);
+
+    if (addressIndex.address_.end() == it) {
+
+        return false;
+    }
+
+    chain = (0 != (it->second >> 32));
+    index = static_cast<std::uint32_t>(it->second);
+
+    return true;
+}
+
 bool Blockchain::move_transactions(
     const Identifier& nymID,
     const proto::Bip44Address& address,
@@ -617,6 +705,32 @@ bool Blockchain::StoreIncoming(
     const std::uint32_t index,
     const BIP44Chain chain,
     const proto::BlockchainTransaction& transaction) const
+{
+    // The account, the transaction and the activity thread are stored under
+    // one root commit
+    return storage_.Batch([&]() -> bool {
+        return store_incoming(nymID, accountID, index, chain, transaction);
+    });
+}
+
+bool Blockchain::StoreOutgoing(
+    const Identifier& senderNymID,
+    const Identifier& accountID,
+    const Identifier& recipientContactID,
+    const proto::BlockchainTransaction& transaction) const
+{
+    return storage_.Batch([&]() -> bool {
+        return store_outgoing(
+            senderNymID, accountID, recipientContactID, transaction);
+    });
+}
+
+bool Blockchain::store_incoming(
+    const Identifier& nymID,
+    const Identifier& accountID,
+    const std::uint32_t index,
+    const BIP44Chain chain,
+    const proto::BlockchainTransaction& transaction) const
 {
     LOCK_ACCOUNT()
 
@@ -641,30 +755,25 @@ bool Blockchain::StoreIncoming(
         return false;
     }
 
-    auto& address = find_address(index, chain, *account);
-    bool exists = false;
-
-    for (const auto& txid : address.incoming()) {
-        if (txid == transaction.txid()) {
-            exists = true;
-            break;
-        }
-    }
+    auto& addressIndex = index_account(accountLock, accountID, *account);
+    auto& address = find_address(index, chain, addressIndex, *account);
+    auto& incoming = addressIndex.incoming_[address_key(chain, index)];
+    const bool exists = (false == incoming.insert(transaction.txid()).second);
 
+    // A transaction which is already recorded leaves the account unchanged
     if (false == exists) {
         address.add_incoming(transaction.txid());
-    }
-
-    auto saved = storage_.Store(sNymID, account->type(), *account);
 
-    if (false == saved) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Failed to save account."
-              << std::endl;
+        if (false == storage_.Store(sNymID, account->type(), *account)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to save account."
+                  << std::endl;
+            addressIndex.valid_ = false;
 
-        return false;
+            return false;
+        }
     }
 
-    saved = storage_.Store(transaction);
+    auto saved = storage_.Store(transaction);
 
     if (false == saved) {
         otErr << OT_METHOD << __FUNCTION__ << ": Failed to save transaction."
@@ -684,7 +793,7 @@ bool Blockchain::StoreIncoming(
         nymID, contactID, StorageBox::INCOMINGBLOCKCHAIN, transaction);
 }
 
-bool Blockchain::StoreOutgoing(
+bool Blockchain::store_outgoing(
     const Identifier& senderNymID,
     const Identifier& accountID,
     const Identifier& recipientContactID,
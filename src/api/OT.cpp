@@ -63,6 +63,7 @@
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/OTDataFolder.hpp"
 #include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/OTPaths.hpp"
 #include "opentxs/network/DhtConfig.hpp"
 #include "opentxs/network/ServerConnection.hpp"
 #include "opentxs/network/ZMQ.hpp"
@@ -72,6 +73,7 @@
 #include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/String.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <ctime>
 #include <memory>
@@ -83,6 +85,10 @@
 #define STORAGE_CONFIG_KEY "storage"
 
 #define OT_METHOD "opentxs::OT::"
+#define OT_MAX_PERIODIC_WORKERS 4
+// Values put to the DHT expire, so unchanged objects are still re-announced
+// this often (in seconds) even though they are skipped otherwise.
+#define OT_DHT_REPUBLISH_AGE 300
 
 namespace opentxs
 {
@@ -105,6 +111,7 @@ OT::OT(
     , server_refresh_interval_(std::numeric_limits<std::int64_t>::max())
     , unit_publish_interval_(std::numeric_limits<std::int64_t>::max())
     , unit_refresh_interval_(std::numeric_limits<std::int64_t>::max())
+    , context_flush_interval_(0)
     , word_list_(words.c_str(), words.size())
     , passphrase_(passphrase.c_str(), passphrase.size())
     , primary_storage_plugin_(storagePlugin)
@@ -113,6 +120,15 @@ OT::OT(
     , config_lock_()
     , task_list_lock_()
     , periodic_task_list()
+    , task_queue_lock_()
+    , task_queue_signal_()
+    , task_queue_()
+    , active_tasks_()
+    , task_workers_()
+    , publish_lock_()
+    , published_()
+    , dht_published_(0)
+    , dht_skipped_(0)
     , shutdown_(false)
     , activity_(nullptr)
     , api_(nullptr)
@@ -214,6 +230,10 @@ Storage& OT::DB() const
     return *storage_;
 }
 
+std::uint64_t OT::DHTPublished() const { return dht_published_.load(); }
+
+std::uint64_t OT::DHTSkipped() const { return dht_skipped_.load(); }
+
 Dht& OT::DHT() const
 {
     OT_ASSERT(dht_)
@@ -371,7 +391,36 @@ void OT::Init_Contacts()
     contacts_.reset(new ContactManager(*storage_, *wallet_));
 }
 
-void OT::Init_Contracts() { wallet_.reset(new class Wallet(*this)); }
+void OT::Init_Contracts()
+{
+    wallet_.reset(new class Wallet(*this));
+
+    // A non-zero interval defers signing and storing edited contexts. Edits
+    // are journaled immediately and written to storage by a periodic flush.
+    bool notUsed;
+    Config().CheckSet_long(
+        "consensus",
+        "context_flush_interval",
+        0,
+        context_flush_interval_,
+        notUsed);
+
+    if (0 >= context_flush_interval_) {
+        return;
+    }
+
+    String dataFolder, journal;
+
+    if (OTDataFolder::Get(dataFolder) &&
+        OTPaths::AppendFile(journal, dataFolder, "contexts.journal")) {
+        wallet_->start_context_journal(journal.Get());
+    } else {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Unable to locate context journal. Contexts will be "
+              << "stored synchronously." << std::endl;
+        context_flush_interval_ = 0;
+    }
+}
 
 void OT::Init_Crypto() { crypto_.reset(new CryptoEngine(*this)); }
 
@@ -534,6 +583,12 @@ void OT::Init_Storage()
         config.gc_interval_,
         config.gc_interval_,
         notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "object_cache_size",
+        config.object_cache_size_,
+        config.object_cache_size_,
+        notUsed);
     Config().CheckSet_str(
         STORAGE_CONFIG_KEY,
         "path",
@@ -565,6 +620,12 @@ void OT::Init_Storage()
         String(config.fs_root_file_),
         config.fs_root_file_,
         notUsed);
+    Config().CheckSet_long(
+        STORAGE_CONFIG_KEY,
+        "fs_fd_cache",
+        config.fs_fd_cache_,
+        config.fs_fd_cache_,
+        notUsed);
     Config().CheckSet_str(
         STORAGE_CONFIG_KEY,
         STORAGE_CONFIG_FS_BACKUP_DIRECTORY_KEY,
@@ -647,14 +708,18 @@ void OT::Init_Periodic()
     auto storage = storage_.get();
     auto now = std::time(nullptr);
 
+    // Publishing only loads the objects which changed since they were last
+    // published. Refreshing only needs the ids, so nothing gets loaded.
     Schedule(
         nym_publish_interval_,
-        [storage]() -> void {
+        [this, storage]() -> void {
+            PublishList pending;
             NymLambda nymLambda(
-                [](const serializedCredentialIndex& nym) -> void {
+                [this, &pending](const serializedCredentialIndex& nym) -> void {
                     OT::App().DHT().Insert(nym);
+                    published("nym", nym.nymid(), pending);
                 });
-            storage->MapPublicNyms(nymLambda);
+            storage->MapPublicNyms(nymLambda, publish_filter("nym", pending));
         },
         now);
 
@@ -662,21 +727,28 @@ void OT::Init_Periodic()
         nym_refresh_interval_,
         [storage]() -> void {
             NymLambda nymLambda(
-                [](const serializedCredentialIndex& nym) -> void {
-                    OT::App().DHT().GetPublicNym(nym.nymid());
+                [](const serializedCredentialIndex&) -> void {});
+            MapFilter refresh(
+                [](const std::string& id, const std::string&) -> bool {
+                    OT::App().DHT().GetPublicNym(id);
+
+                    return false;
                 });
-            storage->MapPublicNyms(nymLambda);
+            storage->MapPublicNyms(nymLambda, refresh);
         },
         (now - nym_refresh_interval_ / 2));
 
     Schedule(
         server_publish_interval_,
-        [storage]() -> void {
+        [this, storage]() -> void {
+            PublishList pending;
             ServerLambda serverLambda(
-                [](const proto::ServerContract& server) -> void {
+                [this, &pending](const proto::ServerContract& server) -> void {
                     OT::App().DHT().Insert(server);
+                    published("server", server.id(), pending);
                 });
-            storage->MapServers(serverLambda);
+            storage->MapServers(
+                serverLambda, publish_filter("server", pending));
         },
         now);
 
@@ -684,35 +756,66 @@ void OT::Init_Periodic()
         server_refresh_interval_,
         [storage]() -> void {
             ServerLambda serverLambda(
-                [](const proto::ServerContract& server) -> void {
-                    OT::App().DHT().GetServerContract(server.id());
+                [](const proto::ServerContract&) -> void {});
+            MapFilter refresh(
+                [](const std::string& id, const std::string&) -> bool {
+                    OT::App().DHT().GetServerContract(id);
+
+                    return false;
                 });
-            storage->MapServers(serverLambda);
+            storage->MapServers(serverLambda, refresh);
         },
         (now - server_refresh_interval_ / 2));
 
     Schedule(
         unit_publish_interval_,
-        [storage]() -> void {
+        [this, storage]() -> void {
+            PublishList pending;
             UnitLambda unitLambda(
-                [](const proto::UnitDefinition& unit) -> void {
+                [this, &pending](const proto::UnitDefinition& unit) -> void {
                     OT::App().DHT().Insert(unit);
+                    published("unit", unit.id(), pending);
                 });
-            storage->MapUnitDefinitions(unitLambda);
+            storage->MapUnitDefinitions(
+                unitLambda, publish_filter("unit", pending));
         },
         now);
 
     Schedule(
         unit_refresh_interval_,
         [storage]() -> void {
-            UnitLambda unitLambda(
-                [](const proto::UnitDefinition& unit) -> void {
-                    OT::App().DHT().GetUnitDefinition(unit.id());
+            UnitLambda unitLambda([](const proto::UnitDefinition&) -> void {});
+            MapFilter refresh(
+                [](const std::string& id, const std::string&) -> bool {
+                    OT::App().DHT().GetUnitDefinition(id);
+
+                    return false;
                 });
-            storage->MapUnitDefinitions(unitLambda);
+            storage->MapUnitDefinitions(unitLambda, refresh);
         },
         (now - unit_refresh_interval_ / 2));
 
+    if (0 < context_flush_interval_) {
+        auto wallet = wallet_.get();
+
+        OT_ASSERT(nullptr != wallet);
+
+        Schedule(
+            context_flush_interval_,
+            [wallet]() -> void { wallet->FlushContexts(); },
+            now);
+    }
+
+    const unsigned int workers = std::max(
+        1u,
+        std::min(
+            std::thread::hardware_concurrency(),
+            static_cast<unsigned int>(OT_MAX_PERIODIC_WORKERS)));
+
+    for (unsigned int i = 0; i < workers; ++i) {
+        task_workers_.emplace_back(new std::thread(&OT::RunTasks, this));
+    }
+
     periodic_.reset(new std::thread(&OT::Periodic, this));
 }
 
@@ -725,6 +828,38 @@ void OT::Init_ZMQ()
     zeromq_.reset(new class ZMQ(*config));
 }
 
+void OT::Parallel(
+    const std::size_t count,
+    const ParallelTask& task,
+    const std::size_t threshold) const
+{
+    if ((count < std::max<std::size_t>(threshold, 2)) ||
+        task_workers_.empty() || shutdown_.load()) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+
+        return;
+    }
+
+    std::shared_ptr<ParallelJob> job(new ParallelJob);
+    job->task_ = task;
+    job->count_ = count;
+
+    {
+        std::lock_guard<std::mutex> queueLock(task_queue_lock_);
+        job_queue_.push_back(job);
+    }
+
+    task_queue_signal_.notify_all();
+    // The calling thread works on its own batch, so the batch finishes even
+    // if every worker is occupied by a periodic task.
+    run_job(*job);
+    std::unique_lock<std::mutex> jobLock(job->lock_);
+    job->done_.wait(
+        jobLock, [&]() -> bool { return job->finished_.load() == count; });
+}
+
 void OT::Periodic()
 {
     while (!shutdown_.load()) {
@@ -735,11 +870,19 @@ void OT::Periodic()
 
         for (auto& task : periodic_task_list) {
             if ((now - std::get<0>(task)) > std::get<1>(task)) {
+                std::lock_guard<std::mutex> queueLock(task_queue_lock_);
+
+                // Don't queue a task again while the previous run is still
+                // waiting for, or occupying, a worker
+                if (false == active_tasks_.insert(&task).second) {
+                    continue;
+                }
+
                 // set "last performed"
                 std::get<0>(task) = now;
-                // run the task in an independent thread
-                auto taskThread = std::thread(std::get<2>(task));
-                taskThread.detach();
+                // hand the task to the worker pool
+                task_queue_.push_back(&task);
+                task_queue_signal_.notify_one();
             }
         }
 
@@ -757,6 +900,51 @@ void OT::Periodic()
     }
 }
 
+OT::PublishFilter OT::publish_filter(
+    const std::string& type,
+    PublishList& pending)
+{
+    return [this, type, &pending](
+               const std::string& id, const std::string& hash) -> bool {
+        const auto now = std::time(nullptr);
+        std::lock_guard<std::mutex> publishLock(publish_lock_);
+        const auto it = published_.find(type + id);
+
+        if (published_.end() != it) {
+            const auto& last = it->second;
+            const bool changed = (last.first != hash);
+            const bool expired = ((now - last.second) >= OT_DHT_REPUBLISH_AGE);
+
+            if ((false == changed) && (false == expired)) {
+                dht_skipped_++;
+
+                return false;
+            }
+        }
+
+        pending[id] = hash;
+
+        return true;
+    };
+}
+
+void OT::published(
+    const std::string& type,
+    const std::string& id,
+    const PublishList& pending)
+{
+    const auto it = pending.find(id);
+
+    if (pending.end() == it) {
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> publishLock(publish_lock_);
+    published_[type + id] = {it->second, std::time(nullptr)};
+    dht_published_++;
+}
+
 void OT::recover()
 {
     OT_ASSERT(api_);
@@ -777,6 +965,74 @@ void OT::recover()
     }
 }
 
+void OT::run_job(ParallelJob& job)
+{
+    while (true) {
+        const auto index = job.next_.fetch_add(1);
+
+        if (index >= job.count_) {
+
+            return;
+        }
+
+        job.task_(index);
+
+        if (job.count_ == (job.finished_.fetch_add(1) + 1)) {
+            // Taking the lock makes sure the submitter does not miss the
+            // signal
+            {
+                std::lock_guard<std::mutex> jobLock(job.lock_);
+            }
+
+            job.done_.notify_all();
+        }
+    }
+}
+
+void OT::RunTasks()
+{
+    std::unique_lock<std::mutex> queueLock(task_queue_lock_);
+
+    while (true) {
+        task_queue_signal_.wait(queueLock, [this]() -> bool {
+            return shutdown_.load() || (false == job_queue_.empty()) ||
+                   (false == task_queue_.empty());
+        });
+
+        if (shutdown_.load()) {
+
+            return;
+        }
+
+        // Parallel batches have a caller waiting on them, so they are
+        // serviced before periodic tasks
+        if (false == job_queue_.empty()) {
+            auto job = job_queue_.front();
+
+            OT_ASSERT(job);
+
+            if (job->next_.load() >= job->count_) {
+                job_queue_.pop_front();
+
+                continue;
+            }
+
+            queueLock.unlock();
+            run_job(*job);
+            queueLock.lock();
+
+            continue;
+        }
+
+        const TaskItem* task = task_queue_.front();
+        task_queue_.pop_front();
+        queueLock.unlock();
+        std::get<2>(*task)();
+        queueLock.lock();
+        active_tasks_.erase(task);
+    }
+}
+
 void OT::Schedule(
     const time64_t& interval,
     const PeriodicTask& task,
@@ -828,6 +1084,25 @@ void OT::Shutdown()
         periodic_->join();
     }
 
+    {
+        // Taking the lock makes sure no worker misses the signal
+        std::lock_guard<std::mutex> queueLock(task_queue_lock_);
+    }
+
+    task_queue_signal_.notify_all();
+
+    for (auto& worker : task_workers_) {
+        OT_ASSERT(worker);
+
+        worker->join();
+    }
+
+    task_workers_.clear();
+
+    if (wallet_) {
+        wallet_->FlushContexts();
+    }
+
     if (api_) {
         api_->Cleanup();
     }
@@ -50,6 +50,8 @@
 #include "opentxs/contact/Contact.hpp"
 #include "opentxs/contact/ContactData.hpp"
 #include "opentxs/core/contract/peer/PeerObject.hpp"
+#include "opentxs/core/crypto/CryptoEncodingEngine.hpp"
+#include "opentxs/core/crypto/CryptoEngine.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Message.hpp"
@@ -60,7 +62,9 @@
 #include "opentxs/server/ServerLoader.hpp"
 #include "opentxs/storage/Storage.hpp"
 
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 #define OT_METHOD "opentxs::Wallet::"
 
@@ -69,6 +73,10 @@ namespace opentxs
 
 Wallet::Wallet(OT& ot)
     : ot_(ot)
+    , context_journal_lock_()
+    , context_journal_(nullptr)
+    , dirty_contexts_()
+    , recovered_contexts_()
 {
 }
 
@@ -86,10 +94,29 @@ std::shared_ptr<class Context> Wallet::context(
         return it->second;
     }
 
-    // Load from storage, if it exists.
-    std::shared_ptr<proto::Context> serialized;
-    const bool loaded = ot_.DB().Load(
-        String(localNymID).Get(), String(remoteNymID).Get(), serialized, true);
+    // Prefer state recovered from the journal, since it is newer than
+    // anything in storage. Otherwise load from storage, if it exists.
+    std::shared_ptr<const proto::Context> serialized;
+    auto journaled = recovered_contexts_.find(context);
+    const bool recovered = (recovered_contexts_.end() != journaled);
+
+    if (recovered) {
+        serialized = std::make_shared<proto::Context>(
+            proto::TextToProto<proto::Context>(journaled->second));
+
+        if ((local != serialized->localnym()) ||
+            (remote != serialized->remotenym())) {
+            // Fall back to the stored state
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Invalid journaled context." << std::endl;
+            recovered_contexts_.erase(journaled);
+
+            return this->context(localNymID, remoteNymID);
+        }
+    }
+
+    const bool loaded =
+        recovered || ot_.DB().Load(local, remote, serialized, true);
 
     if (!loaded) {
         return nullptr;
@@ -153,17 +180,33 @@ std::shared_ptr<class Context> Wallet::context(
 
     OT_ASSERT(entry);
 
-    const bool valid = entry->Validate();
+    // Journaled records are unsigned. They are signed by store_context()
+    // below instead of being validated.
+    const bool valid = recovered || entry->Validate();
 
     if (!valid) {
         context_map_.erase(context);
-
         otErr << OT_METHOD << __FUNCTION__ << ": invalid signature on context."
               << std::endl;
 
         return nullptr;
     }
 
+    if (recovered) {
+        std::unique_lock<std::mutex> lock(entry->lock_);
+
+        // The journal record is discarded once the state it holds has been
+        // stored. Until then the context is retried by FlushContexts().
+        if (store_context(lock, *entry)) {
+            recovered_contexts_.erase(context);
+        } else {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to store recovered context." << std::endl;
+            std::lock_guard<std::mutex> journalLock(context_journal_lock_);
+            dirty_contexts_[context] = entry;
+        }
+    }
+
     return entry;
 }
 
@@ -215,6 +258,94 @@ std::shared_ptr<const class ServerContext> Wallet::ServerContext(
     return output;
 }
 
+void Wallet::FlushContexts()
+{
+    recover_contexts();
+
+    std::map<ContextID, std::weak_ptr<class Context>> dirty{};
+
+    {
+        std::lock_guard<std::mutex> journalLock(context_journal_lock_);
+        dirty.swap(dirty_contexts_);
+    }
+
+    std::map<ContextID, std::weak_ptr<class Context>> failed{};
+    std::vector<ContextID> stored{};
+
+    // Every context is stored under one root commit
+    ot_.DB().Batch([&]() -> bool {
+        for (auto& it : dirty) {
+            auto context = it.second.lock();
+
+            // Contexts are only dropped from the map when they fail validation
+            if (!context) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(context->lock_);
+
+            if (store_context(lock, *context)) {
+                stored.push_back(it.first);
+            } else {
+                failed.insert(it);
+            }
+        }
+
+        return failed.empty();
+    });
+
+    std::lock_guard<std::mutex> mapLock(context_map_lock_);
+
+    for (const auto& id : stored) {
+        recovered_contexts_.erase(id);
+    }
+
+    std::lock_guard<std::mutex> journalLock(context_journal_lock_);
+    dirty_contexts_.insert(failed.begin(), failed.end());
+
+    // The journal can only be discarded once every context it describes is in
+    // storage, including any which were edited while this flush was running.
+    // Records for contexts which could not be recovered yet are carried over.
+    if (context_journal_ && dirty_contexts_.empty()) {
+        std::vector<std::string> records{};
+
+        for (const auto& it : recovered_contexts_) {
+            records.push_back(ot_.Crypto().Encode().DataEncode(it.second));
+        }
+
+        context_journal_->Rewrite(records);
+    }
+}
+
+bool Wallet::journal_context(
+    const std::unique_lock<std::mutex>& lock,
+    class Context& context) const
+{
+    std::lock_guard<std::mutex> journalLock(context_journal_lock_);
+
+    if (!context_journal_) {
+        return false;
+    }
+
+    // Records are not signed. The signature is created once, when the
+    // context is written to storage by store_context().
+    const auto serialized = context.serialize(lock);
+    const auto record = ot_.Crypto().Encode().DataEncode(
+        proto::ProtoAsString(serialized));
+
+    if (!context_journal_->Append(record)) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to write to context journal." << std::endl;
+
+        return false;
+    }
+
+    dirty_contexts_[{serialized.localnym(), serialized.remotenym()}] =
+        context.shared_from_this();
+
+    return true;
+}
+
 Editor<class Context> Wallet::mutable_Context(
     const Identifier& notaryID,
     const Identifier& clientNymID)
@@ -334,6 +465,21 @@ Editor<class ServerContext> Wallet::mutable_ServerContext(
     return Editor<class ServerContext>(child, callback);
 }
 
+void Wallet::recover_contexts()
+{
+    std::unique_lock<std::mutex> mapLock(context_map_lock_);
+    std::vector<ContextID> recovered{};
+
+    for (const auto& it : recovered_contexts_) {
+        recovered.push_back(it.first);
+    }
+
+    // Instantiating a recovered context validates and stores it
+    for (const auto& id : recovered) {
+        context(Identifier(id.first), Identifier(id.second));
+    }
+}
+
 void Wallet::save(class Context* context) const
 {
     if (nullptr == context) {
@@ -342,11 +488,69 @@ void Wallet::save(class Context* context) const
 
     std::unique_lock<std::mutex> lock(context->lock_);
 
-    context->update_signature(lock);
+    // With deferred persistence enabled, signing and storing waits for the
+    // next FlushContexts() call.
+    if (journal_context(lock, *context)) {
+        return;
+    }
+
+    store_context(lock, *context);
+}
+
+void Wallet::start_context_journal(const std::string& path)
+{
+    std::lock_guard<std::mutex> journalLock(context_journal_lock_);
+    context_journal_.reset(new Journal(path));
+
+    OT_ASSERT(context_journal_);
+
+    // Records are appended in order, so later records for the same context
+    // replace earlier ones.
+    const bool read = context_journal_->Read(
+        [&](const std::string& record) -> bool {
+            const auto decoded = ot_.Crypto().Encode().DataDecode(record);
+            const auto serialized =
+                proto::TextToProto<proto::Context>(decoded);
+
+            if (serialized.localnym().empty() ||
+                serialized.remotenym().empty()) {
+                otErr << OT_METHOD << __FUNCTION__
+                      << ": Invalid record in context journal." << std::endl;
+
+                return true;
+            }
+
+            recovered_contexts_[{serialized.localnym(),
+                                 serialized.remotenym()}] = decoded;
+
+            return true;
+        });
+
+    if (!read) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Unable to open context journal " << path
+              << ". Contexts will be stored synchronously." << std::endl;
+        context_journal_.reset();
+
+        return;
+    }
+
+    if (0 < recovered_contexts_.size()) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": Recovered "
+               << recovered_contexts_.size() << " contexts from journal."
+               << std::endl;
+    }
+}
+
+bool Wallet::store_context(
+    const std::unique_lock<std::mutex>& lock,
+    class Context& context) const
+{
+    context.update_signature(lock);
 
-    OT_ASSERT(context->validate(lock));
+    OT_ASSERT(context.validate(lock));
 
-    ot_.DB().Store(context->contract(lock));
+    return ot_.DB().Store(context.contract(lock));
 }
 
 ConstNym Wallet::Nym(
@@ -14742,6 +14742,29 @@ int32_t OTAPI_Exec::getMarketList(
     return ot_api_.getMarketList(theNotaryID, theNymID);
 }
 
+// Returns int32_t:
+// -1 means error; no message was sent.
+// >0 means NO error, and the message was sent, and the request number fits into
+// an integer...
+//  ...and in fact the requestNum IS the return value!
+//
+int32_t OTAPI_Exec::getStatistics(
+    const std::string& NOTARY_ID,
+    const std::string& NYM_ID) const
+{
+    std::lock_guard<std::recursive_mutex> lock(lock_);
+
+    OT_ASSERT_MSG(
+        !NOTARY_ID.empty(),
+        "OTAPI_Exec::getStatistics: Null NOTARY_ID passed in.");
+    OT_ASSERT_MSG(
+        !NYM_ID.empty(), "OTAPI_Exec::getStatistics: Null NYM_ID passed in.");
+
+    const Identifier theNotaryID(NOTARY_ID), theNymID(NYM_ID);
+
+    return ot_api_.getStatistics(theNotaryID, theNymID);
+}
+
 // Returns int32_t:
 // -1 means error; no message was sent.
 //  0 means NO error, but also: no message was sent.
@@ -3069,6 +3069,13 @@ int32_t OTAPI_Wrap::getMarketList(
     return Exec()->getMarketList(NOTARY_ID, NYM_ID);
 }
 
+int32_t OTAPI_Wrap::getStatistics(
+    const std::string& NOTARY_ID,
+    const std::string& NYM_ID)
+{
+    return Exec()->getStatistics(NOTARY_ID, NYM_ID);
+}
+
 int32_t OTAPI_Wrap::getMarketOffers(
     const std::string& NOTARY_ID,
     const std::string& NYM_ID,
@@ -6868,9 +6868,40 @@ bool OTClient::processServerReplyGetAccountData(
 
     const String strAcctID(ACCOUNT_ID);
     const std::string str_acct_id(strAcctID.Get());
+    const String strNotaryID(NOTARY_ID);
+
+    // A box with the same hash as the one already on disk was loaded and
+    // verified when it first arrived, so it doesn't need doing again.
+    const auto unchanged = [&](const String& folder,
+                               const String& replyHash,
+                               const bool bInbox) -> bool {
+        Identifier localHash;
+
+        if (!replyHash.Exists()) return false;
+
+        const bool bLocalHash =
+            bInbox ? pNym->GetInboxHash(str_acct_id, localHash)
+                   : pNym->GetOutboxHash(str_acct_id, localHash);
+
+        return bLocalHash && replyHash.Compare(String(localHash)) &&
+               OTDB::Exists(folder.Get(), strNotaryID.Get(), strAcctID.Get());
+    };
+
+    if (strInbox.Exists() &&
+        unchanged(OTFolders::Inbox(), theReply.m_strInboxHash, true)) {
+        otInfo << __FUNCTION__ << ": Inbox unchanged for account "
+               << str_acct_id << ".\n";
+        strInbox.Release();
+    }
+
+    if (strOutbox.Exists() &&
+        unchanged(OTFolders::Outbox(), theReply.m_strOutboxHash, false)) {
+        otInfo << __FUNCTION__ << ": Outbox unchanged for account "
+               << str_acct_id << ".\n";
+        strOutbox.Release();
+    }
 
     if (strInbox.Exists()) {
-        const String strNotaryID(NOTARY_ID);
 
         // Load the ledger object from strInbox
         Ledger theInbox(NYM_ID, ACCOUNT_ID, NOTARY_ID);
@@ -54,24 +54,29 @@
 #include "opentxs/contact/Contact.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
 #include "opentxs/core/Account.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Ledger.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Message.hpp"
 #include "opentxs/core/Nym.hpp"
+#include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/core/Types.hpp"
 #include "opentxs/ext/OTPayment.hpp"
 
 #include <inttypes.h>
 #include <stdint.h>
+#include <algorithm>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace
 {
@@ -111,6 +116,9 @@ namespace opentxs
 //#define MC_UI_TEXT_TO "<font color='grey'>To:</font> %s"
 //#define MC_UI_TEXT_FROM "<font color='grey'>From:</font> %s"
 
+// Fewer boxes than this are loaded on the calling thread
+#define OT_RECORDLIST_PARALLEL_THRESHOLD 4
+
 bool OT_API_Set_AddrBookCallback(OTLookupCaller& theCaller)  // OTLookupCaller
                                                              // must have
 {  // OTNameLookup attached already.
@@ -235,6 +243,14 @@ void OTNameLookup::notifyOfSuccessfulNotarization(
     // (Only useful when overriding.)
 }
 
+// virtual
+void OTNameLookup::notifyOfChangedRecords(
+    const std::vector<int32_t>&,
+    int32_t) const
+{
+    // (Only useful when overriding.)
+}
+
 // OTLookupCaller CLASS
 
 OTLookupCaller::~OTLookupCaller()
@@ -1176,6 +1192,7 @@ bool OTRecordList::PerformAutoAccept()
 bool OTRecordList::Populate()
 {
     OT_ASSERT(nullptr != m_pLookup);
+    const vec_OTRecordList previous(m_contents);
     ClearContents();
     // Loop through all the accounts.
     //
@@ -1196,6 +1213,10 @@ bool OTRecordList::Populate()
     // automatically.
     //
     PerformAutoAccept();
+    // Load every box we're going to look at up front, all at once. The loops
+    // below only read from this snapshot.
+    //
+    load_boxes(*pWallet);
     // OUTPAYMENTS, OUTMAIL, MAIL, PAYMENTS INBOX, and RECORD BOX (2 kinds.)
     // Loop through the Nyms.
     //
@@ -1793,13 +1814,7 @@ bool OTRecordList::Populate()
             // will, however, work
             // either way.
             //
-            Ledger* pInbox =
-                m_bRunFast
-                    ? OTAPI_Wrap::OTAPI()->LoadPaymentInboxNoVerify(
-                          theNotaryID, theNymID)
-                    : OTAPI_Wrap::OTAPI()->LoadPaymentInbox(
-                          theNotaryID, theNymID);
-            std::unique_ptr<Ledger> theInboxAngel(pInbox);
+            auto pInbox = get_box(Ledger::paymentInbox, theNotaryID, theNymID);
 
             int32_t nIndex = (-1);
             // It loaded up, so let's loop through it.
@@ -2118,13 +2133,8 @@ bool OTRecordList::Populate()
             // Also loop through its record box. For this record box, pass the
             // NYM_ID twice, since it's the recordbox for the Nym.
             // OPTIMIZE FYI: m_bRunFast impacts run speed here.
-            Ledger* pRecordbox =
-                m_bRunFast
-                    ? OTAPI_Wrap::OTAPI()->LoadRecordBoxNoVerify(
-                          theNotaryID, theNymID, theNymID)  // twice.
-                    : OTAPI_Wrap::OTAPI()->LoadRecordBox(
-                          theNotaryID, theNymID, theNymID);
-            std::unique_ptr<Ledger> theRecordBoxAngel(pRecordbox);
+            auto pRecordbox =
+                get_box(Ledger::recordBox, theNotaryID, theNymID);  // twice.
 
             // It loaded up, so let's loop through it.
             if (nullptr != pRecordbox) {
@@ -2730,13 +2740,8 @@ bool OTRecordList::Populate()
 
             // Also loop through its expired record box.
             // OPTIMIZE FYI: m_bRunFast impacts run speed here.
-            Ledger* pExpiredbox =
-                m_bRunFast
-                    ? OTAPI_Wrap::OTAPI()->LoadExpiredBoxNoVerify(
-                          theNotaryID, theNymID)
-                    : OTAPI_Wrap::OTAPI()->LoadExpiredBox(
-                          theNotaryID, theNymID);
-            std::unique_ptr<Ledger> theExpiredBoxAngel(pExpiredbox);
+            auto pExpiredbox =
+                get_box(Ledger::expiredBox, theNotaryID, theNymID);
 
             // It loaded up, so let's loop through it.
             if (nullptr != pExpiredbox) {
@@ -3385,12 +3390,7 @@ bool OTRecordList::Populate()
         // return for FASTER PERFORMANCE, then call SetFastMode() before
         // Populating.
         //
-        Ledger* pInbox = m_bRunFast
-                             ? OTAPI_Wrap::OTAPI()->LoadInboxNoVerify(
-                                   theNotaryID, theNymID, theAccountID)
-                             : OTAPI_Wrap::OTAPI()->LoadInbox(
-                                   theNotaryID, theNymID, theAccountID);
-        std::unique_ptr<Ledger> theInboxAngel(pInbox);
+        auto pInbox = get_box(Ledger::inbox, theNotaryID, theAccountID);
 
         // It loaded up, so let's loop through it.
         if (nullptr != pInbox) {
@@ -3673,12 +3673,7 @@ bool OTRecordList::Populate()
         // return for FASTER PERFORMANCE, then call SetFastMode() before running
         // Populate.
         //
-        Ledger* pOutbox = m_bRunFast
-                              ? OTAPI_Wrap::OTAPI()->LoadOutboxNoVerify(
-                                    theNotaryID, theNymID, theAccountID)
-                              : OTAPI_Wrap::OTAPI()->LoadOutbox(
-                                    theNotaryID, theNymID, theAccountID);
-        std::unique_ptr<Ledger> theOutboxAngel(pOutbox);
+        auto pOutbox = get_box(Ledger::outbox, theNotaryID, theAccountID);
 
         // It loaded up, so let's loop through it.
         if (nullptr != pOutbox) {
@@ -3867,12 +3862,8 @@ bool OTRecordList::Populate()
         // return for FASTER PERFORMANCE, then call SetFastMode() before
         // Populating.
         //
-        Ledger* pRecordbox = m_bRunFast
-                                 ? OTAPI_Wrap::OTAPI()->LoadRecordBoxNoVerify(
-                                       theNotaryID, theNymID, theAccountID)
-                                 : OTAPI_Wrap::OTAPI()->LoadRecordBox(
-                                       theNotaryID, theNymID, theAccountID);
-        std::unique_ptr<Ledger> theRecordBoxAngel(pRecordbox);
+        auto pRecordbox =
+            get_box(Ledger::recordBox, theNotaryID, theAccountID);
 
         // It loaded up, so let's loop through it.
         if (nullptr != pRecordbox) {
@@ -4373,9 +4364,347 @@ bool OTRecordList::Populate()
     // SORT the vector.
     //
     SortRecords();
+    notify_changes(previous);
     return true;
 }
 
+const char* OTRecordList::box_folder(const Ledger::ledgerType theType)
+{
+    switch (theType) {
+        case Ledger::inbox:
+            return OTFolders::Inbox().Get();
+        case Ledger::outbox:
+            return OTFolders::Outbox().Get();
+        case Ledger::paymentInbox:
+            return OTFolders::PaymentInbox().Get();
+        case Ledger::recordBox:
+            return OTFolders::RecordBox().Get();
+        case Ledger::expiredBox:
+            return OTFolders::ExpiredBox().Get();
+        default:
+            break;
+    }
+
+    OT_FAIL;
+}
+
+// Boxes are keyed by their location in storage, which is unique across box
+// types.
+std::string OTRecordList::box_path(
+    const Ledger::ledgerType theType,
+    const Identifier& theNotaryID,
+    const Identifier& theAccountID)
+{
+    const String strNotaryID(theNotaryID), strAccountID(theAccountID);
+    std::string str_path(box_folder(theType));
+    str_path += Log::PathSeparator();
+    str_path += strNotaryID.Get();
+    str_path += Log::PathSeparator();
+    str_path += strAccountID.Get();
+
+    return str_path;
+}
+
+void OTRecordList::add_box(
+    map_of_boxes& theBoxes,
+    const Ledger::ledgerType theType,
+    const Identifier& theNotaryID,
+    const Identifier& theNymID,
+    const Identifier& theAccountID,
+    const Nym* pNym)
+{
+    const std::string str_path(box_path(theType, theNotaryID, theAccountID));
+    auto it = m_boxes.find(str_path);
+    BoxSnapshot& theBox = theBoxes[str_path];
+
+    if (m_boxes.end() != it) {
+        theBox = it->second;
+    }
+
+    theBox.m_Type = theType;
+    theBox.m_NotaryID = theNotaryID;
+    theBox.m_NymID = theNymID;
+    theBox.m_AccountID = theAccountID;
+    theBox.m_pNym = pNym;
+}
+
+std::shared_ptr<Ledger> OTRecordList::get_box(
+    const Ledger::ledgerType theType,
+    const Identifier& theNotaryID,
+    const Identifier& theAccountID) const
+{
+    auto it = m_boxes.find(box_path(theType, theNotaryID, theAccountID));
+
+    if (m_boxes.end() == it) {
+
+        return nullptr;
+    }
+
+    return it->second.m_pBox;
+}
+
+// Same as the OT_API::Load...Box functions, except that it doesn't lock the
+// API and it keeps the previous ledger if the file hasn't changed. OTDB has
+// no locking of its own, so reads from it are serialized on storageLock.
+void OTRecordList::load_box(
+    BoxSnapshot& theBox,
+    bool bVerify,
+    std::mutex& storageLock)
+{
+    OT_ASSERT(nullptr != theBox.m_pNym);
+
+    const std::string str_path(
+        box_path(theBox.m_Type, theBox.m_NotaryID, theBox.m_AccountID));
+    const String strNotaryID(theBox.m_NotaryID),
+        strAccountID(theBox.m_AccountID);
+    const char* szFolder = box_folder(theBox.m_Type);
+
+    std::string strRawFile;
+
+    {
+        std::lock_guard<std::mutex> lock(storageLock);
+
+        if (OTDB::Exists(szFolder, strNotaryID.Get(), strAccountID.Get())) {
+            strRawFile = OTDB::QueryPlainString(
+                szFolder, strNotaryID.Get(), strAccountID.Get());
+        }
+    }
+
+    if ((nullptr != theBox.m_pBox) && (strRawFile == theBox.m_strRawFile) &&
+        (theBox.m_bVerified || !bVerify)) {
+
+        return;
+    }
+
+    theBox.m_strRawFile.clear();
+    theBox.m_bVerified = false;
+    theBox.m_pBox.reset();
+
+    if (strRawFile.length() < 2) {
+        otWarn << "OTRecordList::" << __FUNCTION__
+               << ": Box doesn't exist (yet): " << str_path << "\n";
+
+        return;
+    }
+
+    std::shared_ptr<Ledger> pBox(Ledger::GenerateLedger(
+        theBox.m_NymID,
+        theBox.m_AccountID,
+        theBox.m_NotaryID,
+        theBox.m_Type));
+    OT_ASSERT(nullptr != pBox);
+
+    const String strBox(strRawFile);
+    bool bLoaded = false;
+
+    switch (theBox.m_Type) {
+        case Ledger::inbox:
+            bLoaded = pBox->LoadInboxFromString(strBox);
+            break;
+        case Ledger::outbox:
+            bLoaded = pBox->LoadOutboxFromString(strBox);
+            break;
+        case Ledger::paymentInbox:
+            bLoaded = pBox->LoadPaymentInboxFromString(strBox);
+            break;
+        case Ledger::recordBox:
+            bLoaded = pBox->LoadRecordBoxFromString(strBox);
+            break;
+        case Ledger::expiredBox:
+            bLoaded = pBox->LoadExpiredBoxFromString(strBox);
+            break;
+        default:
+            OT_FAIL;
+    }
+
+    if (bLoaded && bVerify) {
+        theBox.m_bVerified = pBox->VerifyAccount(*theBox.m_pNym);
+    }
+
+    if (!bLoaded || (bVerify && !theBox.m_bVerified)) {
+        otWarn << "OTRecordList::" << __FUNCTION__
+               << ": Unable to load or verify: " << str_path << "\n";
+
+        return;
+    }
+
+    theBox.m_strRawFile.swap(strRawFile);
+    theBox.m_pBox = pBox;
+}
+
+// Loads the payments inbox, record box and expired box of each nym on each
+// server, and the inbox, outbox and record box of each account. The boxes are
+// parsed and verified on the OT task workers.
+//
+// The API lock is held throughout, so no other thread can change a box or a
+// nym while the snapshot is taken. The loaders never use the API themselves.
+// Storage reads are serialized in load_box. Verification only reads the nyms,
+// and an RSA key holds its own lock while it is in use, so several boxes may
+// verify against the same nym at once.
+void OTRecordList::load_boxes(OTWallet& theWallet)
+{
+    std::lock_guard<std::recursive_mutex> apiLock(OT::App().API().Lock());
+    map_of_boxes boxes;
+
+    for (auto& it_nym : m_nyms) {
+        const Identifier theNymID(it_nym);
+
+        if (nullptr == OTAPI_Wrap::OTAPI()->GetNym(theNymID)) continue;
+
+        const Nym* pNym = OTAPI_Wrap::OTAPI()->GetOrLoadPrivateNym(
+            theNymID, false, __FUNCTION__);
+
+        if (nullptr == pNym) continue;
+
+        for (auto& it_server : m_servers) {
+            const Identifier theNotaryID(it_server);
+
+            if (!OT::App().Contract().Server(theNotaryID)) continue;
+
+            add_box(
+                boxes,
+                Ledger::paymentInbox,
+                theNotaryID,
+                theNymID,
+                theNymID,
+                pNym);
+            add_box(
+                boxes, Ledger::recordBox, theNotaryID, theNymID, theNymID, pNym);
+            add_box(
+                boxes,
+                Ledger::expiredBox,
+                theNotaryID,
+                theNymID,
+                theNymID,
+                pNym);
+        }
+    }
+
+    for (auto& it_acct : m_accounts) {
+        const Identifier theAccountID(it_acct);
+        Account* pAccount = theWallet.GetAccount(theAccountID);
+
+        if (nullptr == pAccount) continue;
+
+        const Identifier& theNymID = pAccount->GetNymID();
+        const Identifier& theNotaryID = pAccount->GetPurportedNotaryID();
+        const String strNymID(theNymID), strNotaryID(theNotaryID),
+            strInstrumentDefinitionID(pAccount->GetInstrumentDefinitionID());
+
+        if ((m_nyms.end() ==
+             std::find(m_nyms.begin(), m_nyms.end(), strNymID.Get())) ||
+            (m_servers.end() ==
+             std::find(m_servers.begin(), m_servers.end(), strNotaryID.Get())) ||
+            (m_assets.end() == m_assets.find(strInstrumentDefinitionID.Get())))
+            continue;
+
+        const Nym* pNym = OTAPI_Wrap::OTAPI()->GetOrLoadPrivateNym(
+            theNymID, false, __FUNCTION__);
+
+        if (nullptr == pNym) continue;
+
+        add_box(
+            boxes, Ledger::inbox, theNotaryID, theNymID, theAccountID, pNym);
+        add_box(
+            boxes, Ledger::outbox, theNotaryID, theNymID, theAccountID, pNym);
+        add_box(
+            boxes, Ledger::recordBox, theNotaryID, theNymID, theAccountID, pNym);
+    }
+
+    std::vector<BoxSnapshot*> pending;
+
+    for (auto& it : boxes) {
+        pending.push_back(&it.second);
+    }
+
+    const bool bVerify = !m_bRunFast;
+    std::mutex storageLock;
+    OT::App().Parallel(
+        pending.size(),
+        [&](const std::size_t index) -> void {
+            load_box(*pending[index], bVerify, storageLock);
+        },
+        OT_RECORDLIST_PARALLEL_THRESHOLD);
+
+    m_boxes.swap(boxes);
+}
+
+// Records built by this Populate which match one from the previous Populate
+// are replaced by the previous instance, and only the rest are reported.
+void OTRecordList::notify_changes(const vec_OTRecordList& previous)
+{
+    std::multimap<int64_t, shared_ptr_OTRecord> unmatched;
+
+    for (auto& pRecord : previous) {
+        unmatched.emplace(pRecord->GetTransactionNum(), pRecord);
+    }
+
+    std::vector<int32_t> changed;
+
+    for (std::size_t i = 0; i < m_contents.size(); ++i) {
+        auto& pRecord = m_contents[i];
+        auto range = unmatched.equal_range(pRecord->GetTransactionNum());
+        auto it = range.first;
+
+        for (; it != range.second; ++it) {
+            if (same_record(*it->second, *pRecord)) break;
+        }
+
+        if (range.second == it) {
+            changed.push_back(static_cast<int32_t>(i));
+
+            continue;
+        }
+
+        pRecord = it->second;
+        unmatched.erase(it);
+    }
+
+    if (changed.empty() && unmatched.empty()) return;
+
+    m_pLookup->notifyOfChangedRecords(
+        changed, static_cast<int32_t>(unmatched.size()));
+}
+
+bool OTRecordList::same_record(const OTRecord& lhs, const OTRecord& rhs)
+{
+    bool bLhsSuccess = false, bRhsSuccess = false;
+    int64_t lLhsClosing = 0, lRhsClosing = 0;
+
+    return (lhs.GetRecordType() == rhs.GetRecordType()) &&
+           (lhs.GetTransactionNum() == rhs.GetTransactionNum()) &&
+           (lhs.GetTransNumForDisplay() == rhs.GetTransNumForDisplay()) &&
+           (lhs.GetBoxIndex() == rhs.GetBoxIndex()) &&
+           (lhs.GetValidFrom() == rhs.GetValidFrom()) &&
+           (lhs.GetValidTo() == rhs.GetValidTo()) &&
+           (lhs.IsPending() == rhs.IsPending()) &&
+           (lhs.IsOutgoing() == rhs.IsOutgoing()) &&
+           (lhs.IsRecord() == rhs.IsRecord()) &&
+           (lhs.IsReceipt() == rhs.IsReceipt()) &&
+           (lhs.IsExpired() == rhs.IsExpired()) &&
+           (lhs.IsCanceled() == rhs.IsCanceled()) &&
+           (lhs.IsFinalReceipt() == rhs.IsFinalReceipt()) &&
+           (lhs.HasSuccess(bLhsSuccess) == rhs.HasSuccess(bRhsSuccess)) &&
+           (bLhsSuccess == bRhsSuccess) &&
+           (lhs.GetClosingNum(lLhsClosing) == rhs.GetClosingNum(lRhsClosing)) &&
+           (lLhsClosing == lRhsClosing) &&
+           (lhs.GetNotaryID() == rhs.GetNotaryID()) &&
+           (lhs.GetInstrumentDefinitionID() ==
+            rhs.GetInstrumentDefinitionID()) &&
+           (lhs.GetNymID() == rhs.GetNymID()) &&
+           (lhs.GetAccountID() == rhs.GetAccountID()) &&
+           (lhs.GetOtherNymID() == rhs.GetOtherNymID()) &&
+           (lhs.GetOtherAccountID() == rhs.GetOtherAccountID()) &&
+           (lhs.GetName() == rhs.GetName()) &&
+           (lhs.GetDate() == rhs.GetDate()) &&
+           (lhs.GetAmount() == rhs.GetAmount()) &&
+           (lhs.GetInstrumentType() == rhs.GetInstrumentType()) &&
+           (lhs.GetMemo() == rhs.GetMemo()) &&
+           (lhs.GetThreadItemId() == rhs.GetThreadItemId()) &&
+           (lhs.GetMsgID() == rhs.GetMsgID()) &&
+           (lhs.GetContents() == rhs.GetContents());
+}
+
 const list_of_strings& OTRecordList::GetNyms() const { return m_nyms; }
 
 // Populate already sorts. But if you have to add some external records
@@ -12091,6 +12091,49 @@ int32_t OT_API::getMarketList(
     return static_cast<int32_t>(lRequestNumber);
 }
 
+/// GET THE NOTARY'S LATENCY STATISTICS
+///
+/// Only the admin nym is allowed to do this. On success the reply payload
+/// contains the same JSON report the notary writes to its statistics file.
+int32_t OT_API::getStatistics(
+    const Identifier& NOTARY_ID,
+    const Identifier& NYM_ID) const
+{
+    std::lock_guard<std::recursive_mutex> lock(lock_);
+
+    Nym* pNym = GetOrLoadPrivateNym(NYM_ID, false, __FUNCTION__);
+
+    if (nullptr == pNym) {
+        return (-1);
+    }
+
+    Message theMessage;
+    auto context = wallet_.mutable_ServerContext(NYM_ID, NOTARY_ID);
+
+    // (0) Set up the REQUEST NUMBER and then INCREMENT IT
+    auto lRequestNumber = context.It().Request();
+    theMessage.m_strRequestNum.Format("%" PRId64, lRequestNumber);
+    context.It().IncrementRequest();
+
+    // (1) Set up member variables
+    theMessage.m_strCommand = "getStatistics";
+    theMessage.m_strNymID = String(NYM_ID);
+    theMessage.m_strNotaryID = String(NOTARY_ID);
+    theMessage.SetAcknowledgments(context.It());
+
+    // (2) Sign the Message
+    theMessage.SignContract(*pNym);
+
+    // (3) Save the Message (with signatures and all, back to its internal
+    // member m_strRawFile.)
+    theMessage.SaveContract();
+
+    // (Send it)
+    SendMessage(NOTARY_ID, pNym, theMessage);
+
+    return static_cast<int32_t>(lRequestNumber);
+}
+
 /// GET ALL THE OFFERS ON A SPECIFIC MARKET
 ///
 /// A specific Nym is requesting the Server to send a list of the offers on a
@@ -13138,6 +13181,22 @@ int32_t OT_API::getAccountData(
     theMessage.SetAcknowledgments(context.It());
     theMessage.m_strAcctID = strAcctID;
 
+    // Tell the server which versions of the boxes are already here, so it
+    // only sends the ones that have changed since.
+    Identifier inboxHash, outboxHash;
+
+    if (OTDB::Exists(
+            OTFolders::Inbox().Get(), strNotaryID.Get(), strAcctID.Get()) &&
+        pNym->GetInboxHash(strAcctID.Get(), inboxHash)) {
+        inboxHash.GetString(theMessage.m_strInboxHash);
+    }
+
+    if (OTDB::Exists(
+            OTFolders::Outbox().Get(), strNotaryID.Get(), strAcctID.Get()) &&
+        pNym->GetOutboxHash(strAcctID.Get(), outboxHash)) {
+        outboxHash.GetString(theMessage.m_strOutboxHash);
+    }
+
     // (2) Sign the Message
     theMessage.SignContract(*pNym);
 
@@ -44,15 +44,30 @@
 #include "opentxs/client/OTAPI_Wrap.hpp"
 #include "opentxs/client/OT_ME.hpp"
 #include "opentxs/consensus/ServerContext.hpp"
+#include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
+#include "opentxs/core/String.hpp"
 #include "opentxs/network/ZMQ.hpp"
 
+#include <map>
+#include <mutex>
 #include <ostream>
+#include <string>
 
 #define MIN_MESSAGE_LENGTH 10
 
 #define OT_METHOD "opentxs::Utility::"
 
+namespace
+{
+// The digest of each inbox and outbox whose box receipts were all found (or
+// downloaded) last time, keyed by notary, nym, account and box type. A box
+// which hasn't changed since doesn't need its signature checked or its
+// receipts looked for again.
+std::mutex verified_boxes_lock_;
+std::map<std::string, std::string> verified_boxes_;
+}  // namespace
+
 namespace opentxs
 {
 
@@ -1757,6 +1772,30 @@ bool Utility::insureHaveAllBoxReceipts(
     // the box receipts are, and download them from the server. No point trying
     // to load them before that time, when I know it will fail.
     //
+    const bool bCacheable = (0 != nBoxType) && (1 > nRequestSeeking);
+    const std::string boxKey = notaryID + ':' + nymID + ':' + accountID + ':' +
+                               std::to_string(nBoxType);
+    std::string boxDigest;
+
+    if (bCacheable && VerifyStringVal(ledger)) {
+        Identifier digest;
+
+        if (digest.CalculateDigest(String(ledger))) {
+            boxDigest = String(digest).Get();
+        }
+
+        std::lock_guard<std::mutex> lock(verified_boxes_lock_);
+        const auto it = verified_boxes_.find(boxKey);
+
+        if (!boxDigest.empty() && (verified_boxes_.end() != it) &&
+            (it->second == boxDigest)) {
+            otInfo << strLocation << ": Box unchanged since its receipts "
+                                     "were last retrieved.\n";
+
+            return true;
+        }
+    }
+
     if (!VerifyStringVal(ledger) ||
         (!OTAPI_Wrap::VerifySignature(nymID, ledger))) {
         otOut << strLocation << ": Unable to load or verify signature on "
@@ -2074,6 +2113,11 @@ bool Utility::insureHaveAllBoxReceipts(
         }
     }
 
+    if (bReturnValue && !boxDigest.empty()) {
+        std::lock_guard<std::mutex> lock(verified_boxes_lock_);
+        verified_boxes_[boxKey] = boxDigest;
+    }
+
     return bReturnValue;
 }
 
@@ -545,8 +545,8 @@ bool Account::GenerateNewAccount(
 
     acctInstrumentDefinitionID_.SetString(String(instrumentDefinitionID));
 
-    otLog3 << __FUNCTION__ << ": Creating new account, type:\n"
-           << String(instrumentDefinitionID) << "\n";
+    OT_LOG(otLog3) << __FUNCTION__ << ": Creating new account, type:\n"
+                   << String(instrumentDefinitionID) << "\n";
 
     SetRealNotaryID(notaryID);
     SetPurportedNotaryID(notaryID);
@@ -729,7 +729,7 @@ void Account::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Set(str_result.c_str());
 }
 
 // return -1 if error, 0 if nothing, and 1 if the node was processed.
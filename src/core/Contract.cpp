@@ -40,6 +40,7 @@
 
 #include "opentxs/core/Contract.hpp"
 
+#include "opentxs/api/OT.hpp"
 #include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 #include "opentxs/core/crypto/CryptoHash.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
@@ -59,6 +60,7 @@
 #include "opentxs/core/String.hpp"
 
 #include <stdint.h>
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <irrxml/irrXML.hpp>
@@ -66,11 +68,16 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 using namespace irr;
 using namespace io;
 
 #define OT_METHOD "opentxs::Contract::"
+// Matches the 2 KB line buffer contracts have always been read through.
+#define OT_CONTRACT_MAX_LINE 2047
+// Fewer contracts than this are verified on the calling thread
+#define OT_VERIFY_SIGNATURES_THRESHOLD 4
 
 namespace opentxs
 {
@@ -606,6 +613,39 @@ bool Contract::VerifySignature(const Nym& theNym, const OTPasswordData* pPWData)
     return false;
 }
 
+// static
+bool Contract::VerifySignatures(
+    const std::vector<const Contract*>& contracts,
+    const Nym& theNym)
+{
+    // Each contract goes through the same VerifySignature() as a single
+    // check, including its logging and the signature memo. The calls only
+    // share theNym, which they read.
+    // Each element is written by a single call, and read only after all of
+    // them have returned.
+    std::vector<std::uint8_t> verified(contracts.size(), 0);
+
+    OT::App().Parallel(
+        contracts.size(),
+        [&](const std::size_t index) -> void {
+            const auto* pContract = contracts[index];
+
+            OT_ASSERT(nullptr != pContract);
+
+            verified[index] = pContract->VerifySignature(theNym);
+        },
+        OT_VERIFY_SIGNATURES_THRESHOLD);
+
+    for (std::size_t i = 0; i < contracts.size(); ++i) {
+        if (0 == verified[i]) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool Contract::VerifyWithKey(
     const OTAsymmetricKey& theKey,
     const OTPasswordData* pPWData) const
@@ -748,17 +788,20 @@ bool Contract::VerifySignature(
         if (theSignature.getMetaData() != *(theKey.m_pMetadata)) return false;
     }
 
+    const String strContents(trim(m_xmlUnsigned));
+    const Data plaintext(
+        strContents.Get(),
+        strContents.GetLength() + 1);  // include null terminator
+    Data signature;
+    theSignature.GetData(signature);
     OTPasswordData thePWData("Contract::VerifySignature 2");
 
-    CryptoAsymmetric& engine = theKey.engine();
-
-    if (false ==
-        engine.VerifyContractSignature(
-            trim(m_xmlUnsigned),
-            theKey,
-            theSignature,
-            hashType,
-            (nullptr != pPWData) ? pPWData : &thePWData)) {
+    if (false == CryptoAsymmetric::VerifyMemoized(
+                     plaintext,
+                     theKey,
+                     signature,
+                     hashType,
+                     (nullptr != pPWData) ? pPWData : &thePWData)) {
         otLog4 << __FUNCTION__
                << ": engine.VerifyContractSignature returned false.\n";
         return false;
@@ -1185,13 +1228,77 @@ bool Contract::LoadContractFromString(const String& theStr)
     return bSuccess;
 }
 
+namespace
+{
+// Hands out the lines of a buffer as pointers into it, without copying. The
+// line splitting matches String::sgets exactly (including its 2047 character
+// line limit) so that the signed content comes out byte for byte the same as
+// it did when contracts were read through a 2 KB line buffer.
+class LineReader
+{
+public:
+    LineReader(const char* data, std::size_t size)
+        : data_(data)
+        , size_(size)
+    {
+    }
+
+    // Returns false once there is nothing left to read after this line.
+    bool Next(const char*& line, std::size_t& length)
+    {
+        line = data_ + position_;
+        length = 0;
+
+        if (position_ >= size_) return false;
+
+        while ((position_ < size_) && (0 != data_[position_]) &&
+               (length < OT_CONTRACT_MAX_LINE)) {
+            if ('\n' == data_[position_]) {
+                ++position_;
+
+                return more();
+            }
+
+            ++position_;
+            ++length;
+        }
+
+        return more();
+    }
+
+private:
+    const char* data_{nullptr};
+    const std::size_t size_{0};
+    std::size_t position_{0};
+
+    bool more() const { return (position_ < size_) && (0 != data_[position_]); }
+};
+
+bool starts_with(const char* line, std::size_t length, const char* prefix)
+{
+    const std::size_t size = std::strlen(prefix);
+
+    return (length >= size) && (0 == std::memcmp(line, prefix, size));
+}
+
+bool contains(const char* line, std::size_t length, const char* needle)
+{
+    const char* end = line + length;
+
+    return end != std::search(line, end, needle, needle + std::strlen(needle));
+}
+
+bool is_dashes(const char* line, std::size_t length)
+{
+    return (length > 3) && ('-' == line[1]) && ('-' == line[2]) &&
+           ('-' == line[3]);
+}
+}  // namespace
+
 bool Contract::ParseRawFile()
 {
-    char buffer1[2100];  // a bit bigger than 2048, just for safety reasons.
     OTSignature* pSig = nullptr;
 
-    std::string line;
-
     bool bSignatureMode = false;           // "currently in signature mode"
     bool bContentMode = false;             // "currently in content mode"
     bool bHaveEnteredContentMode = false;  // "have yet to enter content mode"
@@ -1203,76 +1310,87 @@ bool Contract::ParseRawFile()
         return false;
     }
 
-    // This is redundant (I thought) but the problem hasn't cleared up yet.. so
-    // trying to really nail it now.
-    std::string str_Trim(m_strRawFile.Get());
-    std::string str_Trim2 = String::trim(str_Trim);
-    m_strRawFile.Set(str_Trim2.c_str());
+    // Trim surrounding whitespace, but only copy the file if there actually is
+    // some (there usually isn't.)
+    {
+        const char* szRaw = m_strRawFile.Get();
+        const std::size_t rawLength = std::strlen(szRaw);
+        const char* szWhitespace = " \t\f\v\n\r";
+        std::size_t first = 0;
+        std::size_t last = rawLength;
+
+        while ((first < rawLength) &&
+               (nullptr != std::strchr(szWhitespace, szRaw[first]))) {
+            ++first;
+        }
+
+        while ((last > first) &&
+               (nullptr != std::strchr(szWhitespace, szRaw[last - 1]))) {
+            --last;
+        }
 
+        if ((first < last) &&
+            ((0 != first) || (rawLength != last) ||
+             (rawLength != m_strRawFile.GetLength()))) {
+            const std::string strTrimmed(szRaw + first, last - first);
+            m_strRawFile.Set(strTrimmed.c_str());
+        }
+    }
+
+    // The signed content and the signatures are accumulated here and stored
+    // once at the end, instead of being formatted onto a String line by line.
+    std::string strContent;
+    std::string strSignature;
+    strContent.reserve(m_strRawFile.GetLength());
+
+    LineReader reader(m_strRawFile.Get(), m_strRawFile.GetLength());
+    const char* pBuf = nullptr;
+    std::size_t lineLength = 0;
+    const char* pSkipped = nullptr;
+    std::size_t skippedLength = 0;
     bool bIsEOF = false;
-    m_strRawFile.reset();
 
     do {
-        // Just a fresh start at the top of the loop block... probably
-        // unnecessary.
-        memset(
-            buffer1, 0, 2100);  // todo remove this in optimization. (might be
-                                // removed already...)
-
         // the call returns true if there's more to read, and false if there
         // isn't.
-        bIsEOF = !(m_strRawFile.sgets(buffer1, 2048));
+        bIsEOF = !reader.Next(pBuf, lineLength);
 
-        line = buffer1;
-        const char* pBuf = line.c_str();
-
-        if (line.length() < 2) {
+        if (lineLength < 2) {
             if (bSignatureMode) continue;
         }
 
         // if we're on a dashed line...
-        else if (line.at(0) == '-') {
+        else if (pBuf[0] == '-') {
             if (bSignatureMode) {
                 // we just reached the end of a signature
-                //    otErr << "%s\n", pSig->Get());
+                OT_ASSERT(nullptr != pSig);
+
+                pSig->Set(strSignature.c_str());
+                strSignature.clear();
                 pSig = nullptr;
                 bSignatureMode = false;
                 continue;
             }
 
             // if I'm NOT in signature mode, and I just hit a dash, that means
-            // there
-            // are only four options:
+            // there are only four options:
 
             // a. I have not yet even entered content mode, and just now
             // entering it for the first time.
             if (!bHaveEnteredContentMode) {
-                if ((line.length() > 3) &&
-                    (line.find("BEGIN") != std::string::npos) &&
-                    line.at(1) == '-' && line.at(2) == '-' &&
-                    line.at(3) == '-') {
-                    //                    otErr << "\nProcessing contract...
-                    // \n";
+                if (is_dashes(pBuf, lineLength) &&
+                    contains(pBuf, lineLength, "BEGIN")) {
                     bHaveEnteredContentMode = true;
                     bContentMode = true;
-                    continue;
-                } else {
-                    continue;
                 }
 
+                continue;
             }
 
             // b. I am now entering signature mode!
             else if (
-                line.length() > 3 &&
-                line.find("SIGNATURE") != std::string::npos &&
-                line.at(1) == '-' && line.at(2) == '-' && line.at(3) == '-') {
-                // if (bContentMode)
-                //    otLog3 << "Finished reading contract.\n\nReading a
-                // signature at the bottom of the contract...\n");
-                // else
-                //    otLog3 << "Reading another signature...\n");
-
+                is_dashes(pBuf, lineLength) &&
+                contains(pBuf, lineLength, "SIGNATURE")) {
                 bSignatureMode = true;
                 bContentMode = false;
 
@@ -1289,8 +1407,7 @@ bool Contract::ParseRawFile()
                 continue;
             }
             // c. There is an error in the file!
-            else if (
-                line.length() < 3 || line.at(1) != ' ' || line.at(2) != '-') {
+            else if (lineLength < 3 || pBuf[1] != ' ' || pBuf[2] != '-') {
                 otOut
                     << "Error in contract " << m_strFilename
                     << ": a dash at the beginning of the "
@@ -1298,34 +1415,20 @@ bool Contract::ParseRawFile()
                     << m_strRawFile << "\n";
                 return false;
             }
-            // d. It is an escaped dash, and therefore kosher, so I merely
-            // remove the escape and add it.
-            // I've decided not to remove the dashes but to keep them as part of
-            // the signed content.
-            // It's just much easier to deal with that way. The input code will
-            // insert the extra dashes.
-            // pBuf += 2;
+            // d. It is an escaped dash, and therefore kosher. I've decided not
+            // to remove the dashes but to keep them as part of the signed
+            // content. It's just much easier to deal with that way. The input
+            // code will insert the extra dashes.
         }
 
         // Else we're on a normal line, not a dashed line.
         else {
             if (bHaveEnteredContentMode) {
                 if (bSignatureMode) {
-                    if (line.length() < 2) {
-                        otLog3 << "Skipping short line...\n";
-
-                        if (bIsEOF || !m_strRawFile.sgets(buffer1, 2048)) {
-                            otOut << "Error in signature for contract "
-                                  << m_strFilename
-                                  << ": Unexpected EOF after short line.\n";
-                            return false;
-                        }
-
-                        continue;
-                    } else if (line.compare(0, 8, "Version:") == 0) {
+                    if (starts_with(pBuf, lineLength, "Version:")) {
                         otLog3 << "Skipping version section...\n";
 
-                        if (bIsEOF || !m_strRawFile.sgets(buffer1, 2048)) {
+                        if (bIsEOF || !reader.Next(pSkipped, skippedLength)) {
                             otOut << "Error in signature for contract "
                                   << m_strFilename
                                   << ": Unexpected EOF after \"Version:\"\n";
@@ -1333,10 +1436,10 @@ bool Contract::ParseRawFile()
                         }
 
                         continue;
-                    } else if (line.compare(0, 8, "Comment:") == 0) {
+                    } else if (starts_with(pBuf, lineLength, "Comment:")) {
                         otLog3 << "Skipping comment section...\n";
 
-                        if (bIsEOF || !m_strRawFile.sgets(buffer1, 2048)) {
+                        if (bIsEOF || !reader.Next(pSkipped, skippedLength)) {
                             otOut << "Error in signature for contract "
                                   << m_strFilename
                                   << ": Unexpected EOF after \"Comment:\"\n";
@@ -1345,11 +1448,11 @@ bool Contract::ParseRawFile()
 
                         continue;
                     }
-                    if (line.compare(0, 5, "Meta:") == 0) {
+                    if (starts_with(pBuf, lineLength, "Meta:")) {
                         otLog3 << "Collecting signature metadata...\n";
 
-                        if (line.length() != 13)  // "Meta:    knms" (It will
-                                                  // always be exactly 13
+                        if (lineLength != 13)  // "Meta:    knms" (It will
+                                               // always be exactly 13
                         // characters int64_t.) knms represents the
                         // first characters of the Key type, NymID,
                         // Master Cred ID, and ChildCred ID. Key type is
@@ -1364,20 +1467,20 @@ bool Contract::ParseRawFile()
                         OT_ASSERT(nullptr != pSig);
                         if (false ==
                             pSig->getMetaData().SetMetadata(
-                                line.at(9),
-                                line.at(10),
-                                line.at(11),
-                                line.at(12)))  // "knms" from "Meta:    knms"
+                                pBuf[9],
+                                pBuf[10],
+                                pBuf[11],
+                                pBuf[12]))  // "knms" from "Meta:    knms"
                         {
                             otOut << "Error in signature for contract "
                                   << m_strFilename
                                   << ": Unexpected metadata in the \"Meta:\" "
                                      "comment.\nLine: "
-                                  << line << "\n";
+                                  << std::string(pBuf, lineLength) << "\n";
                             return false;
                         }
 
-                        if (bIsEOF || !m_strRawFile.sgets(buffer1, 2048)) {
+                        if (bIsEOF || !reader.Next(pSkipped, skippedLength)) {
                             otOut << "Error in signature for contract "
                                   << m_strFilename
                                   << ": Unexpected EOF after \"Meta:\"\n";
@@ -1388,18 +1491,18 @@ bool Contract::ParseRawFile()
                     }
                 }
                 if (bContentMode) {
-                    if (line.compare(0, 6, "Hash: ") == 0) {
+                    if (starts_with(pBuf, lineLength, "Hash: ")) {
                         otLog3 << "Collecting message digest algorithm from "
                                   "contract header...\n";
 
-                        std::string strTemp = line.substr(6);
+                        const std::string strTemp(pBuf + 6, lineLength - 6);
                         String strHashType = strTemp.c_str();
                         strHashType.ConvertToUpperCase();
 
                         m_strSigHashType =
                             CryptoHash::StringToHashType(strHashType);
 
-                        if (bIsEOF || !m_strRawFile.sgets(buffer1, 2048)) {
+                        if (bIsEOF || !reader.Next(pSkipped, skippedLength)) {
                             otOut << "Error in contract " << m_strFilename
                                   << ": Unexpected EOF after \"Hash:\"\n";
                             return false;
@@ -1418,9 +1521,12 @@ bool Contract::ParseRawFile()
                 "processing signature, in "
                 "Contract::ParseRawFile");
 
-            pSig->Concatenate("%s\n", pBuf);
-        } else if (bContentMode)
-            m_xmlUnsigned.Concatenate("%s\n", pBuf);
+            strSignature.append(pBuf, lineLength);
+            strSignature.push_back('\n');
+        } else if (bContentMode) {
+            strContent.append(pBuf, lineLength);
+            strContent.push_back('\n');
+        }
     } while (!bIsEOF);
 
     if (!bHaveEnteredContentMode) {
@@ -1435,7 +1541,20 @@ bool Contract::ParseRawFile()
         otErr << "Error in Contract::ParseRawFile: EOF while reading "
                  "signature.\n";
         return false;
-    } else if (!LoadContractXML()) {
+    }
+
+    // The XML can't be parsed in place from m_strRawFile. The signed content
+    // is interleaved with the armor headers and the signatures, and it has to
+    // be kept in m_xmlUnsigned anyway, since that is what signatures are
+    // checked against and what SaveContract writes back out. irrXML also
+    // reads its input into a buffer of its own. So this is the one copy.
+    if (m_xmlUnsigned.Exists()) {
+        strContent.insert(0, m_xmlUnsigned.Get());
+    }
+
+    m_xmlUnsigned.Set(strContent.c_str());
+
+    if (!LoadContractXML()) {
         otErr << "Error in Contract::ParseRawFile: unable to load XML "
                  "portion of contract into memory.\n";
         return false;
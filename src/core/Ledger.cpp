@@ -51,6 +51,7 @@
 #include "opentxs/core/Account.hpp"
 #include "opentxs/core/Cheque.hpp"
 #include "opentxs/core/Contract.hpp"
+#include "opentxs/core/Data.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Item.hpp"
 #include "opentxs/core/Log.hpp"
@@ -65,6 +66,7 @@
 
 #include <stdlib.h>
 #include <sys/types.h>
+#include <cstddef>
 #include <cstdint>
 #include <irrxml/irrXML.hpp>
 #include <memory>
@@ -96,6 +98,8 @@ char const* const __TypeStringsLedger[] = {
                    // paymentInbox.
     "error_state"};
 
+bool Ledger::__packed_records = false;
+
 char const* Ledger::_GetTypeString(ledgerType theType)
 {
     int32_t nType = static_cast<int32_t>(theType);
@@ -1751,6 +1755,13 @@ void Ledger::UpdateContents()  // Before transmission or serialization, this is
     tag.add_attribute("nymID", strNymID.Get());
     tag.add_attribute("notaryID", strLedgerAcctNotaryID.Get());
 
+    // In packed form the abbreviated records are still generated below, but
+    // into a scratch tag, and only their binary form goes into the ledger.
+    const bool bPacked = bSavingAbbreviated && (0 < nPartialRecordCount) &&
+                         (m_bPackedRecords || __packed_records);
+    Tag packedRecords("packedRecords");
+    Tag& records = bPacked ? packedRecords : tag;
+
     // loop through the transactions and print them out here.
     for (auto& it : m_mapTransactions) {
         OTTransaction* pTransaction = it.second;
@@ -1777,22 +1788,22 @@ void Ledger::UpdateContents()  // Before transmission or serialization, this is
             switch (GetType()) {
 
                 case Ledger::nymbox:
-                    pTransaction->SaveAbbreviatedNymboxRecord(tag);
+                    pTransaction->SaveAbbreviatedNymboxRecord(records);
                     break;
                 case Ledger::inbox:
-                    pTransaction->SaveAbbreviatedInboxRecord(tag);
+                    pTransaction->SaveAbbreviatedInboxRecord(records);
                     break;
                 case Ledger::outbox:
-                    pTransaction->SaveAbbreviatedOutboxRecord(tag);
+                    pTransaction->SaveAbbreviatedOutboxRecord(records);
                     break;
                 case Ledger::paymentInbox:
-                    pTransaction->SaveAbbrevPaymentInboxRecord(tag);
+                    pTransaction->SaveAbbrevPaymentInboxRecord(records);
                     break;
                 case Ledger::recordBox:
-                    pTransaction->SaveAbbrevRecordBoxRecord(tag);
+                    pTransaction->SaveAbbrevRecordBoxRecord(records);
                     break;
                 case Ledger::expiredBox:
-                    pTransaction->SaveAbbrevExpiredBoxRecord(tag);
+                    pTransaction->SaveAbbrevExpiredBoxRecord(records);
                     break;
 
                 default
@@ -1811,10 +1822,26 @@ void Ledger::UpdateContents()  // Before transmission or serialization, this is
         }
     }
 
+    if (bPacked) {
+        Data thePacked;
+        OTASCIIArmor ascPacked;
+
+        if (PackAbbreviatedRecords(packedRecords, thePacked) &&
+            ascPacked.SetData(thePacked)) {
+            tag.add_attribute("packedRecords", formatInt(1));
+            tag.add_tag("packedRecords", ascPacked.Get());
+        } else {
+            otErr << "OTLedger::UpdateContents: Failed packing abbreviated "
+                     "records. Saving them as XML instead.\n";
+
+            for (auto record : packedRecords.tags()) { tag.add_tag(record); }
+        }
+    }
+
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Set(str_result.c_str());
 }
 
 // LoadContract will call this function at the right time.
@@ -1906,6 +1933,15 @@ int32_t Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
         int32_t nPartialRecordCount =
             (strNumPartialRecords.Exists() ? atoi(strNumPartialRecords.Get())
                                            : 0);
+        const String strPackedRecords = xml->getAttributeValue("packedRecords");
+        m_bPackedRecords = strPackedRecords.Exists();
+
+        if (m_bPackedRecords && (1 != atoi(strPackedRecords.Get()))) {
+            otErr << szFunc << ": Unsupported packed record format ("
+                  << strPackedRecords << ") in ledger for account: "
+                  << strLedgerAcctID << "\n";
+            return (-1);
+        }
 
         String strExpected;  // The record type has a different name for each
                              // box.
@@ -1956,55 +1992,52 @@ int32_t Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
                                       // block due to switch block (above.)
         {
 
+            // In packed form, all the records are in a single field.
+            //
+            Data thePacked;
+            std::size_t lPackedOffset = 0;
+
+            if (m_bPackedRecords) {
+                OTASCIIArmor ascPacked;
+
+                if (!LoadEncodedTextFieldByName(
+                        xml, ascPacked, "packedRecords") ||
+                    !ascPacked.GetData(thePacked)) {
+                    otOut << szFunc << ": Failure: Unable to load packed "
+                                       "abbreviated records in "
+                          << GetTypeString() << " box for account: "
+                          << strLedgerAcctID << "\n";
+                    return (-1);
+                }
+            }
+
             // We iterate to read the expected number of partial records from
             // the xml.
             // (They had better be there...)
             //
             while (nPartialRecordCount-- > 0) {
-                //                xml->read(); // <==================
-                if (!SkipToElement(xml)) {
-                    otOut << szFunc << ": Failure: Unable to find element when "
-                                       "one was expected ("
-                          << strExpected
-                          << ") "
-                             "for abbreviated record of receipt in "
-                          << GetTypeString() << " box:\n\n"
-                          << m_strRawFile << "\n\n";
-                    return (-1);
-                }
-
-                // strExpected can be one of:
-                //
-                //                strExpected.Set("nymboxRecord");
-                //                strExpected.Set("inboxRecord");
-                //                strExpected.Set("outboxRecord");
-                //
-                // We're loading here either a nymboxRecord, inboxRecord, or
-                // outboxRecord...
-                //
-                const String strLoopNodeName = xml->getNodeName();
-
-                if (strLoopNodeName.Exists() &&
-                    (xml->getNodeType() == irr::io::EXN_ELEMENT) &&
-                    (strExpected.Compare(strLoopNodeName))) {
-                    int64_t lNumberOfOrigin = 0;
-                    int theOriginType = static_cast<int>(originType::not_applicable);  // default
-                    int64_t lTransactionNum = 0;
-                    int64_t lInRefTo = 0;
-                    int64_t lInRefDisplay = 0;
-
-                    time64_t the_DATE_SIGNED = OT_TIME_ZERO;
-                    int theType = OTTransaction::error_state;  // default
-                    String strHash;
-
-                    int64_t lAdjustment = 0;
-                    int64_t lDisplayValue = 0;
-                    int64_t lClosingNum = 0;
-                    int64_t lRequestNum = 0;
-                    bool bReplyTransSuccess = false;
-
-                    int32_t nAbbrevRetVal = LoadAbbreviatedRecord(
-                        xml,
+                int64_t lNumberOfOrigin = 0;
+                int theOriginType = static_cast<int>(originType::not_applicable);  // default
+                int64_t lTransactionNum = 0;
+                int64_t lInRefTo = 0;
+                int64_t lInRefDisplay = 0;
+
+                time64_t the_DATE_SIGNED = OT_TIME_ZERO;
+                int theType = OTTransaction::error_state;  // default
+                String strHash;
+
+                int64_t lAdjustment = 0;
+                int64_t lDisplayValue = 0;
+                int64_t lClosingNum = 0;
+                int64_t lRequestNum = 0;
+                bool bReplyTransSuccess = false;
+
+                int32_t nAbbrevRetVal = -1;
+
+                if (m_bPackedRecords) {
+                    nAbbrevRetVal = UnpackAbbreviatedRecord(
+                        thePacked,
+                        lPackedOffset,
                         lNumberOfOrigin,
                         theOriginType,
                         lTransactionNum,
@@ -2018,50 +2051,49 @@ int32_t Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
                         lClosingNum,
                         lRequestNum,
                         bReplyTransSuccess,
-                        pNumList);  // This is for "OTTransaction::blank" and
-                                    // "OTTransaction::successNotice",
-                                    // otherwise nullptr.
-                    if ((-1) == nAbbrevRetVal)
-                        return (
-                            -1);  // The function already logs appropriately.
+                        pNumList);
+                } else {
+                    //                xml->read(); // <==================
+                    if (!SkipToElement(xml)) {
+                        otOut << szFunc
+                              << ": Failure: Unable to find element when "
+                                 "one was expected ("
+                              << strExpected
+                              << ") "
+                                 "for abbreviated record of receipt in "
+                              << GetTypeString() << " box:\n\n"
+                              << m_strRawFile << "\n\n";
+                        return (-1);
+                    }
 
+                    // strExpected can be one of:
                     //
-                    // See if the same-ID transaction already exists in the
-                    // ledger.
-                    // (There can only be one.)
+                    //                strExpected.Set("nymboxRecord");
+                    //                strExpected.Set("inboxRecord");
+                    //                strExpected.Set("outboxRecord");
                     //
-                    OTTransaction* pExistingTrans =
-                        GetTransaction(lTransactionNum);
-                    if (nullptr !=
-                        pExistingTrans)  // Uh-oh, it's already there!
-                    {
-                        otOut << szFunc << ": Error loading transaction "
-                              << lTransactionNum << " (" << strExpected
-                              << "), since one was already there, in box for "
-                                 "account: "
-                              << strLedgerAcctID << ".\n";
-                        return (-1);
-                    }
+                    // We're loading here either a nymboxRecord, inboxRecord, or
+                    // outboxRecord...
+                    //
+                    const String strLoopNodeName = xml->getNodeName();
 
-                    // CONSTRUCT THE ABBREVIATED RECEIPT HERE...
+                    if (!strLoopNodeName.Exists() ||
+                        (xml->getNodeType() != irr::io::EXN_ELEMENT) ||
+                        !strExpected.Compare(strLoopNodeName)) {
+                        otErr << szFunc
+                              << ": Expected abbreviated record element.\n";
+                        return (-1);  // error condition
+                    }
 
-                    // Set all the values we just loaded here during actual
-                    // construction of transaction
-                    // (as abbreviated transaction) i.e. make a special
-                    // constructor for abbreviated transactions
-                    // which is ONLY used here.
-                    //
-                    OTTransaction* pTransaction = new OTTransaction(
-                        NYM_ID,
-                        ACCOUNT_ID,
-                        NOTARY_ID,
+                    nAbbrevRetVal = LoadAbbreviatedRecord(
+                        xml,
                         lNumberOfOrigin,
-                        static_cast<originType>(theOriginType),
+                        theOriginType,
                         lTransactionNum,
-                        lInRefTo,  // lInRefTo
+                        lInRefTo,
                         lInRefDisplay,
                         the_DATE_SIGNED,
-                        static_cast<OTTransaction::transactionType>(theType),
+                        theType,
                         strHash,
                         lAdjustment,
                         lDisplayValue,
@@ -2069,80 +2101,134 @@ int32_t Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
                         lRequestNum,
                         bReplyTransSuccess,
                         pNumList);  // This is for "OTTransaction::blank" and
-                                    // "OTTransaction::successNotice", otherwise
-                                    // nullptr.
-                    OT_ASSERT(nullptr != pTransaction);
-                    //
-                    // NOTE: For THIS CONSTRUCTOR ONLY, we DO set the purported
-                    // AcctID and purported NotaryID.
-                    // WHY? Normally you set the "real" IDs at construction, and
-                    // then set the "purported" IDs
-                    // when loading from string. But this constructor (only this
-                    // one) is actually used when
-                    // loading abbreviated receipts as you load their
-                    // inbox/outbox/nymbox.
-                    // Abbreviated receipts are not like real transactions,
-                    // which have notaryID, AcctID, nymID,
-                    // and signature attached, and the whole thing is
-                    // base64-encoded and then added to the ledger
-                    // as part of a list of contained objects. Rather, with
-                    // abbreviated receipts, there are a series
-                    // of XML records loaded up as PART OF the ledger itself.
-                    // None of these individual XML records
-                    // has its own signature, or its own record of the main IDs
-                    // -- those are assumed to be on the parent
-                    // ledger.
-                    // That's the whole point: abbreviated records don't store
-                    // redundant info, and don't each have their
-                    // own signature, because we want them to be as small as
-                    // possible inside their parent ledger.
-                    // Therefore I will pass in the parent ledger's "real" IDs
-                    // at construction, and immediately thereafter
-                    // set the parent ledger's "purported" IDs onto the
-                    // abbreviated transaction. That way, VerifyContractID()
-                    // will still work and do its job properly with these
-                    // abbreviated records.
-                    //
-                    // This part normally happens in "GenerateTransaction".
-                    // NOTE: Moved to OTTransaction constructor (for
-                    // abbreviateds) for now.
-                    //
-                    //                    pTransaction->SetPurportedAccountID(
-                    // GetPurportedAccountID());
-                    //                    pTransaction->SetPurportedNotaryID(
-                    // GetPurportedNotaryID());
+                                    // "OTTransaction::successNotice",
+                                    // otherwise nullptr.
+                }
 
-                    // Add it to the ledger's list of transactions...
-                    //
+                if ((-1) == nAbbrevRetVal)
+                    return (-1);  // The function already logs appropriately.
 
-                    if (pTransaction->VerifyContractID()) {
-                        // Add it to the ledger...
-                        //
-                        m_mapTransactions[pTransaction->GetTransactionNum()] =
-                            pTransaction;
-                        pTransaction->SetParent(*this);
-                        //                      otLog5 << "Loaded abbreviated
-                        // transaction and adding to m_mapTransactions in
-                        // OTLedger\n");
-                    } else {
-                        otErr << szFunc << ": ERROR: verifying contract ID on "
-                                           "abbreviated transaction "
-                              << pTransaction->GetTransactionNum() << "\n";
-                        delete pTransaction;
-                        pTransaction = nullptr;
-                        return (-1);
-                    }
-                    //                    xml->read(); // <==================
-                    // MIGHT need to add "skip after element" here.
+                //
+                // See if the same-ID transaction already exists in the
+                // ledger.
+                // (There can only be one.)
+                //
+                OTTransaction* pExistingTrans =
+                    GetTransaction(lTransactionNum);
+                if (nullptr !=
+                    pExistingTrans)  // Uh-oh, it's already there!
+                {
+                    otOut << szFunc << ": Error loading transaction "
+                          << lTransactionNum << " (" << strExpected
+                          << "), since one was already there, in box for "
+                             "account: "
+                          << strLedgerAcctID << ".\n";
+                    return (-1);
+                }
+
+                // CONSTRUCT THE ABBREVIATED RECEIPT HERE...
+
+                // Set all the values we just loaded here during actual
+                // construction of transaction
+                // (as abbreviated transaction) i.e. make a special
+                // constructor for abbreviated transactions
+                // which is ONLY used here.
+                //
+                OTTransaction* pTransaction = new OTTransaction(
+                    NYM_ID,
+                    ACCOUNT_ID,
+                    NOTARY_ID,
+                    lNumberOfOrigin,
+                    static_cast<originType>(theOriginType),
+                    lTransactionNum,
+                    lInRefTo,  // lInRefTo
+                    lInRefDisplay,
+                    the_DATE_SIGNED,
+                    static_cast<OTTransaction::transactionType>(theType),
+                    strHash,
+                    lAdjustment,
+                    lDisplayValue,
+                    lClosingNum,
+                    lRequestNum,
+                    bReplyTransSuccess,
+                    pNumList);  // This is for "OTTransaction::blank" and
+                                // "OTTransaction::successNotice", otherwise
+                                // nullptr.
+                OT_ASSERT(nullptr != pTransaction);
+                //
+                // NOTE: For THIS CONSTRUCTOR ONLY, we DO set the purported
+                // AcctID and purported NotaryID.
+                // WHY? Normally you set the "real" IDs at construction, and
+                // then set the "purported" IDs
+                // when loading from string. But this constructor (only this
+                // one) is actually used when
+                // loading abbreviated receipts as you load their
+                // inbox/outbox/nymbox.
+                // Abbreviated receipts are not like real transactions,
+                // which have notaryID, AcctID, nymID,
+                // and signature attached, and the whole thing is
+                // base64-encoded and then added to the ledger
+                // as part of a list of contained objects. Rather, with
+                // abbreviated receipts, there are a series
+                // of XML records loaded up as PART OF the ledger itself.
+                // None of these individual XML records
+                // has its own signature, or its own record of the main IDs
+                // -- those are assumed to be on the parent
+                // ledger.
+                // That's the whole point: abbreviated records don't store
+                // redundant info, and don't each have their
+                // own signature, because we want them to be as small as
+                // possible inside their parent ledger.
+                // Therefore I will pass in the parent ledger's "real" IDs
+                // at construction, and immediately thereafter
+                // set the parent ledger's "purported" IDs onto the
+                // abbreviated transaction. That way, VerifyContractID()
+                // will still work and do its job properly with these
+                // abbreviated records.
+                //
+                // This part normally happens in "GenerateTransaction".
+                // NOTE: Moved to OTTransaction constructor (for
+                // abbreviateds) for now.
+                //
+                //                    pTransaction->SetPurportedAccountID(
+                // GetPurportedAccountID());
+                //                    pTransaction->SetPurportedNotaryID(
+                // GetPurportedNotaryID());
+
+                // Add it to the ledger's list of transactions...
+                //
+
+                if (pTransaction->VerifyContractID()) {
+                    // Add it to the ledger...
                     //
-                    // Update: Nope.
+                    m_mapTransactions[pTransaction->GetTransactionNum()] =
+                        pTransaction;
+                    pTransaction->SetParent(*this);
+                    //                      otLog5 << "Loaded abbreviated
+                    // transaction and adding to m_mapTransactions in
+                    // OTLedger\n");
                 } else {
-                    otErr << szFunc
-                          << ": Expected abbreviated record element.\n";
-                    return (-1);  // error condition
+                    otErr << szFunc << ": ERROR: verifying contract ID on "
+                                       "abbreviated transaction "
+                          << pTransaction->GetTransactionNum() << "\n";
+                    delete pTransaction;
+                    pTransaction = nullptr;
+                    return (-1);
                 }
+                //                    xml->read(); // <==================
+                // MIGHT need to add "skip after element" here.
+                //
+                // Update: Nope.
             }  // while
-        }      // if (number of partial records > 0)
+
+            if (m_bPackedRecords && (lPackedOffset != thePacked.GetSize())) {
+                otErr << szFunc << ": Error: unexpected data after the "
+                                   "packed abbreviated records in box for "
+                                   "account: "
+                      << strLedgerAcctID << "\n";
+                return (-1);
+            }
+        }  // if (number of partial records > 0)
 
         otLog4 << szFunc << ": Loading account ledger of type \"" << strType
                << "\", version: " << m_strVersion << "\n";
@@ -72,6 +72,8 @@
 #include <typeinfo>
 
 #define LOG_DEQUE_SIZE 1024
+#define LOG_STREAM_COUNT 7
+#define LOG_WRITER_INTERVAL 100
 
 extern "C" {
 
@@ -145,44 +147,104 @@ OTLOG_IMPORT OTLogStream otLog5(5);  // logs using OTLog::vOutput(5)
 OTLogStream::OTLogStream(int _logLevel)
     : std::ostream(this)
     , logLevel(_logLevel)
-    , next(0)
-    , pBuffer(new char[1024])
 {
 }
 
-OTLogStream::~OTLogStream()
+OTLogStream::~OTLogStream() {}
+
+std::string& OTLogStream::buffer() const
+{
+    // One partial line per thread for each stream (levels -1 through 5)
+    static thread_local std::string buffers[LOG_STREAM_COUNT];
+    const int index = std::min(std::max(logLevel + 1, 0), LOG_STREAM_COUNT - 1);
+
+    return buffers[index];
+}
+
+bool OTLogStream::Enabled() const
 {
-    delete[] pBuffer;
-    pBuffer = nullptr;
+    return (0 > logLevel) || (logLevel <= Log::LogLevel());
 }
 
 int OTLogStream::overflow(int c)
 {
-    pBuffer[next++] = c;
-    if (c != '\n' && next < 1000) {
-        return 0;
+    typedef std::streambuf::traits_type traits;
+
+    if (traits::eq_int_type(c, traits::eof())) {
+        return traits::not_eof(c);
     }
 
-    pBuffer[next++] = '\0';
-    next = 0;
+    if (!Enabled()) {
+        return c;
+    }
 
+    auto& line = buffer();
+    line.push_back(static_cast<char>(c));
+
+    if ('\n' == c) {
+        send(line);
+    }
+
+    return c;
+}
+
+void OTLogStream::send(std::string& line) const
+{
     if (logLevel < 0) {
-        Log::Error(pBuffer);
-        return 0;
+        Log::Error(line.c_str());
+    } else {
+        Log::Output(logLevel, line.c_str());
+    }
+
+    line.clear();
+}
+
+std::streamsize OTLogStream::xsputn(const char* s, std::streamsize n)
+{
+    if (!Enabled()) {
+        return n;
+    }
+
+    auto& line = buffer();
+    const char* end = s + n;
+
+    while (s < end) {
+        auto newline = static_cast<const char*>(std::memchr(s, '\n', end - s));
+
+        if (nullptr == newline) {
+            line.append(s, end - s);
+
+            break;
+        }
+
+        line.append(s, newline + 1 - s);
+        send(line);
+        s = newline + 1;
     }
 
-    Log::Output(logLevel, pBuffer);
-    return 0;
+    return n;
 }
 
 Log::Log(Settings& config)
     : config_(config)
+    , memlog_lock_()
+    , memlog_(LOG_DEQUE_SIZE)
+    , pending_(nullptr)
+    , running_(false)
+    , producers_(0)
+    , writer_lock_()
+    , signal_lock_()
+    , signal_()
+    , writer_(nullptr)
+    , log_file_()
 {
     bool notUsed{false};
     config_.Check_bool(
         CONFIG_LOG_SECTION, CONFIG_LOG_TO_FILE_KEY, write_log_file_, notUsed);
 }
 
+Log::~Log() { stop_writer(); }
+
 //  OTLog Init, must run this before using any OTLog function.
 
 // static
@@ -199,7 +261,12 @@ bool Log::Init(
     if (strThreadContext.Compare(GLOBAL_LOGNAME)) return false;
 
     if (!pLogger->m_bInitialized) {
-        pLogger->logDeque = std::deque<String*>();
+        {
+            std::lock_guard<std::mutex> lock(pLogger->memlog_lock_);
+            pLogger->memlog_head_ = 0;
+            pLogger->memlog_size_ = 0;
+        }
+
         pLogger->m_strThreadContext = strThreadContext;
 
         pLogger->m_nLogLevel = nLogLevel;
@@ -248,6 +315,7 @@ bool Log::Init(
             }
 
         pLogger->m_bInitialized = true;
+        pLogger->start_writer();
 
         // Set the new log-assert function pointer.
         Assert* pLogAssert = new Assert(Log::logAssert);
@@ -271,6 +339,9 @@ bool Log::IsInitialized()
 bool Log::Cleanup()
 {
     if (nullptr != pLogger) {
+        // Nothing may still be queued, or being queued, when the logger
+        // goes away.
+        pLogger->stop_writer();
         delete pLogger;
         pLogger = nullptr;
         return true;
@@ -330,9 +401,16 @@ bool Log::SetLogLevel(const int32_t& nLogLevel)
 // command line utilities who might otherwise interpret it as their own input,
 // if I was actually writing to stdout.)
 //
+// Once the logger is initialized, output is handed to the writer thread, which
+// keeps the log file open. Before that it is written directly.
+//
 // static
 bool Log::LogToFile(const String& strOutput)
 {
+    if (IsInitialized() && pLogger->try_enqueue(strOutput)) {
+        return true;
+    }
+
     // We now do this either way.
     {
         std::cerr << strOutput;
@@ -377,20 +455,28 @@ String Log::GetMemlogAtIndex(int32_t nIndex)
     // lets check if we are Initialized in this context
     CheckLogger(Log::pLogger);
 
-    uint32_t uIndex = static_cast<uint32_t>(nIndex);
+    const uint32_t uIndex = static_cast<uint32_t>(nIndex);
+    bool bInBounds = false;
+    String strLogEntry;
+
+    {
+        std::lock_guard<std::mutex> lock(Log::pLogger->memlog_lock_);
+        bInBounds = (nIndex >= 0) && (uIndex < Log::pLogger->memlog_size_);
 
-    if ((nIndex < 0) || (uIndex >= Log::pLogger->logDeque.size())) {
+        if (bInBounds) {
+            strLogEntry.Set(
+                Log::pLogger->memlog_[Log::pLogger->memlog_index(uIndex)]
+                    .c_str());
+        }
+    }
+
+    // Logging the error adds to the memlog, so it waits for the lock to be
+    // released.
+    if (!bInBounds) {
         otErr << __FUNCTION__ << ": index out of bounds: " << nIndex << "\n";
         return "";
     }
 
-    if (nullptr != Log::pLogger->logDeque.at(uIndex))
-        ;  // check for null
-    else
-        OT_FAIL;
-
-    const String strLogEntry = *Log::pLogger->logDeque.at(uIndex);
-
     if (strLogEntry.Exists())
         return strLogEntry;
     else
@@ -404,7 +490,9 @@ int32_t Log::GetMemlogSize()
     // lets check if we are Initialized in this context
     CheckLogger(Log::pLogger);
 
-    return static_cast<int32_t>(Log::pLogger->logDeque.size());
+    std::lock_guard<std::mutex> lock(Log::pLogger->memlog_lock_);
+
+    return static_cast<int32_t>(Log::pLogger->memlog_size_);
 }
 
 String Log::PeekMemlogFront()
@@ -412,14 +500,12 @@ String Log::PeekMemlogFront()
     // lets check if we are Initialized in this context
     CheckLogger(Log::pLogger);
 
-    if (Log::pLogger->logDeque.size() <= 0) return nullptr;
+    std::lock_guard<std::mutex> lock(Log::pLogger->memlog_lock_);
 
-    if (nullptr != Log::pLogger->logDeque.front())
-        ;  // check for null
-    else
-        OT_FAIL;
+    if (Log::pLogger->memlog_size_ <= 0) return nullptr;
 
-    const String strLogEntry = *Log::pLogger->logDeque.front();
+    const String strLogEntry =
+        Log::pLogger->memlog_[Log::pLogger->memlog_index(0)].c_str();
 
     if (strLogEntry.Exists())
         return strLogEntry;
@@ -432,14 +518,15 @@ String Log::PeekMemlogBack()
     // lets check if we are Initialized in this context
     CheckLogger(Log::pLogger);
 
-    if (Log::pLogger->logDeque.size() <= 0) return nullptr;
+    std::lock_guard<std::mutex> lock(Log::pLogger->memlog_lock_);
 
-    if (nullptr != Log::pLogger->logDeque.back())
-        ;  // check for null
-    else
-        OT_FAIL;
+    if (Log::pLogger->memlog_size_ <= 0) return nullptr;
 
-    const String strLogEntry = *Log::pLogger->logDeque.back();
+    const String strLogEntry =
+        Log::pLogger
+            ->memlog_[Log::pLogger->memlog_index(
+                Log::pLogger->memlog_size_ - 1)]
+            .c_str();
 
     if (strLogEntry.Exists())
         return strLogEntry;
@@ -453,13 +540,12 @@ bool Log::PopMemlogFront()
     // lets check if we are Initialized in this context
     CheckLogger(Log::pLogger);
 
-    if (Log::pLogger->logDeque.size() <= 0) return false;
+    std::lock_guard<std::mutex> lock(Log::pLogger->memlog_lock_);
 
-    String* strLogFront = Log::pLogger->logDeque.front();
-    if (nullptr != strLogFront) delete strLogFront;
-    strLogFront = nullptr;
+    if (Log::pLogger->memlog_size_ <= 0) return false;
 
-    Log::pLogger->logDeque.pop_front();
+    Log::pLogger->memlog_head_ = Log::pLogger->memlog_index(1);
+    --Log::pLogger->memlog_size_;
 
     return true;
 }
@@ -470,13 +556,11 @@ bool Log::PopMemlogBack()
     // lets check if we are Initialized in this context
     CheckLogger(Log::pLogger);
 
-    if (Log::pLogger->logDeque.size() <= 0) return false;
+    std::lock_guard<std::mutex> lock(Log::pLogger->memlog_lock_);
 
-    String* strLogBack = Log::pLogger->logDeque.back();
-    if (nullptr != strLogBack) delete strLogBack;
-    strLogBack = nullptr;
+    if (Log::pLogger->memlog_size_ <= 0) return false;
 
-    Log::pLogger->logDeque.pop_back();
+    --Log::pLogger->memlog_size_;
 
     return true;
 }
@@ -489,16 +573,151 @@ bool Log::PushMemlogFront(const String& strLog)
 
     OT_ASSERT(strLog.Exists());
 
-    Log::pLogger->logDeque.push_front(new String(strLog));
+    std::lock_guard<std::mutex> lock(Log::pLogger->memlog_lock_);
+    auto& memlog = Log::pLogger->memlog_;
+
+    // The slot before the head is the back when the ring is full, so the
+    // oldest entry is overwritten in place.
+    Log::pLogger->memlog_head_ =
+        Log::pLogger->memlog_index(memlog.size() - 1);
+    memlog[Log::pLogger->memlog_head_].assign(strLog.Get());
 
-    if (Log::pLogger->logDeque.size() > LOG_DEQUE_SIZE) {
-        Log::PopMemlogBack();  // We start removing from the back when it
-                               // reaches this size.
+    if (Log::pLogger->memlog_size_ < memlog.size()) {
+        ++Log::pLogger->memlog_size_;
     }
 
     return true;
 }
 
+std::size_t Log::memlog_index(std::size_t position) const
+{
+    return (memlog_head_ + position) % memlog_.size();
+}
+
+void Log::enqueue(const char* text)
+{
+    auto line = new LogLine;
+    line->text_ = text;
+    line->next_ = pending_.load();
+
+    while (!pending_.compare_exchange_weak(line->next_, line)) {
+    }
+
+    // Not taking signal_lock_ keeps logging lock-free. A missed wakeup only
+    // delays the line until the writer's next timeout.
+    signal_.notify_one();
+}
+
+void Log::start_writer()
+{
+    if (write_log_file_ && m_strLogFilePath.Exists()) {
+        log_file_.open(m_strLogFilePath.Get(), std::ios::app);
+
+        if (log_file_.fail()) {
+            std::cerr << "Log::" << __FUNCTION__
+                      << ": Unable to open log file " << m_strLogFilePath
+                      << std::endl;
+        }
+    }
+
+    running_.store(true);
+    writer_.reset(new std::thread(&Log::writer, this));
+}
+
+void Log::stop_writer()
+{
+    running_.store(false);
+
+    // A thread which saw running_ before it was cleared may still be
+    // pushing its line, so let it finish before the last flush.
+    while (0 < producers_.load()) {
+        std::this_thread::yield();
+    }
+
+    {
+        // Taking the lock makes sure the writer does not miss the signal
+        std::lock_guard<std::mutex> lock(signal_lock_);
+    }
+
+    signal_.notify_all();
+
+    if (writer_) {
+        writer_->join();
+        writer_.reset();
+    }
+
+    write_pending();
+}
+
+bool Log::try_enqueue(const String& text)
+{
+    ++producers_;
+    const bool running = running_.load();
+
+    if (running && text.Exists()) {
+        enqueue(text.Get());
+    }
+
+    --producers_;
+
+    return running;
+}
+
+void Log::write_pending()
+{
+    std::lock_guard<std::mutex> lock(writer_lock_);
+    LogLine* line = pending_.exchange(nullptr);
+    LogLine* ordered = nullptr;
+
+    // The queue is newest first
+    while (nullptr != line) {
+        LogLine* next = line->next_;
+        line->next_ = ordered;
+        ordered = line;
+        line = next;
+    }
+
+    if (nullptr == ordered) {
+        return;
+    }
+
+    const bool toFile = log_file_.is_open() && log_file_.good();
+
+    while (nullptr != ordered) {
+        std::unique_ptr<LogLine> done(ordered);
+        ordered = done->next_;
+        std::cerr << done->text_;
+
+        if (toFile) {
+            log_file_ << done->text_;
+        }
+    }
+
+    std::cerr.flush();
+
+    if (toFile) {
+        log_file_.flush();
+    }
+}
+
+void Log::writer()
+{
+    while (running_.load()) {
+        {
+            std::unique_lock<std::mutex> lock(signal_lock_);
+            signal_.wait_for(
+                lock,
+                std::chrono::milliseconds(LOG_WRITER_INTERVAL),
+                [this]() -> bool {
+                    return (false == running_.load()) ||
+                           (nullptr != pending_.load());
+                });
+        }
+
+        write_pending();
+    }
+}
+
 // static
 bool Log::Sleep(const std::chrono::microseconds us)
 {
@@ -527,6 +746,11 @@ size_t Log::logAssert(
         LogToFile(szMessage);
         LogToFile("\n");
 
+        // The process is about to stop, so don't leave it to the writer
+        if (IsInitialized()) {
+            pLogger->write_pending();
+        }
+
 #else  // if Android
         __android_log_write(
             ANDROID_LOG_FATAL, "OT Assert (or Fail)", szMessage);
@@ -547,6 +771,10 @@ size_t Log::logAssert(
             nLinenumber);
         LogToFile(strTemp.Get());
 
+        if (IsInitialized()) {
+            pLogger->write_pending();
+        }
+
 #else  // if Android
         String strAndroidAssertMsg;
         strAndroidAssertMsg.Format(
@@ -130,6 +130,8 @@
 #define REQUEST_ADMIN_RESPONSE "requestAdminResponse"
 #define ADD_CLAIM "addClaim"
 #define ADD_CLAIM_RESPONSE "addClaimResponse"
+#define GET_STATISTICS "getStatistics"
+#define GET_STATISTICS_RESPONSE "getStatisticsResponse"
 
 // PROTOCOL DOCUMENT
 
@@ -211,6 +213,8 @@ const Message::TypeMap Message::message_names_{
     {MessageType::requestAdminR, REQUEST_ADMIN_RESPONSE},
     {MessageType::addClaim, ADD_CLAIM},
     {MessageType::addClaimR, ADD_CLAIM_RESPONSE},
+    {MessageType::getStatistics, GET_STATISTICS},
+    {MessageType::getStatisticsR, GET_STATISTICS_RESPONSE},
 };
 
 const std::map<MessageType, MessageType> Message::reply_message_{
@@ -247,6 +251,7 @@ const std::map<MessageType, MessageType> Message::reply_message_{
     {MessageType::registerContract, MessageType::registerContractR},
     {MessageType::requestAdmin, MessageType::requestAdminR},
     {MessageType::addClaim, MessageType::addClaimR},
+    {MessageType::getStatistics, MessageType::getStatisticsR},
 };
 
 const Message::ReverseTypeMap Message::message_types_ = make_reverse_map();
@@ -3295,6 +3300,15 @@ public:
         pTag->add_attribute("notaryID", m.m_strNotaryID.Get());
         pTag->add_attribute("accountID", m.m_strAcctID.Get());
 
+        // The hashes of the boxes the client already has, if any. The server
+        // leaves those boxes out of the reply if they haven't changed.
+        if (m.m_strInboxHash.Exists()) {
+            pTag->add_attribute("inboxHash", m.m_strInboxHash.Get());
+        }
+        if (m.m_strOutboxHash.Exists()) {
+            pTag->add_attribute("outboxHash", m.m_strOutboxHash.Get());
+        }
+
         parent.add_tag(pTag);
     }
 
@@ -3305,6 +3319,8 @@ public:
         m.m_strNotaryID = xml->getAttributeValue("notaryID");
         m.m_strAcctID = xml->getAttributeValue("accountID");
         m.m_strRequestNum = xml->getAttributeValue("requestNum");
+        m.m_strInboxHash = xml->getAttributeValue("inboxHash");
+        m.m_strOutboxHash = xml->getAttributeValue("outboxHash");
 
         otWarn << "\nCommand: " << m.m_strCommand
                << "\nNymID:    " << m.m_strNymID
@@ -3340,6 +3356,12 @@ public:
         }
 
         if (m.m_bSuccess) {
+            // A box is left out when the client already has that version.
+            pTag->add_attribute(
+                "inboxUnchanged", formatBool(!m.m_ascPayload2.GetLength()));
+            pTag->add_attribute(
+                "outboxUnchanged", formatBool(!m.m_ascPayload3.GetLength()));
+
             if (m.m_ascPayload.GetLength()) {
                 pTag->add_tag("account", m.m_ascPayload.Get());
             }
@@ -3365,6 +3387,10 @@ public:
         m.m_strAcctID = xml->getAttributeValue("accountID");
         m.m_strInboxHash = xml->getAttributeValue("inboxHash");
         m.m_strOutboxHash = xml->getAttributeValue("outboxHash");
+        const String strInboxUnchanged =
+            xml->getAttributeValue("inboxUnchanged");
+        const String strOutboxUnchanged =
+            xml->getAttributeValue("outboxUnchanged");
 
         if (m.m_bSuccess) {
             if (!Contract::LoadEncodedTextFieldByName(
@@ -3375,7 +3401,8 @@ public:
                 return (-1);  // error condition
             }
 
-            if (!Contract::LoadEncodedTextFieldByName(
+            if (!strInboxUnchanged.Compare("true") &&
+                !Contract::LoadEncodedTextFieldByName(
                     xml, m.m_ascPayload2, "inbox")) {
                 otErr << "Error in OTMessage::ProcessXMLNode: Expected inbox"
                       << " element with text field, for " << m.m_strCommand
@@ -3383,7 +3410,8 @@ public:
                 return (-1);  // error condition
             }
 
-            if (!Contract::LoadEncodedTextFieldByName(
+            if (!strOutboxUnchanged.Compare("true") &&
+                !Contract::LoadEncodedTextFieldByName(
                     xml, m.m_ascPayload3, "outbox")) {
                 otErr << "Error in OTMessage::ProcessXMLNode: Expected outbox"
                       << " element with text field, for " << m.m_strCommand
@@ -4353,4 +4381,95 @@ public:
 RegisterStrategy StrategyAddClaimResponse::reg(
     "addClaimResponse",
     new StrategyAddClaimResponse());
+
+class StrategyGetStatistics : public OTMessageStrategy
+{
+public:
+    virtual void writeXml(Message& m, Tag& parent)
+    {
+        TagPtr pTag(new Tag(m.m_strCommand.Get()));
+
+        pTag->add_attribute("requestNum", m.m_strRequestNum.Get());
+        pTag->add_attribute("nymID", m.m_strNymID.Get());
+        pTag->add_attribute("notaryID", m.m_strNotaryID.Get());
+
+        parent.add_tag(pTag);
+    }
+
+    virtual int32_t processXml(Message& m, irr::io::IrrXMLReader*& xml)
+    {
+        m.m_strCommand = xml->getNodeName();  // Command
+        m.m_strNymID = xml->getAttributeValue("nymID");
+        m.m_strNotaryID = xml->getAttributeValue("notaryID");
+        m.m_strRequestNum = xml->getAttributeValue("requestNum");
+
+        otWarn << "\nCommand: " << m.m_strCommand
+               << "\nNymID:    " << m.m_strNymID
+               << "\nNotaryID: " << m.m_strNotaryID
+               << "\nRequest #: " << m.m_strRequestNum << "\n";
+
+        return 1;
+    }
+    static RegisterStrategy reg;
+};
+RegisterStrategy StrategyGetStatistics::reg(
+    "getStatistics",
+    new StrategyGetStatistics());
+
+class StrategyGetStatisticsResponse : public OTMessageStrategy
+{
+public:
+    virtual void writeXml(Message& m, Tag& parent)
+    {
+        TagPtr pTag(new Tag(m.m_strCommand.Get()));
+
+        pTag->add_attribute("success", formatBool(m.m_bSuccess));
+        pTag->add_attribute("requestNum", m.m_strRequestNum.Get());
+        pTag->add_attribute("nymID", m.m_strNymID.Get());
+        pTag->add_attribute("notaryID", m.m_strNotaryID.Get());
+
+        if (m.m_bSuccess && (m.m_ascPayload.GetLength() > 2)) {
+            pTag->add_tag("messagePayload", m.m_ascPayload.Get());
+        } else if (!m.m_bSuccess && (m.m_ascInReferenceTo.GetLength() > 2)) {
+            pTag->add_tag("inReferenceTo", m.m_ascInReferenceTo.Get());
+        }
+
+        parent.add_tag(pTag);
+    }
+
+    virtual int32_t processXml(Message& m, irr::io::IrrXMLReader*& xml)
+    {
+        processXmlSuccess(m, xml);
+
+        m.m_strCommand = xml->getNodeName();  // Command
+        m.m_strRequestNum = xml->getAttributeValue("requestNum");
+        m.m_strNymID = xml->getAttributeValue("nymID");
+        m.m_strNotaryID = xml->getAttributeValue("notaryID");
+
+        const char* pElementExpected =
+            m.m_bSuccess ? "messagePayload" : "inReferenceTo";
+        OTASCIIArmor& ascTextExpected =
+            m.m_bSuccess ? m.m_ascPayload : m.m_ascInReferenceTo;
+
+        if (!Contract::LoadEncodedTextFieldByName(
+                xml, ascTextExpected, pElementExpected)) {
+            otErr << "Error in StrategyGetStatisticsResponse: "
+                     "Expected "
+                  << pElementExpected << " element with text field, for "
+                  << m.m_strCommand << ".\n";
+            return (-1);  // error condition
+        }
+
+        otWarn << "\nCommand: " << m.m_strCommand << "  "
+               << (m.m_bSuccess ? "SUCCESS" : "FAILED")
+               << "\nNymID:    " << m.m_strNymID
+               << "\nNotaryID: " << m.m_strNotaryID << "\n\n";
+
+        return 1;
+    }
+    static RegisterStrategy reg;
+};
+RegisterStrategy StrategyGetStatisticsResponse::reg(
+    "getStatisticsResponse",
+    new StrategyGetStatisticsResponse());
 }  // namespace opentxs
@@ -50,6 +50,7 @@
 #include "opentxs/core/crypto/Bip39.hpp"
 #endif
 #include "opentxs/core/crypto/Credential.hpp"
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 #include "opentxs/core/crypto/NymParameters.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/crypto/OTPassword.hpp"
@@ -2774,6 +2775,10 @@ bool Nym::VerifyPseudonym() const
 {
     // If there are credentials, then we verify the Nym via his credentials.
     if (!m_mapCredentialSets.empty()) {
+        // The signatures from every credential in every set are collected
+        // first and checked together at the end.
+        CryptoAsymmetric::VerificationBatch batch;
+
         // Verify Nym by his own credentials.
         for (const auto& it : m_mapCredentialSets) {
             const CredentialSet* pCredential = it.second;
@@ -2791,13 +2796,23 @@ bool Nym::VerifyPseudonym() const
 
             // Verify all Credentials in the CredentialSet, including source
             // verification for the master credential.
-            if (!pCredential->VerifyInternally()) {
+            if (!pCredential->VerifyInternally(batch)) {
                 otOut << __FUNCTION__ << ": Credential ("
                       << pCredential->GetMasterCredID()
                       << ") failed its own internal verification." << std::endl;
                 return false;
             }
         }
+
+        if (!CryptoAsymmetric::BatchVerify(batch)) {
+            String strNymID;
+            GetIdentifier(strNymID);
+            otOut << __FUNCTION__ << ": Credential signatures for Nym "
+                  << strNymID << " failed verification." << std::endl;
+
+            return false;
+        }
+
         return true;
     }
     otErr << "No credentials.\n";
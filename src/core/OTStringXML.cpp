@@ -44,6 +44,8 @@
 
 #include <irrxml/irrXML.hpp>
 
+#include <cstring>
+
 namespace opentxs
 {
 
@@ -116,15 +118,19 @@ OTStringXML::operator irr::io::IFileReadCallBack*()
 int32_t OTStringXML::read(void* buffer, uint32_t sizeToRead)
 {
     if (buffer && sizeToRead && Exists()) {
-        char* pBuf = static_cast<char*>(buffer);
-
-        int32_t nBytesToCopy =
-            (sizeToRead > GetLength() ? GetLength() : sizeToRead);
-        int32_t i;
-        for (i = 0; i < nBytesToCopy; i++) {
-            pBuf[i] = sgetc();
+        // Hand the reader the remaining bytes in one block instead of one
+        // sgetc() at a time.
+        const uint32_t remaining =
+            (position_ < length_) ? (length_ - position_) : 0;
+        const uint32_t nBytesToCopy =
+            (sizeToRead > remaining ? remaining : sizeToRead);
+
+        if (0 < nBytesToCopy) {
+            std::memcpy(buffer, data_ + position_, nBytesToCopy);
+            position_ += nBytesToCopy;
         }
-        return i;
+
+        return static_cast<int32_t>(nBytesToCopy);
     }
     else {
         return 0;
@@ -2140,10 +2140,10 @@ bool OTTransaction::VerifyBalanceReceipt(
                                             // and thus isn't figured in here.
             break;
         default: {
-            otLog4 << "OTTransaction::" << __FUNCTION__ << ": Ignoring "
-                   << pTransaction->GetTypeString()
-                   << " item in inbox while verifying it against balance "
-                      "receipt.\n";
+            OT_LOG(otLog4) << "OTTransaction::" << __FUNCTION__ << ": Ignoring "
+                           << pTransaction->GetTypeString()
+                           << " item in inbox while verifying it against "
+                              "balance receipt.\n";
         }
             continue;
         }
@@ -2845,6 +2845,8 @@ bool OTTransaction::VerifyItems(Nym& theNym)
     // if pointer not null, and it's a withdrawal, and it's an acknowledgement
     // (not a rejection or error)
     //
+    std::vector<const Contract*> items;
+
     for (auto& it : GetItemList()) {
         // loop through the ALL items that make up this transaction and check
         // to see if a response to deposit.
@@ -2855,16 +2857,12 @@ bool OTTransaction::VerifyItems(Nym& theNym)
 
         if (NYM_ID != pItem->GetNymID()) return false;
 
-        if (!pItem->VerifySignature(theNym)) // NO need to call
-                                             // VerifyAccount since
-                                             // VerifyContractID is
-                                             // ALREADY called and now
-                                             // here's
-                                             // VerifySignature().
-            return false;
+        items.push_back(pItem);
     }
 
-    return true;
+    // NO need to call VerifyAccount since VerifyContractID is ALREADY called.
+    // The item signatures are independent, so they're checked as one batch.
+    return Contract::VerifySignatures(items, theNym);
 }
 
 /*
@@ -4091,7 +4089,7 @@ void OTTransaction::UpdateContents()
     std::string str_result;
     tag.output(str_result);
 
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    m_xmlUnsigned.Set(str_result.c_str());
 }
 
 /*
@@ -4950,8 +4948,8 @@ void OTTransaction::ProduceInboxReportItem(Item& theBalanceItem)
 {
     Item::itemType theItemType = Item::error_state;
 
-    otLog3 << "Producing statement report item for inbox item type: "
-           << GetTypeString() << ".\n"; // temp remove.
+    OT_LOG(otLog3) << "Producing statement report item for inbox item type: "
+                   << GetTypeString() << ".\n"; // temp remove.
 
     switch (m_Type) { // These are the types that have an amount (somehow)
     case OTTransaction::pending: // the amount is stored on the transfer item in
@@ -4990,10 +4988,10 @@ void OTTransaction::ProduceInboxReportItem(Item& theBalanceItem)
         break;
     default: // All other types are irrelevant for inbox reports
     {
-        otLog3 << "OTTransaction::ProduceInboxReportItem: Ignoring "
-               << GetTypeString()
-               << " transaction "
-                  "in inbox while making balance statement.\n";
+        OT_LOG(otLog3) << "OTTransaction::ProduceInboxReportItem: Ignoring "
+                       << GetTypeString()
+                       << " transaction "
+                          "in inbox while making balance statement.\n";
     }
         return;
     } // why not transfer receipt? Because the amount was already removed from
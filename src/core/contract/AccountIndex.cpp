@@ -0,0 +1,399 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/core/stdafx.hpp"
+
+#include "opentxs/core/contract/AccountIndex.hpp"
+
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/OTStorage.hpp"
+
+#include <vector>
+
+// Number of IDs copied out of the index at a time by Visit
+#define OT_ACCOUNT_INDEX_VISIT_BATCH 1024
+// Obsolete lines allowed in the log before it is rewritten
+#define OT_ACCOUNT_INDEX_SLACK 1024
+
+#define OT_METHOD "opentxs::AccountIndex::"
+
+namespace opentxs
+{
+std::mutex AccountIndex::map_lock_{};
+std::map<std::string, std::weak_ptr<AccountIndex>> AccountIndex::map_{};
+
+AccountIndex::AccountIndex(const std::string& unitID)
+    : unit_id_(unitID)
+    , file_(unitID + ".ai")
+    , lock_()
+    , accounts_()
+    , log_(nullptr)
+    , loaded_(false)
+{
+    Lock lock(lock_);
+    loaded_ = load(lock);
+}
+
+bool AccountIndex::Add(const std::string& accountID)
+{
+    Lock lock(lock_);
+
+    if (false == loaded_) {
+
+        return false;
+    }
+
+    if (0 < accounts_.count(accountID)) {
+
+        return true;
+    }
+
+    if (false == append(lock, '+', accountID)) {
+
+        return false;
+    }
+
+    accounts_.insert(accountID);
+
+    return true;
+}
+
+bool AccountIndex::append(
+    const Lock& lock,
+    const char op,
+    const std::string& accountID)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    if ((false == open(lock)) || (false == log_->Append(op + accountID))) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write account "
+              << "index for unit " << unit_id_ << std::endl;
+
+        return false;
+    }
+
+    if ((2 * accounts_.size() + OT_ACCOUNT_INDEX_SLACK) < log_->Size()) {
+        compact(lock);
+    }
+
+    return true;
+}
+
+// Rewrites the log with one line per account
+bool AccountIndex::compact(const Lock& lock)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    std::vector<std::string> records{};
+
+    for (const auto& account : accounts_) {
+        records.push_back('+' + account);
+    }
+
+    if ((false == open(lock)) || (false == log_->Rewrite(records))) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to rewrite account "
+              << "index for unit " << unit_id_ << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool AccountIndex::Erase(const std::string& accountID)
+{
+    Lock lock(lock_);
+
+    if (false == loaded_) {
+
+        return false;
+    }
+
+    if (0 == accounts_.count(accountID)) {
+
+        return true;
+    }
+
+    if (false == append(lock, '-', accountID)) {
+
+        return false;
+    }
+
+    accounts_.erase(accountID);
+
+    return true;
+}
+
+bool AccountIndex::Exists(const std::string& accountID) const
+{
+    Lock lock(lock_);
+
+    return (0 < accounts_.count(accountID));
+}
+
+std::shared_ptr<AccountIndex> AccountIndex::Get(const std::string& unitID)
+{
+    Lock lock(map_lock_);
+    auto& weak = map_[unitID];
+    auto output = weak.lock();
+
+    if (!output) {
+        output.reset(new AccountIndex(unitID));
+        weak = output;
+    }
+
+    return output;
+}
+
+// Reads the account records file which was used before the index.
+bool AccountIndex::import_records(const Lock& lock)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    const std::string records = unit_id_ + ".a";
+
+    if (false == OTDB::Exists(OTFolders::Contract().Get(), records)) {
+
+        return false;
+    }
+
+    std::unique_ptr<OTDB::Storable> pStorable(OTDB::QueryObject(
+        OTDB::STORED_OBJ_STRING_MAP, OTFolders::Contract().Get(), records));
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    if (nullptr == pMap) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to load account "
+              << "records for unit " << unit_id_ << std::endl;
+
+        return false;
+    }
+
+    for (const auto& it : pMap->the_map) {
+        if (unit_id_ != it.second) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Error: wrong instrument "
+                  << "definition ID (" << it.second << ") when expecting: "
+                  << unit_id_ << std::endl;
+
+            continue;
+        }
+
+        accounts_.insert(it.first);
+    }
+
+    otWarn << OT_METHOD << __FUNCTION__ << ": Imported " << accounts_.size()
+           << " account records for unit " << unit_id_ << std::endl;
+
+    return true;
+}
+
+// Returns false, with the index empty and its files as they were, unless every
+// record was read. A partial index must never be compacted, since that would
+// drop the records after the failure from the log for good.
+bool AccountIndex::load(const Lock& lock)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    if (false == OTDB::Exists(OTFolders::Contract().Get(), file_)) {
+        const std::string records = unit_id_ + ".a";
+
+        if (false == OTDB::Exists(OTFolders::Contract().Get(), records)) {
+
+            return true;
+        }
+
+        if ((false == import_records(lock)) || (false == compact(lock))) {
+            // Leave the records file to be imported again next time.
+            log_.reset();
+            accounts_.clear();
+            OTDB::EraseValueByKey(OTFolders::Contract().Get(), file_);
+
+            return false;
+        }
+
+        OTDB::EraseValueByKey(OTFolders::Contract().Get(), records);
+
+        return true;
+    }
+
+    if (false == open(lock)) {
+
+        return false;
+    }
+
+    const bool read = log_->Read([&](const std::string& line) -> bool {
+        if (2 > line.size()) {
+
+            return true;
+        }
+
+        const auto account = line.substr(1);
+
+        switch (line[0]) {
+            case '+': {
+                accounts_.insert(account);
+            } break;
+            case '-': {
+                accounts_.erase(account);
+            } break;
+            default: {
+                otErr << OT_METHOD << __FUNCTION__ << ": Invalid line in "
+                      << "account index for unit " << unit_id_ << std::endl;
+
+                return false;
+            }
+        }
+
+        return true;
+    });
+
+    if (false == read) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to read account "
+              << "index for unit " << unit_id_ << ". The file is left as it "
+              << "is." << std::endl;
+        log_.reset();
+        accounts_.clear();
+    }
+
+    return read;
+}
+
+bool AccountIndex::Loaded() const
+{
+    Lock lock(lock_);
+
+    return loaded_;
+}
+
+bool AccountIndex::open(const Lock& lock)
+{
+    OT_ASSERT(lock.owns_lock());
+
+    if (log_) {
+
+        return true;
+    }
+
+    std::string file{};
+
+    // StorePlainString creates the folder, and an empty log, for the first
+    // account of the unit
+    if ((false == OTDB::Exists(OTFolders::Contract().Get(), file_)) &&
+        (false ==
+         OTDB::StorePlainString("", OTFolders::Contract().Get(), file_))) {
+
+        return false;
+    }
+
+    if (false == path(file)) {
+
+        return false;
+    }
+
+    log_.reset(new Journal(file));
+
+    OT_ASSERT(log_);
+
+    return true;
+}
+
+bool AccountIndex::path(std::string& output) const
+{
+    const auto result =
+        OTDB::FormPathString(output, OTFolders::Contract().Get(), file_);
+
+    if (0 > result) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid path for account "
+              << "index for unit " << unit_id_ << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+std::size_t AccountIndex::Size() const
+{
+    Lock lock(lock_);
+
+    return accounts_.size();
+}
+
+bool AccountIndex::Visit(
+    const std::function<bool(const std::string&)>& visitor,
+    const std::string& afterAccountID) const
+{
+    if (false == Loaded()) {
+
+        return false;
+    }
+
+    std::vector<std::string> batch{};
+    std::string last = afterAccountID;
+
+    while (true) {
+        batch.clear();
+
+        {
+            Lock lock(lock_);
+            auto it = last.empty() ? accounts_.begin()
+                                   : accounts_.upper_bound(last);
+
+            while ((accounts_.end() != it) &&
+                   (OT_ACCOUNT_INDEX_VISIT_BATCH > batch.size())) {
+                batch.push_back(*it++);
+            }
+        }
+
+        if (batch.empty()) {
+
+            return true;
+        }
+
+        for (const auto& account : batch) {
+            if (false == visitor(account)) {
+
+                return true;
+            }
+        }
+
+        last = batch.back();
+    }
+}
+}  // namespace opentxs
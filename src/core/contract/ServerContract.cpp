@@ -394,10 +394,21 @@ bool ServerContract::verify_signature(
         return false;
     }
 
+    if (verified(lock, signature)) {
+
+        return true;
+    }
+
     auto serialized = SigVersion(lock);
     auto& sigProto = *serialized.mutable_signature();
     sigProto.CopyFrom(signature);
 
-    return nym_->VerifyProto(serialized, sigProto);
+    const bool valid = nym_->VerifyProto(serialized, sigProto);
+
+    if (valid) {
+        set_verified(lock, signature);
+    }
+
+    return valid;
 }
 }  // namespace opentxs
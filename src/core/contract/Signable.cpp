@@ -40,6 +40,7 @@
 
 #include "opentxs/core/contract/Signable.hpp"
 
+#include "opentxs/core/crypto/SignatureMemo.hpp"
 #include "opentxs/core/Log.hpp"
 
 namespace opentxs
@@ -155,6 +156,41 @@ bool Signable::verify_write_lock(const Lock& lock) const
     return true;
 }
 
+bool Signable::verified(
+    const Lock& lock,
+    const proto::Signature& signature) const
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    // The signed form includes id_, so it only identifies the contents if it
+    // was calculated from them.
+    if (!CheckID(lock)) {
+
+        return false;
+    }
+
+    Identifier signatureID;
+    signatureID.CalculateDigest(proto::ProtoAsData(signature));
+
+    return SignatureMemo::Check(id_, signatureID);
+}
+
+void Signable::set_verified(
+    const Lock& lock,
+    const proto::Signature& signature) const
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    if (!CheckID(lock)) {
+
+        return;
+    }
+
+    Identifier signatureID;
+    signatureID.CalculateDigest(proto::ProtoAsData(signature));
+    SignatureMemo::Insert(id_, signatureID);
+}
+
 bool Signable::verify_signature(
     const Lock& lock,
     const proto::Signature&) const
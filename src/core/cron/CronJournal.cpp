@@ -0,0 +1,266 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/core/stdafx.hpp"
+
+#include "opentxs/core/cron/CronJournal.hpp"
+
+#include "opentxs/api/OT.hpp"
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
+#include "opentxs/core/crypto/CryptoEncodingEngine.hpp"
+#include "opentxs/core/crypto/CryptoEngine.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/OTStorage.hpp"
+
+#include <vector>
+
+#define OT_METHOD "opentxs::CronJournal::"
+
+namespace opentxs
+{
+CronJournal::CronJournal(
+    const std::string& folder,
+    const std::string& file,
+    const Nym& signer)
+    : folder_(folder)
+    , file_(file)
+    , signer_(signer)
+    , log_(nullptr)
+{
+}
+
+bool CronJournal::Append(
+    const std::int64_t generation,
+    const std::string& record)
+{
+    const std::string line = std::to_string(generation) + ' ' + record;
+    std::string signature{};
+
+    if (false == sign(line, signature)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to sign record for "
+              << file_ << std::endl;
+
+        return false;
+    }
+
+    if ((false == open()) || (false == log_->Append(line + ' ' + signature))) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write " << file_
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool CronJournal::Clear()
+{
+    if ((false == open()) || (false == log_->Rewrite({}))) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to clear " << file_
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool CronJournal::open()
+{
+    if (log_) {
+
+        return true;
+    }
+
+    std::string file{};
+
+    // StorePlainString creates the folder, and an empty journal, before the
+    // first record
+    if ((false == OTDB::Exists(folder_, file_)) &&
+        (false == OTDB::StorePlainString("", folder_, file_))) {
+
+        return false;
+    }
+
+    if (false == path(file)) {
+
+        return false;
+    }
+
+    log_.reset(new Journal(file));
+
+    OT_ASSERT(log_);
+
+    return true;
+}
+
+bool CronJournal::path(std::string& output) const
+{
+    if (0 > OTDB::FormPathString(output, folder_, file_)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid path for " << file_
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool CronJournal::Replay(
+    const std::int64_t generation,
+    const Replayer& replayer)
+{
+    if (false == OTDB::Exists(folder_, file_)) {
+
+        return true;
+    }
+
+    if (false == open()) {
+
+        return false;
+    }
+
+    std::size_t records{0};
+    bool output = log_->Read([&](const std::string& record) -> bool {
+        ++records;
+        const auto first = record.find(' ');
+        const auto last = record.rfind(' ');
+        std::int64_t lineGeneration{-1};
+
+        try {
+            lineGeneration = std::stoll(record.substr(0, first));
+        } catch (...) {
+        }
+
+        if ((std::string::npos == first) || (first == last) ||
+            (0 > lineGeneration)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Invalid line " << records
+                  << " in " << file_ << std::endl;
+
+            return false;
+        }
+
+        if (generation != lineGeneration) {
+
+            return true;
+        }
+
+        const auto line = record.substr(0, last);
+
+        if (false == verify(line, record.substr(last + 1))) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Bad signature on line "
+                  << records << " of " << file_ << std::endl;
+
+            return false;
+        }
+
+        if (false == replayer(line.substr(first + 1))) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to replay record "
+                  << records << " of " << file_ << std::endl;
+
+            return false;
+        }
+
+        return true;
+    });
+
+    if (false == output) {
+        const std::string failed = file_ + ".failed";
+        const auto contents = OTDB::QueryPlainString(folder_, file_);
+
+        if ((false == contents.empty()) &&
+            OTDB::StorePlainString(contents, folder_, failed)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Kept a copy of "
+                  << file_ << " as " << failed << std::endl;
+        } else {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to keep a copy of "
+                  << file_ << std::endl;
+        }
+    }
+
+    return output;
+}
+
+bool CronJournal::sign(const std::string& line, std::string& signature) const
+{
+    const auto& key = signer_.GetPrivateSignKey();
+    const Data plaintext(line.data(), line.size());
+    Data output{};
+
+    if (false ==
+        key.engine().Sign(plaintext, key, key.SigHashType(), output)) {
+
+        return false;
+    }
+
+    signature = OT::App().Crypto().Encode().DataEncode(output);
+
+    return true;
+}
+
+std::size_t CronJournal::Size()
+{
+    if (false == open()) {
+
+        return 0;
+    }
+
+    return log_->Size();
+}
+
+bool CronJournal::verify(
+    const std::string& line,
+    const std::string& signature) const
+{
+    const auto& key = signer_.GetPublicSignKey();
+    const Data plaintext(line.data(), line.size());
+    const auto decoded = OT::App().Crypto().Encode().DataDecode(signature);
+    const Data sig(decoded.data(), decoded.size());
+
+    if (0 == sig.GetSize()) {
+
+        return false;
+    }
+
+    return CryptoAsymmetric::VerifyMemoized(
+        plaintext, key, sig, key.SigHashType());
+}
+}  // namespace opentxs
@@ -63,6 +63,7 @@
 #include <map>
 #include <memory>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -82,6 +83,9 @@ int32_t OTCron::__cron_max_items_per_nym = 10; // The maximum number of cron
                                                // items any given Nym can have
                                                // active at the same time.
 
+int32_t OTCron::__cron_journal_records = 1000; // Changes journaled before the
+                                               // cron file is saved again.
+
 Timer OTCron::tCron(true);
 
 // Make sure Server Nym is set on this cron object before loading or saving,
@@ -94,10 +98,42 @@ bool OTCron::LoadCron()
 
     OT_ASSERT(nullptr != GetServerNym());
 
+    m_bJournalFailed = false;
+
     bool bSuccess = LoadContract(szFoldername, szFilename);
 
     if (bSuccess) bSuccess = VerifySignature(*(GetServerNym()));
 
+    if (bSuccess) {
+        // The numbers read from the file are not changes.
+        m_lNumbersTaken = 0;
+        m_listNumbersAdded.clear();
+
+        // A journal which can't be replayed in full is left in place, rather
+        // than being folded into a new snapshot and cleared.
+        if (!journal_file().Replay(
+                m_lJournalGeneration,
+                [this](const std::string& strRecord) -> bool {
+                    return replay(strRecord);
+                })) {
+            otErr << "OTCron::LoadCron: Failed replaying some of the changes "
+                     "journaled since the cron file was saved.\n";
+            m_bJournalFailed = true;
+        }
+    }
+
+    // Whatever was loaded or replayed before the failure is only part of the
+    // state, and must never be saved as a new snapshot.
+    if (m_bJournalFailed) {
+        Release_Cron();
+        return false;
+    }
+
+    if (bSuccess) {
+        // Start the next generation from everything that was replayed.
+        if (0 < journal_file().Size()) bSuccess = SaveCron();
+    }
+
     return bSuccess;
 }
 
@@ -110,22 +146,277 @@ bool OTCron::SaveCron()
 
     ReleaseSignatures();
 
+    // Records journaled until now are folded into this file, and will be
+    // skipped if they are still there when it is loaded.
+    m_lJournalGeneration++;
+
     // Sign it, save it internally to string, and then save that out to the
     // file.
     if (!SignContract(*m_pServerNym) || !SaveContract() ||
         !SaveContract(szFoldername, szFilename)) {
         otErr << "Error saving main Cronfile:\n" << szFoldername
               << Log::PathSeparator() << szFilename << "\n";
+        m_lJournalGeneration--;
         return false;
     }
-    else
-        return true;
+
+    m_lNumbersTaken = 0;
+    m_listNumbersAdded.clear();
+    journal_file().Clear();
+
+    return true;
+}
+
+bool OTCron::SaveCronItem(OTCronItem& theItem)
+{
+    if (nullptr == GetItemByOfficialNum(theItem.GetTransactionNum())) {
+        otErr << __FUNCTION__ << ": Item is not on Cron: "
+              << theItem.GetTransactionNum() << "\n";
+        return false;
+    }
+
+    const String strItem(theItem);
+    OTASCIIArmor ascItem;
+    ascItem.SetString(strItem, false); // linebreaks = false
+
+    return journal(
+        "update",
+        formatLong(theItem.GetTransactionNum()) + ' ' + ascItem.Get());
+}
+
+bool OTCron::SaveTransactionNumbers()
+{
+    if ((0 == m_lNumbersTaken) && m_listNumbersAdded.empty()) return true;
+
+    return journal("numbers", "");
+}
+
+CronJournal& OTCron::journal_file()
+{
+    OT_ASSERT(nullptr != GetServerNym());
+
+    if (!m_pJournal) {
+        m_pJournal.reset(new CronJournal(OTFolders::Cron().Get(),
+                                         "OT-CRON.jnl", // todo stop
+                                                        // hardcoding
+                                                        // filenames.
+                                         *GetServerNym()));
+    }
+
+    return *m_pJournal;
+}
+
+// Appends one change to the journal, along with the transaction numbers taken
+// and added since the previous one. Falls back to saving the whole cron file
+// when the journal is disabled, full, or can't be written, or if the cron
+// file has never been saved.
+bool OTCron::journal(const std::string& strType, const std::string& strArgs)
+{
+    if ((0 >= __cron_journal_records) ||
+        !OTDB::Exists(OTFolders::Cron().Get(), "OT-CRON.crn")) {
+        return SaveCron();
+    }
+
+    std::string strAdded;
+
+    for (auto& lTransactionNum : m_listNumbersAdded) {
+        if (!strAdded.empty()) strAdded += ',';
+
+        strAdded += formatLong(lTransactionNum);
+    }
+
+    if (strAdded.empty()) strAdded = "-";
+
+    std::string strRecord =
+        strType + ' ' + formatLong(m_lNumbersTaken) + ' ' + strAdded;
+
+    if (!strArgs.empty()) strRecord += ' ' + strArgs;
+
+    if (!journal_file().Append(m_lJournalGeneration, strRecord)) {
+        return SaveCron();
+    }
+
+    m_lNumbersTaken = 0;
+    m_listNumbersAdded.clear();
+
+    if (static_cast<std::size_t>(__cron_journal_records) <=
+        journal_file().Size()) {
+        return SaveCron();
+    }
+
+    return true;
+}
+
+// Adds an item which was already on Cron before the file was saved.
+bool OTCron::load_item(const String& strData, time64_t tDateAdded)
+{
+    OTCronItem* pItem = OTCronItem::NewCronItem(strData);
+
+    if (nullptr == pItem) {
+        otErr << "Unable to create cron item from data in cron file.\n";
+        return false;
+    }
+
+    // Why not do this here (when loading from storage), as well as when
+    // first adding the item to cron,
+    // and thus save myself the trouble of verifying the signature EVERY
+    // ITERATION of ProcessCron().
+    //
+    if (!pItem->VerifySignature(*m_pServerNym)) {
+        otErr << "OTCron::" << __FUNCTION__ << ": ERROR SECURITY: Server "
+                 "signature failed to "
+                 "verify on a cron item while loading: "
+              << pItem->GetTransactionNum() << "\n";
+        delete pItem;
+        pItem = nullptr;
+        return false;
+    }
+    else if (AddCronItem(*pItem, nullptr,
+                         false, // bSaveReceipt=false. The receipt is
+                                // only saved once: When item FIRST
+                                // added to cron...
+                         tDateAdded)) { // ...But here, the item was
+                                        // ALREADY in cron, and is
+                                        // merely being loaded from
+                                        // disk.
+        // Thus, it would be wrong to try to create the "original
+        // record" as if it were brand
+        // new and still had the user's signature on it. (Once added to
+        // Cron, the signatures are
+        // released and the SERVER signs it from there. That's why the
+        // user's version is saved
+        // as a receipt in the first place -- so we have a record of the
+        // user's authorization.)
+        otInfo << "Successfully loaded cron item and added to list.\n";
+    }
+    else {
+        otErr << "OTCron::" << __FUNCTION__ << ": Though loaded / verified "
+                 "successfully, "
+                 "unable to add cron item (from cron file) to cron "
+                 "list.\n";
+        delete pItem;
+        pItem = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+// Takes an item off Cron without running its removal hooks.
+bool OTCron::erase_item(int64_t lTransactionNum)
+{
+    auto it_map = FindItemOnMap(lTransactionNum);
+
+    if (m_mapCronItems.end() == it_map) return false;
+
+    auto it_multimap = FindItemOnMultimap(lTransactionNum);
+    OT_ASSERT(m_multimapCronItems.end() != it_multimap);
+
+    OTCronItem* pItem = it_map->second;
+    m_mapCronItems.erase(it_map);
+    m_multimapCronItems.erase(it_multimap);
+    delete pItem;
+
+    return true;
+}
+
+// Applies one journal record while loading. Removed items are simply dropped:
+// the side effects of removing them were saved when it happened.
+bool OTCron::replay(const std::string& strRecord)
+{
+    std::istringstream in(strRecord);
+    std::string strType, strAdded;
+    int64_t lTaken = 0;
+
+    in >> strType >> lTaken >> strAdded;
+
+    if (in.fail()) return false;
+
+    // Numbers are added at the back and taken from the front, so adding them
+    // first gives the same list whichever happened first.
+    if ("-" != strAdded) {
+        std::istringstream added(strAdded);
+        std::string strNumber;
+
+        while (std::getline(added, strNumber, ',')) {
+            m_listTransactionNumbers.push_back(
+                String::StringToLong(strNumber));
+        }
+    }
+
+    for (; (0 < lTaken) && !m_listTransactionNumbers.empty(); --lTaken) {
+        m_listTransactionNumbers.pop_front();
+    }
+
+    if ("numbers" == strType) return true;
+
+    if ("add" == strType) {
+        std::string strDateAdded, strArmored;
+        in >> strDateAdded >> strArmored;
+        const OTASCIIArmor ascItem(strArmored.c_str());
+        String strItem;
+
+        return !in.fail() && ascItem.GetString(strItem, false) &&
+               load_item(strItem, OTTimeGetTimeFromSeconds(
+                                      parseTimestamp(strDateAdded)));
+    }
+
+    int64_t lTransactionNum = 0;
+    in >> lTransactionNum;
+
+    if (in.fail()) return false;
+
+    if ("remove" == strType) return erase_item(lTransactionNum);
+
+    if ("update" == strType) {
+        std::string strArmored;
+        in >> strArmored;
+        const OTASCIIArmor ascItem(strArmored.c_str());
+        String strItem;
+        auto it_multimap = FindItemOnMultimap(lTransactionNum);
+
+        if (in.fail() || !ascItem.GetString(strItem, false)) return false;
+
+        // Items changed while being activated are updated before the record
+        // which adds them, and that record has the same state.
+        if (m_multimapCronItems.end() == it_multimap) return true;
+
+        const time64_t tDateAdded = it_multimap->first;
+
+        return erase_item(lTransactionNum) && load_item(strItem, tDateAdded);
+    }
+
+    return false;
 }
 
 // Loops through ALL markets, and calls pMarket->GetNym_OfferList(NYM_ID,
 // *pOfferList) for each.
 // Returns a list of all the offers that a specific Nym has on all the markets.
 //
+std::string OTCron::GetMarketListState()
+{
+    std::string output;
+
+    for (auto& it : m_mapMarkets) {
+        OTMarket* pMarket = it.second;
+        OT_ASSERT(nullptr != pMarket);
+
+        output += it.first;
+        output += ':' + to_string<int64_t>(pMarket->GetVersion());
+        output += ':' + to_string<int64_t>(pMarket->GetScale());
+        output += ':' + to_string<uint64_t>(pMarket->GetHighestBidPrice());
+        output += ':' + to_string<uint64_t>(pMarket->GetLowestAskPrice());
+        output += ':' + to_string<int64_t>(pMarket->GetLastSalePrice());
+        output += ':' + pMarket->GetLastSaleDate();
+        output += ':' + to_string<int64_t>(pMarket->GetTotalAvailableAssets());
+        output += ':' + to_string<uint64_t>(pMarket->GetBidCount());
+        output += ':' + to_string<uint64_t>(pMarket->GetAskCount());
+        output += ';';
+    }
+
+    return output;
+}
+
 bool OTCron::GetNym_OfferList(OTASCIIArmor& ascOutput, const Identifier& NYM_ID,
                               int32_t& nOfferCount)
 {
@@ -342,6 +633,7 @@ int32_t OTCron::GetTransactionCount() const
 void OTCron::AddTransactionNumber(const int64_t& lTransactionNum)
 {
     m_listTransactionNumbers.push_back(lTransactionNum);
+    m_listNumbersAdded.push_back(lTransactionNum);
 }
 
 // Once this starts returning 0, OTCron can no longer process trades and
@@ -353,6 +645,7 @@ int64_t OTCron::GetNextTransactionNumber()
     int64_t lTransactionNum = m_listTransactionNumbers.front();
 
     m_listTransactionNumbers.pop_front();
+    m_lNumbersTaken++;
 
     return lTransactionNum;
 }
@@ -382,6 +675,10 @@ int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
 
         m_NOTARY_ID.SetString(strNotaryID);
 
+        const String strJournal(xml->getAttributeValue("journal"));
+        m_lJournalGeneration =
+            strJournal.Exists() ? String::StringToLong(strJournal.Get()) : 0;
+
         otOut << "\n\nLoading OTCron for NotaryID: " << strNotaryID << "\n";
 
         nReturnVal = 1;
@@ -414,55 +711,8 @@ int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
                      "value.\n";
             return (-1); // error condition
         }
-        else {
-            OTCronItem* pItem = OTCronItem::NewCronItem(strData);
-
-            if (nullptr == pItem) {
-                otErr << "Unable to create cron item from data in cron file.\n";
-                return (-1);
-            }
-
-            // Why not do this here (when loading from storage), as well as when
-            // first adding the item to cron,
-            // and thus save myself the trouble of verifying the signature EVERY
-            // ITERATION of ProcessCron().
-            //
-            if (!pItem->VerifySignature(*m_pServerNym)) {
-                otErr << "OTCron::ProcessXMLNode: ERROR SECURITY: Server "
-                         "signature failed to "
-                         "verify on a cron item while loading: "
-                      << pItem->GetTransactionNum() << "\n";
-                delete pItem;
-                pItem = nullptr;
-                return (-1);
-            }
-            else if (AddCronItem(*pItem, nullptr,
-                                   false, // bSaveReceipt=false. The receipt is
-                                          // only saved once: When item FIRST
-                                          // added to cron...
-                                   tDateAdded)) { // ...But here, the item was
-                                                  // ALREADY in cron, and is
-                                                  // merely being loaded from
-                                                  // disk.
-                // Thus, it would be wrong to try to create the "original
-                // record" as if it were brand
-                // new and still had the user's signature on it. (Once added to
-                // Cron, the signatures are
-                // released and the SERVER signs it from there. That's why the
-                // user's version is saved
-                // as a receipt in the first place -- so we have a record of the
-                // user's authorization.)
-                otInfo << "Successfully loaded cron item and added to list.\n";
-            }
-            else {
-                otErr << "OTCron::ProcessXMLNode: Though loaded / verified "
-                         "successfully, "
-                         "unable to add cron item (from cron file) to cron "
-                         "list.\n";
-                delete pItem;
-                pItem = nullptr;
-                return (-1);
-            }
+        else if (!load_item(strData, tDateAdded)) {
+            return (-1);
         }
 
         nReturnVal = 1;
@@ -499,6 +749,7 @@ int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
         {
             otErr << "Somehow error while loading, verifying, or adding market "
                      "while loading Cron file.\n";
+            if (pMarket->JournalFailed()) m_bJournalFailed = true;
             delete pMarket;
             pMarket = nullptr;
             return (-1);
@@ -520,10 +771,14 @@ void OTCron::UpdateContents()
 
     const String NOTARY_ID(m_NOTARY_ID);
 
-    Tag tag("cron");
-
-    tag.add_attribute("version", m_strVersion.Get());
-    tag.add_attribute("notaryID", NOTARY_ID.Get());
+    // Cron items are written as they are armored instead of being collected
+    // into a tree first.
+    std::string str_result;
+    TagWriter tag(str_result);
+    tag.Open("cron");
+    tag.Attribute("version", m_strVersion.Get());
+    tag.Attribute("notaryID", NOTARY_ID.Get());
+    tag.Attribute("journal", formatLong(m_lJournalGeneration));
 
     // Save the Market entries (the markets themselves are saved in a markets
     // folder.)
@@ -538,14 +793,13 @@ void OTCron::UpdateContents()
             pMarket->GetInstrumentDefinitionID());
         String str_CURRENCY_ID(pMarket->GetCurrencyID());
 
-        TagPtr tagMarket(new Tag("market"));
-        tagMarket->add_attribute("marketID", str_MARKET_ID.Get());
-        tagMarket->add_attribute("instrumentDefinitionID",
-                                 str_INSTRUMENT_DEFINITION_ID.Get());
-        tagMarket->add_attribute("currencyID", str_CURRENCY_ID.Get());
-        tagMarket->add_attribute("marketScale",
-                                 formatLong(pMarket->GetScale()));
-        tag.add_tag(tagMarket);
+        tag.Open("market");
+        tag.Attribute("marketID", str_MARKET_ID.Get());
+        tag.Attribute(
+            "instrumentDefinitionID", str_INSTRUMENT_DEFINITION_ID.Get());
+        tag.Attribute("currencyID", str_CURRENCY_ID.Get());
+        tag.Attribute("marketScale", formatLong(pMarket->GetScale()));
+        tag.Close();
     }
 
     // Save the Cron Items
@@ -558,23 +812,22 @@ void OTCron::UpdateContents()
             *pItem); // Extract the cron item contract into string form.
         OTASCIIArmor ascItem(strItem); // Base64-encode that for storage.
 
-        TagPtr tagCronItem(new Tag("cronItem", ascItem.Get()));
-        tagCronItem->add_attribute("dateAdded", formatTimestamp(tDateAdded));
-        tag.add_tag(tagCronItem);
+        tag.Open("cronItem");
+        tag.Attribute("dateAdded", formatTimestamp(tDateAdded));
+        tag.Text(ascItem.Get());
+        tag.Close();
     }
 
     // Save the transaction numbers.
     //
     for (auto& lTransactionNumber : m_listTransactionNumbers) {
-        TagPtr tagNumber(new Tag("transactionNum"));
-        tagNumber->add_attribute("value", formatLong(lTransactionNumber));
-        tag.add_tag(tagNumber);
+        tag.Open("transactionNum");
+        tag.Attribute("value", formatLong(lTransactionNumber));
+        tag.Close();
     } // for
 
-    std::string str_result;
-    tag.output(str_result);
-
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    tag.Close();
+    m_xmlUnsigned.Set(str_result.c_str());
 }
 
 int64_t OTCron::computeTimeout()
@@ -611,7 +864,6 @@ void OTCron::ProcessCronItems()
                  "ROUND!!!\n\n";
         return;
     }
-    bool bNeedToSave = false;
 
     // loop through the cron items and tell each one to ProcessCron().
     // If the item returns true, that means leave it on the list. Otherwise,
@@ -643,19 +895,22 @@ void OTCron::ProcessCronItems()
             continue;
         }
         pItem->HookRemovalFromCron(nullptr, GetNextTransactionNumber());
+        const int64_t lTransactionNum = pItem->GetTransactionNum();
         otOut << "OTCron::" << __FUNCTION__
-              << ": Removing cron item: " << pItem->GetTransactionNum() << "\n";
+              << ": Removing cron item: " << lTransactionNum << "\n";
         it = m_multimapCronItems.erase(it);
-        auto it_map = FindItemOnMap(pItem->GetTransactionNum());
+        auto it_map = FindItemOnMap(lTransactionNum);
         OT_ASSERT(m_mapCronItems.end() != it_map);
         m_mapCronItems.erase(it_map);
 
         delete pItem;
         pItem = nullptr;
 
-        bNeedToSave = true;
+        journal("remove", formatLong(lTransactionNum));
     }
-    if (bNeedToSave) SaveCron();
+
+    // Items which stayed on Cron may still have used up numbers.
+    SaveTransactionNumbers();
 }
 
 // OTCron IS responsible for cleaning up theItem, and takes ownership.
@@ -745,7 +1000,11 @@ bool OTCron::AddCronItem(OTCronItem& theItem, Nym* pActivator,
             //            theItem.SaveContract();
 
             // Since we added an item to the Cron, we SAVE it.
-            bSuccess = SaveCron();
+            const String strItem(theItem);
+            OTASCIIArmor ascItem;
+            ascItem.SetString(strItem, false); // linebreaks = false
+            bSuccess = journal(
+                "add", formatTimestamp(tDateAdded) + ' ' + ascItem.Get());
 
             if (bSuccess)
                 otOut << __FUNCTION__
@@ -801,7 +1060,7 @@ bool OTCron::RemoveCronItem(int64_t lTransactionNum,
         delete pItem;
 
         // An item has been removed from Cron. SAVE.
-        return SaveCron();
+        return journal("remove", formatLong(lTransactionNum));
     }
 
     return false;
@@ -211,7 +211,9 @@ bool Credential::VerifyMasterID() const
 
 /** Verifies the cryptographic integrity of a credential. Assumes the
  * CredentialSet specified by owner_backlink_ is valid. */
-bool Credential::verify_internally(const Lock& lock) const
+bool Credential::verify_internally(
+    const Lock& lock,
+    CryptoAsymmetric::VerificationBatch* batch) const
 {
     OT_ASSERT(nullptr != owner_backlink_);
 
@@ -248,7 +250,13 @@ bool Credential::verify_internally(const Lock& lock) const
     if (proto::CREDROLE_MASTERKEY == role_) {
         GoodMasterSignature = true;  // Covered by VerifySignedBySelf()
     } else {
-        GoodMasterSignature = verify_master_signature(lock);
+        const std::size_t queued = (nullptr == batch) ? 0 : batch->size();
+        GoodMasterSignature = verify_master_signature(lock, batch);
+        CryptoAsymmetric::DescribeFailures(
+            batch,
+            queued,
+            std::string(OT_METHOD) + __FUNCTION__ + ": This credential hasn't "
+                "been signed by its  master credential.");
     }
 
     if (!GoodMasterSignature) {
@@ -261,7 +269,9 @@ bool Credential::verify_internally(const Lock& lock) const
     return true;
 }
 
-bool Credential::verify_master_signature(const Lock& lock) const
+bool Credential::verify_master_signature(
+    const Lock& lock,
+    CryptoAsymmetric::VerificationBatch* batch) const
 {
     OT_ASSERT(owner_backlink_);
 
@@ -277,7 +287,7 @@ bool Credential::verify_master_signature(const Lock& lock) const
     }
 
     return (owner_backlink_->GetMasterCredential().Verify(
-        *serialized, role_, Identifier(MasterID()), *masterSig));
+        *serialized, role_, Identifier(MasterID()), *masterSig, batch));
 }
 
 SerializedSignature Credential::MasterSignature() const
@@ -334,7 +344,7 @@ bool Credential::validate(const Lock& lock) const
     }
 
     // Check cryptographic requirements
-    return verify_internally(lock);
+    return verify_internally(lock, nullptr);
 }
 
 bool Credential::Validate() const
@@ -344,6 +354,17 @@ bool Credential::Validate() const
     return validate(lock);
 }
 
+bool Credential::Validate(CryptoAsymmetric::VerificationBatch& batch) const
+{
+    Lock lock(lock_);
+
+    if (!isValid(lock)) {
+        return false;
+    }
+
+    return verify_internally(lock, &batch);
+}
+
 Identifier Credential::GetID(const Lock& lock) const
 {
     OT_ASSERT(verify_write_lock(lock));
@@ -624,7 +645,8 @@ bool Credential::GetVerificationSet(
 bool Credential::Verify(
     const Data&,
     const proto::Signature&,
-    const proto::KeyRole) const
+    const proto::KeyRole,
+    CryptoAsymmetric::VerificationBatch*) const
 {
     OT_ASSERT_MSG(false, "This method was called on the wrong credential.");
 
@@ -637,7 +659,8 @@ bool Credential::Verify(
     const proto::Credential&,
     const proto::CredentialRole&,
     const Identifier&,
-    const proto::Signature&) const
+    const proto::Signature&,
+    CryptoAsymmetric::VerificationBatch*) const
 {
     OT_ASSERT_MSG(false, "This method was called on the wrong credential.");
 
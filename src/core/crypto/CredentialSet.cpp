@@ -136,6 +136,19 @@ int32_t CredentialSet::GetPublicKeysBySignature(
 }
 
 bool CredentialSet::VerifyInternally() const
+{
+    CryptoAsymmetric::VerificationBatch batch;
+
+    if (!VerifyInternally(batch)) {
+
+        return false;
+    }
+
+    return CryptoAsymmetric::BatchVerify(batch);
+}
+
+bool CredentialSet::VerifyInternally(
+    CryptoAsymmetric::VerificationBatch& batch) const
 {
     if (!m_MasterCredential) {
         otOut << __FUNCTION__
@@ -146,7 +159,7 @@ bool CredentialSet::VerifyInternally() const
     // Check for a valid master credential, including whether or not the NymID
     // and MasterID in the CredentialSet match the master credentials's
     // versions.
-    if (!(m_MasterCredential->Validate())) {
+    if (!(m_MasterCredential->Validate(batch))) {
         otOut << __FUNCTION__
               << ": Master Credential failed to verify: " << GetMasterCredID()
               << "\nNymID: " << GetNymID() << "\n";
@@ -160,7 +173,7 @@ bool CredentialSet::VerifyInternally() const
 
         OT_ASSERT(pSub);
 
-        if (!pSub->Validate()) {
+        if (!pSub->Validate(batch)) {
             otOut << __FUNCTION__
                   << ": Child credential failed to verify: " << str_sub_id
                   << "\nNymID: " << GetNymID() << "\n";
@@ -551,7 +564,7 @@ bool CredentialSet::Load_Master(
     const String& strMasterCredID,
     const OTPasswordData*)
 {
-    std::shared_ptr<proto::Credential> serialized;
+    std::shared_ptr<const proto::Credential> serialized;
     bool loaded = OT::App().DB().Load(strMasterCredID.Get(), serialized);
 
     if (!loaded) {
@@ -603,7 +616,7 @@ bool CredentialSet::LoadChildKeyCredential(const String& strSubID)
 
     OT_ASSERT(GetNymID().Exists());
 
-    std::shared_ptr<proto::Credential> child;
+    std::shared_ptr<const proto::Credential> child;
     bool loaded = OT::App().DB().Load(strSubID.Get(), child);
 
     if (!loaded) {
@@ -40,10 +40,24 @@
 
 #include "opentxs/core/crypto/CryptoAsymmetric.hpp"
 
+#include "opentxs/api/OT.hpp"
+#include "opentxs/core/crypto/CryptoHash.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
 #include "opentxs/core/crypto/OTSignature.hpp"
+#include "opentxs/core/crypto/SignatureMemo.hpp"
 #include "opentxs/core/Data.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Log.hpp"
 #include "opentxs/core/String.hpp"
 
+#include <cstddef>
+#include <string>
+
+// Batches with fewer checks than this are verified on the calling thread
+#define OT_BATCH_VERIFY_THRESHOLD 4
+
+#define OT_METHOD "opentxs::CryptoAsymmetric::"
+
 namespace opentxs
 {
 
@@ -91,6 +105,63 @@ EcdsaCurve CryptoAsymmetric::KeyTypeToCurve(
    return output;
 }
 
+bool CryptoAsymmetric::BatchVerify(VerificationBatch& batch)
+{
+    // Neither libsecp256k1 nor libsodium expose a batched verification
+    // function, so the independent checks are spread across the task workers
+    // instead.
+    OT::App().Parallel(
+        batch.size(),
+        [&batch](const std::size_t index) -> void {
+            auto& item = batch[index];
+
+            if (nullptr == item.key_) {
+                item.valid_ = false;
+
+                return;
+            }
+
+            item.valid_ = VerifyMemoized(
+                item.plaintext_, *item.key_, item.signature_, item.hash_);
+        },
+        OT_BATCH_VERIFY_THRESHOLD);
+
+    bool output = true;
+
+    for (const auto& item : batch) {
+        if (item.valid_) {
+
+            continue;
+        }
+
+        if (item.failure_.empty()) {
+            otLog3 << OT_METHOD << __FUNCTION__
+                   << ": Signature failed verification." << std::endl;
+        } else {
+            otErr << item.failure_ << std::endl;
+        }
+
+        output = false;
+    }
+
+    return output;
+}
+
+void CryptoAsymmetric::DescribeFailures(
+    VerificationBatch* batch,
+    const std::size_t start,
+    const std::string& message)
+{
+    if (nullptr == batch) {
+
+        return;
+    }
+
+    for (std::size_t i = start; i < batch->size(); ++i) {
+        (*batch)[i].failure_ = message;
+    }
+}
+
 bool CryptoAsymmetric::SignContract(
     const String& strContractUnsigned,
     const OTAsymmetricKey& theKey,
@@ -134,4 +205,46 @@ bool CryptoAsymmetric::VerifyContractSignature(
 
 }
 
+bool CryptoAsymmetric::VerifyMemoized(
+    const Data& plaintext,
+    const OTAsymmetricKey& theKey,
+    const Data& signature,
+    const proto::HashType hashType,
+    const OTPasswordData* pPWData)
+{
+    // A signature over the same contents with the same key verifies the same
+    // way every time, so check whether it already has in this process.
+    Identifier contentsID, signatureID, keyID;
+
+    // Without a key ID the memo could mix up signatures by different keys.
+    if ((false == theKey.CalculateID(keyID)) || keyID.IsEmpty()) {
+
+        return theKey.engine().Verify(
+            plaintext, theKey, signature, hashType, pPWData);
+    }
+
+    contentsID.CalculateDigest(plaintext);
+    const String strHashType(CryptoHash::HashTypeToString(hashType));
+    Data signatureKey(keyID);
+    signatureKey += signature;
+    signatureKey.Concatenate(strHashType.Get(), strHashType.GetLength());
+    signatureID.CalculateDigest(signatureKey);
+
+    if (SignatureMemo::Check(contentsID, signatureID)) {
+
+        return true;
+    }
+
+    if (false ==
+        theKey.engine().Verify(
+            plaintext, theKey, signature, hashType, pPWData)) {
+
+        return false;
+    }
+
+    SignatureMemo::Insert(contentsID, signatureID);
+
+    return true;
+}
+
 } // namespace opentxs
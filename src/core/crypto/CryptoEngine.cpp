@@ -52,6 +52,7 @@
 #include "opentxs/core/crypto/CryptoSymmetric.hpp"
 #include "opentxs/core/crypto/CryptoSymmetricEngine.hpp"
 #include "opentxs/core/crypto/CryptoUtil.hpp"
+#include "opentxs/core/crypto/EphemeralKeyPool.hpp"
 #if OT_CRYPTO_USING_LIBSECP256K1
 #include "opentxs/core/crypto/Libsecp256k1.hpp"
 #endif
@@ -68,6 +69,7 @@
 #include "opentxs/core/Log.hpp"
 
 #include <functional>
+#include <map>
 #include <ostream>
 
 extern "C" {
@@ -160,6 +162,10 @@ const OTCachedKey& CryptoEngine::CachedKey(const OTCachedKey& source) const
 
 void CryptoEngine::Cleanup()
 {
+    if (ephemeral_) {
+        ephemeral_->Stop();
+    }
+
 #if OT_CRYPTO_SUPPORTED_KEY_SECP256K1
     secp256k1_->Cleanup();
 #endif
@@ -201,6 +207,13 @@ CryptoEncodingEngine& CryptoEngine::Encode() const
     return *encode_;
 }
 
+const EphemeralKeyPool& CryptoEngine::Ephemeral() const
+{
+    OT_ASSERT(ephemeral_);
+
+    return *ephemeral_;
+}
+
 CryptoHashEngine& CryptoEngine::Hash() const
 {
     OT_ASSERT(hash_);
@@ -240,6 +253,13 @@ void CryptoEngine::Init()
     secp256k1_->Init();
 #endif
     ed25519_->Init();
+
+    std::map<proto::AsymmetricKeyType, const Ecdsa*> ecdh{};
+    ecdh[proto::AKEYTYPE_ED25519] = ed25519_.get();
+#if OT_CRYPTO_SUPPORTED_KEY_SECP256K1
+    ecdh[proto::AKEYTYPE_SECP256K1] = secp256k1_.get();
+#endif
+    ephemeral_.reset(new EphemeralKeyPool(ecdh));
 }
 
 void CryptoEngine::init_default_key(const Lock&) const
@@ -278,6 +278,37 @@ bool Ecdsa::EncryptSessionKeyECDH(
     return true;
 }
 
+bool Ecdsa::EncryptSessionKeyECDH(
+    const OTPassword& privateKey,
+    const AsymmetricKeyEC& publicKey,
+    SymmetricKey& sessionKey,
+    OTPassword& newKeyPassword) const
+{
+    Data dhPublicKey;
+
+    if (!publicKey.GetKey(dhPublicKey)) {
+        otErr << __FUNCTION__ << ": Failed to get public key." << std::endl;
+
+        return false;
+    }
+
+    if (!ECDH(dhPublicKey, privateKey, newKeyPassword)) {
+        otErr << __FUNCTION__ << ": ECDH shared secret negotiation failed."
+              << std::endl;
+
+        return false;
+    }
+
+    if (!sessionKey.ChangePassword(newKeyPassword)) {
+        otErr << __FUNCTION__ << ": Session key encryption failed."
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
 bool Ecdsa::ExportECPrivatekey(
     const OTPassword& privkey,
     const OTPasswordData& password,
@@ -0,0 +1,214 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/core/stdafx.hpp"
+
+#include "opentxs/core/crypto/EphemeralKeyPool.hpp"
+
+#include "opentxs/core/crypto/Ecdsa.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+
+#include <ostream>
+
+#define OT_METHOD "opentxs::EphemeralKeyPool::"
+
+namespace opentxs
+{
+EphemeralKeyPool::EphemeralKeyPool(
+    const std::map<proto::AsymmetricKeyType, const Ecdsa*>& engines)
+    : engines_(engines)
+    , lock_()
+    , signal_()
+    , pools_()
+    , running_(false)
+    , shutdown_(false)
+    , refill_thread_(nullptr)
+{
+}
+
+bool EphemeralKeyPool::generate(
+    const proto::AsymmetricKeyType type,
+    Keypair& keypair) const
+{
+    const auto it = engines_.find(type);
+
+    if (engines_.end() == it) {
+
+        return false;
+    }
+
+    OT_ASSERT(nullptr != it->second);
+
+    keypair.private_.reset(new OTPassword);
+    keypair.public_.reset(new Data);
+
+    OT_ASSERT(keypair.private_);
+    OT_ASSERT(keypair.public_);
+
+    return it->second->RandomKeypair(*keypair.private_, *keypair.public_);
+}
+
+// Only curves which have been requested at least once have a pool
+bool EphemeralKeyPool::needs_refill(const Lock&) const
+{
+    for (const auto& it : pools_) {
+        if (target_ > it.second.size()) {
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void EphemeralKeyPool::refill() const
+{
+    while (true) {
+        auto type = proto::AKEYTYPE_ERROR;
+
+        {
+            Lock lock(lock_);
+            signal_.wait(lock, [&]() -> bool {
+                return shutdown_.load() || needs_refill(lock);
+            });
+
+            if (shutdown_.load()) {
+
+                return;
+            }
+
+            for (const auto& it : pools_) {
+                if (target_ > it.second.size()) {
+                    type = it.first;
+
+                    break;
+                }
+            }
+        }
+
+        // Generate outside the lock so Take() is never blocked by it
+        Keypair keypair{};
+
+        if (false == generate(type, keypair)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to generate keypair. Refill stopped."
+                  << std::endl;
+
+            return;
+        }
+
+        Lock lock(lock_);
+        pools_[type].emplace_back(std::move(keypair));
+    }
+}
+
+void EphemeralKeyPool::start(const Lock&) const
+{
+    if (running_.load() || shutdown_.load()) {
+
+        return;
+    }
+
+    running_.store(true);
+    refill_thread_.reset(new std::thread(&EphemeralKeyPool::refill, this));
+}
+
+void EphemeralKeyPool::Stop()
+{
+    {
+        Lock lock(lock_);
+        shutdown_.store(true);
+    }
+
+    signal_.notify_all();
+
+    if (refill_thread_ && refill_thread_->joinable()) {
+        refill_thread_->join();
+    }
+
+    refill_thread_.reset();
+    running_.store(false);
+}
+
+bool EphemeralKeyPool::Take(
+    const proto::AsymmetricKeyType type,
+    OTPassword& privateKey,
+    Data& publicKey) const
+{
+    if (0 == engines_.count(type)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unsupported key type ("
+              << type << ")" << std::endl;
+
+        return false;
+    }
+
+    Keypair keypair{};
+
+    {
+        Lock lock(lock_);
+        start(lock);
+        auto& pool = pools_[type];
+
+        if (false == pool.empty()) {
+            keypair = std::move(pool.front());
+            pool.pop_front();
+        }
+    }
+
+    signal_.notify_all();
+
+    if (false == bool(keypair.private_)) {
+        if (false == generate(type, keypair)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to generate keypair." << std::endl;
+
+            return false;
+        }
+    }
+
+    privateKey = *keypair.private_;
+    publicKey = *keypair.public_;
+
+    return true;
+}
+
+EphemeralKeyPool::~EphemeralKeyPool() { Stop(); }
+}  // namespace opentxs
@@ -91,11 +91,14 @@
 #include <cstdint>
 #include <memory>
 #include <ostream>
+#include <string>
 
 namespace opentxs
 {
 
-bool KeyCredential::VerifySignedBySelf(const Lock& lock) const
+bool KeyCredential::VerifySignedBySelf(
+    const Lock& lock,
+    CryptoAsymmetric::VerificationBatch* batch) const
 {
     OT_ASSERT(m_SigningKey);
 
@@ -108,7 +111,13 @@ bool KeyCredential::VerifySignedBySelf(const Lock& lock) const
         return false;
     }
 
-    bool goodPublic = VerifySig(lock, *publicSig, PUBLIC_VERSION);
+    const std::size_t queued = (nullptr == batch) ? 0 : batch->size();
+    bool goodPublic = VerifySig(lock, *publicSig, PUBLIC_VERSION, batch);
+    CryptoAsymmetric::DescribeFailures(
+        batch,
+        queued,
+        std::string(__FUNCTION__) +
+            ": Could not verify public self signature.");
 
     if (!goodPublic) {
         otErr << __FUNCTION__ << ": Could not verify public self signature."
@@ -127,7 +136,15 @@ bool KeyCredential::VerifySignedBySelf(const Lock& lock) const
             return false;
         }
 
-        bool goodPrivate = VerifySig(lock, *privateSig, PRIVATE_VERSION);
+        const std::size_t queuedPrivate =
+            (nullptr == batch) ? 0 : batch->size();
+        bool goodPrivate =
+            VerifySig(lock, *privateSig, PRIVATE_VERSION, batch);
+        CryptoAsymmetric::DescribeFailures(
+            batch,
+            queuedPrivate,
+            std::string(__FUNCTION__) +
+                ": Could not verify private self signature.");
 
         if (!goodPrivate) {
             otErr << __FUNCTION__
@@ -243,15 +260,17 @@ int32_t KeyCredential::GetPublicKeysBySignature(
     return nCount;
 }
 
-bool KeyCredential::verify_internally(const Lock& lock) const
+bool KeyCredential::verify_internally(
+    const Lock& lock,
+    CryptoAsymmetric::VerificationBatch* batch) const
 {
     // Perform common Credential verifications
-    if (!ot_super::verify_internally(lock)) {
+    if (!ot_super::verify_internally(lock, batch)) {
         return false;
     }
 
     // All KeyCredentials must sign themselves
-    if (!VerifySignedBySelf(lock)) {
+    if (!VerifySignedBySelf(lock, batch)) {
         otOut << __FUNCTION__ << ": Failed verifying key credential: it's not "
                                  "signed by itself (its own signing key.)\n";
         return false;
@@ -579,7 +598,8 @@ bool KeyCredential::addKeyCredentialtoSerializedCredential(
 bool KeyCredential::Verify(
     const Data& plaintext,
     const proto::Signature& sig,
-    const proto::KeyRole key) const
+    const proto::KeyRole key,
+    CryptoAsymmetric::VerificationBatch* batch) const
 {
     const OTKeypair* keyToUse = nullptr;
 
@@ -598,6 +618,11 @@ bool KeyCredential::Verify(
 
     OT_ASSERT(nullptr != keyToUse);
 
+    if (nullptr != batch) {
+
+        return keyToUse->Verify(plaintext, sig, *batch);
+    }
+
     return keyToUse->Verify(plaintext, sig);
 }
 
@@ -648,7 +673,8 @@ bool KeyCredential::SelfSign(
 bool KeyCredential::VerifySig(
     const Lock& lock,
     const proto::Signature& sig,
-    const CredentialModeFlag asPrivate) const
+    const CredentialModeFlag asPrivate,
+    CryptoAsymmetric::VerificationBatch* batch) const
 {
     serializedCredential serialized;
 
@@ -670,7 +696,7 @@ bool KeyCredential::VerifySig(
 
     Data plaintext = proto::ProtoAsData<proto::Credential>(*serialized);
 
-    return Verify(plaintext, sig);
+    return Verify(plaintext, sig, proto::KEYROLE_SIGN, batch);
 }
 
 bool KeyCredential::TransportKey(Data& publicKey, OTPassword& privateKey)
@@ -52,16 +52,15 @@
 #include "opentxs/core/crypto/CryptoSymmetricEngine.hpp"
 #include "opentxs/core/crypto/CryptoUtil.hpp"
 #include "opentxs/core/crypto/Ecdsa.hpp"
+#include "opentxs/core/crypto/EphemeralKeyPool.hpp"
 #if OT_CRYPTO_USING_LIBSECP256K1
 #include "opentxs/core/crypto/Libsecp256k1.hpp"
 #endif
 #include "opentxs/core/crypto/Libsodium.hpp"
-#include "opentxs/core/crypto/NymParameters.hpp"
 #include "opentxs/core/crypto/OpenSSL.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/crypto/OTAsymmetricKey.hpp"
 #include "opentxs/core/crypto/OTEnvelope.hpp"
-#include "opentxs/core/crypto/OTKeypair.hpp"
 #include "opentxs/core/crypto/OTPasswordData.hpp"
 #include "opentxs/core/crypto/SymmetricKey.hpp"
 #include "opentxs/core/util/Assert.hpp"
@@ -81,6 +80,78 @@
 
 namespace opentxs
 {
+bool Letter::AddECRecipients(
+    const proto::AsymmetricKeyType type,
+    const mapOfECKeys& recipients,
+    SymmetricKey& sessionKey,
+    proto::Envelope& envelope)
+{
+    const Ecdsa* engine = nullptr;
+
+    switch (type) {
+        case proto::AKEYTYPE_SECP256K1: {
+#if OT_CRYPTO_SUPPORTED_KEY_SECP256K1
+#if OT_CRYPTO_USING_LIBSECP256K1
+            engine =
+                &static_cast<Libsecp256k1&>(OT::App().Crypto().SECP256K1());
+#endif
+#endif
+        } break;
+        case proto::AKEYTYPE_ED25519: {
+            engine = &static_cast<Libsodium&>(OT::App().Crypto().ED25519());
+        } break;
+        default: {
+        }
+    }
+
+    if (nullptr == engine) {
+        otErr << __FUNCTION__ << ": Unsupported key type." << std::endl;
+
+        return false;
+    }
+
+    // One ephemeral keypair per curve is shared by every recipient on that
+    // curve. It is only ever needed as a raw secret, so it is never
+    // serialized or encrypted.
+    OTPassword dhPrivateKey;
+    Data dhPublicKey;
+
+    if (!OT::App().Crypto().Ephemeral().Take(type, dhPrivateKey, dhPublicKey)) {
+        otErr << __FUNCTION__ << ": Failed to obtain ephemeral keypair."
+              << std::endl;
+
+        return false;
+    }
+
+    auto& newDhKey = *envelope.add_dhkey();
+    newDhKey.set_version(1);
+    newDhKey.set_type(type);
+    newDhKey.set_mode(proto::KEYMODE_PUBLIC);
+    newDhKey.set_role(proto::KEYROLE_ENCRYPT);
+    newDhKey.set_key(dhPublicKey.GetPointer(), dhPublicKey.GetSize());
+
+    // Individually encrypt the session key to each recipient and add
+    // the encrypted key to the global list of session keys for this
+    // letter. The session key stays unlocked throughout, so only the
+    // new password is derived for each recipient.
+    for (const auto& it : recipients) {
+        OTPassword newKeyPassword;
+        const bool haveSessionKey = engine->EncryptSessionKeyECDH(
+            dhPrivateKey, *it.second, sessionKey, newKeyPassword);
+
+        if (!haveSessionKey) {
+            otErr << __FUNCTION__ << ": Session key encryption failed."
+                  << std::endl;
+
+            return false;
+        }
+
+        sessionKey.Serialize(*envelope.add_sessionkey());
+    }
+
+    return true;
+}
+
 bool Letter::AddRSARecipients(
     __attribute__((unused)) const mapOfAsymmetricKeys& recipients,
     __attribute__((unused)) const SymmetricKey& sessionKey,
@@ -213,47 +284,12 @@ bool Letter::Seal(
 
     if (haveRecipientsECDSA) {
 #if OT_CRYPTO_SUPPORTED_KEY_SECP256K1
-#if OT_CRYPTO_USING_LIBSECP256K1
-        Ecdsa& engine =
-            static_cast<Libsecp256k1&>(OT::App().Crypto().SECP256K1());
-#endif
-        std::unique_ptr<OTKeypair> dhKeypair;
-        NymParameters parameters(proto::CREDTYPE_LEGACY);
-        parameters.setNymParameterType(NymParameterType::SECP256K1);
-        dhKeypair.reset(new OTKeypair(parameters, proto::KEYROLE_ENCRYPT));
-
-        OT_ASSERT(dhKeypair);
-
-        auto& newDhKey = *output.add_dhkey();
-        newDhKey = *dhKeypair->Serialize(false);
-
-        std::unique_ptr<AsymmetricKeyEC> dhPrivateKey;
-        dhPrivateKey.reset(static_cast<AsymmetricKeySecp256k1*>(
-            OTAsymmetricKey::KeyFactory(*dhKeypair->Serialize(true))));
-
-        OT_ASSERT(dhPrivateKey);
-
-        // Individually encrypt the session key to each recipient and add
-        // the encrypted key to the global list of session keys for this
-        // letter.
-        for (auto it : secp256k1Recipients) {
-            OTPassword newKeyPassword;
-            const bool haveSessionKey = engine.EncryptSessionKeyECDH(
-                *dhPrivateKey,
-                *it.second,
-                defaultPassword,
+        if (!AddECRecipients(
+                proto::AKEYTYPE_SECP256K1,
+                secp256k1Recipients,
                 *sessionKey,
-                newKeyPassword);
-
-            if (haveSessionKey) {
-                auto& serializedSessionKey = *output.add_sessionkey();
-                sessionKey->Serialize(serializedSessionKey);
-            } else {
-                otErr << __FUNCTION__ << ": Session key encryption failed."
-                      << std::endl;
-
-                return false;
-            }
+                output)) {
+            return false;
         }
 #else
         otErr << __FUNCTION__ << ": Attempting to Seal to "
@@ -265,44 +301,12 @@ bool Letter::Seal(
     }
 
     if (haveRecipientsED25519) {
-        Ecdsa& engine = static_cast<Libsodium&>(OT::App().Crypto().ED25519());
-        std::unique_ptr<OTKeypair> dhKeypair;
-        NymParameters parameters(proto::CREDTYPE_LEGACY);
-        parameters.setNymParameterType(NymParameterType::ED25519);
-        dhKeypair.reset(new OTKeypair(parameters, proto::KEYROLE_ENCRYPT));
-
-        OT_ASSERT(dhKeypair);
-
-        auto& newDhKey = *output.add_dhkey();
-        newDhKey = *dhKeypair->Serialize(false);
-
-        std::unique_ptr<AsymmetricKeyEC> dhPrivateKey;
-        dhPrivateKey.reset(static_cast<AsymmetricKeyEd25519*>(
-            OTAsymmetricKey::KeyFactory(*dhKeypair->Serialize(true))));
-
-        OT_ASSERT(dhPrivateKey);
-
-        // Individually encrypt the session key to each recipient and add
-        // the encrypted key to the global list of session keys for this
-        // letter.
-        for (auto it : ed25519Recipients) {
-            OTPassword newKeyPassword;
-            const bool haveSessionKey = engine.EncryptSessionKeyECDH(
-                *dhPrivateKey,
-                *it.second,
-                defaultPassword,
+        if (!AddECRecipients(
+                proto::AKEYTYPE_ED25519,
+                ed25519Recipients,
                 *sessionKey,
-                newKeyPassword);
-
-            if (haveSessionKey) {
-                auto& serializedSessionKey = *output.add_sessionkey();
-                sessionKey->Serialize(serializedSessionKey);
-            } else {
-                otErr << __FUNCTION__ << ": Session key encryption failed."
-                      << std::endl;
-
-                return false;
-            }
+                output)) {
+            return false;
         }
     }
 
@@ -92,10 +92,12 @@ namespace opentxs
 /** Verify that nym_id_ is the same as the hash of m_strSourceForNymID. Also
  * verify that *this == owner_backlink_->GetMasterCredential() (the master
  * credential.) Verify the (self-signed) signature on *this. */
-bool MasterCredential::verify_internally(const Lock& lock) const
+bool MasterCredential::verify_internally(
+    const Lock& lock,
+    CryptoAsymmetric::VerificationBatch* batch) const
 {
     // Perform common Key Credential verifications
-    if (!ot_super::verify_internally(lock)) {
+    if (!ot_super::verify_internally(lock, batch)) {
         return false;
     }
 
@@ -245,7 +247,8 @@ bool MasterCredential::Verify(
     const proto::Credential& credential,
     const proto::CredentialRole& role,
     const Identifier& masterID,
-    const proto::Signature& masterSig) const
+    const proto::Signature& masterSig,
+    CryptoAsymmetric::VerificationBatch* batch) const
 {
     if (!proto::Validate<proto::Credential>(
             credential, VERBOSE, proto::KEYMODE_PUBLIC, role, false)) {
@@ -269,7 +272,8 @@ bool MasterCredential::Verify(
     signature.CopyFrom(masterSig);
     signature.clear_signature();
 
-    return Verify(proto::ProtoAsData(copy), masterSig);
+    return Verify(
+        proto::ProtoAsData(copy), masterSig, proto::KEYROLE_SIGN, batch);
 }
 
 bool MasterCredential::hasCapability(const NymCapability& capability) const
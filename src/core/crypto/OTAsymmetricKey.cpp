@@ -1057,8 +1057,28 @@ bool OTAsymmetricKey::Verify(const Data& plaintext, const proto::Signature& sig)
     Data signature;
     signature.Assign(sig.signature().c_str(), sig.signature().size());
 
-    return engine().Verify(
-        plaintext, *this, signature, sig.hashtype(), nullptr);
+    return CryptoAsymmetric::VerifyMemoized(
+        plaintext, *this, signature, sig.hashtype());
+}
+
+bool OTAsymmetricKey::Verify(
+    const Data& plaintext,
+    const proto::Signature& sig,
+    CryptoAsymmetric::VerificationBatch& batch) const
+{
+    if (IsPrivate()) {
+        otErr << "You must use public keys to verify signatures.\n";
+        return false;
+    }
+
+    CryptoAsymmetric::Verification item;
+    item.key_ = this;
+    item.plaintext_ = plaintext;
+    item.signature_.Assign(sig.signature().c_str(), sig.signature().size());
+    item.hash_ = sig.hashtype();
+    batch.push_back(item);
+
+    return true;
 }
 
 bool OTAsymmetricKey::Sign(
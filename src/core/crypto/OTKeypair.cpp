@@ -351,6 +351,20 @@ bool OTKeypair::Verify(
     return m_pkeyPublic->Verify(plaintext, sig);
 }
 
+bool OTKeypair::Verify(
+    const Data& plaintext,
+    const proto::Signature& sig,
+    CryptoAsymmetric::VerificationBatch& batch) const
+{
+    if (!m_pkeyPublic) {
+        otErr << __FUNCTION__ << ": Missing public key. Can not verify.\n";
+
+        return false;
+    }
+
+    return m_pkeyPublic->Verify(plaintext, sig, batch);
+}
+
 bool OTKeypair::TransportKey(Data& publicKey, OTPassword& privateKey) const
 {
     OT_ASSERT(m_pkeyPrivate);
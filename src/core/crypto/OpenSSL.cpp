@@ -1116,7 +1116,8 @@ bool OpenSSL::ArgumentCheck(
     ECB = (CryptoSymmetric::AES_256_ECB == cipher);
 
     // Debug logging
-    otLog3 << "Using cipher: " << CryptoSymmetric::ModeToString(cipher) << "\n";
+    OT_LOG(otLog3) << "Using cipher: " << CryptoSymmetric::ModeToString(cipher)
+                   << "\n";
 
     if (ECB) {
         otLog3 << "...in ECB mode.\n";
@@ -2668,6 +2669,7 @@ bool OpenSSL::Sign(
         dynamic_cast<OTAsymmetricKey_OpenSSL*>(&theTempKey);
     OT_ASSERT(nullptr != pTempOpenSSLKey);
 
+    std::lock_guard<std::mutex> keyLock(pTempOpenSSLKey->dp->lock_);
     const EVP_PKEY* pkey = pTempOpenSSLKey->dp->GetKey(pPWData);
     OT_ASSERT(nullptr != pkey);
 
@@ -2693,6 +2695,7 @@ bool OpenSSL::Verify(
         dynamic_cast<OTAsymmetricKey_OpenSSL*>(&theTempKey);
     OT_ASSERT(nullptr != pTempOpenSSLKey);
 
+    std::lock_guard<std::mutex> keyLock(pTempOpenSSLKey->dp->lock_);
     const EVP_PKEY* pkey = pTempOpenSSLKey->dp->GetKey(pPWData);
     OT_ASSERT(nullptr != pkey);
 
@@ -3258,7 +3261,9 @@ bool OpenSSL::DecryptSessionKey(
         dynamic_cast<OTAsymmetricKey_OpenSSL*>(&theTempPrivateKey);
 
     EVP_PKEY* private_key = nullptr;
+    std::unique_lock<std::mutex> keyLock;
     if (nullptr != pPrivateKey) {
+        keyLock = std::unique_lock<std::mutex>(pPrivateKey->dp->lock_);
         private_key = const_cast<EVP_PKEY*>(pPrivateKey->dp->GetKey(pPWData));
     }
 
@@ -0,0 +1,101 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/core/stdafx.hpp"
+
+#include "opentxs/core/crypto/SignatureMemo.hpp"
+
+namespace opentxs
+{
+std::mutex SignatureMemo::lock_;
+std::set<SignatureMemo::Key> SignatureMemo::verified_;
+std::deque<SignatureMemo::Key> SignatureMemo::order_;
+
+bool SignatureMemo::Check(
+    const Identifier& contract,
+    const Identifier& signature)
+{
+    if (contract.empty() || signature.empty()) {
+
+        return false;
+    }
+
+    Lock lock(lock_);
+
+    return (verified_.end() != verified_.find(Key(contract, signature)));
+}
+
+void SignatureMemo::Clear()
+{
+    Lock lock(lock_);
+    verified_.clear();
+    order_.clear();
+}
+
+void SignatureMemo::Insert(
+    const Identifier& contract,
+    const Identifier& signature)
+{
+    if (contract.empty() || signature.empty()) {
+
+        return;
+    }
+
+    Key key(contract, signature);
+    Lock lock(lock_);
+
+    if (false == verified_.insert(key).second) {
+
+        return;
+    }
+
+    order_.push_back(key);
+
+    while (OT_SIGNATURE_MEMO_SIZE < order_.size()) {
+        verified_.erase(order_.front());
+        order_.pop_front();
+    }
+}
+
+std::size_t SignatureMemo::Size()
+{
+    Lock lock(lock_);
+
+    return verified_.size();
+}
+}  // namespace opentxs
@@ -276,6 +276,21 @@ bool SymmetricKey::ChangePassword(
     return false;
 }
 
+bool SymmetricKey::ChangePassword(const OTPassword& newPassword)
+{
+    if (false == bool(plaintext_key_)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Master key is locked."
+              << std::endl;
+
+        return false;
+    }
+
+    OTPasswordData password("");
+    password.SetOverride(newPassword);
+
+    return EncryptKey(*plaintext_key_, password);
+}
+
 bool SymmetricKey::Decrypt(
     const proto::Ciphertext& input,
     const OTPasswordData& keyPassword,
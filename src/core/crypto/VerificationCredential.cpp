@@ -144,10 +144,12 @@ serializedCredential VerificationCredential::serialize(
     return serializedCredential;
 }
 
-bool VerificationCredential::verify_internally(const Lock& lock) const
+bool VerificationCredential::verify_internally(
+    const Lock& lock,
+    CryptoAsymmetric::VerificationBatch* batch) const
 {
     // Perform common Credential verifications
-    if (!ot_super::verify_internally(lock)) {
+    if (!ot_super::verify_internally(lock, batch)) {
         return false;
     }
 
@@ -71,6 +71,7 @@
 #include <map>
 #include <memory>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -100,6 +101,10 @@ int32_t OTMarket::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
             String::StringToLong(xml->getAttributeValue("lastSalePrice"));
         m_strLastSaleDate = xml->getAttributeValue("lastSaleDate");
 
+        const String strJournal(xml->getAttributeValue("journal"));
+        m_lJournalGeneration =
+            strJournal.Exists() ? String::StringToLong(strJournal.Get()) : 0;
+
         const String strNotaryID(xml->getAttributeValue("notaryID")),
             strInstrumentDefinitionID(
                 xml->getAttributeValue("instrumentDefinitionID")),
@@ -171,29 +176,30 @@ void OTMarket::UpdateContents()
         INSTRUMENT_DEFINITION_ID(m_INSTRUMENT_DEFINITION_ID),
         CURRENCY_TYPE_ID(m_CURRENCY_TYPE_ID);
 
-    Tag tag("market");
-
-    tag.add_attribute("version", m_strVersion.Get());
-    tag.add_attribute("notaryID", NOTARY_ID.Get());
-    tag.add_attribute("instrumentDefinitionID", INSTRUMENT_DEFINITION_ID.Get());
-    tag.add_attribute("currencyTypeID", CURRENCY_TYPE_ID.Get());
-    tag.add_attribute("marketScale", formatLong(m_lScale));
-    tag.add_attribute("lastSaleDate", m_strLastSaleDate);
-    tag.add_attribute("lastSalePrice", formatLong(m_lLastSalePrice));
+    // Offers are written as they are armored instead of being collected
+    // into a tree first.
+    std::string str_result;
+    TagWriter tag(str_result);
+    tag.Open("market");
+    tag.Attribute("version", m_strVersion.Get());
+    tag.Attribute("notaryID", NOTARY_ID.Get());
+    tag.Attribute("instrumentDefinitionID", INSTRUMENT_DEFINITION_ID.Get());
+    tag.Attribute("currencyTypeID", CURRENCY_TYPE_ID.Get());
+    tag.Attribute("marketScale", formatLong(m_lScale));
+    tag.Attribute("lastSaleDate", m_strLastSaleDate);
+    tag.Attribute("lastSalePrice", formatLong(m_lLastSalePrice));
+    tag.Attribute("journal", formatLong(m_lJournalGeneration));
 
     // Save the offers for sale.
     for (auto& it : m_mapAsks) {
         OTOffer* pOffer = it.second;
         OT_ASSERT(nullptr != pOffer);
 
-        String strOffer(
-            *pOffer); // Extract the offer contract into string form.
-        OTASCIIArmor ascOffer(strOffer); // Base64-encode that for storage.
-
-        TagPtr tagOffer(new Tag("offer", ascOffer.Get()));
-        tagOffer->add_attribute(
+        tag.Open("offer");
+        tag.Attribute(
             "dateAdded", formatTimestamp(pOffer->GetDateAddedToMarket()));
-        tag.add_tag(tagOffer);
+        tag.Text(pOffer->GetArmored());
+        tag.Close();
     }
 
     // Save the bids.
@@ -201,36 +207,120 @@ void OTMarket::UpdateContents()
         OTOffer* pOffer = it.second;
         OT_ASSERT(nullptr != pOffer);
 
-        String strOffer(
-            *pOffer); // Extract the offer contract into string form.
-        OTASCIIArmor ascOffer(strOffer); // Base64-encode that for storage.
-
-        TagPtr tagOffer(new Tag("offer", ascOffer.Get()));
-        tagOffer->add_attribute(
+        tag.Open("offer");
+        tag.Attribute(
             "dateAdded", formatTimestamp(pOffer->GetDateAddedToMarket()));
-        tag.add_tag(tagOffer);
+        tag.Text(pOffer->GetArmored());
+        tag.Close();
     }
 
-    std::string str_result;
-    tag.output(str_result);
-
-    m_xmlUnsigned.Concatenate("%s", str_result.c_str());
+    tag.Close();
+    m_xmlUnsigned.Set(str_result.c_str());
 }
 
 int64_t OTMarket::GetTotalAvailableAssets()
 {
     int64_t lTotal = 0;
 
-    for (auto& it : m_mapAsks) {
-        OTOffer* pOffer = it.second;
-        OT_ASSERT(nullptr != pOffer);
-
-        lTotal += pOffer->GetAmountAvailable();
+    for (auto& it : m_mapAskLevels) {
+        lTotal += it.second.m_lAmountAvailable;
     }
 
     return lTotal;
 }
 
+int64_t OTMarket::GetBidDepth(const int64_t& lPrice) const
+{
+    auto it = m_mapBidLevels.find(lPrice);
+
+    if (it == m_mapBidLevels.end()) return 0;
+
+    return it->second.m_lAmountAvailable;
+}
+
+int64_t OTMarket::GetAskDepth(const int64_t& lPrice) const
+{
+    auto it = m_mapAskLevels.find(lPrice);
+
+    if (it == m_mapAskLevels.end()) return 0;
+
+    return it->second.m_lAmountAvailable;
+}
+
+// The offer must already be on m_mapBids or m_mapAsks.
+void OTMarket::add_to_price_level(OTOffer& theOffer)
+{
+    mapOfPriceLevels& theLevels =
+        (theOffer.IsBid() ? m_mapBidLevels : m_mapAskLevels);
+    OTPriceLevel& theLevel = theLevels[theOffer.GetPriceLimit()];
+
+    theLevel.m_lOfferCount++;
+    theLevel.m_lAmountAvailable += theOffer.GetAmountAvailable();
+}
+
+void OTMarket::remove_from_price_level(OTOffer& theOffer)
+{
+    mapOfPriceLevels& theLevels =
+        (theOffer.IsBid() ? m_mapBidLevels : m_mapAskLevels);
+    auto it = theLevels.find(theOffer.GetPriceLimit());
+
+    if (it == theLevels.end()) {
+        otErr << "OTMarket::" << __FUNCTION__
+              << ": Missing price level for offer "
+              << theOffer.GetTransactionNum() << "\n";
+
+        return;
+    }
+
+    OTPriceLevel& theLevel = it->second;
+    theLevel.m_lOfferCount--;
+    theLevel.m_lAmountAvailable -= theOffer.GetAmountAvailable();
+
+    if (0 >= theLevel.m_lOfferCount) theLevels.erase(it);
+}
+
+// Call this right after theOffer.IncrementFinishedSoFar(lAmount).
+void OTMarket::offer_filled(OTOffer& theOffer, const int64_t& lAmount)
+{
+    m_lVersion++;
+
+    if (GetOffer(theOffer.GetTransactionNum()) != &theOffer) return;
+
+    mapOfPriceLevels& theLevels =
+        (theOffer.IsBid() ? m_mapBidLevels : m_mapAskLevels);
+    auto it = theLevels.find(theOffer.GetPriceLimit());
+
+    if (it != theLevels.end()) it->second.m_lAmountAvailable -= lAmount;
+}
+
+// Moves any offer whose trade has since been linked onto the per-Nym index.
+void OTMarket::index_nym_offers()
+{
+    auto it = m_setUnindexedOffers.begin();
+
+    while (it != m_setUnindexedOffers.end()) {
+        OTOffer* pOffer = GetOffer(*it);
+
+        if (nullptr == pOffer) {
+            it = m_setUnindexedOffers.erase(it);
+
+            continue;
+        }
+
+        OTTrade* pTrade = pOffer->GetTrade();
+
+        if (nullptr == pTrade) {
+            ++it;
+
+            continue;
+        }
+
+        const String strNymID(pTrade->GetSenderNymID());
+        m_mapNymOffers[strNymID.Get()].insert(*it);
+        it = m_setUnindexedOffers.erase(it);
+    }
+}
+
 // Get list of offers for a particular Nym, to send that Nym
 //
 bool OTMarket::GetNym_OfferList(const Identifier& NYM_ID,
@@ -240,12 +330,19 @@ bool OTMarket::GetNym_OfferList(const Identifier& NYM_ID,
     nNymOfferCount =
         0; // Outputs the count of offers for NYM_ID (on this market.)
 
-    // Loop through the offers, up to some maximum depth, and then add each
-    // as a data member to an offer list, then pack it into ascOutput.
+    index_nym_offers();
+
+    const String strNymID(NYM_ID);
+    auto itNym = m_mapNymOffers.find(strNymID.Get());
+
+    if (itNym == m_mapNymOffers.end()) return true;
+
+    // Only this Nym's offers are visited, via the per-Nym index.
     //
-    for (auto& it : m_mapOffers) {
-        OTOffer* pOffer = it.second;
-        OT_ASSERT(nullptr != pOffer);
+    for (const int64_t& lOfferNum : itNym->second) {
+        OTOffer* pOffer = GetOffer(lOfferNum);
+
+        if (nullptr == pOffer) continue;
 
         OTTrade* pTrade = pOffer->GetTrade();
 
@@ -409,6 +506,23 @@ bool OTMarket::GetOfferList(OTASCIIArmor& ascOutput, int64_t lDepth,
 
     if (0 == lDepth) lDepth = MAX_MARKET_QUERY_DEPTH;
 
+    // The packed list only changes when the order book does, so a cached copy
+    // is returned for as long as the market version hasn't moved.
+    if (m_lOfferListVersion != m_lVersion) {
+        m_mapOfferListCache.clear();
+        m_lOfferListVersion = m_lVersion;
+    }
+
+    auto itCached = m_mapOfferListCache.find(lDepth);
+
+    if (itCached != m_mapOfferListCache.end()) {
+        nOfferCount = itCached->second.first;
+
+        if (0 < nOfferCount) ascOutput.Set(itCached->second.second.c_str());
+
+        return true;
+    }
+
     // Loop through the offers, up to some maximum depth, and then add each
     // as a data member to an offer list, then pack it into ascOutput.
 
@@ -491,8 +605,16 @@ bool OTMarket::GetOfferList(OTASCIIArmor& ascOutput, int64_t lDepth,
 
     // Now pack the list into strOutput...
 
-    if (nOfferCount == 0)
+    if (static_cast<std::size_t>(MAX_MARKET_QUERY_DEPTH) <
+        m_mapOfferListCache.size())
+        m_mapOfferListCache.clear();
+
+    if (nOfferCount == 0) {
+        m_mapOfferListCache[lDepth] =
+            std::pair<int32_t, std::string>(0, std::string());
+
         return true; // Success, but there were zero offers found.
+    }
 
     if (nOfferCount > 0) {
         OTDB::Storage* pStorage = OTDB::GetDefaultStorage();
@@ -523,6 +645,9 @@ bool OTMarket::GetOfferList(OTASCIIArmor& ascOutput, int64_t lDepth,
             // and then Set() that as the string contents.
             ascOutput.SetData(theData);
 
+            m_mapOfferListCache[lDepth] =
+                std::pair<int32_t, std::string>(nOfferCount, ascOutput.Get());
+
             return true;
         }
         else
@@ -575,6 +700,14 @@ OTOffer* OTMarket::GetOffer(const int64_t& lTransactionNum)
 
 bool OTMarket::RemoveOffer(const int64_t& lTransactionNum) // if false, offer
                                                            // wasn't found.
+{
+    if (!remove_offer(lTransactionNum)) return false;
+
+    // <====== SAVE since an offer was removed.
+    return journal("remove", formatLong(lTransactionNum));
+}
+
+bool OTMarket::remove_offer(const int64_t& lTransactionNum)
 {
     bool bReturnValue = false;
 
@@ -601,15 +734,12 @@ bool OTMarket::RemoveOffer(const int64_t& lTransactionNum) // if false, offer
         // The code operates the same whether ask or bid. Just use a pointer.
         mapOfOffers* pMap = (pOffer->IsBid() ? &m_mapBids : &m_mapAsks);
 
-        // Future solution here: instead of looping through all the offers and
-        // finding it,
-        // I could just have each Offer store a copy of the iterator that's
-        // returned when
-        // it's first inserted. Later I just erase that iterator from the right
-        // list to remove. Todo.
+        // Offers at one price sit together on the multimap, so only that
+        // price's range needs to be searched.
         OTOffer* pSameOffer = nullptr;
+        auto range = pMap->equal_range(pOffer->GetPriceLimit());
 
-        for (mapOfOffers::iterator iii = pMap->begin(); iii != pMap->end();
+        for (mapOfOffers::iterator iii = range.first; iii != range.second;
              ++iii) {
             pSameOffer = iii->second;
 
@@ -619,6 +749,7 @@ bool OTMarket::RemoveOffer(const int64_t& lTransactionNum) // if false, offer
             // found it!
             if (lTransactionNum == pSameOffer->GetTransactionNum()) {
                 pMap->erase(iii);
+                remove_from_price_level(*pSameOffer);
                 break;
             }
 
@@ -628,6 +759,22 @@ bool OTMarket::RemoveOffer(const int64_t& lTransactionNum) // if false, offer
             pSameOffer = nullptr;
         }
 
+        OTTrade* pTrade = pOffer->GetTrade();
+
+        if (nullptr != pTrade) {
+            const String strNymID(pTrade->GetSenderNymID());
+            auto itNym = m_mapNymOffers.find(strNymID.Get());
+
+            if (itNym != m_mapNymOffers.end()) {
+                itNym->second.erase(lTransactionNum);
+
+                if (itNym->second.empty()) m_mapNymOffers.erase(itNym);
+            }
+        }
+
+        m_setUnindexedOffers.erase(lTransactionNum);
+        m_lVersion++;
+
         if (nullptr == pSameOffer) {
             otErr << "Removed Offer from offers list, but not found on bid/ask "
                      "list.\n";
@@ -651,10 +798,7 @@ bool OTMarket::RemoveOffer(const int64_t& lTransactionNum) // if false, offer
         pSameOffer = nullptr;
     }
 
-    if (bReturnValue)
-        return SaveMarket(); // <====== SAVE since an offer was removed.
-    else
-        return false;
+    return bReturnValue;
 }
 
 // This method demands an Offer reference in order to verify that it really
@@ -726,14 +870,32 @@ bool OTMarket::AddOffer(OTTrade* pTrade, OTOffer& theOffer, bool bSaveFile,
             otLog4 << "Offer added as an ask to the market.\n";
         }
 
+        add_to_price_level(theOffer);
+
+        if (nullptr != pTrade) {
+            const String strNymID(pTrade->GetSenderNymID());
+            m_mapNymOffers[strNymID.Get()].insert(lTransactionNum);
+        }
+        else {
+            m_setUnindexedOffers.insert(lTransactionNum);
+        }
+
+        m_lVersion++;
+
         if (bSaveFile) {
             // Set this to the current date/time, since the offer is
             // being added for the first time.
             //
             theOffer.SetDateAddedToMarket(OTTimeGetCurrentTime());
 
-            return SaveMarket(); // <====== SAVE since an offer was added to the
-                                 // Market.
+            const String strOffer(theOffer);
+            OTASCIIArmor ascOffer;
+            ascOffer.SetString(strOffer, false); // linebreaks = false
+
+            // <====== SAVE since an offer was added to the Market.
+            return journal("add",
+                           formatTimestamp(theOffer.GetDateAddedToMarket()) +
+                               ' ' + ascOffer.Get());
         }
         else {
             // Set this to the date passed in, since this offer was
@@ -781,6 +943,25 @@ bool OTMarket::LoadMarket()
             str_TRADES_FILE.Get())); // markets/recent/<market_ID>.bin
     }
 
+    // A journal which can't be replayed in full is left in place, rather than
+    // being folded into a new snapshot and cleared.
+    if (bSuccess) {
+        if (!journal_file().Replay(
+                m_lJournalGeneration,
+                [this](const std::string& strRecord) -> bool {
+                    return replay(strRecord);
+                })) {
+            otErr << "OTMarket::LoadMarket: Failed replaying some of the "
+                     "changes journaled since the market file was saved: "
+                  << szFilename << "\n";
+            m_bJournalFailed = true;
+            return false;
+        }
+
+        // Start the next generation from everything that was replayed.
+        if (0 < journal_file().Size()) bSuccess = SaveMarket();
+    }
+
     return bSuccess;
 }
 
@@ -802,31 +983,208 @@ bool OTMarket::SaveMarket()
     // the old version of the market from before the most recent changes.
     ReleaseSignatures();
 
+    // Records journaled until now are folded into this file, and will be
+    // skipped if they are still there when it is loaded.
+    m_lJournalGeneration++;
+
     // Sign it, save it internally to string, and then save that out to the
     // file.
     if (!SignContract(*(GetCron()->GetServerNym())) || !SaveContract() ||
         !SaveContract(szFoldername, szFilename)) {
         otErr << "Error saving Market:\n" << szFoldername
               << Log::PathSeparator() << szFilename << "\n";
+        m_lJournalGeneration--;
         return false;
     }
 
+    journal_file().Clear();
+
     // Save a copy of recent trades.
+    save_trade_list();
 
-    if (nullptr != m_pTradeList) {
+    return true;
+}
 
-        String str_TRADES_FILE;
-        str_TRADES_FILE.Format("%s.bin", str_MARKET_ID.Get());
+// If this fails, oh well. It's informational, anyway.
+bool OTMarket::save_trade_list()
+{
+    if (nullptr == m_pTradeList) return true;
 
-        const char* szSubFolder = "recent"; // todo stop hardcoding.
+    Identifier MARKET_ID(*this);
+    String str_MARKET_ID(MARKET_ID);
 
-        // If this fails, oh well. It's informational, anyway.
-        if (!OTDB::StoreObject(*m_pTradeList, szFoldername, // markets
-                               szSubFolder,                 // markets/recent
-                               str_TRADES_FILE.Get()))      // markets/recent/<Market_ID>.bin
-            otErr << "Error saving recent trades for Market:\n" << szFoldername
-                  << Log::PathSeparator() << szSubFolder << Log::PathSeparator()
-                  << szFilename << "\n";
+    const char* szFoldername = OTFolders::Market().Get();
+
+    String str_TRADES_FILE;
+    str_TRADES_FILE.Format("%s.bin", str_MARKET_ID.Get());
+
+    const char* szSubFolder = "recent"; // todo stop hardcoding.
+
+    if (!OTDB::StoreObject(*m_pTradeList, szFoldername, // markets
+                           szSubFolder,                 // markets/recent
+                           str_TRADES_FILE.Get())) {    // markets/recent/<Market_ID>.bin
+        otErr << "Error saving recent trades for Market:\n" << szFoldername
+              << Log::PathSeparator() << szSubFolder << Log::PathSeparator()
+              << str_TRADES_FILE << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+bool OTMarket::SaveOffer(OTOffer& theOffer)
+{
+    // Offers which aren't resting on the market aren't in the market file
+    // either, so there is nothing to save.
+    if (m_mapOffers.end() == m_mapOffers.find(theOffer.GetTransactionNum())) {
+        return true;
+    }
+
+    const String strOffer(theOffer);
+    OTASCIIArmor ascOffer;
+    ascOffer.SetString(strOffer, false); // linebreaks = false
+
+    return journal("update", ascOffer.Get());
+}
+
+bool OTMarket::SaveTrade(OTOffer& theOffer, OTOffer& theOtherOffer)
+{
+    bool bSuccess = SaveOffer(theOffer) && SaveOffer(theOtherOffer);
+
+    std::string strSale = formatLong(m_lLastSalePrice);
+
+    if (!m_strLastSaleDate.empty()) strSale += ' ' + m_strLastSaleDate;
+
+    bSuccess = bSuccess && journal("sale", strSale);
+    save_trade_list();
+
+    return bSuccess;
+}
+
+CronJournal& OTMarket::journal_file()
+{
+    OT_ASSERT(nullptr != GetCron());
+    OT_ASSERT(nullptr != GetCron()->GetServerNym());
+
+    if (!m_pJournal) {
+        Identifier MARKET_ID(*this);
+        String str_MARKET_ID(MARKET_ID);
+        m_pJournal.reset(new CronJournal(OTFolders::Market().Get(),
+                                         std::string(str_MARKET_ID.Get()) +
+                                             ".jnl",
+                                         *(GetCron()->GetServerNym())));
+    }
+
+    return *m_pJournal;
+}
+
+// Appends one change to the journal. Falls back to saving the whole market
+// file when the journal is disabled, full, or can't be written, or if the
+// market file has never been saved.
+bool OTMarket::journal(const std::string& strType, const std::string& strArgs)
+{
+    const int32_t nLimit = OTCron::GetCronJournalRecords();
+    Identifier MARKET_ID(*this);
+    String str_MARKET_ID(MARKET_ID);
+
+    if ((0 >= nLimit) ||
+        !OTDB::Exists(OTFolders::Market().Get(), str_MARKET_ID.Get())) {
+        return SaveMarket();
+    }
+
+    if (!journal_file().Append(m_lJournalGeneration, strType + ' ' + strArgs)) {
+        return SaveMarket();
+    }
+
+    if (static_cast<std::size_t>(nLimit) <= journal_file().Size()) {
+        return SaveMarket();
+    }
+
+    return true;
+}
+
+OTOffer* OTMarket::load_offer(const std::string& strArmored)
+{
+    const OTASCIIArmor ascOffer(strArmored.c_str());
+    String strOffer;
+
+    if (!ascOffer.GetString(strOffer, false)) return nullptr;
+
+    OTOffer* pOffer = new OTOffer(m_NOTARY_ID, m_INSTRUMENT_DEFINITION_ID,
+                                  m_CURRENCY_TYPE_ID, m_lScale);
+
+    OT_ASSERT(nullptr != pOffer);
+
+    if (!pOffer->LoadContractFromString(strOffer)) {
+        delete pOffer;
+        return nullptr;
+    }
+
+    pOffer->SetArmored(strArmored);
+
+    return pOffer;
+}
+
+// Applies one journal record while loading.
+bool OTMarket::replay(const std::string& strRecord)
+{
+    std::istringstream in(strRecord);
+    std::string strType;
+
+    in >> strType;
+
+    if ("sale" == strType) {
+        in >> m_lLastSalePrice;
+
+        if (in.fail()) return false;
+
+        m_strLastSaleDate.clear();
+        in >> m_strLastSaleDate;
+
+        return true;
+    }
+
+    if ("remove" == strType) {
+        int64_t lTransactionNum = 0;
+        in >> lTransactionNum;
+
+        return !in.fail() && remove_offer(lTransactionNum);
+    }
+
+    std::string strDateAdded, strArmored;
+
+    if ("add" == strType) in >> strDateAdded;
+
+    in >> strArmored;
+
+    if (in.fail() || (("add" != strType) && ("update" != strType))) {
+        return false;
+    }
+
+    OTOffer* pOffer = load_offer(strArmored);
+
+    if (nullptr == pOffer) return false;
+
+    time64_t tDateAdded = OT_TIME_ZERO;
+
+    if ("add" == strType) {
+        tDateAdded = OTTimeGetTimeFromSeconds(parseTimestamp(strDateAdded));
+    }
+    else {
+        OTOffer* pExisting = GetOffer(pOffer->GetTransactionNum());
+
+        if (nullptr == pExisting) {
+            delete pOffer;
+            return false;
+        }
+
+        tDateAdded = pExisting->GetDateAddedToMarket();
+        remove_offer(pOffer->GetTransactionNum());
+    }
+
+    if (!AddOffer(nullptr, *pOffer, false, tDateAdded)) {
+        delete pOffer;
+        return false;
     }
 
     return true;
@@ -872,9 +1230,9 @@ int64_t OTMarket::GetLowestAskPrice()
 {
     int64_t lPrice = 0;
 
-    auto it = m_mapAsks.begin();
+    auto it = m_mapAskLevels.begin();
 
-    if (it != m_mapAsks.end()) {
+    if (it != m_mapAskLevels.end()) {
         lPrice = it->first;
 
         // Market orders have a 0 price, so we need to skip any if they are
@@ -885,12 +1243,11 @@ int64_t OTMarket::GetLowestAskPrice()
         // other
         // actual prices, so we need to skip any that have a 0 price.
         //
-        while (0 == lPrice) {
+        // All market orders share a single price level, so at most one step.
+        if (0 == lPrice) {
             ++it;
 
-            if (it == m_mapAsks.end()) break;
-
-            lPrice = it->first;
+            lPrice = (it == m_mapAskLevels.end()) ? 0 : it->first;
         }
     }
 
@@ -1791,6 +2148,8 @@ void OTMarket::ProcessTrade(OTTrade& theTrade, OTOffer& theOffer,
                 theOtherOffer.IncrementFinishedSoFar(
                     lOtherOfferFinished); // I was storing these up in the loop
                                           // above.
+                offer_filled(theOffer, lOfferFinished);
+                offer_filled(theOtherOffer, lOtherOfferFinished);
 
                 // These have updated values, so let's save them.
                 theTrade.ReleaseSignatures();
@@ -1859,12 +2218,13 @@ void OTMarket::ProcessTrade(OTTrade& theTrade, OTOffer& theOffer,
                 // just processed.
                 // Make sure to save the Market since it contains those offers
                 // that have just updated.
-                SaveMarket();
+                SaveTrade(theOffer, theOtherOffer);
 
                 // The Trade has changed, and it is stored as a CronItem. So I
                 // save Cron as well, for
                 // the same reason I saved the Market.
-                pCron->SaveCron();
+                pCron->SaveCronItem(theTrade);
+                pCron->SaveCronItem(*pOtherTrade);
             }
 
             //
@@ -2391,7 +2751,7 @@ bool OTMarket::ProcessTrade(OTTrade& theTrade, OTOffer& theOffer)
     //
     if ((0 == lRelevantPrice) && // Market order has 0 price.
         theOffer.IsMarketOrder()) {
-        otInfo << "OTMarket::" << __FUNCTION__ << ": Removing market order that has 0 price: "
+        OT_LOG(otInfo) << "OTMarket::" << __FUNCTION__ << ": Removing market order that has 0 price: "
             << formatLong(theTrade.GetOpeningNum()) << "\n";
         return false;
     }
@@ -2507,7 +2867,7 @@ bool OTMarket::ProcessTrade(OTTrade& theTrade, OTOffer& theOffer)
                 (theOffer.GetMinimumIncrement() >
                  theOffer.GetAmountAvailable())) {
 
-                    otInfo << "OTMarket::" << __FUNCTION__ << ": Removing market order: "
+                    OT_LOG(otInfo) << "OTMarket::" << __FUNCTION__ << ": Removing market order: "
                         << formatLong(theTrade.GetOpeningNum()) << ". IsFlaggedForRemoval: "
                         << formatBool(theTrade.IsFlaggedForRemoval())
                         << ". Minimum increment is larger than Amount available: "
@@ -2592,7 +2952,7 @@ bool OTMarket::ProcessTrade(OTTrade& theTrade, OTOffer& theOffer)
                 (theOffer.GetMinimumIncrement() >
                  theOffer.GetAmountAvailable())) {
 
-                    otInfo << "OTMarket::" << __FUNCTION__ << ": Removing market order: "
+                    OT_LOG(otInfo) << "OTMarket::" << __FUNCTION__ << ": Removing market order: "
                         << formatLong(theTrade.GetOpeningNum()) << ". IsFlaggedForRemoval: "
                         << formatBool(theTrade.IsFlaggedForRemoval())
                         << ". Minimum increment is larger than Amount available: "
@@ -2776,6 +3136,14 @@ void OTMarket::Release_Market()
         delete pOffer;
         pOffer = nullptr;
     }
+
+    m_mapOffers.clear();
+    m_mapBidLevels.clear();
+    m_mapAskLevels.clear();
+    m_mapNymOffers.clear();
+    m_setUnindexedOffers.clear();
+    m_mapOfferListCache.clear();
+    m_lVersion++;
 }
 
 void OTMarket::Release()
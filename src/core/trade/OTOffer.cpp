@@ -40,6 +40,7 @@
 
 #include "opentxs/core/trade/OTOffer.hpp"
 
+#include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/Tag.hpp"
 #include "opentxs/core/Contract.hpp"
@@ -318,6 +319,7 @@ void OTOffer::UpdateContents()
 
     // I release this because I'm about to repopulate it.
     m_xmlUnsigned.Release();
+    m_strArmored.clear();
 
     Tag tag("marketOffer");
 
@@ -420,6 +422,22 @@ void OTOffer::SetDateAddedToMarket(time64_t tDate)  // Used in OTCron when
     m_tDateAddedToMarket = tDate;
 }
 
+const std::string& OTOffer::GetArmored()
+{
+    if (m_strArmored.empty()) {
+        const String strOffer(*this);
+        const OTASCIIArmor ascOffer(strOffer);
+        m_strArmored = ascOffer.Get();
+    }
+
+    return m_strArmored;
+}
+
+void OTOffer::SetArmored(const std::string& strArmored)
+{
+    m_strArmored = strArmored;
+}
+
 OTOffer::OTOffer()
     : Instrument()
     , m_tDateAddedToMarket(OT_TIME_ZERO)
@@ -470,6 +488,7 @@ void OTOffer::Release_Offer()
 {
     // If there were any dynamically allocated objects, clean them up here.
     m_CURRENCY_TYPE_ID.Release();
+    m_strArmored.clear();
 }
 
 void OTOffer::Release()
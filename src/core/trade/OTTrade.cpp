@@ -532,7 +532,7 @@ OTOffer* OTTrade::GetOffer(Identifier* offerMarketId, OTMarket** market)
             offer_->SignContract(*(GetCron()->GetServerNym()));
             offer_->SaveContract();
 
-            pMarket->SaveMarket();
+            pMarket->SaveOffer(*offer_);
 
             // Now when the market loads next time, it can verify this offer
             // using the server's signature,
@@ -599,7 +599,7 @@ OTOffer* OTTrade::GetOffer(Identifier* offerMarketId, OTMarket** market)
                 offer_->SignContract(*(GetCron()->GetServerNym()));
                 offer_->SaveContract();
 
-                pMarket->SaveMarket();
+                pMarket->SaveOffer(*offer_);
 
                 // Now when the market loads next time, it can verify this offer
                 // using the server's signature,
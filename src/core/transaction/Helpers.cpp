@@ -43,7 +43,9 @@
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/Tag.hpp"
 #include "opentxs/core/Contract.hpp"
+#include "opentxs/core/Data.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Ledger.hpp"
 #include "opentxs/core/Log.hpp"
@@ -57,6 +59,8 @@
 #include <inttypes.h>
 #include <irrxml/irrXML.hpp>
 #include <stdint.h>
+#include <cstddef>
+#include <functional>
 #include <ostream>
 #include <string>
 
@@ -151,8 +155,98 @@ const char* GetOriginTypeToString(int originTypeIndex) // enum originType
     return OriginTypeStrings[originTypeIndex];
 }
 
+namespace
+{
+
+typedef std::function<const char*(const char*)> RecordAttribute;
+
+// Version of the binary layout written by PackAbbreviatedRecords.
+const std::uint8_t PACKED_RECORD_VERSION = 1;
+
+void pack(Data& output, const std::uint8_t value)
+{
+    output.Concatenate(&value, sizeof(value));
+}
+
+void pack(Data& output, const std::uint32_t value)
+{
+    const std::uint8_t bytes[4] = {static_cast<std::uint8_t>(value >> 24),
+                                   static_cast<std::uint8_t>(value >> 16),
+                                   static_cast<std::uint8_t>(value >> 8),
+                                   static_cast<std::uint8_t>(value)};
+    output.Concatenate(bytes, sizeof(bytes));
+}
+
+void pack(Data& output, const std::int64_t value)
+{
+    const std::uint64_t raw = static_cast<std::uint64_t>(value);
+    pack(output, static_cast<std::uint32_t>(raw >> 32));
+    pack(output, static_cast<std::uint32_t>(raw));
+}
+
+void pack(Data& output, const String& value)
+{
+    pack(output, static_cast<std::uint32_t>(value.GetLength()));
+
+    if (value.Exists()) output.Concatenate(value.Get(), value.GetLength());
+}
+
+bool unpack(const Data& input, std::size_t& offset, std::uint8_t& value)
+{
+    if (offset + 1 > input.GetSize()) return false;
+
+    value = static_cast<const std::uint8_t*>(input.GetPointer())[offset++];
+
+    return true;
+}
+
+bool unpack(const Data& input, std::size_t& offset, std::uint32_t& value)
+{
+    if (offset + 4 > input.GetSize()) return false;
+
+    const auto* bytes =
+        static_cast<const std::uint8_t*>(input.GetPointer()) + offset;
+    value = (static_cast<std::uint32_t>(bytes[0]) << 24) |
+            (static_cast<std::uint32_t>(bytes[1]) << 16) |
+            (static_cast<std::uint32_t>(bytes[2]) << 8) |
+            static_cast<std::uint32_t>(bytes[3]);
+    offset += 4;
+
+    return true;
+}
+
+bool unpack(const Data& input, std::size_t& offset, std::int64_t& value)
+{
+    std::uint32_t high = 0, low = 0;
+
+    if (!unpack(input, offset, high) || !unpack(input, offset, low))
+        return false;
+
+    value = static_cast<std::int64_t>(
+        (static_cast<std::uint64_t>(high) << 32) | low);
+
+    return true;
+}
+
+bool unpack(const Data& input, std::size_t& offset, String& value)
+{
+    std::uint32_t size = 0;
+    value.Release();
+
+    if (!unpack(input, offset, size)) return false;
+    if (offset + size > input.GetSize()) return false;
+
+    if (0 < size) {
+        value = String(
+            static_cast<const char*>(input.GetPointer()) + offset, size);
+        offset += size;
+    }
+
+    return true;
+}
+
 // Returns 1 if success, -1 if error.
-int32_t LoadAbbreviatedRecord(irr::io::IrrXMLReader*& xml,
+int32_t LoadAbbreviatedRecord(const RecordAttribute& attribute,
                               int64_t& lNumberOfOrigin,
                               int& theOriginType,
                               int64_t& lTransactionNum,
@@ -166,15 +260,15 @@ int32_t LoadAbbreviatedRecord(irr::io::IrrXMLReader*& xml,
                               int64_t& lClosingNum,
                               int64_t& lRequestNum,
                               bool& bReplyTransSuccess,
-                              NumList* pNumList)
+                              String& strNumbers)
 {
 
-    const String strOriginNum = xml->getAttributeValue("numberOfOrigin");
-    const String strOriginType = xml->getAttributeValue("originType");
-    const String strTransNum = xml->getAttributeValue("transactionNum");
-    const String strInRefTo = xml->getAttributeValue("inReferenceTo");
-    const String strInRefDisplay = xml->getAttributeValue("inRefDisplay");
-    const String strDateSigned = xml->getAttributeValue("dateSigned");
+    const String strOriginNum = attribute("numberOfOrigin");
+    const String strOriginType = attribute("originType");
+    const String strTransNum = attribute("transactionNum");
+    const String strInRefTo = attribute("inReferenceTo");
+    const String strInRefDisplay = attribute("inRefDisplay");
+    const String strDateSigned = attribute("dateSigned");
 
     if (!strTransNum.Exists() || !strInRefTo.Exists() ||
         !strInRefDisplay.Exists() || !strDateSigned.Exists()) {
@@ -199,9 +293,9 @@ int32_t LoadAbbreviatedRecord(irr::io::IrrXMLReader*& xml,
     // Transaction TYPE for the abbreviated record...
     theType = OTTransaction::error_state; // default
     const String strAbbrevType =
-        xml->getAttributeValue("type"); // the type of inbox receipt, or outbox
-                                        // receipt, or nymbox receipt.
-                                        // (Transaction type.)
+        attribute("type"); // the type of inbox receipt, or outbox
+                           // receipt, or nymbox receipt.
+                           // (Transaction type.)
     if (strAbbrevType.Exists()) {
         theType = OTTransaction::GetTypeFromString(strAbbrevType);
 
@@ -226,7 +320,7 @@ int32_t LoadAbbreviatedRecord(irr::io::IrrXMLReader*& xml,
 
     // RECEIPT HASH
     //
-    strHash = xml->getAttributeValue("receiptHash");
+    strHash = attribute("receiptHash");
     if (!strHash.Exists()) {
         otOut << "LoadAbbreviatedRecord: Failure: Expected "
                  "receiptHash while loading "
@@ -239,16 +333,16 @@ int32_t LoadAbbreviatedRecord(irr::io::IrrXMLReader*& xml,
     lDisplayValue = 0;
     lClosingNum = 0;
 
-    const String strAbbrevAdjustment = xml->getAttributeValue("adjustment");
+    const String strAbbrevAdjustment = attribute("adjustment");
     if (strAbbrevAdjustment.Exists())
         lAdjustment = strAbbrevAdjustment.ToLong();
     // -------------------------------------
-    const String strAbbrevDisplayValue = xml->getAttributeValue("displayValue");
+    const String strAbbrevDisplayValue = attribute("displayValue");
     if (strAbbrevDisplayValue.Exists())
         lDisplayValue = strAbbrevDisplayValue.ToLong();
 
     if (OTTransaction::replyNotice == theType) {
-        const String strRequestNum = xml->getAttributeValue("requestNumber");
+        const String strRequestNum = attribute("requestNumber");
 
         if (!strRequestNum.Exists()) {
             otOut << "LoadAbbreviatedRecord: Failed loading "
@@ -260,7 +354,7 @@ int32_t LoadAbbreviatedRecord(irr::io::IrrXMLReader*& xml,
         }
         lRequestNum = strRequestNum.ToLong();
 
-        const String strTransSuccess = xml->getAttributeValue("transSuccess");
+        const String strTransSuccess = attribute("transSuccess");
 
         bReplyTransSuccess = strTransSuccess.Compare("true");
     } // if replyNotice (expecting request Number)
@@ -271,7 +365,7 @@ int32_t LoadAbbreviatedRecord(irr::io::IrrXMLReader*& xml,
     //
     if ((OTTransaction::finalReceipt == theType) ||
         (OTTransaction::basketReceipt == theType)) {
-        const String strAbbrevClosingNum = xml->getAttributeValue("closingNum");
+        const String strAbbrevClosingNum = attribute("closingNum");
 
         if (!strAbbrevClosingNum.Exists()) {
             otOut << "LoadAbbreviatedRecord: Failed loading "
@@ -285,15 +379,194 @@ int32_t LoadAbbreviatedRecord(irr::io::IrrXMLReader*& xml,
 
     // These types carry their own internal list of numbers.
     //
+    strNumbers.Release();
+
+    if ((OTTransaction::blank == theType) ||
+        (OTTransaction::successNotice == theType)) {
+        strNumbers = attribute("totalListOfNumbers");
+    } // if blank or successNotice (expecting totalListOfNumbers.. no more
+      // multiple blanks in the same ledger! They all go in a single
+      // transaction.)
+
+    return 1;
+}
+
+} // namespace
+
+// Returns 1 if success, -1 if error.
+int32_t LoadAbbreviatedRecord(irr::io::IrrXMLReader*& xml,
+                              int64_t& lNumberOfOrigin,
+                              int& theOriginType,
+                              int64_t& lTransactionNum,
+                              int64_t& lInRefTo,
+                              int64_t& lInRefDisplay,
+                              time64_t& the_DATE_SIGNED,
+                              int& theType,
+                              String& strHash,
+                              int64_t& lAdjustment,
+                              int64_t& lDisplayValue,
+                              int64_t& lClosingNum,
+                              int64_t& lRequestNum,
+                              bool& bReplyTransSuccess,
+                              NumList* pNumList)
+{
+    String strNumbers;
+    const int32_t nReturnVal = LoadAbbreviatedRecord(
+        [&xml](const char* name) { return xml->getAttributeValue(name); },
+        lNumberOfOrigin, theOriginType, lTransactionNum, lInRefTo,
+        lInRefDisplay, the_DATE_SIGNED, theType, strHash, lAdjustment,
+        lDisplayValue, lClosingNum, lRequestNum, bReplyTransSuccess,
+        strNumbers);
+
+    if ((1 == nReturnVal) && (nullptr != pNumList) &&
+        ((OTTransaction::blank == theType) ||
+         (OTTransaction::successNotice == theType))) {
+        pNumList->Release();
+
+        if (strNumbers.Exists()) pNumList->Add(strNumbers);
+    }
+
+    return nReturnVal;
+}
+
+// The records are read back from the attributes SaveAbbreviated*Record wrote,
+// through the same validation as the XML loader, so both formats carry exactly
+// the same fields.
+bool PackAbbreviatedRecords(const Tag& records, Data& output)
+{
+    output.Release();
+    pack(output, PACKED_RECORD_VERSION);
+
+    for (const auto& record : records.tags()) {
+        OT_ASSERT(record);
+
+        const auto& attributes = record->attributes();
+        auto attribute = [&attributes](const char* name) -> const char* {
+            const auto it = attributes.find(name);
+
+            return (attributes.end() == it) ? nullptr : it->second.c_str();
+        };
+
+        int64_t lNumberOfOrigin = 0;
+        int theOriginType = static_cast<int>(originType::not_applicable);
+        int64_t lTransactionNum = 0;
+        int64_t lInRefTo = 0;
+        int64_t lInRefDisplay = 0;
+        time64_t the_DATE_SIGNED = OT_TIME_ZERO;
+        int theType = OTTransaction::error_state;
+        String strHash;
+        int64_t lAdjustment = 0;
+        int64_t lDisplayValue = 0;
+        int64_t lClosingNum = 0;
+        int64_t lRequestNum = 0;
+        bool bReplyTransSuccess = false;
+        String strNumbers;
+
+        if (1 != LoadAbbreviatedRecord(
+                     attribute, lNumberOfOrigin, theOriginType,
+                     lTransactionNum, lInRefTo, lInRefDisplay,
+                     the_DATE_SIGNED, theType, strHash, lAdjustment,
+                     lDisplayValue, lClosingNum, lRequestNum,
+                     bReplyTransSuccess, strNumbers)) {
+            otErr << __FUNCTION__ << ": Failed packing abbreviated "
+                  << record->name() << ".\n";
+
+            return false;
+        }
+
+        OT_ASSERT((0 <= theType) && (0xff >= theType));
+        OT_ASSERT((0 <= theOriginType) && (0xff >= theOriginType));
+
+        pack(output, static_cast<std::uint8_t>(theType));
+        pack(output, static_cast<std::uint8_t>(theOriginType));
+        pack(output, lNumberOfOrigin);
+        pack(output, lTransactionNum);
+        pack(output, lInRefTo);
+        pack(output, lInRefDisplay);
+        pack(output, static_cast<std::int64_t>(the_DATE_SIGNED));
+        pack(output, lAdjustment);
+        pack(output, lDisplayValue);
+        pack(output, lClosingNum);
+        pack(output, lRequestNum);
+        pack(output, static_cast<std::uint8_t>(bReplyTransSuccess ? 1 : 0));
+        pack(output, strHash);
+        pack(output, strNumbers);
+    }
+
+    return true;
+}
+
+// Returns 1 if success, -1 if error.
+int32_t UnpackAbbreviatedRecord(const Data& input,
+                                std::size_t& offset,
+                                int64_t& lNumberOfOrigin,
+                                int& theOriginType,
+                                int64_t& lTransactionNum,
+                                int64_t& lInRefTo,
+                                int64_t& lInRefDisplay,
+                                time64_t& the_DATE_SIGNED,
+                                int& theType,
+                                String& strHash,
+                                int64_t& lAdjustment,
+                                int64_t& lDisplayValue,
+                                int64_t& lClosingNum,
+                                int64_t& lRequestNum,
+                                bool& bReplyTransSuccess,
+                                NumList* pNumList)
+{
+    if (0 == offset) {
+        std::uint8_t version = 0;
+
+        if (!unpack(input, offset, version) ||
+            (PACKED_RECORD_VERSION != version)) {
+            otErr << __FUNCTION__ << ": Unsupported packed record version "
+                  << static_cast<int>(version) << ".\n";
+
+            return (-1);
+        }
+    }
+
+    std::uint8_t type = 0, origin = 0, success = 0;
+    std::int64_t date = 0;
+    String strNumbers;
+
+    const bool bUnpacked =
+        unpack(input, offset, type) && unpack(input, offset, origin) &&
+        unpack(input, offset, lNumberOfOrigin) &&
+        unpack(input, offset, lTransactionNum) &&
+        unpack(input, offset, lInRefTo) &&
+        unpack(input, offset, lInRefDisplay) && unpack(input, offset, date) &&
+        unpack(input, offset, lAdjustment) &&
+        unpack(input, offset, lDisplayValue) &&
+        unpack(input, offset, lClosingNum) &&
+        unpack(input, offset, lRequestNum) &&
+        unpack(input, offset, success) && unpack(input, offset, strHash) &&
+        unpack(input, offset, strNumbers);
+
+    if (!bUnpacked) {
+        otErr << __FUNCTION__ << ": Truncated packed abbreviated record.\n";
+
+        return (-1);
+    }
+
+    theType = type;
+    theOriginType = origin;
+    the_DATE_SIGNED = static_cast<time64_t>(date);
+    bReplyTransSuccess = (0 != success);
+
+    if ((OTTransaction::error_state <= theType) || !strHash.Exists()) {
+        otErr << __FUNCTION__ << ": Invalid packed abbreviated record for "
+              << "trans num: " << lTransactionNum << "\n";
+
+        return (-1);
+    }
+
     if ((nullptr != pNumList) && ((OTTransaction::blank == theType) ||
                                   (OTTransaction::successNotice == theType))) {
-        const String strNumbers = xml->getAttributeValue("totalListOfNumbers");
         pNumList->Release();
 
         if (strNumbers.Exists()) pNumList->Add(strNumbers);
-    } // if blank or successNotice (expecting totalListOfNumbers.. no more
-      // multiple blanks in the same ledger! They all go in a single
-      // transaction.)
+    }
 
     return 1;
 }
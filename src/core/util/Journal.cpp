@@ -0,0 +1,375 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/core/stdafx.hpp"
+
+#include "opentxs/core/util/Journal.hpp"
+
+#include "opentxs/core/Log.hpp"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <cerrno>
+#include <cstdio>
+
+#ifdef _WIN32
+#define OT_JOURNAL_FLAGS (_O_BINARY | _O_NOINHERIT)
+#define OT_JOURNAL_MODE (_S_IREAD | _S_IWRITE)
+#define ot_journal_close ::_close
+#define ot_journal_open ::_open
+#define ot_journal_read ::_read
+#define ot_journal_seek ::_lseeki64
+#define ot_journal_sync ::_commit
+#define ot_journal_truncate ::_chsize_s
+#define ot_journal_write ::_write
+#else
+#define OT_JOURNAL_FLAGS O_CLOEXEC
+#define OT_JOURNAL_MODE (S_IRUSR | S_IWUSR)
+#define ot_journal_close ::close
+#define ot_journal_open ::open
+#define ot_journal_read ::read
+#define ot_journal_seek ::lseek
+#define ot_journal_sync ::fsync
+#define ot_journal_truncate ::ftruncate
+#define ot_journal_write ::write
+#endif
+
+#define OT_METHOD "opentxs::Journal::"
+
+namespace opentxs
+{
+Journal::Journal(const std::string& path)
+    : path_(path)
+    , fd_(-1)
+    , length_(0)
+    , records_(0)
+{
+}
+
+bool Journal::Append(const std::string& record)
+{
+    if (std::string::npos != record.find('\n')) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Record contains a line "
+              << "break." << std::endl;
+
+        return false;
+    }
+
+    if (false == open()) {
+
+        return false;
+    }
+
+    const std::string line = record + '\n';
+
+    // A record which did not reach the disk completely is cut off again, so
+    // the next one starts on a fresh line.
+    if ((false == write_all(fd_, line)) || (0 != ot_journal_sync(fd_))) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write to "
+              << path_ << std::endl;
+
+        if ((0 != ot_journal_truncate(fd_, length_)) ||
+            (length_ != ot_journal_seek(fd_, length_, SEEK_SET))) {
+            close();
+        }
+
+        return false;
+    }
+
+    length_ += line.size();
+    ++records_;
+
+    return true;
+}
+
+void Journal::close()
+{
+    if (-1 != fd_) {
+        ot_journal_close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool Journal::open()
+{
+    if (-1 != fd_) {
+
+        return true;
+    }
+
+    fd_ = ot_journal_open(
+        path_.c_str(), O_RDWR | O_CREAT | OT_JOURNAL_FLAGS, OT_JOURNAL_MODE);
+
+    if (-1 == fd_) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to open " << path_
+              << std::endl;
+
+        return false;
+    }
+
+    std::string contents{};
+
+    if (false == read_file(fd_, contents)) {
+        close();
+
+        return false;
+    }
+
+    const auto end = contents.rfind('\n');
+    length_ = (std::string::npos == end) ? 0 : (end + 1);
+    records_ = 0;
+
+    for (std::int64_t i = 0; i < length_; ++i) {
+        if ('\n' == contents[i]) {
+            ++records_;
+        }
+    }
+
+    if (static_cast<std::int64_t>(contents.size()) != length_) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": Removing an unfinished "
+               << "record from " << path_ << std::endl;
+
+        if ((0 != ot_journal_truncate(fd_, length_)) ||
+            (0 != ot_journal_sync(fd_))) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Unable to repair "
+                  << path_ << std::endl;
+            close();
+
+            return false;
+        }
+    }
+
+    if (length_ != ot_journal_seek(fd_, length_, SEEK_SET)) {
+        close();
+
+        return false;
+    }
+
+    return true;
+}
+
+bool Journal::Read(const Reader& reader)
+{
+    if (false == open()) {
+
+        return false;
+    }
+
+    std::string contents{};
+    const bool readFile = read_file(fd_, contents);
+
+    if ((false == readFile) ||
+        (length_ != ot_journal_seek(fd_, length_, SEEK_SET))) {
+        close();
+
+        return false;
+    }
+
+    std::size_t start{0};
+
+    while (static_cast<std::int64_t>(start) < length_) {
+        const auto end = contents.find('\n', start);
+
+        if (std::string::npos == end) {
+
+            break;
+        }
+
+        if (false == reader(contents.substr(start, end - start))) {
+
+            return false;
+        }
+
+        start = end + 1;
+    }
+
+    return true;
+}
+
+bool Journal::read_file(const int fd, std::string& output)
+{
+    output.clear();
+
+    if (0 != ot_journal_seek(fd, 0, SEEK_SET)) {
+
+        return false;
+    }
+
+    char buffer[65536];
+
+    while (true) {
+        const auto bytes = ot_journal_read(fd, buffer, sizeof(buffer));
+
+        if (0 == bytes) {
+
+            return true;
+        }
+
+        if (0 > bytes) {
+            if (EINTR == errno) {
+
+                continue;
+            }
+
+            return false;
+        }
+
+        output.append(buffer, bytes);
+    }
+}
+
+bool Journal::Rewrite(const std::vector<std::string>& records)
+{
+    std::string contents{};
+
+    for (const auto& record : records) {
+        if (std::string::npos != record.find('\n')) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Record contains a line "
+                  << "break." << std::endl;
+
+            return false;
+        }
+
+        contents += record;
+        contents += '\n';
+    }
+
+    const std::string temp = path_ + ".tmp";
+    const int fd = ot_journal_open(
+        temp.c_str(),
+        O_RDWR | O_CREAT | O_TRUNC | OT_JOURNAL_FLAGS,
+        OT_JOURNAL_MODE);
+
+    if (-1 == fd) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to create " << temp
+              << std::endl;
+
+        return false;
+    }
+
+    const bool written =
+        write_all(fd, contents) && (0 == ot_journal_sync(fd));
+    ot_journal_close(fd);
+
+    if (false == written) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write " << temp
+              << std::endl;
+        std::remove(temp.c_str());
+
+        return false;
+    }
+
+    close();
+
+#ifdef _WIN32
+    std::remove(path_.c_str());
+#endif
+
+    if ((0 != std::rename(temp.c_str(), path_.c_str())) ||
+        (false == sync_folder(path_))) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to replace " << path_
+              << std::endl;
+
+        return false;
+    }
+
+    return open();
+}
+
+std::size_t Journal::Size()
+{
+    open();
+
+    return records_;
+}
+
+// Makes a rename inside the folder holding path durable
+bool Journal::sync_folder(const std::string& path)
+{
+#ifdef _WIN32
+    return true;
+#else
+    const auto slash = path.rfind('/');
+    const std::string folder =
+        (std::string::npos == slash) ? "." : path.substr(0, slash + 1);
+    const int fd = ::open(folder.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (-1 == fd) {
+
+        return false;
+    }
+
+    const bool output = (0 == ::fsync(fd));
+    ::close(fd);
+
+    return output;
+#endif
+}
+
+bool Journal::write_all(const int fd, const std::string& data)
+{
+    std::size_t written{0};
+
+    while (written < data.size()) {
+        const auto bytes =
+            ot_journal_write(fd, data.data() + written, data.size() - written);
+
+        if (0 > bytes) {
+            if (EINTR == errno) {
+
+                continue;
+            }
+
+            return false;
+        }
+
+        written += bytes;
+    }
+
+    return true;
+}
+
+Journal::~Journal() { close(); }
+}  // namespace opentxs
@@ -40,28 +40,83 @@
 
 #include "opentxs/core/util/Tag.hpp"
 
+#include "opentxs/core/util/Assert.hpp"
+
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 
 namespace opentxs
 {
+namespace
+{
+// The output is signed, so it must not change: attributes sorted by name,
+// the first value of a duplicate name wins, and nothing is escaped.
+template <typename Iterator>
+void write_start(
+    std::string& output,
+    const std::string& name,
+    Iterator begin,
+    Iterator end)
+{
+    output += '<';
+    output += name;
+
+    for (auto it = begin; it != end; ++it) {
+        output += "\n ";
+        output += it->first;
+        output += "=\"";
+        output += it->second;
+        output += '"';
+    }
+}
+
+void write_end(std::string& output, const std::string& name)
+{
+    output += "\n</";
+    output += name;
+    output += ">\n";
+}
+}  // namespace
 
 void Tag::add_attribute(const std::string& str_att_name,
                         const char* sz_att_value)
 {
-    std::string str_temp(sz_att_value);
-
-    add_attribute(str_att_name, str_temp);
+    attributes_.emplace(str_att_name, sz_att_value);
 }
 
 void Tag::add_attribute(const std::string& str_att_name,
                         const std::string& str_att_value)
 {
-    std::pair<std::string, std::string> temp =
-        std::make_pair(str_att_name, str_att_value);
+    attributes_.emplace(str_att_name, str_att_value);
+}
+
+std::size_t Tag::size() const
+{
+    std::size_t output = 1 + name_.size();
+
+    for (auto& kv : attributes_) {
+        output += 5 + kv.first.size() + kv.second.size();
+    }
+
+    if (text_.empty() && tags_.empty()) {
+
+        return output + 4;
+    }
+
+    output += 7 + name_.size();
+
+    if (!text_.empty()) {
+        output += text_.size();
+    }
+    else {
+        for (auto& kv : tags_) {
+            output += kv->size();
+        }
+    }
 
-    attributes_.insert(temp);
+    return output;
 }
 
 void Tag::output(std::string& str_output) const
@@ -71,13 +126,13 @@ void Tag::output(std::string& str_output) const
 
 void Tag::outputXML(std::string& str_output) const
 {
-    str_output += ("<" + name_);
+    str_output.reserve(str_output.size() + size());
+    write(str_output);
+}
 
-    if (!attributes_.empty()) {
-        for (auto& kv : attributes_) {
-            str_output += ("\n " + kv.first + "=\"" + kv.second + "\"");
-        }
-    }
+void Tag::write(std::string& str_output) const
+{
+    write_start(str_output, name_, attributes_.begin(), attributes_.end());
 
     if (text_.empty() && tags_.empty()) {
         str_output += " />\n";
@@ -88,13 +143,13 @@ void Tag::outputXML(std::string& str_output) const
         if (!text_.empty()) {
             str_output += text_;
         }
-        else if (!tags_.empty()) {
+        else {
             for (auto& kv : tags_) {
-                kv->output(str_output);
+                kv->write(str_output);
             }
         }
 
-        str_output += ("\n</" + name_ + ">\n");
+        write_end(str_output, name_);
     }
 }
 
@@ -106,9 +161,7 @@ void Tag::add_tag(TagPtr& tag_input)
 void Tag::add_tag(const std::string& str_tag_name,
                   const std::string& str_tag_value)
 {
-    TagPtr p1 = std::make_shared<Tag>(str_tag_name, str_tag_value);
-
-    add_tag(p1);
+    tags_.push_back(std::make_shared<Tag>(str_tag_name, str_tag_value));
 }
 
 Tag::Tag(const std::string& str_name)
@@ -128,4 +181,128 @@ Tag::Tag(const std::string& str_name, const char* sztext)
 {
 }
 
+TagWriter::TagWriter(std::string& output, const std::size_t reserve)
+    : output_(output)
+    , attributes_()
+    , open_()
+    , started_(true)
+{
+    output_.reserve(output_.size() + reserve);
+}
+
+void TagWriter::Attribute(const std::string& name, const std::string& value)
+{
+    OT_ASSERT(false == started_);
+
+    attributes_.emplace_back(name, value);
+}
+
+void TagWriter::Attribute(const std::string& name, const char* value)
+{
+    OT_ASSERT(false == started_);
+
+    attributes_.emplace_back(name, value);
+}
+
+void TagWriter::Close()
+{
+    if (open_.empty()) {
+
+        return;
+    }
+
+    auto& element = open_.back();
+
+    if (false == started_) {
+        start(true);
+    } else if (element.content_) {
+        write_end(output_, element.name_);
+    }
+
+    open_.pop_back();
+    started_ = true;
+}
+
+void TagWriter::Leaf(const std::string& name, const std::string& text)
+{
+    Open(name);
+    Text(text);
+    Close();
+}
+
+void TagWriter::Open(const std::string& name)
+{
+    if (false == open_.empty()) {
+        if (false == started_) {
+            start(false);
+        }
+
+        open_.back().content_ = true;
+    }
+
+    open_.emplace_back();
+    open_.back().name_ = name;
+    attributes_.clear();
+    started_ = false;
+}
+
+void TagWriter::start(const bool empty)
+{
+    std::stable_sort(
+        attributes_.begin(),
+        attributes_.end(),
+        [](const std::pair<std::string, std::string>& lhs,
+           const std::pair<std::string, std::string>& rhs) -> bool {
+            return lhs.first < rhs.first;
+        });
+    const auto end = std::unique(
+        attributes_.begin(),
+        attributes_.end(),
+        [](const std::pair<std::string, std::string>& lhs,
+           const std::pair<std::string, std::string>& rhs) -> bool {
+            return lhs.first == rhs.first;
+        });
+    write_start(output_, open_.back().name_, attributes_.begin(), end);
+    output_ += empty ? " />\n" : ">\n";
+    attributes_.clear();
+    started_ = true;
+}
+
+void TagWriter::Text(const std::string& text)
+{
+    OT_ASSERT(false == open_.empty());
+
+    if (text.empty()) {
+
+        return;
+    }
+
+    if (false == started_) {
+        start(false);
+    }
+
+    output_ += text;
+    open_.back().content_ = true;
+}
+
+void TagWriter::Write(const Tag& tag)
+{
+    if (false == open_.empty()) {
+        if (false == started_) {
+            start(false);
+        }
+
+        open_.back().content_ = true;
+    }
+
+    tag.outputXML(output_);
+}
+
+TagWriter::~TagWriter()
+{
+    while (false == open_.empty()) {
+        Close();
+    }
+}
+
 } // namespace
@@ -1903,8 +1903,8 @@ int32_t OTPayment::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
         else
             m_Type = OTPayment::ERROR_STATE;
 
-        otLog4 << "Loaded payment... Type: " << GetTypeString()
-               << "\n----------\n";
+        OT_LOG(otLog4) << "Loaded payment... Type: " << GetTypeString()
+                       << "\n----------\n";
 
         return (OTPayment::ERROR_STATE == m_Type) ? (-1) : 1;
     }
@@ -47,6 +47,7 @@
 #include "opentxs/core/crypto/OTKeyring.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/OTDataFolder.hpp"
+#include "opentxs/core/Ledger.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/server/ServerSettings.hpp"
@@ -156,6 +157,20 @@ bool ConfigLoader::load(String& walletFilename)
         OTCron::SetCronMaxItemsPerNym(static_cast<int32_t>(lValue));
     }
 
+    {
+        const char* szComment = "; journal_records is the number of changes "
+                                "to the cron file or a market file which\n"
+                                "; are appended to a journal before the whole "
+                                "file is saved again. 0 saves the\n"
+                                "; whole file after every change.\n";
+
+        bool bIsNewKey = false;
+        std::int64_t lValue = 0;
+        OT::App().Config().CheckSet_long(
+            "cron", "journal_records", 1000, lValue, bIsNewKey, szComment);
+        OTCron::SetCronJournalRecords(static_cast<int32_t>(lValue));
+    }
+
     // HEARTBEAT
 
     {
@@ -242,6 +257,42 @@ bool ConfigLoader::load(String& walletFilename)
         ServerSettings::SetMinMarketScale(lValue);
     }
 
+    // LEDGERS
+
+    {
+        const char* szComment =
+            "; packed_records saves the abbreviated receipts in each box as a "
+            "single packed binary field,\n"
+            "; instead of one XML element per receipt. (Boxes saved in either "
+            "format can still be loaded.)\n";
+
+        bool bIsNewKey = false;
+        bool bValue = false;
+        OT::App().Config().CheckSet_bool(
+            "ledger", "packed_records", false, bValue, bIsNewKey, szComment);
+        Ledger::SetPackedRecords(bValue);
+    }
+
+    // STATISTICS
+
+    {
+        const char* szComment =
+            "; write_interval is the number of seconds between writes of the "
+            "statistics file\n"
+            "; (notary-statistics.json in the data folder.) 0 disables it.\n";
+
+        bool bIsNewKey = false;
+        std::int64_t lValue = 0;
+        OT::App().Config().CheckSet_long(
+            "statistics",
+            "write_interval",
+            ServerSettings::GetStatisticsInterval(),
+            lValue,
+            bIsNewKey,
+            szComment);
+        ServerSettings::SetStatisticsInterval(lValue);
+    }
+
     // SECURITY (beginnings of..)
 
     // Master Key Timeout
@@ -454,6 +505,10 @@ bool ConfigLoader::load(String& walletFilename)
         "permissions",
         "cmd_request_admin",
         ServerSettings::__cmd_request_admin);
+    OT::App().Config().SetOption_bool(
+        "permissions",
+        "cmd_get_statistics",
+        ServerSettings::__cmd_get_statistics);
 
     // Done Loading... Lets save any changes...
     if (!OT::App().Config().Save()) {
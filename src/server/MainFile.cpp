@@ -568,11 +568,19 @@ bool MainFile::LoadServerUserAndContract()
     server_->m_Cron.SetNotaryID(NOTARY_ID);
     server_->m_Cron.SetServerNym(&serverNym);
 
-    if (!server_->m_Cron.LoadCron())
+    if (!server_->m_Cron.LoadCron()) {
+        // Running on without the journaled changes would save a snapshot
+        // which silently drops them.
+        OT_ASSERT_MSG(
+            !server_->m_Cron.JournalFailed(),
+            "ASSERT: MainFile::LoadServerUserAndContract: Failed replaying "
+            "the cron or market journals. The journals were kept with a "
+            ".failed suffix.\n");
         Log::vError(
             "%s: Failed loading Cron file. (Did you just create "
             "this server?)\n",
             szFunc);
+    }
     Log::vOutput(0, "%s: Loading the server contract...\n", szFunc);
 
     auto pContract = OT::App().Contract().Server(NOTARY_ID);
@@ -49,10 +49,12 @@
 #include "opentxs/network/ZMQ.hpp"
 #include "opentxs/server/OTServer.hpp"
 #include "opentxs/server/ServerLoader.hpp"
+#include "opentxs/server/ServerStatistics.hpp"
 #include "opentxs/server/UserCommandProcessor.hpp"
 
 #include <stddef.h>
 #include <sys/types.h>
+#include <chrono>
 #include <ostream>
 #include <string>
 
@@ -99,6 +101,8 @@ void MessageProcessor::init(int port, zcert_t* transportKey)
 void MessageProcessor::run()
 {
     for (;;) {
+        server_->statistics_.Write();
+
         // timeout is the time left until the next cron should execute.
         int64_t timeout = server_->computeTimeout();
         if (timeout <= 0) {
@@ -147,6 +151,16 @@ void MessageProcessor::processSocket()
 
     int rc = zstr_send(zmqSocket_, responseString.c_str());
 
+    // A REP socket can not report its backlog, but a request which is already
+    // waiting by the time the reply goes out means the notary is behind.
+    if (0 != (zsock_events(zmqSocket_) & ZMQ_POLLIN)) {
+        ++backlog_;
+    } else {
+        backlog_ = 0;
+    }
+
+    server_->statistics_.QueueDepth(backlog_);
+
     if (rc != 0) {
         Log::vError(
             "MessageProcessor: failed to send response\n"
@@ -166,10 +180,18 @@ bool MessageProcessor::processMessage(
         return true;
     }
 
-    OTASCIIArmor armored;
-    armored.MemSet(messageString.data(), messageString.size());
+    const auto start = std::chrono::steady_clock::now();
+    auto& statistics = server_->statistics_;
     String serialized;
-    armored.GetString(serialized);
+
+    {
+        ServerStatistics::Timer timer(
+            statistics, ServerStatistics::Phase::dearmor);
+        OTASCIIArmor armored;
+        armored.MemSet(messageString.data(), messageString.size());
+        armored.GetString(serialized);
+    }
+
     Message request;
 
     if (false == serialized.Exists()) {
@@ -179,13 +201,19 @@ bool MessageProcessor::processMessage(
         return true;
     }
 
-    if (false == request.LoadContractFromString(serialized)) {
-        otErr << OT_METHOD << __FUNCTION__
-              << ": Failed to deserialized request." << std::endl;
+    {
+        ServerStatistics::Timer timer(
+            statistics, ServerStatistics::Phase::parse);
 
-        return true;
+        if (false == request.LoadContractFromString(serialized)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to deserialized request." << std::endl;
+
+            return true;
+        }
     }
 
+    const auto type = Message::Type(request.m_strCommand.Get());
     Message repy{};
     const bool processed =
         server_->userCommandProcessor_.ProcessUserCommand(request, repy);
@@ -194,32 +222,43 @@ bool MessageProcessor::processMessage(
         otWarn << OT_METHOD << __FUNCTION__
                << ": Failed to process user command " << request.m_strCommand
                << std::endl;
-        otInfo << String(request) << std::endl;
+        OT_LOG(otInfo) << String(request) << std::endl;
     } else {
         otWarn << OT_METHOD << __FUNCTION__
                << ": Successfully processed user command "
                << request.m_strCommand << std::endl;
     }
 
-    String serializedReply(repy);
+    {
+        ServerStatistics::Timer timer(
+            statistics, ServerStatistics::Phase::armor);
+        String serializedReply(repy);
 
-    if (false == serializedReply.Exists()) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Failed to serialize reply."
-              << std::endl;
+        if (false == serializedReply.Exists()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to serialize reply." << std::endl;
+            statistics.Command(
+                type, std::chrono::steady_clock::now() - start, false);
 
-        return true;
-    }
+            return true;
+        }
 
-    OTASCIIArmor armoredReply(serializedReply);
+        OTASCIIArmor armoredReply(serializedReply);
 
-    if (false == armoredReply.Exists()) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Failed to armor reply."
-              << std::endl;
+        if (false == armoredReply.Exists()) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to armor reply."
+                  << std::endl;
+            statistics.Command(
+                type, std::chrono::steady_clock::now() - start, false);
 
-        return true;
+            return true;
+        }
+
+        reply.assign(armoredReply.Get(), armoredReply.GetLength());
     }
 
-    reply.assign(armoredReply.Get(), armoredReply.GetLength());
+    statistics.Command(
+        type, std::chrono::steady_clock::now() - start, processed);
 
     return false;
 }
@@ -77,6 +77,7 @@
 #include "opentxs/server/Transactor.hpp"
 
 #include <inttypes.h>
+#include <algorithm>
 #include <cstdint>
 #include <deque>
 #include <list>
@@ -84,6 +85,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #define OT_METHOD "opentxs::Notary::"
 
@@ -98,6 +100,27 @@ Notary::Notary(OTServer* server)
 {
 }
 
+// Signs the contracts one after another on the calling thread. A stage holds
+// only two or three contracts, which is too few to gain anything from handing
+// them to other threads.
+void Notary::sign(const std::vector<Contract*>& contracts) const
+{
+    std::vector<Contract*> pending;
+
+    for (auto* contract : contracts) {
+        if ((nullptr != contract) &&
+            (pending.end() ==
+             std::find(pending.begin(), pending.end(), contract))) {
+            pending.push_back(contract);
+        }
+    }
+
+    for (auto* contract : pending) {
+        contract->SignContract(server_->m_nymServer);
+        contract->SaveContract();
+    }
+}
+
 void Notary::NotarizeTransfer(
     Nym& theNym,
     ClientContext& context,
@@ -422,19 +445,15 @@ void Notary::NotarizeTransfer(
                 // Now we have created 2 new transactions from the server to the
                 // users' boxes
                 // Let's sign them and add to their inbox / outbox.
-                pOutboxTransaction->SignContract(server_->m_nymServer);
-                pInboxTransaction->SignContract(server_->m_nymServer);
-
-                pOutboxTransaction->SaveContract();
-                pInboxTransaction->SaveContract();
                 // Meanwhile a copy of the outbox transaction is also added to
                 // pOutbox. (It's just another copy of the outbox, but used
                 // purely for verifying the balance statement, while a different
                 // copy of the outbox is used for actually adding the receipt
                 // and saving to the outbox file.)
                 //
-                pTEMPOutboxTransaction->SignContract(server_->m_nymServer);
-                pTEMPOutboxTransaction->SaveContract();
+                sign({pOutboxTransaction,
+                      pInboxTransaction,
+                      pTEMPOutboxTransaction});
 
                 // No need to save a box receipt in this case, like we normally
                 // would
@@ -521,26 +540,18 @@ void Notary::NotarizeTransfer(
                         theFromOutbox.ReleaseSignatures();
                         theToInbox.ReleaseSignatures();
 
-                        // Sign them.
-                        theFromOutbox.SignContract(server_->m_nymServer);
-                        theToInbox.SignContract(server_->m_nymServer);
-
-                        // Save them internally
-                        theFromOutbox.SaveContract();
-                        theToInbox.SaveContract();
+                        // Sign them, and save them internally.
+                        sign({&theFromOutbox, &theToInbox});
 
                         // Save their internals (signatures and all) to file.
                         theFromAccount.SaveOutbox(theFromOutbox);
                         pDestinationAcct->SaveInbox(theToInbox);
 
+                        // The accounts now hold the new box hashes.
                         theFromAccount.ReleaseSignatures();
-                        theFromAccount.SignContract(server_->m_nymServer);
-                        theFromAccount.SaveContract();
-                        theFromAccount.SaveAccount();
-
                         pDestinationAcct->ReleaseSignatures();
-                        pDestinationAcct->SignContract(server_->m_nymServer);
-                        pDestinationAcct->SaveContract();
+                        sign({&theFromAccount, pDestinationAcct.get()});
+                        theFromAccount.SaveAccount();
                         pDestinationAcct->SaveAccount();
 
                         // Now we can set the response item as an
@@ -599,12 +610,7 @@ void Notary::NotarizeTransfer(
     // Now, whether it was rejection or acknowledgement, it is set properly and
     // it is signed, and it
     // is owned by the transaction, who will take it from here.
-    pResponseItem->SignContract(server_->m_nymServer);
-    pResponseItem->SaveContract();  // the signing was of no effect because I
-                                    // forgot to save.
-
-    pResponseBalanceItem->SignContract(server_->m_nymServer);
-    pResponseBalanceItem->SaveContract();
+    sign({pResponseItem, pResponseBalanceItem});
 }
 
 /// NotarizeWithdrawal supports two withdrawal types:
@@ -1436,12 +1442,7 @@ void Notary::NotarizeWithdrawal(
     // Now, whether it was rejection or acknowledgement, it is set properly and
     // it is signed, and it
     // is owned by the transaction, who will take it from here.
-    pResponseItem->SignContract(server_->m_nymServer);
-    pResponseItem->SaveContract();  // the signing was of no effect because I
-                                    // forgot to save.
-
-    pResponseBalanceItem->SignContract(server_->m_nymServer);
-    pResponseBalanceItem->SaveContract();
+    sign({pResponseItem, pResponseBalanceItem});
 }
 
 /// NotarizePayDividend
@@ -1986,6 +1987,13 @@ void Notary::NotarizePayDividend(
                                     lAmountPerShare,
                                     &theAccounts);
 
+                                // Saves the progress of the payout after
+                                // each batch of vouchers, so the server can
+                                // finish it on restart if it is interrupted.
+                                actionPayDividend.Checkpoint(
+                                    SHARES_INSTRUMENT_DEFINITION_ID,
+                                    lTotalCostOfDividend);
+
                                 // Loops through all the accounts for a given
                                 // instrument definition
                                 // (PAYOUT_INSTRUMENT_DEFINITION_ID),
@@ -1996,11 +2004,14 @@ void Notary::NotarizePayDividend(
                                 // lAmountPerShare * number of shares in
                                 // account.)
                                 //
-                                const bool bForEachAcct =
+                                bool bForEachAcct =
                                     pSharesContract->VisitAccountRecords(
                                         actionPayDividend);  // <================
                                                              // pay all the
                                                              // dividends here.
+                                // The vouchers are sent in batches. This
+                                // sends the last one.
+                                bForEachAcct &= actionPayDividend.Finish();
 
                                 // TODO: Since the above line of code loops
                                 // through all the accounts and loads them
@@ -2285,12 +2296,7 @@ void Notary::NotarizePayDividend(
     // Now, whether it was rejection or acknowledgement, it is set properly and
     // it is signed, and it
     // is owned by the transaction, who will take it from here.
-    pResponseItem->SignContract(server_->m_nymServer);
-    pResponseItem->SaveContract();  // the signing was of no effect because I
-                                    // forgot to save.
-
-    pResponseBalanceItem->SignContract(server_->m_nymServer);
-    pResponseBalanceItem->SaveContract();
+    sign({pResponseItem, pResponseBalanceItem});
 }
 
 /// for depositing a cheque or cash.
@@ -3763,11 +3769,7 @@ void Notary::NotarizeDeposit(
                             pSourceAcct->ReleaseSignatures();
                             theAccount.ReleaseSignatures();
 
-                            pSourceAcct->SignContract(server_->m_nymServer);
-                            theAccount.SignContract(server_->m_nymServer);
-
-                            pSourceAcct->SaveContract();
-                            theAccount.SaveContract();
+                            sign({pSourceAcct, &theAccount});
 
                             pSourceAcct->SaveAccount();
                             theAccount.SaveAccount();
@@ -4196,12 +4198,7 @@ void Notary::NotarizeDeposit(
     // Now, whether it was rejection or acknowledgement, it is set properly and
     // it is signed, and it
     // is owned by the transaction, who will take it from here.
-    pResponseItem->SignContract(server_->m_nymServer);
-    pResponseItem->SaveContract();  // the signing was of no effect because I
-                                    // forgot to save.
-
-    pResponseBalanceItem->SignContract(server_->m_nymServer);
-    pResponseBalanceItem->SaveContract();
+    sign({pResponseItem, pResponseBalanceItem});
 }
 
 // DONE:  Need to make sure both parties have included TWO!!! transaction
@@ -4887,12 +4884,7 @@ void Notary::NotarizePaymentPlan(
     // Now, whether it was rejection or acknowledgement, it is set properly and
     // it is signed, and it
     // is owned by the transaction, who will take it from here.
-    pResponseItem->SignContract(server_->m_nymServer);
-    pResponseItem->SaveContract();  // the signing was of no effect because I
-                                    // forgot to save.
-
-    pResponseBalanceItem->SignContract(server_->m_nymServer);
-    pResponseBalanceItem->SaveContract();
+    sign({pResponseItem, pResponseBalanceItem});
 }
 
 void Notary::NotarizeSmartContract(
@@ -5642,12 +5634,7 @@ void Notary::NotarizeSmartContract(
     // Now, whether it was rejection or acknowledgement, it is set properly and
     // it is signed, and it
     // is owned by the transaction, who will take it from here.
-    pResponseItem->SignContract(server_->m_nymServer);
-    pResponseItem->SaveContract();  // the signing was of no effect because I
-                                    // forgot to save.
-
-    pResponseBalanceItem->SignContract(server_->m_nymServer);
-    pResponseBalanceItem->SaveContract();
+    sign({pResponseItem, pResponseBalanceItem});
 }
 
 // DONE: The code inside here is just a copy of payment plan.
@@ -5858,12 +5845,7 @@ void Notary::NotarizeCancelCronItem(
     // Now, whether it was rejection or acknowledgement, it is set properly and
     // it is signed, and it
     // is owned by the transaction, who will take it from here.
-    pResponseItem->SignContract(server_->m_nymServer);
-    pResponseItem->SaveContract();  // the signing was of no effect because I
-                                    // forgot to save.
-
-    pResponseBalanceItem->SignContract(server_->m_nymServer);
-    pResponseBalanceItem->SaveContract();
+    sign({pResponseItem, pResponseBalanceItem});
 }
 
 /// a user is exchanging in or out of a basket.  (Ex. He's trading 2 gold and 3
@@ -9463,11 +9445,7 @@ void Notary::NotarizeProcessInbox(
                             theFromInbox.ReleaseSignatures();
                             theFromOutbox.ReleaseSignatures();
 
-                            theFromInbox.SignContract(server_->m_nymServer);
-                            theFromOutbox.SignContract(server_->m_nymServer);
-
-                            theFromInbox.SaveContract();
-                            theFromOutbox.SaveContract();
+                            sign({&theFromInbox, &theFromOutbox});
 
                             theFromInbox.SaveInbox();
                             theFromOutbox.SaveOutbox();
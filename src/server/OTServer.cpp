@@ -63,6 +63,7 @@
 #include "opentxs/core/String.hpp"
 #include "opentxs/ext/OTPayment.hpp"
 #include "opentxs/server/ConfigLoader.hpp"
+#include "opentxs/server/PayDividendVisitor.hpp"
 #include "opentxs/server/Transactor.hpp"
 
 #include <inttypes.h>
@@ -71,6 +72,7 @@
 #include <fstream>
 #include <string>
 #include <regex>
+#include <vector>
 
 #define SERVER_PID_FILENAME "ot.pid"
 #define SEED_BACKUP_FILE "seed_backup.json"
@@ -129,7 +131,7 @@ void OTServer::ProcessCron()
     }
 
     if (bAddedNumbers) {
-        m_Cron.SaveCron();
+        m_Cron.SaveTransactionNumbers();
     }
 
     m_Cron.ProcessCronItems();  // This needs to be called regularly for trades,
@@ -147,7 +149,8 @@ const Nym& OTServer::GetServerNym() const { return m_nymServer; }
 bool OTServer::IsFlaggedForShutdown() const { return m_bShutdownFlag; }
 
 OTServer::OTServer()
-    : mainFile_(this)
+    : statistics_()
+    , mainFile_(this)
     , notary_(this)
     , transactor_(this)
     , userCommandProcessor_(this)
@@ -628,6 +631,12 @@ void OTServer::Init(std::map<std::string, std::string>& args, bool readOnly)
     // With the Server's private key loaded, and the latest transaction number
     // loaded, and all the various other data (contracts, etc) the server is now
     // ready for operation!
+
+    // Finish sending any dividend vouchers that were interrupted when the
+    // server last stopped. (The funds were already moved.)
+    if (!readOnly) {
+        PayDividendVisitor::Resume(*this);
+    }
 }
 
 // msg, the request msg from payer, which is attached WHOLE to the Nymbox
@@ -643,7 +652,7 @@ bool OTServer::SendInstrumentToNym(
     const OTPayment* pPayment,
     const char* szCommand)
 {
-    OT_ASSERT(nullptr == pPayment);
+    OT_ASSERT(nullptr != pPayment);
     OT_ASSERT(pPayment->IsValid());
     // If a payment was passed in (for us to use it to construct pMsg, which is
     // nullptr in the case where payment isn't nullptr)
@@ -777,16 +786,7 @@ bool OTServer::DropMessageToNymbox(
     // provide
     // both.
     const char* szFunc = "OTServer::DropMessageToNymbox";
-    int64_t lTransNum = 0;
-    const bool bGotNextTransNum =
-        transactor_.issueNextTransactionNumber(lTransNum);
 
-    if (!bGotNextTransNum) {
-        Log::vError(
-            "%s: Error: failed trying to get next transaction number.\n",
-            szFunc);
-        return false;
-    }
     switch (theType) {
         case OTTransaction::message:
             break;
@@ -802,99 +802,66 @@ bool OTServer::DropMessageToNymbox(
     // If pMsg was not already passed in here, then
     // create pMsg using pstrMessage.
     //
-    std::unique_ptr<Message> theMsgAngel;
+    Message theMsg;
     const Message* message{nullptr};
 
     if (nullptr == pMsg) {
-        theMsgAngel.reset(new Message);
-
-        if (nullptr != szCommand)
-            theMsgAngel->m_strCommand = szCommand;
-        else {
-            switch (theType) {
-                case OTTransaction::message:
-                    theMsgAngel->m_strCommand = "sendNymMessage";
-                    break;
-                case OTTransaction::instrumentNotice:
-                    theMsgAngel->m_strCommand = "sendNymInstrument";
-                    break;
-                default:
-                    break;  // should never happen.
-            }
-        }
-        theMsgAngel->m_strNotaryID = String(m_strNotaryID);
-        theMsgAngel->m_bSuccess = true;
-        SENDER_NYM_ID.GetString(theMsgAngel->m_strNymID);
-        RECIPIENT_NYM_ID.GetString(
-            theMsgAngel->m_strNymID2);  // set the recipient ID
-                                        // in theMsgAngel to match our
-                                        // recipient ID.
-        // Load up the recipient's public key (so we can encrypt the envelope
-        // to him that will contain the payment instrument.)
-        //
-        Nym nymRecipient(RECIPIENT_NYM_ID);
-
-        bool bLoadedNym =
-            nymRecipient.LoadPublicKey();  // Old style (deprecated.) But this
-                                           // function calls the new style,
-                                           // LoadCredentials, at the top.
-                                           // Eventually we'll just call that
-                                           // here directly.
-        if (!bLoadedNym) {
-            Log::vError(
-                "%s: Failed trying to load public key for recipient.\n",
-                szFunc);
-            return false;
-        } else if (!nymRecipient.VerifyPseudonym()) {
-            Log::vError(
-                "%s: Failed trying to verify Nym for recipient.\n", szFunc);
+        if (!instrument_notice(
+                SENDER_NYM_ID,
+                RECIPIENT_NYM_ID,
+                theType,
+                *pstrMessage,
+                szCommand,
+                theMsg)) {
+
             return false;
         }
-        const OTAsymmetricKey& thePubkey = nymRecipient.GetPublicEncrKey();
-        // Wrap the message up into an envelope and attach it to theMsgAngel.
-        //
-        OTEnvelope theEnvelope;
-
-        theMsgAngel->m_ascPayload.Release();
-
-        if ((nullptr != pstrMessage) && pstrMessage->Exists() &&
-            theEnvelope.Seal(thePubkey, *pstrMessage) &&  // Seal pstrMessage
-                                                          // into theEnvelope,
-            // using nymRecipient's
-            // public key.
-            theEnvelope.GetCiphertext(theMsgAngel->m_ascPayload))  // Grab the
-                                                                   // sealed
-                                                                   // version as
-        // base64-encoded string, into
-        // theMsgAngel->m_ascPayload.
-        {
-            theMsgAngel->SignContract(m_nymServer);
-            theMsgAngel->SaveContract();
-        } else {
+
+        message = &theMsg;
+    } else {
+        message = pMsg;
+    }
+
+    return DropMessagesToNymbox(
+        NOTARY_ID, RECIPIENT_NYM_ID, theType, {message});
+}
+
+// Drops several messages into the same Nymbox, loading and saving it once.
+// Used when paying dividends, where one recipient may own many accounts.
+//
+bool OTServer::DropMessagesToNymbox(
+    const Identifier& NOTARY_ID,
+    const Identifier& RECIPIENT_NYM_ID,
+    OTTransaction::transactionType theType,
+    const std::vector<const Message*>& messages,
+    const std::vector<int64_t>& references)
+{
+    const char* szFunc = "OTServer::DropMessagesToNymbox";
+
+    if (messages.empty()) {
+
+        return true;
+    }
+
+    OT_ASSERT(references.empty() || (references.size() == messages.size()));
+
+    std::vector<int64_t> numbers{};
+
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        int64_t lTransNum = 0;
+        const bool bGotNextTransNum =
+            transactor_.issueNextTransactionNumber(lTransNum);
+
+        if (!bGotNextTransNum) {
             Log::vError(
-                "%s: Failed trying to seal envelope containing theMsgAngel "
-                "(or while grabbing the base64-encoded result.)\n",
+                "%s: Error: failed trying to get next transaction number.\n",
                 szFunc);
             return false;
         }
 
-        // By this point, pMsg is all set up, signed and saved. Its payload
-        // contains
-        // the envelope (as base64) containing the encrypted message.
-
-        message = theMsgAngel.get();
-    } else {
-        message = pMsg;
+        numbers.push_back(lTransNum);
     }
-    //  else // pMsg was passed in, so it's not nullptr. No need to create it
-    // ourselves like above. (pstrMessage should be nullptr anyway in this
-    // case.)
-    //  {
-    //       // Apparently no need to do anything in here at all.
-    //  }
-    // Grab a string copy of message.
-    //
-    const String strInMessage(*message);
+
     Ledger theLedger(
         RECIPIENT_NYM_ID,
         RECIPIENT_NYM_ID,
@@ -907,31 +874,48 @@ bool OTServer::DropMessageToNymbox(
          theLedger.VerifyContractID() &&  // Instead, we'll verify the IDs and
                                           // Signature only.
          theLedger.VerifySignature(m_nymServer))) {
-        // Create the instrumentNotice to put in the Nymbox.
-        OTTransaction* pTransaction = OTTransaction::GenerateTransaction(
-            theLedger, theType, originType::not_applicable, lTransNum);
-
-        if (nullptr !=
-            pTransaction)  // The above has an OT_ASSERT within, but I
-                           // just like to check my pointers.
-        {
-            // NOTE: todo: SHOULD this be "in reference to" itself? The reason,
-            // I assume we are doing this
-            // is because there is a reference STRING so "therefore" there must
-            // be a reference # as well. Eh?
-            // Anyway, it must be understood by those involved that a message is
-            // stored inside. (Which has no transaction #.)
-
-            pTransaction->SetReferenceToNum(lTransNum);  // <====== Recipient
-                                                         // RECEIVES entire
-                                                         // incoming message as
-                                                         // string here, which
-                                                         // includes the sender
-                                                         // user ID,
+        std::vector<OTTransaction*> added{};
+
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            OT_ASSERT(nullptr != messages[i]);
+
+            // Grab a string copy of message.
+            //
+            const String strInMessage(*messages[i]);
+            const int64_t lTransNum = numbers[i];
+            // Create the instrumentNotice to put in the Nymbox.
+            OTTransaction* pTransaction = OTTransaction::GenerateTransaction(
+                theLedger, theType, originType::not_applicable, lTransNum);
+
+            if (nullptr == pTransaction)  // The above has an OT_ASSERT
+                                          // within, but I just like to check
+                                          // my pointers.
+            {
+                const String strRecipientNymID(RECIPIENT_NYM_ID);
+                Log::vError(
+                    "%s: Failed while trying to generate transaction in order "
+                    "to add a message to Nymbox: %s\n",
+                    szFunc,
+                    strRecipientNymID.Get());
+
+                return false;
+            }
+
+            // NOTE: todo: SHOULD this be "in reference to" itself? The
+            // reason, I assume we are doing this
+            // is because there is a reference STRING so "therefore" there
+            // must be a reference # as well. Eh?
+            // Anyway, it must be understood by those involved that a message
+            // is stored inside. (Which has no transaction #.)
+
+            // Recipient RECEIVES entire incoming message as string here,
+            // which includes the sender user ID,
+            pTransaction->SetReferenceToNum(
+                references.empty() ? lTransNum : references[i]);
             pTransaction->SetReferenceString(
-                strInMessage);  // and has an OTEnvelope in the payload. Message
-            // is signed by sender, and envelope is encrypted
-            // to recipient.
+                strInMessage);  // and has an OTEnvelope in the payload.
+            // Message is signed by sender, and envelope is encrypted to
+            // recipient.
 
             pTransaction->SignContract(m_nymServer);
             pTransaction->SaveContract();
@@ -939,35 +923,30 @@ bool OTServer::DropMessageToNymbox(
                                                       // transaction to the
                                                       // nymbox. (It will
                                                       // cleanup.)
+            added.push_back(pTransaction);
+        }
 
-            theLedger.ReleaseSignatures();
-            theLedger.SignContract(m_nymServer);
-            theLedger.SaveContract();
-            theLedger.SaveNymbox();  // We don't grab the Nymbox hash here,
-                                     // since
-            // nothing important changed (just a message
-            // was sent.)
+        theLedger.ReleaseSignatures();
+        theLedger.SignContract(m_nymServer);
+        theLedger.SaveContract();
+        theLedger.SaveNymbox();  // We don't grab the Nymbox hash here,
+                                 // since
+        // nothing important changed (just a message
+        // was sent.)
 
-            // Any inbox/nymbox/outbox ledger will only itself contain
-            // abbreviated versions of the receipts, including their hashes.
-            //
-            // The rest is stored separately, in the box receipt, which is
-            // created
-            // whenever a receipt is added to a box, and deleted after a receipt
-            // is removed from a box.
-            //
+        // Any inbox/nymbox/outbox ledger will only itself contain
+        // abbreviated versions of the receipts, including their hashes.
+        //
+        // The rest is stored separately, in the box receipt, which is
+        // created
+        // whenever a receipt is added to a box, and deleted after a receipt
+        // is removed from a box.
+        //
+        for (auto& pTransaction : added) {
             pTransaction->SaveBoxReceipt(theLedger);
-
-            return true;
-        } else  // should never happen
-        {
-            const String strRecipientNymID(RECIPIENT_NYM_ID);
-            Log::vError(
-                "%s: Failed while trying to generate transaction in order to "
-                "add a message to Nymbox: %s\n",
-                szFunc,
-                strRecipientNymID.Get());
         }
+
+        return true;
     } else {
         const String strRecipientNymID(RECIPIENT_NYM_ID);
         Log::vError(
@@ -979,6 +958,93 @@ bool OTServer::DropMessageToNymbox(
     return false;
 }
 
+// Creates a message "from the server", containing pstrMessage sealed to the
+// recipient, for DropMessageToNymbox. Only reads from *this, so several of
+// these may be prepared at once.
+//
+bool OTServer::instrument_notice(
+    const Identifier& SENDER_NYM_ID,
+    const Identifier& RECIPIENT_NYM_ID,
+    OTTransaction::transactionType theType,
+    const String& strMessage,
+    const char* szCommand,
+    Message& theMsg) const
+{
+    const char* szFunc = "OTServer::instrument_notice";
+
+    if (nullptr != szCommand)
+        theMsg.m_strCommand = szCommand;
+    else {
+        switch (theType) {
+            case OTTransaction::message:
+                theMsg.m_strCommand = "sendNymMessage";
+                break;
+            case OTTransaction::instrumentNotice:
+                theMsg.m_strCommand = "sendNymInstrument";
+                break;
+            default:
+                break;  // should never happen.
+        }
+    }
+    theMsg.m_strNotaryID = String(m_strNotaryID);
+    theMsg.m_bSuccess = true;
+    SENDER_NYM_ID.GetString(theMsg.m_strNymID);
+    RECIPIENT_NYM_ID.GetString(theMsg.m_strNymID2);  // set the recipient ID
+                                                     // in theMsg to match our
+                                                     // recipient ID.
+    // Load up the recipient's public key (so we can encrypt the envelope
+    // to him that will contain the payment instrument.)
+    //
+    Nym nymRecipient(RECIPIENT_NYM_ID);
+
+    bool bLoadedNym =
+        nymRecipient.LoadPublicKey();  // Old style (deprecated.) But this
+                                       // function calls the new style,
+                                       // LoadCredentials, at the top.
+                                       // Eventually we'll just call that
+                                       // here directly.
+    if (!bLoadedNym) {
+        Log::vError(
+            "%s: Failed trying to load public key for recipient.\n", szFunc);
+        return false;
+    } else if (!nymRecipient.VerifyPseudonym()) {
+        Log::vError("%s: Failed trying to verify Nym for recipient.\n", szFunc);
+        return false;
+    }
+    const OTAsymmetricKey& thePubkey = nymRecipient.GetPublicEncrKey();
+    // Wrap the message up into an envelope and attach it to theMsg.
+    //
+    OTEnvelope theEnvelope;
+
+    theMsg.m_ascPayload.Release();
+
+    if (strMessage.Exists() &&
+        theEnvelope.Seal(thePubkey, strMessage) &&  // Seal strMessage into
+                                                    // theEnvelope, using
+                                                    // nymRecipient's public
+                                                    // key.
+        theEnvelope.GetCiphertext(theMsg.m_ascPayload))  // Grab the sealed
+                                                         // version as
+                                                         // base64-encoded
+                                                         // string, into
+                                                         // theMsg.m_ascPayload.
+    {
+        theMsg.SignContract(m_nymServer);
+        theMsg.SaveContract();
+    } else {
+        Log::vError(
+            "%s: Failed trying to seal envelope containing theMsg "
+            "(or while grabbing the base64-encoded result.)\n",
+            szFunc);
+        return false;
+    }
+
+    // By this point, theMsg is all set up, signed and saved. Its payload
+    // contains the envelope (as base64) containing the encrypted message.
+
+    return true;
+}
+
 bool OTServer::GetConnectInfo(std::string& strHostname, uint32_t& nPort) const
 {
     bool notUsed = false;
@@ -43,20 +43,37 @@
 #include "opentxs/api/OT.hpp"
 #include "opentxs/api/Wallet.hpp"
 #include "opentxs/consensus/ClientContext.hpp"
+#include "opentxs/core/contract/UnitDefinition.hpp"
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
 #include "opentxs/core/Account.hpp"
 #include "opentxs/core/AccountVisitor.hpp"
 #include "opentxs/core/Cheque.hpp"
 #include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Ledger.hpp"
 #include "opentxs/core/Log.hpp"
+#include "opentxs/core/Message.hpp"
+#include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/String.hpp"
-#include "opentxs/core/util/Assert.hpp"
-#include "opentxs/core/util/Common.hpp"
 #include "opentxs/ext/OTPayment.hpp"
 #include "opentxs/server/OTServer.hpp"
 #include "opentxs/server/Transactor.hpp"
 
 #include <inttypes.h>
 #include <stdint.h>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+// Number of shareholders whose vouchers are prepared and sent together
+#define OT_DIVIDEND_BATCH 256
+// Batches with fewer vouchers than this are signed on the calling thread
+#define OT_DIVIDEND_PARALLEL_THRESHOLD 4
+// Checkpoints are kept with the other server state, in the cron folder
+#define OT_DIVIDEND_FOLDER "dividends"
 
 namespace opentxs
 {
@@ -100,54 +117,126 @@ PayDividendVisitor::~PayDividendVisitor()
     m_lAmountReturned = 0;
 }
 
-// For each "user" account of a specific instrument definition, this function
-// is called in order to pay a dividend to the Nym who owns that account.
+bool PayDividendVisitor::Checkpoint(
+    const Identifier& theSharesInstrumentDefinitionID,
+    int64_t lTotalCost)
+{
+    m_strSharesInstrumentDefinitionID =
+        String(theSharesInstrumentDefinitionID).Get();
+    m_lTotalCost = lTotalCost;
 
-// PayDividendVisitor::Trigger() is used in
-// OTUnitDefinition::VisitAccountRecords()
-// cppcheck-suppress unusedFunction
-bool PayDividendVisitor::Trigger(Account& theSharesAccount)  // theSharesAccount
-                                                             // is, say, a Pepsi
-                                                             // shares
-// account.  Here, we'll send a dollars voucher
-// to its owner.
+    if (OTDB::Exists(
+            OTFolders::Cron().Get(), OT_DIVIDEND_FOLDER, checkpoint_file())) {
+        otErr << __FUNCTION__ << ": Another payout for "
+              << m_strSharesInstrumentDefinitionID
+              << " is unfinished. This one can not be resumed if it is "
+              << "interrupted." << std::endl;
+        m_strSharesInstrumentDefinitionID.clear();
+
+        return false;
+    }
+
+    return save_checkpoint({});
+}
+
+std::string PayDividendVisitor::checkpoint_file() const
 {
-    const int64_t lPayoutAmount =
-        (theSharesAccount.GetBalance() * GetPayoutPerShare());
+    return m_strSharesInstrumentDefinitionID + ".d";
+}
 
-    if (lPayoutAmount <= 0) {
-        Log::Output(
-            0,
-            "PayDividendVisitor::Trigger: nothing to pay, "
-            "since this account owns no shares. (Returning "
-            "true.)");
-        return true;  // nothing to pay, since this account owns no shares.
-                      // Success!
+bool PayDividendVisitor::Finish(bool bReturnLeftovers)
+{
+    const bool bFlushed = Flush();
+
+    if (bReturnLeftovers) {
+        const int64_t lLeftovers =
+            m_lTotalCost - (m_lAmountPaidOut + m_lAmountReturned);
+
+        if (lLeftovers > 0) {
+            OTServer& theServer = *(GetServer());
+            const Nym& theServerNym = theServer.GetServerNym();
+            TransactionNumber lNewTransactionNumber = 0;
+            bool bGotNextTransNum = false;
+
+            {
+                auto context = OT::App().Contract().mutable_ClientContext(
+                    theServerNym.ID(), theServerNym.ID());
+                bGotNextTransNum =
+                    theServer.transactor_.issueNextTransactionNumberToNym(
+                        context.It(), lNewTransactionNumber);
+            }
+
+            if (bGotNextTransNum) {
+                Payout leftovers;
+                leftovers.recipient_ = *(GetNymID());
+                leftovers.amount_ = lLeftovers;
+                leftovers.number_ = lNewTransactionNumber;
+
+                // Recorded first, so that resuming never returns them twice
+                save_checkpoint({leftovers});
+                return_voucher(
+                    *(GetNymID()), lLeftovers, lNewTransactionNumber);
+            } else {
+                otErr << __FUNCTION__ << ": Failed issuing a transaction "
+                      << "number to return " << lLeftovers
+                      << " leftover units to the payer." << std::endl;
+            }
+        }
+    }
+
+    if (!m_strSharesInstrumentDefinitionID.empty()) {
+        OTDB::EraseValueByKey(
+            OTFolders::Cron().Get(), OT_DIVIDEND_FOLDER, checkpoint_file());
+        m_strSharesInstrumentDefinitionID.clear();
+    }
+
+    return bFlushed;
+}
+
+bool PayDividendVisitor::Flush()
+{
+    if (m_pending.empty()) {
+
+        return true;
+    }
+
+    std::vector<Payout> batch;
+    batch.swap(m_pending);
+
+    return send(batch);
+}
+
+// Whether a voucher was already added to the Nymbox. Vouchers sent by this
+// class are recorded there in reference to their own transaction number.
+bool PayDividendVisitor::delivered(const Identifier& nymID, int64_t lNumber)
+    const
+{
+    Ledger theNymbox(nymID, nymID, notaryID_);
+
+    if (!theNymbox.LoadNymbox()) {
+
+        return false;
     }
-    OT_ASSERT(nullptr != GetNotaryID());
-    const Identifier& theNotaryID = *(GetNotaryID());
-    OT_ASSERT(nullptr != GetPayoutInstrumentDefinitionID());
+
+    return (0 < theNymbox.GetTransactionCountInRefTo(lNumber));
+}
+
+// Issues and signs the voucher for one shareholder, and seals it into the
+// notice for their Nymbox. Called from several threads at once.
+void PayDividendVisitor::prepare(Payout& payout, std::mutex& noticeLock) const
+{
+    if (0 == payout.number_) {
+
+        return;
+    }
+
+    const Identifier& theNotaryID = notaryID_;
     const Identifier& thePayoutInstrumentDefinitionID =
-        *(GetPayoutInstrumentDefinitionID());
-    OT_ASSERT(nullptr != GetVoucherAcctID());
-    const Identifier& theVoucherAcctID = *(GetVoucherAcctID());
-    OT_ASSERT(nullptr != GetServer());
-    OTServer& theServer = *(GetServer());
-    Nym& theServerNym = const_cast<Nym&>(theServer.GetServerNym());
+        *m_pPayoutInstrumentDefinitionID;
+    const Identifier& theVoucherAcctID = *m_pVoucherAcctID;
+    const OTServer& theServer = *m_pServer;
+    const Nym& theServerNym = theServer.GetServerNym();
     const Identifier theServerNymID(theServerNym);
-    const Identifier& RECIPIENT_ID = theSharesAccount.GetNymID();
-    OT_ASSERT(nullptr != GetNymID());
-    const Identifier& theSenderNymID = *(GetNymID());
-    OT_ASSERT(nullptr != GetMemo());
-    const String& strMemo = *(GetMemo());
-    // Note: theSenderNymID is the originator of the Dividend Payout.
-    // However, all the actual vouchers will be from "the server Nym" and
-    // not from theSenderNymID. So then why is it even here? Because anytime
-    // there's an error, the server will send to theSenderNymID instead of
-    // RECIPIENT_ID (so the original sender can have his money back, instead of
-    // just having it get lost in the ether.)
-    bool bReturnValue = false;
-
     Cheque theVoucher(theNotaryID, thePayoutInstrumentDefinitionID);
 
     // 10 minutes ==    600 Seconds
@@ -165,171 +254,497 @@ bool PayDividendVisitor::Trigger(Account& theSharesAccount)  // theSharesAccount
                                                                    // occurs in
     // 180 days (6 months).
     // Todo hardcoding.
-    TransactionNumber lNewTransactionNumber = 0;
-    auto context = OT::App().Contract().mutable_ClientContext(
-        theServerNym.ID(), theServerNym.ID());
-    bool bGotNextTransNum =
-        theServer.transactor_.issueNextTransactionNumberToNym(
-            context.It(), lNewTransactionNumber);  // We save the transaction
-    // number on the server Nym (normally we'd discard it) because
-    // when the cheque is deposited, the server nym, as the owner of
-    // the voucher account, needs to verify the transaction # on the
-    // cheque (to prevent double-spending of cheques.)
-    if (bGotNextTransNum) {
-        const bool bIssueVoucher = theVoucher.IssueCheque(
-            lPayoutAmount,          // The amount of the cheque.
-            lNewTransactionNumber,  // Requiring a transaction number prevents
-                                    // double-spending of cheques.
-            VALID_FROM,  // The expiration date (valid from/to dates) of the
-                         // cheque
-            VALID_TO,  // Vouchers are automatically starting today and lasting
-                       // 6
-                       // months.
-            theVoucherAcctID,  // The asset account the cheque is drawn on.
-            theServerNymID,    // Nym ID of the sender (in this case the server
-                               // nym.)
-            strMemo,  // Optional memo field. Includes item note and request
+    const bool bIssueVoucher = theVoucher.IssueCheque(
+        payout.amount_,   // The amount of the cheque.
+        payout.number_,   // Requiring a transaction number prevents
+                          // double-spending of cheques.
+        VALID_FROM,       // The expiration date (valid from/to dates) of the
+                          // cheque
+        VALID_TO,  // Vouchers are automatically starting today and lasting 6
+                   // months.
+        theVoucherAcctID,  // The asset account the cheque is drawn on.
+        theServerNymID,    // Nym ID of the sender (in this case the server
+                           // nym.)
+        *m_pstrMemo,  // Optional memo field. Includes item note and request
                       // memo.
-            &RECIPIENT_ID);
-
-        // All account crediting / debiting happens in the caller, in OTServer.
-        //    (AND it happens only ONCE, to cover ALL vouchers.)
-        // Then in here, the voucher either gets send to the recipient, or if
-        // error, sent back home to
-        // the issuer Nym. (ALL the funds are removed, then the vouchers are
-        // sent one way or the other.)
-        // Any returned vouchers, obviously serve to notify the dividend payer
-        // of where the errors were
-        // (as well as give him the opportunity to get his money back.)
-        //
-        bool bSent = false;
-        if (bIssueVoucher) {
-            // All this does is set the voucher's internal contract string to
-            // "VOUCHER" instead of "CHEQUE". We also set the server itself as
-            // the remitter, which is unusual for vouchers, but necessary in the
-            // case of dividends.
-            //
-            theVoucher.SetAsVoucher(theServerNymID, theVoucherAcctID);
-            theVoucher.SignContract(theServerNym);
-            theVoucher.SaveContract();
-
-            // Send the voucher to the payments inbox of the recipient.
-            //
-            const String strVoucher(theVoucher);
-            OTPayment thePayment(strVoucher);
-
-            // calls DropMessageToNymbox
-            bSent = theServer.SendInstrumentToNym(
-                theNotaryID,
-                theServerNymID,  // sender nym
-                RECIPIENT_ID,    // recipient nym
-                &thePayment,
-                "payDividend");    // todo: hardcoding.
-            bReturnValue = bSent;  // <======= RETURN VALUE.
-            if (bSent)
-                m_lAmountPaidOut +=
-                    lPayoutAmount;  // At the end of iterating all accounts, if
-                                    // m_lAmountPaidOut is less than
-            // lTotalPayoutAmount, then we return to rest
-            // to the sender.
-        } else {
-            const String strPayoutInstrumentDefinitionID(
-                thePayoutInstrumentDefinitionID),
-                strRecipientNymID(RECIPIENT_ID);
-            Log::vError(
-                "PayDividendVisitor::Trigger: ERROR failed "
-                "issuing voucher (to send to dividend payout "
-                "recipient.) "
-                "WAS TRYING TO PAY %" PRId64
-                " of instrument definition %s to Nym %s.\n",
-                lPayoutAmount,
-                strPayoutInstrumentDefinitionID.Get(),
-                strRecipientNymID.Get());
-        }
-        // If we didn't send it, then we need to return the funds to where they
-        // came from.
-        //
-        if (!bSent) {
-            Cheque theReturnVoucher(
-                theNotaryID, thePayoutInstrumentDefinitionID);
-
-            const bool bIssueReturnVoucher = theReturnVoucher.IssueCheque(
-                lPayoutAmount,          // The amount of the cheque.
-                lNewTransactionNumber,  // Requiring a transaction number
-                                        // prevents double-spending of cheques.
-                VALID_FROM,  // The expiration date (valid from/to dates) of the
-                             // cheque
-                VALID_TO,    // Vouchers are automatically starting today and
-                             // lasting 6 months.
-                theVoucherAcctID,  // The asset account the cheque is drawn on.
-                theServerNymID,    // Nym ID of the sender (in this case the
-                                   // server nym.)
-                strMemo,  // Optional memo field. Includes item note and request
-                          // memo.
-                &theSenderNymID);  // We're returning the money to its original
-                                   // sender.
-            if (bIssueReturnVoucher) {
-                // All this does is set the voucher's internal contract string
-                // to
-                // "VOUCHER" instead of "CHEQUE".
-                //
-                theReturnVoucher.SetAsVoucher(theServerNymID, theVoucherAcctID);
-                theReturnVoucher.SignContract(theServerNym);
-                theReturnVoucher.SaveContract();
-
-                // Return the voucher back to the payments inbox of the original
-                // sender.
-                //
-                const String strReturnVoucher(theReturnVoucher);
-                OTPayment theReturnPayment(strReturnVoucher);
-
-                // calls DropMessageToNymbox
-                bSent = theServer.SendInstrumentToNym(
-                    theNotaryID,
-                    theServerNymID,  // sender nym
-                    theSenderNymID,  // recipient nym (original sender.)
-                    &theReturnPayment,
-                    "payDividend");  // todo: hardcoding.
-                if (bSent)
-                    m_lAmountReturned +=
-                        lPayoutAmount;  // At the end of iterating all accounts,
-                                        // if m_lAmountPaidOut+m_lAmountReturned
-                                        // is less than lTotalPayoutAmount, then
-                                        // we return the rest to the sender.
-            } else {
-                const String strPayoutInstrumentDefinitionID(
-                    thePayoutInstrumentDefinitionID),
-                    strSenderNymID(theSenderNymID);
-                Log::vError(
-                    "PayDividendVisitor::Trigger: ERROR "
-                    "failed issuing voucher (to return back to "
-                    "the dividend payout initiator, after a failed "
-                    "payment attempt to the originally intended "
-                    "recipient.) WAS TRYING TO PAY %" PRId64
-                    " of instrument definition "
-                    "%s to Nym %s.\n",
-                    lPayoutAmount,
-                    strPayoutInstrumentDefinitionID.Get(),
-                    strSenderNymID.Get());
-            }
-        }   // if !bSent
-    } else  // !bGotNextTransNum
-    {
+        &payout.recipient_);
+
+    if (!bIssueVoucher) {
         const String strPayoutInstrumentDefinitionID(
             thePayoutInstrumentDefinitionID),
-            strRecipientNymID(RECIPIENT_ID);
+            strRecipientNymID(payout.recipient_);
         Log::vError(
-            "PayDividendVisitor::Trigger: ERROR!! Failed issuing next "
-            "transaction "
-            "number while trying to send a voucher (while paying dividends.) "
+            "PayDividendVisitor::prepare: ERROR failed "
+            "issuing voucher (to send to dividend payout "
+            "recipient.) "
             "WAS TRYING TO PAY %" PRId64
             " of instrument definition %s to Nym %s.\n",
-            lPayoutAmount,
+            payout.amount_,
             strPayoutInstrumentDefinitionID.Get(),
             strRecipientNymID.Get());
+
+        return;
+    }
+
+    // All this does is set the voucher's internal contract string to
+    // "VOUCHER" instead of "CHEQUE". We also set the server itself as
+    // the remitter, which is unusual for vouchers, but necessary in the
+    // case of dividends.
+    //
+    theVoucher.SetAsVoucher(theServerNymID, theVoucherAcctID);
+    theVoucher.SignContract(theServerNym);
+    theVoucher.SaveContract();
+
+    const String strVoucher(theVoucher);
+    const OTPayment thePayment(strVoucher);
+    String strPayment;
+
+    if (!thePayment.GetPaymentContents(strPayment)) {
+        Log::vError("%s: Error GetPaymentContents Failed", __FUNCTION__);
+
+        return;
+    }
+
+    std::shared_ptr<Message> notice(new Message);
+    // See send()
+    std::lock_guard<std::mutex> lock(noticeLock);
+
+    if (theServer.instrument_notice(
+            theServerNymID,
+            payout.recipient_,
+            OTTransaction::instrumentNotice,
+            strPayment,
+            "payDividend",  // todo: hardcoding.
+            *notice)) {
+        payout.notice_ = notice;
+    }
+}
+
+// Pays the amount back to the payer of the dividend, after a voucher could not
+// be delivered to a shareholder.
+bool PayDividendVisitor::return_voucher(
+    const Identifier& RECIPIENT_ID,
+    int64_t lAmount,
+    int64_t lTransactionNumber)
+{
+    const Identifier& theNotaryID = notaryID_;
+    const Identifier& thePayoutInstrumentDefinitionID =
+        *m_pPayoutInstrumentDefinitionID;
+    const Identifier& theVoucherAcctID = *m_pVoucherAcctID;
+    OTServer& theServer = *m_pServer;
+    const Nym& theServerNym = theServer.GetServerNym();
+    const Identifier theServerNymID(theServerNym);
+    const time64_t VALID_FROM = OTTimeGetCurrentTime();
+    const time64_t VALID_TO = OTTimeAddTimeInterval(
+        VALID_FROM, OTTimeGetSecondsFromTime(OT_TIME_SIX_MONTHS_IN_SECONDS));
+    Cheque theReturnVoucher(theNotaryID, thePayoutInstrumentDefinitionID);
+
+    const bool bIssueReturnVoucher = theReturnVoucher.IssueCheque(
+        lAmount,             // The amount of the cheque.
+        lTransactionNumber,  // Requiring a transaction number
+                             // prevents double-spending of cheques.
+        VALID_FROM,  // The expiration date (valid from/to dates) of the
+                     // cheque
+        VALID_TO,    // Vouchers are automatically starting today and
+                     // lasting 6 months.
+        theVoucherAcctID,  // The asset account the cheque is drawn on.
+        theServerNymID,    // Nym ID of the sender (in this case the
+                           // server nym.)
+        *m_pstrMemo,  // Optional memo field. Includes item note and request
+                      // memo.
+        &RECIPIENT_ID);  // We're returning the money to its original
+                         // sender.
+
+    if (!bIssueReturnVoucher) {
+        const String strPayoutInstrumentDefinitionID(
+            thePayoutInstrumentDefinitionID),
+            strSenderNymID(RECIPIENT_ID);
+        Log::vError(
+            "PayDividendVisitor::return_voucher: ERROR "
+            "failed issuing voucher (to return back to "
+            "the dividend payout initiator, after a failed "
+            "payment attempt to the originally intended "
+            "recipient.) WAS TRYING TO PAY %" PRId64
+            " of instrument definition "
+            "%s to Nym %s.\n",
+            lAmount,
+            strPayoutInstrumentDefinitionID.Get(),
+            strSenderNymID.Get());
+
+        return false;
+    }
+
+    // All this does is set the voucher's internal contract string
+    // to
+    // "VOUCHER" instead of "CHEQUE".
+    //
+    theReturnVoucher.SetAsVoucher(theServerNymID, theVoucherAcctID);
+    theReturnVoucher.SignContract(theServerNym);
+    theReturnVoucher.SaveContract();
+
+    // Return the voucher back to the payments inbox of the original
+    // sender. The Nymbox record refers to the voucher's transaction number,
+    // so a resumed payout can tell that it was already returned.
+    //
+    const String strReturnVoucher(theReturnVoucher);
+    const OTPayment theReturnPayment(strReturnVoucher);
+    String strPayment;
+    Message theNotice;
+
+    const bool bSent =
+        theReturnPayment.GetPaymentContents(strPayment) &&
+        theServer.instrument_notice(
+            theServerNymID,  // sender nym
+            RECIPIENT_ID,    // recipient nym (original sender.)
+            OTTransaction::instrumentNotice,
+            strPayment,
+            "payDividend",  // todo: hardcoding.
+            theNotice) &&
+        theServer.DropMessagesToNymbox(
+            theNotaryID,
+            RECIPIENT_ID,
+            OTTransaction::instrumentNotice,
+            {&theNotice},
+            {lTransactionNumber});
+
+    if (bSent) {
+        m_lAmountReturned += lAmount;  // At the end of iterating all accounts,
+                                       // if m_lAmountPaidOut+m_lAmountReturned
+                                       // is less than lTotalPayoutAmount, then
+                                       // we return the rest to the sender.
+    }
+
+    return bSent;
+}
+
+void PayDividendVisitor::Resume(OTServer& theServer)
+{
+    for (const auto& unit : OT::App().Contract().UnitDefinitionList()) {
+        const std::string& strSharesID = unit.first;
+        const std::string strFile = strSharesID + ".d";
+
+        if (!OTDB::Exists(
+                OTFolders::Cron().Get(), OT_DIVIDEND_FOLDER, strFile)) {
+            continue;
+        }
+
+        std::unique_ptr<OTDB::Storable> pStorable(OTDB::QueryObject(
+            OTDB::STORED_OBJ_STRING_MAP,
+            OTFolders::Cron().Get(),
+            OT_DIVIDEND_FOLDER,
+            strFile));
+        auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+        auto pSharesContract =
+            OT::App().Contract().UnitDefinition(Identifier(strSharesID));
+
+        if ((nullptr == pMap) || (!pSharesContract)) {
+            otErr << __FUNCTION__ << ": Unable to resume dividend payout for "
+                  << strSharesID << std::endl;
+
+            continue;
+        }
+
+        auto& theMap = pMap->the_map;
+        auto number = [&](const std::string& key) -> int64_t {
+            return std::strtoll(theMap[key].c_str(), nullptr, 10);
+        };
+        const Identifier theNotaryID(theMap["notary"]);
+        const Identifier thePayerNymID(theMap["nym"]);
+        const Identifier thePayoutInstrumentDefinitionID(theMap["payout"]);
+        const Identifier theVoucherAcctID(theMap["voucher_account"]);
+        const String strMemo(theMap["memo"]);
+        PayDividendVisitor visitor(
+            theNotaryID,
+            thePayerNymID,
+            thePayoutInstrumentDefinitionID,
+            theVoucherAcctID,
+            strMemo,
+            theServer,
+            number("per_share"));
+        visitor.m_strSharesInstrumentDefinitionID = strSharesID;
+        visitor.m_strLastAccount = theMap["last_account"];
+        visitor.m_lTotalCost = number("total");
+        visitor.m_lAmountPaidOut = number("paid");
+        visitor.m_lAmountReturned = number("returned");
+
+        otErr << __FUNCTION__ << ": Resuming dividend payout for "
+              << strSharesID << " after account " << visitor.m_strLastAccount
+              << "." << std::endl;
+
+        visitor.resume(theMap["inflight"]);
+        pSharesContract->VisitAccountRecords(
+            visitor, visitor.m_strLastAccount);
+        visitor.Finish(true);
+    }
+}
+
+// Settles the vouchers which were being sent when the payout was interrupted.
+// Each one is either in the shareholder's Nymbox, in the payer's Nymbox if it
+// was returned, or is sent again.
+void PayDividendVisitor::resume(const std::string& strInflight)
+{
+    std::istringstream stream(strInflight);
+    std::string strEntry;
+    std::vector<Payout> resend;
+
+    while (stream >> strEntry) {
+        const auto first = strEntry.find(':');
+        const auto second = strEntry.find(':', first + 1);
+
+        if ((std::string::npos == first) || (std::string::npos == second)) {
+            otErr << __FUNCTION__ << ": Invalid voucher in dividend payout "
+                  << "checkpoint: " << strEntry << std::endl;
+
+            continue;
+        }
+
+        Payout payout;
+        payout.recipient_ = Identifier(strEntry.substr(0, first));
+        payout.number_ = std::strtoll(
+            strEntry.substr(first + 1, second - first - 1).c_str(),
+            nullptr,
+            10);
+        payout.amount_ =
+            std::strtoll(strEntry.substr(second + 1).c_str(), nullptr, 10);
+
+        if (delivered(payout.recipient_, payout.number_)) {
+            m_lAmountPaidOut += payout.amount_;
+        } else if (delivered(*m_pNymID, payout.number_)) {
+            m_lAmountReturned += payout.amount_;
+        } else {
+            resend.push_back(payout);
+        }
+    }
+
+    if (!resend.empty()) {
+        otErr << __FUNCTION__ << ": Sending " << resend.size()
+              << " vouchers again, which were not delivered before the "
+              << "payout was interrupted." << std::endl;
+        send(resend);
+    }
+}
+
+bool PayDividendVisitor::save_checkpoint(
+    const std::vector<Payout>& inflight) const
+{
+    if (m_strSharesInstrumentDefinitionID.empty()) {
+
+        return true;
+    }
+
+    std::unique_ptr<OTDB::Storable> pStorable(
+        OTDB::CreateObject(OTDB::STORED_OBJ_STRING_MAP));
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    OT_ASSERT(nullptr != pMap);
+
+    auto& theMap = pMap->the_map;
+    theMap["notary"] = String(notaryID_).Get();
+    theMap["nym"] = String(*m_pNymID).Get();
+    theMap["payout"] = String(*m_pPayoutInstrumentDefinitionID).Get();
+    theMap["voucher_account"] = String(*m_pVoucherAcctID).Get();
+    theMap["memo"] = m_pstrMemo->Get();
+    theMap["per_share"] = std::to_string(m_lPayoutPerShare);
+    theMap["total"] = std::to_string(m_lTotalCost);
+    theMap["paid"] = std::to_string(m_lAmountPaidOut);
+    theMap["returned"] = std::to_string(m_lAmountReturned);
+
+    // Vouchers being sent, as recipient:number:amount
+    std::string strInflight;
+
+    for (const auto& payout : inflight) {
+        if (!strInflight.empty()) strInflight += ' ';
+
+        strInflight += std::string(String(payout.recipient_).Get()) + ':' +
+                       std::to_string(payout.number_) + ':' +
+                       std::to_string(payout.amount_);
+    }
+
+    theMap["inflight"] = strInflight;
+    theMap["last_account"] = m_strLastAccount;
+
+    const bool bSaved = OTDB::StoreObject(
+        *pMap, OTFolders::Cron().Get(), OT_DIVIDEND_FOLDER, checkpoint_file());
+
+    if (!bSaved) {
+        otErr << __FUNCTION__ << ": Failed saving dividend payout progress for "
+              << m_strSharesInstrumentDefinitionID << std::endl;
+    }
+
+    return bSaved;
+}
+
+bool PayDividendVisitor::send(std::vector<Payout>& batch)
+{
+    OT_ASSERT(nullptr != GetServer());
+
+    OTServer& theServer = *(GetServer());
+    const Nym& theServerNym = theServer.GetServerNym();
+    const Identifier& theSenderNymID = *(GetNymID());
+
+    // We save the transaction number on the server Nym (normally we'd discard
+    // it) because when the cheque is deposited, the server nym, as the owner
+    // of the voucher account, needs to verify the transaction # on the cheque
+    // (to prevent double-spending of cheques.) The context can only be edited
+    // by one thread, so the numbers for the whole batch are issued here.
+    // Vouchers sent again after an interruption already have their numbers.
+    {
+        auto context = OT::App().Contract().mutable_ClientContext(
+            theServerNym.ID(), theServerNym.ID());
+
+        for (auto& payout : batch) {
+            if (0 != payout.number_) {
+                continue;
+            }
+
+            const bool bGotNextTransNum =
+                theServer.transactor_.issueNextTransactionNumberToNym(
+                    context.It(), payout.number_);
+
+            if (!bGotNextTransNum) {
+                const String strPayoutInstrumentDefinitionID(
+                    *m_pPayoutInstrumentDefinitionID),
+                    strRecipientNymID(payout.recipient_);
+                Log::vError(
+                    "PayDividendVisitor::send: ERROR!! Failed issuing next "
+                    "transaction "
+                    "number while trying to send a voucher (while paying "
+                    "dividends.) "
+                    "WAS TRYING TO PAY %" PRId64
+                    " of instrument definition %s to Nym %s.\n",
+                    payout.amount_,
+                    strPayoutInstrumentDefinitionID.Get(),
+                    strRecipientNymID.Get());
+                payout.number_ = 0;
+            }
+        }
+    }
+
+    // Signing the vouchers is the expensive part. Each voucher is only
+    // written by its own task, and the server nym is only read, which is safe
+    // for the reasons given in Notary::sign. Sealing a notice loads the
+    // recipient nym through the file-based Nym API, which is not made for
+    // concurrent use, so the notices are sealed one at a time.
+    std::mutex noticeLock;
+    OT::App().Parallel(
+        batch.size(),
+        [&](const std::size_t index) -> void {
+            prepare(batch[index], noticeLock);
+        },
+        OT_DIVIDEND_PARALLEL_THRESHOLD);
+
+    // Record which vouchers are being sent before sending them, so that an
+    // interrupted payout can find out which ones were delivered.
+    std::vector<Payout> inflight;
+    std::map<std::string, std::vector<Payout*>> recipients;
+
+    for (auto& payout : batch) {
+        if (0 == payout.number_) {
+            continue;
+        }
+
+        inflight.push_back(payout);
+
+        if (payout.notice_) {
+            recipients[String(payout.recipient_).Get()].push_back(&payout);
+        }
+    }
+
+    // Vouchers sent again after an interruption have no account
+    if (!batch.back().account_.empty()) {
+        m_strLastAccount = batch.back().account_;
+    }
+
+    save_checkpoint(inflight);
+
+    // Every notice for the same Nym is added to its Nymbox at once.
+    bool bSuccess = true;
+
+    for (const auto& it : recipients) {
+        const auto& payouts = it.second;
+        std::vector<const Message*> notices;
+        std::vector<int64_t> numbers;
+
+        for (const auto& payout : payouts) {
+            notices.push_back(payout->notice_.get());
+            numbers.push_back(payout->number_);
+        }
+
+        const bool bSent = theServer.DropMessagesToNymbox(
+            notaryID_,
+            payouts.front()->recipient_,
+            OTTransaction::instrumentNotice,
+            notices,
+            numbers);
+
+        for (auto& payout : payouts) {
+            if (bSent) {
+                m_lAmountPaidOut += payout->amount_;  // At the end of
+                                                      // iterating all
+                                                      // accounts, if
+                // m_lAmountPaidOut is less than lTotalPayoutAmount, then we
+                // return to rest to the sender.
+            } else {
+                payout->notice_.reset();
+            }
+        }
+    }
+
+    // If we didn't send it, then we need to return the funds to where they
+    // came from.
+    //
+    for (auto& payout : batch) {
+        if ((0 == payout.number_) || payout.notice_) {
+            continue;
+        }
+
+        bSuccess = false;
+        return_voucher(theSenderNymID, payout.amount_, payout.number_);
+    }
+
+    save_checkpoint({});
+
+    return bSuccess;
+}
+
+// For each "user" account of a specific instrument definition, this function
+// is called in order to pay a dividend to the Nym who owns that account.
+
+// PayDividendVisitor::Trigger() is used in
+// OTUnitDefinition::VisitAccountRecords()
+// cppcheck-suppress unusedFunction
+bool PayDividendVisitor::Trigger(Account& theSharesAccount)  // theSharesAccount
+                                                             // is, say, a Pepsi
+                                                             // shares
+// account.  Here, we'll send a dollars voucher
+// to its owner. The vouchers are sent in batches, so failures are reported by
+// Flush.
+{
+    const int64_t lPayoutAmount =
+        (theSharesAccount.GetBalance() * GetPayoutPerShare());
+
+    if (lPayoutAmount <= 0) {
+        Log::Output(
+            0,
+            "PayDividendVisitor::Trigger: nothing to pay, "
+            "since this account owns no shares. (Returning "
+            "true.)");
+        return true;  // nothing to pay, since this account owns no shares.
+                      // Success!
+    }
+
+    Payout payout;
+    payout.account_ = String(theSharesAccount.GetPurportedAccountID()).Get();
+    payout.recipient_ = theSharesAccount.GetNymID();
+    payout.amount_ = lPayoutAmount;
+    m_pending.push_back(payout);
+
+    if (OT_DIVIDEND_BATCH <= m_pending.size()) {
+
+        return Flush();
     }
 
-    return bReturnValue;
+    return true;
 }
 
 }  // namespace opentxs
@@ -47,6 +47,7 @@
 #include "opentxs/core/String.hpp"
 #include "opentxs/server/OTServer.hpp"
 #include "opentxs/server/ReplyMessage.hpp"
+#include "opentxs/server/ServerStatistics.hpp"
 #include "opentxs/server/UserCommandProcessor.hpp"
 
 #define OT_METHOD "opentxs::ReplyMessage::"
@@ -328,11 +329,21 @@ bool ReplyMessage::SetPayload2(const String& payload)
     return message_.m_ascPayload2.SetString(payload);
 }
 
+void ReplyMessage::SetPayload2(const OTASCIIArmor& payload)
+{
+    message_.m_ascPayload2 = payload;
+}
+
 bool ReplyMessage::SetPayload3(const String& payload)
 {
     return message_.m_ascPayload3.SetString(payload);
 }
 
+void ReplyMessage::SetPayload3(const OTASCIIArmor& payload)
+{
+    message_.m_ascPayload3 = payload;
+}
+
 void ReplyMessage::SetRequestNumber(const RequestNumber number)
 {
     message_.m_lNewRequestNum = number;
@@ -361,8 +372,14 @@ void ReplyMessage::SetTargetNym(const String& nymID)
 
 ReplyMessage::~ReplyMessage()
 {
-    message_.SignContract(signer_);
-    message_.SaveContract();
+    auto& statistics = server_.statistics_;
+
+    {
+        ServerStatistics::Timer timer(
+            statistics, ServerStatistics::Phase::sign);
+        message_.SignContract(signer_);
+        message_.SaveContract();
+    }
 
     if (drop_ && context_) {
         UserCommandProcessor::drop_reply_notice_to_nymbox(
@@ -377,5 +394,12 @@ ReplyMessage::~ReplyMessage()
     if (context_ && context_->It().HaveLocalNymboxHash()) {
         SetNymboxHash(context_->It().LocalNymboxHash());
     }
+
+    if (context_) {
+        // Releasing the editor saves the client context.
+        ServerStatistics::Timer timer(
+            statistics, ServerStatistics::Phase::persist);
+        context_.reset();
+    }
 }
 }  // namespace opentxs
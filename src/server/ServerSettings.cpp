@@ -54,6 +54,8 @@ int64_t ServerSettings::__min_market_scale = 1;
 int32_t ServerSettings::__heartbeat_no_requests = 10;
 // number of ms between each heartbeat.
 int32_t ServerSettings::__heartbeat_ms_between_beats = 100;
+// number of seconds between writes of the statistics file.
+int64_t ServerSettings::__statistics_interval = 60;
 // The Nym who's allowed to do certain
 // commands even if they are turned off.
 std::string ServerSettings::__override_nym_id;
@@ -108,6 +110,7 @@ bool ServerSettings::__transact_smart_contract = true;
 bool ServerSettings::__cmd_trigger_clause = true;
 bool ServerSettings::__cmd_register_contract = true;
 bool ServerSettings::__cmd_request_admin = true;
+bool ServerSettings::__cmd_get_statistics = true;
 
 // Todo: Might set ALL of these to false (so you're FORCED to set them true
 // in the server.cfg file.) This way you're also assured that the right data
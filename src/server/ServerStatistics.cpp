@@ -0,0 +1,322 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/core/stdafx.hpp"
+
+#include "opentxs/server/ServerStatistics.hpp"
+
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/Message.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/server/ServerSettings.hpp"
+
+#include <algorithm>
+#include <ostream>
+#include <string>
+
+#define STATISTICS_FILE "notary-statistics.json"
+
+#define OT_METHOD "opentxs::ServerStatistics::"
+
+namespace opentxs
+{
+ServerStatistics::Timer::Timer(
+    ServerStatistics& statistics,
+    const ServerStatistics::Phase phase)
+    : statistics_(statistics)
+    , phase_(phase)
+    , start_(std::chrono::steady_clock::now())
+{
+}
+
+ServerStatistics::Timer::~Timer()
+{
+    statistics_.Record(phase_, std::chrono::steady_clock::now() - start_);
+}
+
+ServerStatistics::Histogram::Histogram()
+    : bucket_()
+    , count_(0)
+    , sum_(0)
+    , max_(0)
+{
+    for (auto& bucket : bucket_) {
+        bucket.store(0);
+    }
+}
+
+std::size_t ServerStatistics::Histogram::index(const std::uint64_t value)
+{
+    if (16 > value) {
+
+        return static_cast<std::size_t>(value);
+    }
+
+    std::size_t magnitude = 0;
+
+    for (auto v = value; 1 < v; v >>= 1) {
+        ++magnitude;
+    }
+
+    const auto sub = (value >> (magnitude - 3)) & 7;
+
+    return 16 + (magnitude - 4) * 8 + static_cast<std::size_t>(sub);
+}
+
+std::uint64_t ServerStatistics::Histogram::upper(const std::size_t index)
+{
+    if (16 > index) {
+
+        return index;
+    }
+
+    const std::size_t magnitude = (index - 16) / 8 + 4;
+    const std::uint64_t sub = (index - 16) % 8;
+    const std::uint64_t width = std::uint64_t(1) << (magnitude - 3);
+
+    return ((8 + sub) * width) + width - 1;
+}
+
+std::uint64_t ServerStatistics::Histogram::Percentile(
+    const double percentile) const
+{
+    const auto count = count_.load();
+
+    if (0 == count) {
+
+        return 0;
+    }
+
+    const auto target = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(percentile * count + 0.5));
+    std::uint64_t seen = 0;
+
+    for (std::size_t i = 0; i < buckets_; ++i) {
+        seen += bucket_[i].load(std::memory_order_relaxed);
+
+        if (seen >= target) {
+
+            return std::min(upper(i), max_.load());
+        }
+    }
+
+    return max_.load();
+}
+
+void ServerStatistics::Histogram::Record(const std::uint64_t value)
+{
+    bucket_[index(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    auto max = max_.load(std::memory_order_relaxed);
+
+    while ((value > max) && (false == max_.compare_exchange_weak(max, value))) {
+    }
+}
+
+ServerStatistics::ServerStatistics()
+    : commands_()
+    , failures_()
+    , phase_()
+    , queue_()
+    , started_(std::chrono::steady_clock::now())
+    , last_write_(started_)
+{
+    for (auto& failures : failures_) {
+        failures.store(0);
+    }
+}
+
+void ServerStatistics::Command(
+    const MessageType type,
+    const std::chrono::steady_clock::duration elapsed,
+    const bool success)
+{
+    const auto index = static_cast<std::size_t>(type);
+
+    if (message_types_ <= index) {
+
+        return;
+    }
+
+    commands_[index].Record(micros(elapsed));
+
+    if (false == success) {
+        failures_[index].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ServerStatistics::histogram(
+    std::string& output,
+    const std::string& name,
+    const Histogram& histogram,
+    const std::uint64_t failures)
+{
+    const auto count = histogram.Count();
+    output += "\"" + name + "\": {";
+    output += "\"count\": " + std::to_string(count);
+    output += ", \"failures\": " + std::to_string(failures);
+    output += ", \"mean_us\": " +
+              std::to_string((0 < count) ? histogram.Sum() / count : 0);
+    output += ", \"p50_us\": " + std::to_string(histogram.Percentile(0.5));
+    output += ", \"p90_us\": " + std::to_string(histogram.Percentile(0.9));
+    output += ", \"p99_us\": " + std::to_string(histogram.Percentile(0.99));
+    output += ", \"p999_us\": " + std::to_string(histogram.Percentile(0.999));
+    output += ", \"max_us\": " + std::to_string(histogram.Max());
+    output += "}";
+}
+
+std::uint64_t ServerStatistics::micros(
+    const std::chrono::steady_clock::duration elapsed)
+{
+    const auto output =
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+    return (0 > output) ? 0 : static_cast<std::uint64_t>(output);
+}
+
+std::string ServerStatistics::phase_name(const std::size_t phase)
+{
+    switch (static_cast<Phase>(phase)) {
+        case Phase::dearmor: {
+            return "dearmor";
+        }
+        case Phase::parse: {
+            return "parse";
+        }
+        case Phase::verify: {
+            return "verify";
+        }
+        case Phase::context: {
+            return "context";
+        }
+        case Phase::notarize: {
+            return "notarize";
+        }
+        case Phase::sign: {
+            return "sign";
+        }
+        case Phase::persist: {
+            return "persist";
+        }
+        case Phase::armor: {
+            return "armor";
+        }
+        default: {
+        }
+    }
+
+    return std::to_string(phase);
+}
+
+void ServerStatistics::QueueDepth(const std::uint64_t depth)
+{
+    queue_.Record(depth);
+}
+
+void ServerStatistics::Record(
+    const Phase phase,
+    const std::chrono::steady_clock::duration elapsed)
+{
+    phase_[static_cast<std::size_t>(phase)].Record(micros(elapsed));
+}
+
+std::string ServerStatistics::Report() const
+{
+    const auto uptime = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now() - started_);
+    std::string output = "{\n";
+    output += "    \"uptime_seconds\": " + std::to_string(uptime.count());
+    output += ",\n    \"commands\": {";
+    bool first = true;
+
+    for (std::size_t i = 0; i < message_types_; ++i) {
+        if (0 == commands_[i].Count()) {
+            continue;
+        }
+
+        output += first ? "\n        " : ",\n        ";
+        histogram(
+            output,
+            Message::Command(static_cast<MessageType>(i)),
+            commands_[i],
+            failures_[i].load());
+        first = false;
+    }
+
+    output += first ? "}" : "\n    }";
+    output += ",\n    \"phases\": {";
+    first = true;
+
+    for (std::size_t i = 0; i < phases_; ++i) {
+        output += first ? "\n        " : ",\n        ";
+        histogram(output, phase_name(i), phase_[i], 0);
+        first = false;
+    }
+
+    output += "\n    },\n    ";
+    histogram(output, "queue_depth", queue_, 0);
+    output += "\n}\n";
+
+    return output;
+}
+
+void ServerStatistics::Write()
+{
+    const auto interval = ServerSettings::GetStatisticsInterval();
+
+    if (0 >= interval) {
+
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+
+    if (now - last_write_ < std::chrono::seconds(interval)) {
+
+        return;
+    }
+
+    last_write_ = now;
+
+    if (false == OTDB::StorePlainString(Report(), STATISTICS_FILE)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write "
+              << STATISTICS_FILE << std::endl;
+    }
+}
+}  // namespace opentxs
@@ -74,9 +74,13 @@
 #include "opentxs/server/OTServer.hpp"
 #include "opentxs/server/ReplyMessage.hpp"
 #include "opentxs/server/ServerSettings.hpp"
+#include "opentxs/server/ServerStatistics.hpp"
 #include "opentxs/server/Transactor.hpp"
 
 #include <inttypes.h>
+#include <sys/stat.h>
+
+#include <ctime>
 #include <memory>
 #include <set>
 #include <string>
@@ -87,6 +91,7 @@
 #define NYMBOX_DEPTH 0
 #define INBOX_DEPTH 1
 #define OUTBOX_DEPTH 2
+#define MAX_CACHED_REPLY_BYTES (1024 * 1024 * 32)
 
 namespace opentxs
 {
@@ -254,6 +259,83 @@ bool UserCommandProcessor::add_numbers_to_nymbox(
     return success;
 }
 
+bool UserCommandProcessor::cached_reply(
+    const std::string& key,
+    const std::string& state,
+    CachedReply& output) const
+{
+    if (state.empty()) {
+
+        return false;
+    }
+
+    Lock lock(reply_cache_lock_);
+    auto it = reply_cache_.find(key);
+
+    if (reply_cache_.end() == it) {
+
+        return false;
+    }
+
+    auto& entry = it->second;
+
+    if (entry.first.state_ != state) {
+        reply_cache_bytes_ -= entry.first.size();
+        reply_lru_.erase(entry.second);
+        reply_cache_.erase(it);
+
+        return false;
+    }
+
+    reply_lru_.splice(reply_lru_.begin(), reply_lru_, entry.second);
+    output = entry.first;
+
+    return true;
+}
+
+void UserCommandProcessor::cache_reply(
+    const std::string& key,
+    const CachedReply& reply) const
+{
+    if (reply.state_.empty()) {
+
+        return;
+    }
+
+    const std::size_t limit = MAX_CACHED_REPLY_BYTES;
+    const auto size = reply.size();
+
+    if (limit < size) {
+
+        return;
+    }
+
+    Lock lock(reply_cache_lock_);
+    auto it = reply_cache_.find(key);
+
+    if (reply_cache_.end() != it) {
+        reply_cache_bytes_ -= it->second.first.size();
+        reply_lru_.erase(it->second.second);
+        reply_cache_.erase(it);
+    }
+
+    while (limit < (reply_cache_bytes_ + size)) {
+        OT_ASSERT(false == reply_lru_.empty());
+
+        auto oldest = reply_cache_.find(reply_lru_.back());
+
+        OT_ASSERT(reply_cache_.end() != oldest);
+
+        reply_cache_bytes_ -= oldest->second.first.size();
+        reply_cache_.erase(oldest);
+        reply_lru_.pop_back();
+    }
+
+    reply_lru_.push_front(key);
+    reply_cache_.emplace(key, std::make_pair(reply, reply_lru_.begin()));
+    reply_cache_bytes_ += size;
+}
+
 // ACKNOWLEDGMENTS OF REPLIES ALREADY RECEIVED (FOR OPTIMIZATION.)
 
 // On the client side, whenever the client is DEFINITELY made aware of the
@@ -382,20 +464,25 @@ bool UserCommandProcessor::check_client_nym(ReplyMessage& reply) const
         return false;
     }
 
-    if (false == nymfile.VerifyPseudonym()) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Unable to verify nym "
-              << String(nymfile.ID()) << std::endl;
+    {
+        ServerStatistics::Timer timer(
+            server_->statistics_, ServerStatistics::Phase::verify);
 
-        return false;
-    }
+        if (false == nymfile.VerifyPseudonym()) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Unable to verify nym "
+                  << String(nymfile.ID()) << std::endl;
 
-    otWarn << OT_METHOD << __FUNCTION__ << "Nym verified!" << std::endl;
+            return false;
+        }
 
-    if (false == msgIn.VerifySignature(nymfile)) {
-        otErr << OT_METHOD << __FUNCTION__
-              << ": Unable to verify message signature." << std::endl;
+        otWarn << OT_METHOD << __FUNCTION__ << "Nym verified!" << std::endl;
 
-        return false;
+        if (false == msgIn.VerifySignature(nymfile)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Unable to verify message signature." << std::endl;
+
+            return false;
+        }
     }
 
     otInfo << OT_METHOD << __FUNCTION__
@@ -799,6 +886,54 @@ bool UserCommandProcessor::cmd_get_account_data(ReplyMessage& reply) const
     const auto& serverID = context.Server();
     const auto& serverNym = *context.Nym();
     const Identifier accountID(msgIn.m_strAcctID);
+    const std::string notary = String(serverID).Get();
+    const std::string accountName = String(accountID).Get();
+    const auto key =
+        reply_key(MessageType::getAccountData, nymID, msgIn.m_strAcctID);
+    // The account file and both of its boxes.
+    const auto accountState = [&]() -> std::string {
+        std::string output;
+
+        for (const auto& part :
+             {stored_state(OTFolders::Account().Get(), accountName),
+              stored_state(OTFolders::Inbox().Get(), notary, accountName),
+              stored_state(OTFolders::Outbox().Get(), notary, accountName)}) {
+            if (part.empty()) {
+
+                return {};
+            }
+
+            output += part + ':';
+        }
+
+        return output;
+    };
+    // The client sends the hashes of the boxes it already has. Any box which
+    // still matches is left out of the reply.
+    const auto changed = [](const String& known, const std::string& hash) {
+        return !known.Exists() || !known.Compare(hash.c_str());
+    };
+    CachedReply cached{};
+    cached.state_ = accountState();
+
+    if (cached_reply(key, cached.state_, cached)) {
+        reply.SetPayload(OTASCIIArmor(cached.payload_.c_str()));
+
+        if (changed(msgIn.m_strInboxHash, cached.hash_)) {
+            reply.SetPayload2(OTASCIIArmor(cached.payload2_.c_str()));
+        }
+
+        if (changed(msgIn.m_strOutboxHash, cached.hash2_)) {
+            reply.SetPayload3(OTASCIIArmor(cached.payload3_.c_str()));
+        }
+
+        reply.SetInboxHash(Identifier(String(cached.hash_.c_str())));
+        reply.SetOutboxHash(Identifier(String(cached.hash2_.c_str())));
+        reply.SetSuccess(true);
+
+        return true;
+    }
+
     const auto account = Account::LoadExistingAccount(accountID, serverID);
 
     if (nullptr == account) {
@@ -841,13 +976,34 @@ bool UserCommandProcessor::cmd_get_account_data(ReplyMessage& reply) const
     inbox->CalculateInboxHash(inboxHash);
     outbox->SaveContractRaw(serializedOutbox);
     outbox->CalculateOutboxHash(outboxHash);
-    reply.SetPayload(serializedAccount);
-    reply.SetPayload2(serializedInbox);
-    reply.SetPayload3(serializedOutbox);
+    const OTASCIIArmor payload(serializedAccount);
+    const OTASCIIArmor payload2(serializedInbox);
+    const OTASCIIArmor payload3(serializedOutbox);
+    reply.SetPayload(payload);
+
+    if (changed(msgIn.m_strInboxHash, String(inboxHash).Get())) {
+        reply.SetPayload2(payload2);
+    }
+
+    if (changed(msgIn.m_strOutboxHash, String(outboxHash).Get())) {
+        reply.SetPayload3(payload3);
+    }
+
     reply.SetInboxHash(inboxHash);
     reply.SetOutboxHash(outboxHash);
     reply.SetSuccess(true);
 
+    // Only cache the reply if nothing changed underneath it while it was
+    // being built.
+    if (accountState() == cached.state_) {
+        cached.payload_ = payload.Get();
+        cached.payload2_ = payload2.Get();
+        cached.payload3_ = payload3.Get();
+        cached.hash_ = String(inboxHash).Get();
+        cached.hash2_ = String(outboxHash).Get();
+        cache_reply(key, cached);
+    }
+
     return true;
 }
 
@@ -954,6 +1110,20 @@ bool UserCommandProcessor::cmd_get_instrument_definition(
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_contract);
 
     const Identifier contractID(msgIn.m_strInstrumentDefinitionID);
+    // A contract ID is the hash of the contract, so the serialized form never
+    // changes once it has been found.
+    const auto key = reply_key(
+        MessageType::getInstrumentDefinition,
+        Identifier(),
+        msgIn.m_strInstrumentDefinitionID);
+    CachedReply cached{};
+
+    if (cached_reply(key, msgIn.m_strInstrumentDefinitionID.Get(), cached)) {
+        reply.SetSuccess(true);
+        reply.SetPayload(OTASCIIArmor(cached.payload_.c_str()));
+
+        return true;
+    }
 
     Data serialized{};
     auto unitDefiniton = OT::App().Contract().UnitDefinition(contractID);
@@ -965,14 +1135,21 @@ bool UserCommandProcessor::cmd_get_instrument_definition(
         reply.SetSuccess(true);
         serialized = proto::ProtoAsData<proto::UnitDefinition>(
             unitDefiniton->PublicContract());
-        reply.SetPayload(serialized);
     } else if (server) {
         reply.SetSuccess(true);
         serialized =
             proto::ProtoAsData<proto::ServerContract>(server->PublicContract());
-        reply.SetPayload(serialized);
+    } else {
+
+        return true;
     }
 
+    const OTASCIIArmor payload(serialized);
+    reply.SetPayload(payload);
+    cached.state_ = msgIn.m_strInstrumentDefinitionID.Get();
+    cached.payload_ = payload.Get();
+    cache_reply(key, cached);
+
     return true;
 }
 
@@ -983,6 +1160,23 @@ bool UserCommandProcessor::cmd_get_market_list(ReplyMessage& reply) const
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_market_list);
 
+    const auto key = reply_key(MessageType::getMarketList, Identifier(), "");
+    CachedReply cached{};
+    // Markets are prefixed so that an empty market list still has a state.
+    cached.state_ = "markets:" + server_->m_Cron.GetMarketListState();
+
+    if (cached_reply(key, cached.state_, cached)) {
+        reply.SetSuccess(true);
+        reply.SetDepth(cached.depth_);
+
+        if (0 < cached.depth_) {
+            reply.ClearRequest();
+            reply.SetPayload(OTASCIIArmor(cached.payload_.c_str()));
+        }
+
+        return true;
+    }
+
     OTASCIIArmor output{};
     std::int32_t count{0};
     reply.SetSuccess(server_->m_Cron.GetMarketList(output, count));
@@ -994,6 +1188,10 @@ bool UserCommandProcessor::cmd_get_market_list(ReplyMessage& reply) const
             reply.ClearRequest();
             reply.SetPayload(output);
         }
+
+        cached.payload_ = output.Get();
+        cached.depth_ = count;
+        cache_reply(key, cached);
     }
 
     return true;
@@ -1079,6 +1277,18 @@ bool UserCommandProcessor::cmd_get_mint(ReplyMessage& reply) const
     const auto& context = reply.Context();
     const auto& serverID = context.Server();
     bool loaded = false;
+    const auto key = reply_key(MessageType::getMint, Identifier(), unitID);
+    const std::string notary = String(serverID).Get();
+    const std::string mintFile = std::string(unitID.Get()) + ".PUBLIC";
+    CachedReply cached{};
+    cached.state_ = stored_state(OTFolders::Mint().Get(), notary, mintFile);
+
+    if (cached_reply(key, cached.state_, cached)) {
+        reply.SetSuccess(true);
+        reply.SetPayload(OTASCIIArmor(cached.payload_.c_str()));
+
+        return true;
+    }
 
     std::unique_ptr<Mint> mint(Mint::MintFactory(String(serverID), unitID));
 
@@ -1095,8 +1305,16 @@ bool UserCommandProcessor::cmd_get_mint(ReplyMessage& reply) const
 
         // Yup the asset contract exists.
         if (loaded) {
+            const String serializedMint(*mint);
+            const OTASCIIArmor payload(serializedMint);
             reply.SetSuccess(true);
-            reply.SetPayload(String(*mint));
+            reply.SetPayload(payload);
+
+            if (stored_state(OTFolders::Mint().Get(), notary, mintFile) ==
+                cached.state_) {
+                cached.payload_ = payload.Get();
+                cache_reply(key, cached);
+            }
         }
     }
 
@@ -1139,6 +1357,24 @@ bool UserCommandProcessor::cmd_get_nymbox(ReplyMessage& reply) const
     const auto& serverID = context.Server();
     const auto& serverNym = *context.Nym();
     const Identifier originalNymboxHash = context.LocalNymboxHash();
+    const auto key = reply_key(MessageType::getNymbox, nymID, "");
+    const std::string notary = String(serverID).Get();
+    const std::string nym = String(nymID).Get();
+    CachedReply cached{};
+    cached.state_ = stored_state(OTFolders::Nymbox().Get(), notary, nym);
+
+    // A hit updates the context's nymbox hash, so it is only served if the
+    // nymbox was verified by load_nymbox() when the reply was cached.
+    if (cached_reply(key, cached.state_, cached) && cached.verified_) {
+        const Identifier nymboxHash(String(cached.hash_.c_str()));
+        reply.SetSuccess(true);
+        reply.SetPayload(OTASCIIArmor(cached.payload_.c_str()));
+        context.SetLocalNymboxHash(nymboxHash);
+        reply.SetNymboxHash(nymboxHash);
+
+        return true;
+    }
+
     Identifier newNymboxHash{};
     bool bSavedNymbox{false};
     auto nymbox = load_nymbox(nymID, serverID, serverNym, false);
@@ -1151,8 +1387,10 @@ bool UserCommandProcessor::cmd_get_nymbox(ReplyMessage& reply) const
         return false;
     }
 
+    const String serializedNymbox(*nymbox);
+    const OTASCIIArmor payload(serializedNymbox);
     reply.SetSuccess(true);
-    reply.SetPayload(String(*nymbox));
+    reply.SetPayload(payload);
 
     if (bSavedNymbox) {
         context.SetLocalNymboxHash(newNymboxHash);
@@ -1163,6 +1401,14 @@ bool UserCommandProcessor::cmd_get_nymbox(ReplyMessage& reply) const
 
     reply.SetNymboxHash(newNymboxHash);
 
+    if (stored_state(OTFolders::Nymbox().Get(), notary, nym) ==
+        cached.state_) {
+        cached.payload_ = payload.Get();
+        cached.hash_ = String(newNymboxHash).Get();
+        cached.verified_ = true;
+        cache_reply(key, cached);
+    }
+
     return true;
 }
 
@@ -1207,6 +1453,25 @@ bool UserCommandProcessor::cmd_get_request_number(ReplyMessage& reply) const
     return true;
 }
 
+bool UserCommandProcessor::cmd_get_statistics(ReplyMessage& reply) const
+{
+    const auto& msgIn = reply.Original();
+
+    OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_statistics);
+
+    if (false == isAdmin(reply.Context().RemoteNym().ID())) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": This command is only available to admin nym." << std::endl;
+
+        return false;
+    }
+
+    const String statistics(server_->statistics_.Report());
+    reply.SetSuccess(reply.SetPayload(statistics));
+
+    return true;
+}
+
 bool UserCommandProcessor::cmd_get_transaction_numbers(
     ReplyMessage& reply) const
 {
@@ -1530,8 +1795,13 @@ bool UserCommandProcessor::cmd_notarize_transaction(ReplyMessage& reply) const
             inputNumber));
 
         bool success{false};
-        server_->notary_.NotarizeTransaction(
-            nymfile, context, *transaction, *response.Response(), success);
+
+        {
+            ServerStatistics::Timer timer(
+                server_->statistics_, ServerStatistics::Phase::notarize);
+            server_->notary_.NotarizeTransaction(
+                nymfile, context, *transaction, *response.Response(), success);
+        }
 
         if (response.Response()->IsCancelled()) {
             otErr << OT_METHOD << __FUNCTION__
@@ -1677,13 +1947,18 @@ bool UserCommandProcessor::cmd_process_inbox(ReplyMessage& reply) const
     }
 
     bool success{false};
-    server_->notary_.NotarizeProcessInbox(
-        nymfile,
-        context,
-        *account,
-        *processInbox,
-        *response.Response(),
-        success);
+
+    {
+        ServerStatistics::Timer timer(
+            server_->statistics_, ServerStatistics::Phase::notarize);
+        server_->notary_.NotarizeProcessInbox(
+            nymfile,
+            context,
+            *account,
+            *processInbox,
+            *response.Response(),
+            success);
+    }
 
     if (false == context.ConsumeIssued(inputNumber)) {
         otErr << OT_METHOD << __FUNCTION__ << ": Error removing issued number "
@@ -2977,9 +3252,14 @@ bool UserCommandProcessor::ProcessUserCommand(
         return false;
     }
 
-    if (false == reply.LoadContext()) {
+    {
+        ServerStatistics::Timer timer(
+            server_->statistics_, ServerStatistics::Phase::context);
 
-        return false;
+        if (false == reply.LoadContext()) {
+
+            return false;
+        }
     }
 
     OT_ASSERT(reply.HaveContext());
@@ -3111,6 +3391,9 @@ bool UserCommandProcessor::ProcessUserCommand(
         case MessageType::addClaim: {
             return cmd_add_claim(reply);
         }
+        case MessageType::getStatistics: {
+            return cmd_get_statistics(reply);
+        }
         default: {
             otErr << OT_METHOD << __FUNCTION__
                   << ": Unknown command type: " << command << std::endl;
@@ -3125,6 +3408,20 @@ bool UserCommandProcessor::ProcessUserCommand(
     }
 }
 
+std::string UserCommandProcessor::reply_key(
+    const MessageType type,
+    const Identifier& nymID,
+    const String& objectID)
+{
+    std::string output = Message::Command(type);
+    output += ':';
+    output += String(nymID).Get();
+    output += ':';
+    output += objectID.Get();
+
+    return output;
+}
+
 bool UserCommandProcessor::reregister_nym(ReplyMessage& reply) const
 {
     const auto& msgIn = reply.Original();
@@ -3183,6 +3480,9 @@ bool UserCommandProcessor::save_inbox(
         return false;
     }
 
+    ServerStatistics::Timer timer(
+        server_->statistics_, ServerStatistics::Phase::persist);
+
     if (false == inbox.SaveInbox(&hash)) {
 
         return false;
@@ -3201,6 +3501,9 @@ bool UserCommandProcessor::save_nymbox(
         return false;
     }
 
+    ServerStatistics::Timer timer(
+        server_->statistics_, ServerStatistics::Phase::persist);
+
     if (false == nymbox.SaveNymbox(&hash)) {
 
         return false;
@@ -3219,6 +3522,9 @@ bool UserCommandProcessor::save_outbox(
         return false;
     }
 
+    ServerStatistics::Timer timer(
+        server_->statistics_, ServerStatistics::Phase::persist);
+
     if (false == outbox.SaveOutbox(&hash)) {
 
         return false;
@@ -3227,6 +3533,56 @@ bool UserCommandProcessor::save_outbox(
     return true;
 }
 
+// Identifies the stored version of a file without reading it. A file whose
+// modification time is too recent to tell it apart from a rewrite within the
+// same clock tick is hashed instead.
+std::string UserCommandProcessor::stored_state(
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two)
+{
+    std::string path{};
+
+    if (0 > OTDB::FormPathString(path, folder, one, two)) {
+
+        return {};
+    }
+
+    struct stat info {
+    };
+
+    if ((0 != ::stat(path.c_str(), &info)) || (0 == info.st_size)) {
+
+        return {};
+    }
+
+    const std::string metadata = std::to_string(info.st_ino) + '.' +
+                                 std::to_string(info.st_size) + '.' +
+                                 std::to_string(info.st_mtime);
+
+    if (info.st_mtime < (std::time(nullptr) - 1)) {
+
+        return metadata;
+    }
+
+    const auto contents = OTDB::QueryPlainString(folder, one, two);
+
+    if (contents.empty()) {
+
+        return {};
+    }
+
+    Identifier digest{};
+
+    if (false == digest.CalculateDigest(
+                     Data(contents.data(), contents.size()))) {
+
+        return {};
+    }
+
+    return metadata + '.' + String(digest).Get();
+}
+
 // msg, the request msg from payer, which is attached WHOLE to the Nymbox
 // receipt. contains payment already.
 // or pass pPayment instead: we will create our own msg here (with payment
@@ -76,8 +76,16 @@
 #include <stdexcept>
 #include <utility>
 
+#define OT_STORAGE_REPLICATION_QUEUE 4096
+
 #define OT_METHOD "opentxs::Storage::"
 
+namespace
+{
+/** Number of Storage::Batch calls in progress on this thread */
+thread_local std::size_t batch_depth_{0};
+}  // namespace
+
 namespace opentxs
 {
 const std::uint32_t Storage::HASH_TYPE = 2;  // BTC160
@@ -89,6 +97,21 @@ Storage::Storage(
     const Random& random)
     : crypto_(crypto)
     , gc_interval_(config.gc_interval_)
+    , commit_lock_()
+    , commit_signal_()
+    , updates_(0)
+    , replication_lock_()
+    , replication_signal_()
+    , replication_queue_()
+    , replicated_root_()
+    , replicating_(false)
+    , replication_thread_(nullptr)
+    , object_cache_lock_()
+    , object_cache_()
+    , object_cache_order_()
+    , object_cache_bytes_(0)
+    , object_cache_hits_(0)
+    , object_cache_misses_(0)
     , config_(config)
     , digest_(hash)
     , random_(random)
@@ -120,6 +143,20 @@ Storage::Storage(
     OT_ASSERT(primary_plugin_);
 }
 
+bool Storage::Batch(const std::function<bool()>& updates)
+{
+    ++batch_depth_;
+    const bool output = updates();
+    --batch_depth_;
+
+    if (0 == batch_depth_) {
+
+        return commit(updates_.load()) && output;
+    }
+
+    return output;
+}
+
 std::set<std::string> Storage::BlockchainAccountList(
     const std::string& nymID,
     const proto::ContactItemType type)
@@ -140,6 +177,65 @@ ObjectList Storage::BlockchainTransactionList()
     return Meta().Tree().BlockchainNode().List();
 }
 
+StorageDriver::CachedProto Storage::cached_proto(const std::string& key) const
+{
+    Lock lock(object_cache_lock_);
+    auto it = object_cache_.find(key);
+
+    if (object_cache_.end() == it) {
+        object_cache_misses_++;
+
+        return nullptr;
+    }
+
+    auto& entry = it->second;
+    object_cache_order_.splice(
+        object_cache_order_.end(), object_cache_order_, entry.position_);
+    object_cache_hits_++;
+
+    return entry.object_;
+}
+
+void Storage::cache_proto(
+    const std::string& key,
+    const CachedProto& object,
+    const std::size_t size) const
+{
+    const std::size_t limit =
+        (0 < config_.object_cache_size_)
+            ? static_cast<std::size_t>(config_.object_cache_size_)
+            : 0;
+
+    if (size > limit) {
+        return;
+    }
+
+    Lock lock(object_cache_lock_);
+
+    if (0 < object_cache_.count(key)) {
+        return;
+    }
+
+    while ((object_cache_bytes_ + size) > limit) {
+        OT_ASSERT(false == object_cache_order_.empty());
+
+        auto oldest = object_cache_.find(object_cache_order_.front());
+
+        OT_ASSERT(object_cache_.end() != oldest);
+
+        object_cache_bytes_ -= oldest->second.size_;
+        object_cache_.erase(oldest);
+        object_cache_order_.pop_front();
+    }
+
+    auto& entry = object_cache_[key];
+    entry.object_ = object;
+    entry.size_ = size;
+    entry.position_ =
+        object_cache_order_.insert(object_cache_order_.end(), key);
+    object_cache_bytes_ += size;
+}
+
 void Storage::Cleanup_Storage()
 {
     for (auto& thread : background_threads_) {
@@ -151,6 +247,49 @@ void Storage::Cleanup_Storage()
     if (meta_) {
         meta_->cleanup();
     }
+
+    stop_replication();
+
+    Lock lock(object_cache_lock_);
+    object_cache_.clear();
+    object_cache_order_.clear();
+    object_cache_bytes_ = 0;
+}
+
+bool Storage::commit(const std::uint64_t update)
+{
+    std::unique_lock<std::mutex> lock(commit_lock_);
+
+    // The first thread to arrive stores a root which covers every update
+    // made so far. Threads which arrive while it is working wait for it to
+    // finish, and only store the root again if their update was missed.
+    while (committed_ < update) {
+        if (committing_) {
+            commit_signal_.wait(lock);
+
+            continue;
+        }
+
+        committing_ = true;
+        const auto target = updates_.load();
+        lock.unlock();
+        std::string hash{};
+        const bool saved = meta()->commit(hash) && StoreRoot(hash);
+        lock.lock();
+        committing_ = false;
+        commit_signal_.notify_all();
+
+        if (false == saved) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to store root."
+                  << std::endl;
+
+            return false;
+        }
+
+        committed_ = target;
+    }
+
+    return true;
 }
 
 void Storage::Cleanup()
@@ -215,13 +354,13 @@ bool Storage::EmptyBucket(const bool bucket) const
 {
     OT_ASSERT(primary_plugin_);
 
-    for (const auto& plugin : backup_plugins_) {
-        OT_ASSERT(plugin);
-
-        plugin->EmptyBucket(bucket);
-    }
+    const bool output = primary_plugin_->EmptyBucket(bucket);
+    Replication item{};
+    item.type_ = ReplicationType::EMPTY_BUCKET;
+    item.bucket_ = bucket;
+    replicate(std::move(item));
 
-    return primary_plugin_->EmptyBucket(bucket);
+    return output;
 }
 
 void Storage::InitBackup()
@@ -270,6 +409,7 @@ void Storage::InitPlugins()
 {
     synchronize_root();
     synchronize_plugins();
+    start_replication();
 }
 
 bool Storage::Load(
@@ -329,6 +469,30 @@ bool Storage::Load(
     return false;
 }
 
+bool Storage::Load(
+    const std::string& key,
+    const bool checking,
+    const ValueReader& reader) const
+{
+    OT_ASSERT(primary_plugin_);
+
+    if (primary_plugin_->Load(key, true, reader)) {
+
+        return true;
+    }
+
+    // Objects found by a backup plugin are copied back to the primary plugin
+    // by the copying version, so the view is taken from that copy.
+    std::string value;
+
+    if (false == Load(key, checking, value)) {
+
+        return false;
+    }
+
+    return reader(value.data(), value.size());
+}
+
 bool Storage::Load(
     const std::string& id,
     std::shared_ptr<proto::BlockchainTransaction>& transaction,
@@ -368,6 +532,18 @@ bool Storage::Load(
         id, context, notUsed, checking);
 }
 
+bool Storage::Load(
+    const std::string& nym,
+    const std::string& id,
+    std::shared_ptr<const proto::Context>& context,
+    const bool checking)
+{
+    std::string notUsed;
+
+    return Meta().Tree().NymNode().Nym(nym).Contexts().Load(
+        id, context, notUsed, checking);
+}
+
 bool Storage::Load(
     const std::string& id,
     std::shared_ptr<proto::Credential>& cred,
@@ -376,6 +552,14 @@ bool Storage::Load(
     return Meta().Tree().CredentialNode().Load(id, cred, checking);
 }
 
+bool Storage::Load(
+    const std::string& id,
+    std::shared_ptr<const proto::Credential>& cred,
+    const bool checking)
+{
+    return Meta().Tree().CredentialNode().Load(id, cred, checking);
+}
+
 bool Storage::Load(
     const std::string& id,
     std::shared_ptr<proto::CredentialIndex>& nym,
@@ -626,27 +810,25 @@ std::string Storage::LoadRoot() const
     return root;
 }
 
-// Applies a lambda to all public nyms in the database in a detached thread.
-void Storage::MapPublicNyms(NymLambda& lambda)
+// Applies a lambda to all public nyms in the database. Runs in the calling
+// thread; objects rejected by the filter are never loaded.
+void Storage::MapPublicNyms(NymLambda& lambda, const MapFilter& filter)
 {
-    std::thread bgMap(&Storage::RunMapPublicNyms, this, lambda);
-    bgMap.detach();
+    Meta().Tree().NymNode().Map(lambda, filter);
 }
 
-// Applies a lambda to all server contracts in the database in a detached
-// thread.
-void Storage::MapServers(ServerLambda& lambda)
+// Applies a lambda to all server contracts in the database. Runs in the
+// calling thread; objects rejected by the filter are never loaded.
+void Storage::MapServers(ServerLambda& lambda, const MapFilter& filter)
 {
-    std::thread bgMap(&Storage::RunMapServers, this, lambda);
-    bgMap.detach();
+    Meta().Tree().ServerNode().Map(lambda, filter);
 }
 
-// Applies a lambda to all unit definitions in the database in a detached
-// thread.
-void Storage::MapUnitDefinitions(UnitLambda& lambda)
+// Applies a lambda to all unit definitions in the database. Runs in the
+// calling thread; objects rejected by the filter are never loaded.
+void Storage::MapUnitDefinitions(UnitLambda& lambda, const MapFilter& filter)
 {
-    std::thread bgMap(&Storage::RunMapUnits, this, lambda);
-    bgMap.detach();
+    Meta().Tree().UnitNode().Map(lambda, filter);
 }
 
 bool Storage::Migrate(const std::string& key, const StorageDriver& to) const
@@ -762,10 +944,24 @@ bool Storage::MoveThreadItem(
 
 Editor<storage::Root> Storage::mutable_Meta()
 {
+    std::shared_ptr<std::uint64_t> update{new std::uint64_t{0}};
     std::function<void(storage::Root*, Lock&)> callback =
-        [&](storage::Root* in, Lock& lock) -> void { this->save(in, lock); };
+        [this, update](storage::Root* in, Lock& lock) -> void {
+        *update = this->save(in, lock);
+    };
+    std::function<void(storage::Root*)> commit =
+        [this, update](storage::Root*) -> void {
+        // An Editor can't report a failure to the caller which made the
+        // update, so a root which can't be stored is fatal, as it was before
+        // Batch() existed. Batch() returns the failure instead.
+        if (0 == batch_depth_) {
+            const bool committed = this->commit(*update);
+
+            OT_ASSERT(committed);
+        }
+    };
 
-    return Editor<storage::Root>(write_lock_, meta(), callback);
+    return Editor<storage::Root>(write_lock_, meta(), callback, commit);
 }
 
 ObjectList Storage::NymBoxList(const std::string& nymID, const StorageBox box)
@@ -830,6 +1026,23 @@ ObjectList Storage::NymBoxList(const std::string& nymID, const StorageBox box)
 
 ObjectList Storage::NymList() const { return Meta().Tree().NymNode().List(); }
 
+std::uint64_t Storage::ObjectCacheHits() const
+{
+    return object_cache_hits_.load();
+}
+
+std::uint64_t Storage::ObjectCacheMisses() const
+{
+    return object_cache_misses_.load();
+}
+
+std::size_t Storage::ObjectCacheSize() const
+{
+    Lock lock(object_cache_lock_);
+
+    return object_cache_bytes_;
+}
+
 storage::Root* Storage::meta() const
 {
     Lock lock(write_lock_);
@@ -1068,27 +1281,12 @@ void Storage::RunGC()
     CollectGarbage();
 }
 
-void Storage::RunMapPublicNyms(NymLambda lambda)
-{
-    return Meta().Tree().NymNode().Map(lambda);
-}
-
-void Storage::RunMapServers(ServerLambda lambda)
-{
-    return Meta().Tree().ServerNode().Map(lambda);
-}
-
-void Storage::RunMapUnits(UnitLambda lambda)
-{
-    return Meta().Tree().UnitNode().Map(lambda);
-}
-
-void Storage::save(storage::Root* in, const Lock& lock)
+std::uint64_t Storage::save(storage::Root* in, const Lock& lock)
 {
     OT_ASSERT(verify_write_lock(lock));
     OT_ASSERT(nullptr != in);
 
-    StoreRoot(in->root_);
+    return ++updates_;
 }
 
 bool Storage::SetContactAlias(const std::string& id, const std::string& alias)
@@ -1284,8 +1482,120 @@ ObjectList Storage::ServerList() const
     return Meta().Tree().ServerNode().List();
 }
 
+// Backup plugins receive writes in the same order as the primary plugin, so an
+// object is always replicated before any root which references it.
+void Storage::replicate(Replication&& item) const
+{
+    if (backup_plugins_.empty()) {
+
+        return;
+    }
+
+    Lock lock(replication_lock_);
+
+    if (false == replicating_.load()) {
+        lock.unlock();
+        std::deque<Replication> batch{};
+        batch.emplace_back(std::move(item));
+        write_replicas(batch);
+
+        return;
+    }
+
+    replication_signal_.wait(lock, [this]() -> bool {
+        return shutdown_.load() ||
+               (OT_STORAGE_REPLICATION_QUEUE > replication_queue_.size());
+    });
+    replication_queue_.emplace_back(std::move(item));
+    lock.unlock();
+    replication_signal_.notify_all();
+}
+
+std::string Storage::ReplicatedRoot() const
+{
+    Lock lock(replication_lock_);
+
+    return replicated_root_;
+}
+
+void Storage::replication_worker()
+{
+    std::deque<Replication> batch{};
+
+    while (true) {
+        {
+            Lock lock(replication_lock_);
+            replication_signal_.wait(lock, [this]() -> bool {
+                return shutdown_.load() ||
+                       (false == replication_queue_.empty());
+            });
+
+            // Only reached once shutdown has been requested
+            if (replication_queue_.empty()) {
+
+                return;
+            }
+
+            batch.swap(replication_queue_);
+        }
+
+        // Wake any writers waiting for room in the queue
+        replication_signal_.notify_all();
+        write_replicas(batch);
+        batch.clear();
+    }
+}
+
 void Storage::start() { InitPlugins(); }
 
+void Storage::start_replication()
+{
+    OT_ASSERT(primary_plugin_);
+
+    if (backup_plugins_.empty() || replication_thread_) {
+
+        return;
+    }
+
+    const auto root = primary_plugin_->LoadRoot();
+    bool synchronized{true};
+
+    for (const auto& plugin : backup_plugins_) {
+        OT_ASSERT(plugin);
+
+        synchronized &= (root == plugin->LoadRoot());
+    }
+
+    {
+        Lock lock(replication_lock_);
+
+        if (synchronized) {
+            replicated_root_ = root;
+        }
+    }
+
+    replicating_.store(true);
+    replication_thread_.reset(
+        new std::thread(&Storage::replication_worker, this));
+}
+
+void Storage::stop_replication()
+{
+    {
+        // Later writes go to the backup plugins directly. The replication
+        // thread finishes whatever is already queued before exiting.
+        Lock lock(replication_lock_);
+        shutdown_.store(true);
+        replicating_.store(false);
+    }
+
+    replication_signal_.notify_all();
+
+    if (replication_thread_ && replication_thread_->joinable()) {
+        replication_thread_->join();
+    }
+}
+
 bool Storage::Store(
     const std::string& key,
     const std::string& value,
@@ -1293,27 +1603,33 @@ bool Storage::Store(
 {
     OT_ASSERT(primary_plugin_);
 
-    bool output = primary_plugin_->Store(key, value, bucket);
+    const bool output = primary_plugin_->Store(key, value, bucket);
 
-    for (const auto& plugin : backup_plugins_) {
-        OT_ASSERT(plugin);
-
-        output |= plugin->Store(key, value, bucket);
+    if (output) {
+        Replication item{};
+        item.type_ = ReplicationType::OBJECT;
+        item.key_ = key;
+        item.value_ = value;
+        item.bucket_ = bucket;
+        replicate(std::move(item));
     }
 
     return output;
 }
 
-bool Storage::Store(const std::string& key, std::string& value) const
+bool Storage::Store(const std::string& value, std::string& key) const
 {
     OT_ASSERT(primary_plugin_);
 
-    bool output = primary_plugin_->Store(key, value);
+    const bool output = primary_plugin_->Store(value, key);
 
-    for (const auto& plugin : backup_plugins_) {
-        OT_ASSERT(plugin);
-
-        output |= plugin->Store(key, value);
+    if (output) {
+        Replication item{};
+        item.type_ = ReplicationType::OBJECT;
+        item.key_ = key;
+        item.value_ = value;
+        item.bucket_ = primary_bucket_.load();
+        replicate(std::move(item));
     }
 
     return output;
@@ -1619,13 +1935,13 @@ bool Storage::StoreRoot(const std::string& hash) const
 {
     OT_ASSERT(primary_plugin_);
 
-    for (const auto& plugin : backup_plugins_) {
-        OT_ASSERT(plugin);
+    const bool output = primary_plugin_->StoreRoot(hash);
+    Replication item{};
+    item.type_ = ReplicationType::ROOT;
+    item.key_ = hash;
+    replicate(std::move(item));
 
-        plugin->StoreRoot(hash);
-    }
-
-    return primary_plugin_->StoreRoot(hash);
+    return output;
 }
 
 void Storage::synchronize_plugins()
@@ -1650,7 +1966,8 @@ void Storage::synchronize_plugins()
             continue;
         }
 
-        tree.It().Migrate(*plugin);
+        // Only copy the parts of the tree the backup does not already have
+        tree.It().Migrate(*plugin, true);
     }
 }
 
@@ -1767,5 +2084,57 @@ std::size_t Storage::UnreadCount(
     return threads.Thread(threadId).UnreadCount();
 }
 
+void Storage::write_replicas(const std::deque<Replication>& batch) const
+{
+    std::string root{};
+    std::set<std::pair<std::string, bool>> written{};
+
+    for (const auto& item : batch) {
+        switch (item.type_) {
+            case ReplicationType::OBJECT: {
+                // Objects are content addressed, so a repeat is redundant
+                if (false == written.emplace(item.key_, item.bucket_).second) {
+                    break;
+                }
+
+                for (const auto& plugin : backup_plugins_) {
+                    OT_ASSERT(plugin);
+
+                    plugin->Store(item.key_, item.value_, item.bucket_);
+                }
+            } break;
+            case ReplicationType::ROOT: {
+                // Only the newest root in a batch needs to be written
+                root = item.key_;
+            } break;
+            case ReplicationType::EMPTY_BUCKET: {
+                written.clear();
+
+                for (const auto& plugin : backup_plugins_) {
+                    OT_ASSERT(plugin);
+
+                    plugin->EmptyBucket(item.bucket_);
+                }
+            } break;
+            default: {
+            }
+        }
+    }
+
+    if (root.empty()) {
+
+        return;
+    }
+
+    for (const auto& plugin : backup_plugins_) {
+        OT_ASSERT(plugin);
+
+        plugin->StoreRoot(root);
+    }
+
+    Lock lock(replication_lock_);
+    replicated_root_ = root;
+}
+
 Storage::~Storage() { Cleanup_Storage(); }
 }  // namespace opentxs
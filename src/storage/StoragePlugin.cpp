@@ -110,6 +110,36 @@ bool StoragePlugin_impl::Load(
     return valid;
 }
 
+bool StoragePlugin_impl::Load(
+    const std::string& key,
+    const bool checking,
+    const ValueReader& reader) const
+{
+    if (key.empty()) {
+        if (!checking) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Error: Tried to load empty key" << std::endl;
+        }
+
+        return false;
+    }
+
+    const bool bucket = current_bucket_.load();
+
+    // Same search order as the copying version
+    const bool valid = ReadFromBucket(key, reader, bucket) ||
+                       ReadFromBucket(key, reader, !bucket) ||
+                       ReadFromBucket(key, reader, bucket);
+
+    if (!valid && !checking) {
+        otWarn << OT_METHOD << __FUNCTION__
+               << ": Specified object is not found." << std::endl
+               << "Hash: " << key << std::endl;
+    }
+
+    return valid;
+}
+
 bool StoragePlugin_impl::Migrate(
     const std::string& key,
     const StorageDriver& to) const
@@ -154,6 +184,26 @@ bool StoragePlugin_impl::Migrate(
     return true;
 }
 
+bool StoragePlugin_impl::ReadFromBucket(
+    const std::string& key,
+    const ValueReader& reader,
+    const bool bucket) const
+{
+    std::string value;
+
+    if (false == LoadFromBucket(key, value, bucket)) {
+
+        return false;
+    }
+
+    if (value.empty()) {
+
+        return false;
+    }
+
+    return reader(value.data(), value.size());
+}
+
 bool StoragePlugin_impl::Store(const std::string& value, std::string& key) const
 {
     const bool bucket = current_bucket_.load();
@@ -0,0 +1,447 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#if OT_STORAGE_FS
+#include "opentxs/core/stdafx.hpp"
+
+#include "opentxs/storage/drivers/FileIO.hpp"
+
+#include "opentxs/core/Log.hpp"
+
+#include <boost/filesystem.hpp>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <ios>
+
+#define OT_METHOD "opentxs::storage::FileIO::"
+// Smaller files are cheaper to copy than to map
+#define OT_FILEIO_MMAP_THRESHOLD 65536
+
+namespace opentxs
+{
+namespace storage
+{
+#ifndef _WIN32
+class FileIO::Descriptor
+{
+public:
+    const int fd_{-1};
+
+    explicit Descriptor(const int fd)
+        : fd_(fd)
+    {
+    }
+
+    ~Descriptor()
+    {
+        if (-1 < fd_) {
+            ::close(fd_);
+        }
+    }
+
+private:
+    Descriptor() = delete;
+    Descriptor(const Descriptor&) = delete;
+    Descriptor& operator=(const Descriptor&) = delete;
+};
+
+namespace
+{
+bool file_size(const int fd, std::size_t& size)
+{
+    struct stat info {
+    };
+
+    if (0 != ::fstat(fd, &info)) {
+
+        return false;
+    }
+
+    if ((0 >= info.st_size) || (0xFFFFFFFF <= info.st_size)) {
+
+        return false;
+    }
+
+    size = info.st_size;
+
+    return true;
+}
+
+bool read_file(
+    const int fd,
+    const std::size_t size,
+    const std::string& filename,
+    std::string& output)
+{
+    output.resize(size);
+    std::size_t read{0};
+
+    while (read < size) {
+        const auto bytes = ::pread(fd, &output[read], size - read, read);
+
+        if ((0 > bytes) && (EINTR == errno)) {
+            continue;
+        }
+
+        if (0 >= bytes) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to read "
+                  << filename << std::endl;
+            output.clear();
+
+            return false;
+        }
+
+        read += bytes;
+    }
+
+    return true;
+}
+
+bool sync_folder(const std::string& folder)
+{
+    const int fd = ::open(folder.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (-1 == fd) {
+
+        return false;
+    }
+
+    const bool output = (0 == ::fsync(fd));
+    ::close(fd);
+
+    return output;
+}
+}  // namespace
+#else
+class FileIO::Descriptor
+{
+};
+#endif
+
+FileIO::FileIO(const std::int64_t cacheSize)
+    : cache_size_((0 < cacheSize) ? cacheSize : 0)
+    , counter_(0)
+    , cache_lock_()
+    , cache_order_()
+    , cache_()
+    , folder_lock_()
+    , dirty_folders_()
+{
+}
+
+void FileIO::Clear() const
+{
+    std::lock_guard<std::mutex> lock(cache_lock_);
+    cache_.clear();
+    cache_order_.clear();
+}
+
+void FileIO::forget(const std::string& filename) const
+{
+    std::lock_guard<std::mutex> lock(cache_lock_);
+    auto it = cache_.find(filename);
+
+    if (cache_.end() == it) {
+
+        return;
+    }
+
+    cache_order_.erase(it->second.position_);
+    cache_.erase(it);
+}
+
+FileIO::FD FileIO::open(const std::string& filename, const bool cache) const
+{
+#ifndef _WIN32
+    const bool useCache = cache && (0 < cache_size_);
+
+    if (useCache) {
+        std::lock_guard<std::mutex> lock(cache_lock_);
+        auto it = cache_.find(filename);
+
+        if (cache_.end() != it) {
+            auto& entry = it->second;
+            cache_order_.splice(
+                cache_order_.end(), cache_order_, entry.position_);
+
+            return entry.fd_;
+        }
+    }
+
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (-1 == fd) {
+
+        return {};
+    }
+
+    FD output(new Descriptor(fd));
+
+    if (useCache) {
+        std::lock_guard<std::mutex> lock(cache_lock_);
+        auto& entry = cache_[filename];
+
+        if (entry.fd_) {
+            // Another thread opened the same file
+
+            return entry.fd_;
+        }
+
+        entry.fd_ = output;
+        entry.position_ = cache_order_.insert(cache_order_.end(), filename);
+
+        while (cache_size_ < cache_.size()) {
+            cache_.erase(cache_order_.front());
+            cache_order_.pop_front();
+        }
+    }
+
+    return output;
+#else
+    return {};
+#endif
+}
+
+bool FileIO::Read(
+    const std::string& filename,
+    std::string& output,
+    const bool cache) const
+{
+#ifndef _WIN32
+    const auto fd = open(filename, cache);
+
+    if (!fd) {
+
+        return false;
+    }
+
+    std::size_t size{0};
+
+    if (false == file_size(fd->fd_, size)) {
+
+        return false;
+    }
+
+    return read_file(fd->fd_, size, filename, output);
+#else
+    std::ifstream file(
+        filename, std::ios::in | std::ios::ate | std::ios::binary);
+
+    if (false == file.good()) {
+
+        return false;
+    }
+
+    std::ifstream::pos_type pos = file.tellg();
+
+    if ((0 >= pos) || (0xFFFFFFFF <= pos)) {
+
+        return false;
+    }
+
+    const std::size_t size(pos);
+    file.seekg(0, std::ios::beg);
+    output.resize(size);
+    file.read(&output[0], size);
+
+    return file.good();
+#endif
+}
+
+bool FileIO::Read(
+    const std::string& filename,
+    const Reader& reader,
+    const bool cache) const
+{
+    std::string contents{};
+
+#ifndef _WIN32
+    const auto fd = open(filename, cache);
+
+    if (!fd) {
+
+        return false;
+    }
+
+    std::size_t size{0};
+
+    if (false == file_size(fd->fd_, size)) {
+
+        return false;
+    }
+
+    if (OT_FILEIO_MMAP_THRESHOLD <= size) {
+        void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd->fd_, 0);
+
+        if (MAP_FAILED != map) {
+            const bool output = reader(map, size);
+            ::munmap(map, size);
+
+            return output;
+        }
+    }
+
+    if (false == read_file(fd->fd_, size, filename, contents)) {
+
+        return false;
+    }
+#else
+    if (false == Read(filename, contents, cache)) {
+
+        return false;
+    }
+#endif
+
+    return reader(contents.data(), contents.size());
+}
+
+bool FileIO::Sync() const
+{
+    std::set<std::string> folders{};
+
+    {
+        std::lock_guard<std::mutex> lock(folder_lock_);
+        folders.swap(dirty_folders_);
+    }
+
+    bool output{true};
+
+#ifndef _WIN32
+    for (const auto& folder : folders) {
+        output &= sync_folder(folder);
+    }
+#endif
+
+    return output;
+}
+
+bool FileIO::Write(
+    const std::string& filename,
+    const std::string& contents,
+    const bool sync) const
+{
+    const std::string temp =
+        filename + ".tmp" + std::to_string(++counter_);
+    const auto folder =
+        boost::filesystem::path(filename).parent_path().string();
+
+#ifndef _WIN32
+    const int fd =
+        ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+
+    if (-1 == fd) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to create " << temp
+              << std::endl;
+
+        return false;
+    }
+
+    std::size_t written{0};
+    bool good{true};
+
+    while (good && (written < contents.size())) {
+        const auto bytes = ::write(
+            fd, contents.data() + written, contents.size() - written);
+
+        if ((0 > bytes) && (EINTR == errno)) {
+            continue;
+        }
+
+        good = (0 < bytes);
+
+        if (good) {
+            written += bytes;
+        }
+    }
+
+    // The contents must be on disk before the rename makes them visible
+    good &= (0 == ::fsync(fd));
+    good &= (0 == ::close(fd));
+#else
+    std::ofstream file(temp, std::ios::out | std::ios::trunc | std::ios::binary);
+    file.write(contents.data(), contents.size());
+    file.close();
+    bool good = file.good();
+    std::remove(filename.c_str());
+#endif
+
+    // Files written earlier must be reachable before one which refers to them
+    if (good && sync) {
+        good = Sync();
+    }
+
+    if (good) {
+        good = (0 == std::rename(temp.c_str(), filename.c_str()));
+    }
+
+    if (false == good) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write " << filename
+              << std::endl;
+        std::remove(temp.c_str());
+
+        return false;
+    }
+
+    forget(filename);
+
+    if (sync) {
+#ifndef _WIN32
+        return sync_folder(folder);
+#endif
+    } else {
+        std::lock_guard<std::mutex> lock(folder_lock_);
+        dirty_folders_.insert(folder);
+    }
+
+    return true;
+}
+
+FileIO::~FileIO() { Clear(); }
+}  // namespace storage
+}  // namespace opentxs
+#endif
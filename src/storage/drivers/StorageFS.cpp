@@ -45,11 +45,8 @@
 #include <boost/filesystem.hpp>
 
 #include <cstdio>
-#include <fstream>
-#include <ios>
 #include <iostream>
 #include <thread>
-#include <vector>
 
 namespace opentxs
 {
@@ -61,6 +58,7 @@ StorageFS::StorageFS(
     std::atomic<bool>& bucket)
     : ot_super(config, hash, random, bucket)
     , folder_(config.path_)
+    , io_(config.fs_fd_cache_)
 {
     Init_StorageFS();
 }
@@ -87,32 +85,16 @@ void StorageFS::Purge(const std::string& path) const
 
 std::string StorageFS::LoadRoot() const
 {
+    std::string output{};
+
     if (!folder_.empty()) {
         std::string filename = folder_ + "/" + config_.fs_root_file_;
 
-        if (!boost::filesystem::exists(filename)) { return ""; }
-
-        std::ifstream file(
-            filename,
-            std::ios::in | std::ios::ate | std::ios::binary);
-
-        if (file.good()) {
-            std::ifstream::pos_type pos = file.tellg();
-
-            if ((0 >= pos) || (0xFFFFFFFF <= pos)) { return ""; }
-
-            uint32_t size(pos);
-
-            file.seekg(0, std::ios::beg);
-
-            std::vector<char> bytes(size);
-            file.read(&bytes[0], size);
-
-            return std::string(&bytes[0], size);
-        }
+        // The root file is replaced on every update, so it is never cached
+        io_.Read(filename, output);
     }
 
-    return "";
+    return output;
 }
 
 bool StorageFS::LoadFromBucket(
@@ -123,29 +105,25 @@ bool StorageFS::LoadFromBucket(
     std::string folder =  folder_ + "/" + GetBucketName(bucket);
     std::string filename = folder + "/" + key;
 
-    if (!boost::filesystem::exists(filename)) { return false; }
-
     if (!folder_.empty()) {
-        std::ifstream file(
-            filename,
-            std::ios::in | std::ios::ate | std::ios::binary);
-
-        if (file.good()) {
-            std::ifstream::pos_type pos = file.tellg();
-
-            if ((0 >= pos) || (0xFFFFFFFF <= pos)) { return false; }
 
-            uint32_t size(pos);
+        return io_.Read(filename, value, true);
+    }
 
-            file.seekg(0, std::ios::beg);
+    return false;
+}
 
-            std::vector<char> bytes(size);
-            file.read(&bytes[0], size);
+bool StorageFS::ReadFromBucket(
+    const std::string& key,
+    const ValueReader& reader,
+    const bool bucket) const
+{
+    std::string folder = folder_ + "/" + GetBucketName(bucket);
+    std::string filename = folder + "/" + key;
 
-            value.assign(&bytes[0], size);
+    if (!folder_.empty()) {
 
-            return true;
-        }
+        return io_.Read(filename, reader, true);
     }
 
     return false;
@@ -155,16 +133,9 @@ bool StorageFS::StoreRoot(const std::string& hash) const
 {
     if (!folder_.empty()) {
         std::string filename = folder_ + "/" + config_.fs_root_file_;
-        std::ofstream file(
-            filename,
-            std::ios::out | std::ios::trunc | std::ios::binary);
-
-        if (file.good()) {
-            file.write(hash.c_str(), hash.size());
-            file.close();
 
-            return true;
-        }
+        // Every object the new root refers to must be on disk first
+        return io_.Write(filename, hash, true);
     }
 
     return false;
@@ -179,15 +150,8 @@ bool StorageFS::Store(
     std::string filename = folder + "/" + key;
 
     if (!folder_.empty()) {
-        std::ofstream file(
-            filename,
-            std::ios::out | std::ios::trunc | std::ios::binary);
-        if (file.good()) {
-            file.write(value.c_str(), value.size());
-            file.close();
-
-            return true;
-        }
+
+        return io_.Write(filename, value);
     }
 
     return false;
@@ -205,6 +169,9 @@ bool StorageFS::EmptyBucket(const bool bucket) const
         return false;
     }
 
+    // Cached descriptors refer to files in the old bucket
+    io_.Clear();
+
     std::thread backgroundDelete(&StorageFS::Purge, this, newName);
     backgroundDelete.detach();
 
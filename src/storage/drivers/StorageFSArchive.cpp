@@ -53,11 +53,9 @@
 
 #include <cstdio>
 #include <cstdint>
-#include <fstream>
-#include <ios>
 #include <iostream>
 #include <thread>
-#include <vector>
+#include <utility>
 
 #define ROOT_FILE_EXTENSION ".hash"
 
@@ -79,13 +77,18 @@ StorageFSArchive::StorageFSArchive(
     , encryption_key_(key.release())
     , encrypted_(bool(encryption_key_))
     , ready_(false)
+    , folder_lock_()
+    , folders_()
+    , io_(config.fs_fd_cache_)
 {
     Init_StorageFSArchive();
 }
 
-std::string StorageFSArchive::calculate_path(const std::string& key) const
+std::string StorageFSArchive::calculate_path(
+    const std::string& key,
+    std::string& folder) const
 {
-    std::string folder(folder_);
+    folder = folder_;
 
     if (4 < key.size()) {
         folder += path_seperator_;
@@ -97,8 +100,6 @@ std::string StorageFSArchive::calculate_path(const std::string& key) const
         folder += key.substr(4, 4);
     }
 
-    boost::filesystem::create_directories(folder);
-
     return {folder + path_seperator_ + key};
 }
 
@@ -109,11 +110,24 @@ void StorageFSArchive::Cleanup_StorageFSArchive()
     // future cleanup actions go here
 }
 
-std::string StorageFSArchive::decrypt(const std::string&& input) const
+void StorageFSArchive::create_folder(const std::string& folder) const
+{
+    std::lock_guard<std::mutex> lock(folder_lock_);
+
+    if (0 < folders_.count(folder)) {
+
+        return;
+    }
+
+    boost::filesystem::create_directories(folder);
+    folders_.insert(folder);
+}
+
+std::string StorageFSArchive::decrypt(std::string&& input) const
 {
     if (false == encrypted_) {
 
-        return input;
+        return std::move(input);
     }
 
     const auto ciphertext = proto::TextToProto<proto::Ciphertext>(input);
@@ -177,7 +191,8 @@ bool StorageFSArchive::LoadFromBucket(
     value.clear();
 
     if (ready_.load() && (false == folder_.empty())) {
-        value = read_file(calculate_path(key));
+        std::string folder{};
+        value = read_file(calculate_path(key, folder), true);
     }
 
     return (false == value.empty());
@@ -189,37 +204,24 @@ std::string StorageFSArchive::LoadRoot() const
         std::string filename = folder_ + path_seperator_ +
                                config_.fs_root_file_ + ROOT_FILE_EXTENSION;
 
-        return read_file(filename);
+        return read_file(filename, false);
     }
 
     return "";
 }
 
-std::string StorageFSArchive::read_file(const std::string& filename) const
+std::string StorageFSArchive::read_file(
+    const std::string& filename,
+    const bool cache) const
 {
-    if (!boost::filesystem::exists(filename)) {
-        return {};
-    }
-
-    std::ifstream file(
-        filename, std::ios::in | std::ios::ate | std::ios::binary);
+    std::string contents{};
 
-    if (file.good()) {
-        std::ifstream::pos_type pos = file.tellg();
+    if (false == io_.Read(filename, contents, cache)) {
 
-        if ((0 >= pos) || (0xFFFFFFFF <= pos)) {
-            return {};
-        }
-
-        std::uint32_t size(pos);
-        file.seekg(0, std::ios::beg);
-        std::vector<char> bytes(size);
-        file.read(&bytes[0], size);
-
-        return decrypt(std::string(&bytes[0], size));
+        return {};
     }
 
-    return {};
+    return decrypt(std::move(contents));
 }
 
 bool StorageFSArchive::Store(
@@ -228,8 +230,11 @@ bool StorageFSArchive::Store(
     const bool) const
 {
     if (ready_.load() && false == folder_.empty()) {
+        std::string folder{};
+        const auto filename = calculate_path(key, folder);
+        create_folder(folder);
 
-        return write_file(calculate_path(key), value);
+        return write_file(filename, value, false);
     }
 
     return false;
@@ -242,7 +247,8 @@ bool StorageFSArchive::StoreRoot(const std::string& hash) const
                                      config_.fs_root_file_ +
                                      ROOT_FILE_EXTENSION;
 
-        return write_file(filename, hash);
+        // Every object the new root refers to must be on disk first
+        return write_file(filename, hash, true);
     }
 
     return false;
@@ -250,16 +256,11 @@ bool StorageFSArchive::StoreRoot(const std::string& hash) const
 
 bool StorageFSArchive::write_file(
     const std::string& filename,
-    const std::string& contents) const
+    const std::string& contents,
+    const bool sync) const
 {
     if (false == filename.empty()) {
-        std::ofstream file(
-            filename, std::ios::out | std::ios::trunc | std::ios::binary);
-        const std::string data = encrypt(contents);
-
-        if (file.good()) {
-            file.write(data.c_str(), data.size());
-            file.close();
+        if (io_.Write(filename, encrypt(contents), sync)) {
 
             return true;
         } else {
@@ -66,6 +66,19 @@ bool StorageSqlite3::Select(
     const std::string& key,
     const std::string& tablename,
     std::string& value) const
+{
+    return Select(
+        key, tablename, [&value](const void* data, const std::size_t size) {
+            value.assign(static_cast<const char*>(data), size);
+
+            return true;
+        });
+}
+
+bool StorageSqlite3::Select(
+    const std::string& key,
+    const std::string& tablename,
+    const ValueReader& reader) const
 {
     sqlite3_stmt* statement = nullptr;
     const std::string query =
@@ -77,10 +90,10 @@ bool StorageSqlite3::Select(
     bool success = false;
 
     if (result == SQLITE_ROW) {
+        // The blob belongs to the statement until it is finalized
         const void* pResult = sqlite3_column_blob(statement, 0);
         uint32_t size = sqlite3_column_bytes(statement, 0);
-        value.assign(static_cast<const char*>(pResult), size);
-        success = true;
+        success = reader(pResult, size);
     }
     sqlite3_finalize(statement);
 
@@ -168,6 +181,14 @@ bool StorageSqlite3::LoadFromBucket(
     return Select(key, GetTableName(bucket), value);
 }
 
+bool StorageSqlite3::ReadFromBucket(
+    const std::string& key,
+    const ValueReader& reader,
+    const bool bucket) const
+{
+    return Select(key, GetTableName(bucket), reader);
+}
+
 bool StorageSqlite3::StoreRoot(const std::string& hash) const
 {
     return Upsert(
@@ -124,7 +124,7 @@ void Contacts::extract_addresses(const Lock& lock, const proto::Contact& data)
 
 void Contacts::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageContacts> serialized{nullptr};
+    std::shared_ptr<const proto::StorageContacts> serialized{nullptr};
     driver_.LoadProto(hash, serialized);
 
     if (false == bool(serialized)) {
@@ -61,7 +61,7 @@ bool Contexts::Delete(const std::string& id) { return delete_item(id); }
 
 void Contexts::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageNymList> serialized;
+    std::shared_ptr<const proto::StorageNymList> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -92,6 +92,15 @@ bool Contexts::Load(
     return load_proto<proto::Context>(id, output, alias, checking);
 }
 
+bool Contexts::Load(
+    const std::string& id,
+    std::shared_ptr<const proto::Context>& output,
+    std::string& alias,
+    const bool checking) const
+{
+    return load_proto<const proto::Context>(id, output, alias, checking);
+}
+
 bool Contexts::save(const std::unique_lock<std::mutex>& lock) const
 {
     if (!verify_write_lock(lock)) {
@@ -81,7 +81,7 @@ bool Credentials::check_existing(const bool incoming, Metadata& metadata) const
     // hasn't been updated
     // ...so we have to load the credential just to be sure
     if (!isPrivate) {
-        std::shared_ptr<proto::Credential> existing;
+        std::shared_ptr<const proto::Credential> existing;
 
         if (!driver_.LoadProto(hash, existing, false)) {
             std::cerr << __FUNCTION__ << ": Failed to load object" << std::endl;
@@ -98,7 +98,7 @@ bool Credentials::Delete(const std::string& id) { return delete_item(id); }
 
 void Credentials::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageCredentials> serialized;
+    std::shared_ptr<const proto::StorageCredentials> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -124,6 +124,22 @@ bool Credentials::Load(
     const std::string& id,
     std::shared_ptr<proto::Credential>& cred,
     const bool checking) const
+{
+    std::shared_ptr<const proto::Credential> existing;
+
+    if (!Load(id, existing, checking)) {
+        return false;
+    }
+
+    cred = std::make_shared<proto::Credential>(*existing);
+
+    return true;
+}
+
+bool Credentials::Load(
+    const std::string& id,
+    std::shared_ptr<const proto::Credential>& cred,
+    const bool checking) const
 {
     std::lock_guard<std::mutex> lock(write_lock_);
     const bool exists = (item_map_.end() != item_map_.find(id));
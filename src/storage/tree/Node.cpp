@@ -145,28 +145,50 @@ bool Node::load_raw(
     return driver_.Load(std::get<0>(it->second), checking, output);
 }
 
-bool Node::migrate(const std::string& hash, const StorageDriver& to) const
+bool Node::migrate(
+    const std::string& hash,
+    const StorageDriver& to,
+    const bool incremental) const
 {
     if (!check_hash(hash)) {
         return true;
     }
 
+    if (incremental && migrated(hash, to)) {
+        return true;
+    }
+
     return driver_.Migrate(hash, to);
 }
 
-bool Node::Migrate(const StorageDriver& to) const
+bool Node::Migrate(const StorageDriver& to, const bool incremental) const
 {
+    if (incremental && migrated(root_, to)) {
+        return true;
+    }
+
     bool output{true};
 
     for (const auto item : item_map_) {
-        output &= migrate(std::get<0>(item.second), to);
+        output &= migrate(std::get<0>(item.second), to, incremental);
     }
 
-    output &= migrate(root_, to);
+    output &= migrate(root_, to, incremental);
 
     return output;
 }
 
+bool Node::migrated(const std::string& hash, const StorageDriver& to) const
+{
+    if (!check_hash(hash)) {
+        return false;
+    }
+
+    std::string notUsed{};
+
+    return to.Load(hash, true, notUsed);
+}
+
 std::string Node::normalize_hash(const std::string& hash)
 {
     if (hash.empty()) {
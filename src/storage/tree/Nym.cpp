@@ -251,7 +251,7 @@ const PeerReplies& Nym::IncomingReplyBox() const
 
 void Nym::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageNym> serialized;
+    std::shared_ptr<const proto::StorageNym> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -421,23 +421,27 @@ const Mailbox& Nym::MailInbox() const { return *mail_inbox(); }
 
 const Mailbox& Nym::MailOutbox() const { return *mail_outbox(); }
 
-bool Nym::Migrate(const StorageDriver& to) const
+bool Nym::Migrate(const StorageDriver& to, const bool incremental) const
 {
+    if (incremental && migrated(root_, to)) {
+        return true;
+    }
+
     bool output{true};
-    output &= migrate(credentials_, to);
-    output &= sent_request_box()->Migrate(to);
-    output &= incoming_request_box()->Migrate(to);
-    output &= sent_reply_box()->Migrate(to);
-    output &= incoming_reply_box()->Migrate(to);
-    output &= finished_request_box()->Migrate(to);
-    output &= finished_reply_box()->Migrate(to);
-    output &= processed_request_box()->Migrate(to);
-    output &= processed_reply_box()->Migrate(to);
-    output &= mail_inbox()->Migrate(to);
-    output &= mail_outbox()->Migrate(to);
-    output &= threads()->Migrate(to);
-    output &= contexts()->Migrate(to);
-    output &= migrate(root_, to);
+    output &= migrate(credentials_, to, incremental);
+    output &= sent_request_box()->Migrate(to, incremental);
+    output &= incoming_request_box()->Migrate(to, incremental);
+    output &= sent_reply_box()->Migrate(to, incremental);
+    output &= incoming_reply_box()->Migrate(to, incremental);
+    output &= finished_request_box()->Migrate(to, incremental);
+    output &= finished_reply_box()->Migrate(to, incremental);
+    output &= processed_request_box()->Migrate(to, incremental);
+    output &= processed_reply_box()->Migrate(to, incremental);
+    output &= mail_inbox()->Migrate(to, incremental);
+    output &= mail_outbox()->Migrate(to, incremental);
+    output &= threads()->Migrate(to, incremental);
+    output &= contexts()->Migrate(to, incremental);
+    output &= migrate(root_, to, incremental);
 
     return output;
 }
@@ -979,7 +983,8 @@ bool Nym::Store(
         if (existing->revision() > data.revision()) {
             otErr << OT_METHOD << __FUNCTION__
                   << ": Not saving object with older revision." << std::endl;
-        } else {
+        } else if (existing.get() != &data) {
+            // No copy is needed if the caller updated the loaded instance
             existing = std::make_shared<proto::Bip44Account>(data);
         }
     }
@@ -1007,7 +1012,7 @@ bool Nym::Store(
             if (checked_.load()) {
                 saveOk = !private_.load();
             } else {
-                std::shared_ptr<proto::CredentialIndex> serialized;
+                std::shared_ptr<const proto::CredentialIndex> serialized;
                 driver_.LoadProto(credentials_, serialized, true);
                 saveOk = !private_.load();
             }
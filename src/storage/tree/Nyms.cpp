@@ -70,7 +70,7 @@ bool Nyms::Exists(const std::string& id) const
 
 void Nyms::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageNymList> serialized;
+    std::shared_ptr<const proto::StorageNymList> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -92,40 +92,49 @@ void Nyms::init(const std::string& hash)
     }
 }
 
-void Nyms::Map(NymLambda lambda) const
+void Nyms::Map(NymLambda lambda, const MapFilter& filter) const
 {
     Lock lock(write_lock_);
     const auto copy = item_map_;
-    write_lock_.unlock();
+    lock.unlock();
 
     for (const auto it : copy) {
         const auto& id = it.first;
         const auto& node = *nym(id);
         const auto& hash = node.credentials_;
 
-        std::shared_ptr<proto::CredentialIndex> serialized;
+        std::shared_ptr<const proto::CredentialIndex> serialized;
 
         if (Node::BLANK_HASH == hash) {
             continue;
         }
 
-        if (driver_.LoadProto(hash, serialized, false)) {
+        if (filter && (false == filter(id, hash))) {
+            continue;
+        }
+
+        if (driver_.LoadProto<proto::CredentialIndex>(
+                hash, serialized, false)) {
             lambda(*serialized);
         }
     }
 }
 
-bool Nyms::Migrate(const StorageDriver& to) const
+bool Nyms::Migrate(const StorageDriver& to, const bool incremental) const
 {
+    if (incremental && migrated(root_, to)) {
+        return true;
+    }
+
     bool output{true};
 
     for (const auto index : item_map_) {
         const auto& id = index.first;
         const auto& node = *nym(id);
-        output &= node.Migrate(to);
+        output &= node.Migrate(to, incremental);
     }
 
-    output &= migrate(root_, to);
+    output &= migrate(root_, to, incremental);
 
     return output;
 }
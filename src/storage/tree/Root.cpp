@@ -68,6 +68,7 @@ Root::Root(
     : ot_super(storage, hash)
     , gc_interval_(interval)
     , current_bucket_(bucket)
+    , dirty_(false)
 {
     if (check_hash(hash)) {
         init(hash);
@@ -97,6 +98,24 @@ void Root::cleanup() const
     }
 }
 
+bool Root::commit(std::string& hash) const
+{
+    Lock lock(write_lock_);
+    bool output{true};
+
+    if (dirty_.exchange(false)) {
+        output = save(lock);
+
+        if (false == output) {
+            dirty_.store(true);
+        }
+    }
+
+    hash = root_;
+
+    return output;
+}
+
 void Root::collect_garbage(const StorageDriver* to) const
 {
     Lock lock(write_lock_);
@@ -143,7 +162,7 @@ void Root::collect_garbage(const StorageDriver* to) const
 
 void Root::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageRoot> serialized;
+    std::shared_ptr<const proto::StorageRoot> serialized;
 
     if (!driver_.LoadProto(hash, serialized)) {
         otErr << OT_METHOD << __FUNCTION__
@@ -167,7 +186,9 @@ void Root::init(const std::string& hash)
     tree_root_ = normalize_hash(serialized->items());
 }
 
-bool Root::Migrate(const StorageDriver& to) const
+// Garbage collection always copies the whole tree, since a node being present
+// in the destination says nothing about which bucket its children are in.
+bool Root::Migrate(const StorageDriver& to, const bool) const
 {
     const std::uint64_t time = std::time(nullptr);
     const bool intervalExceeded = ((time - last_gc_.load()) > gc_interval_);
@@ -219,11 +240,11 @@ void Root::save(class Tree* tree, const Lock& lock)
 
     Lock treeLock(tree_lock_);
     tree_root_ = tree->Root();
-    tree_lock_.unlock();
-
-    const bool saved = save(lock);
+    treeLock.unlock();
 
-    OT_ASSERT(saved);
+    // The root object is stored by commit(), which Storage calls once for
+    // any number of tree updates
+    dirty_.store(true);
 }
 
 std::uint64_t Root::Sequence() const { return sequence_.load(); }
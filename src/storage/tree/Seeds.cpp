@@ -74,7 +74,7 @@ bool Seeds::Delete(const std::string& id) { return delete_item(id); }
 
 void Seeds::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageSeeds> serialized;
+    std::shared_ptr<const proto::StorageSeeds> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -67,7 +67,7 @@ bool Servers::Delete(const std::string& id) { return delete_item(id); }
 
 void Servers::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageServers> serialized;
+    std::shared_ptr<const proto::StorageServers> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -98,9 +98,9 @@ bool Servers::Load(
     return load_proto<proto::ServerContract>(id, output, alias, checking);
 }
 
-void Servers::Map(ServerLambda lambda) const
+void Servers::Map(ServerLambda lambda, const MapFilter& filter) const
 {
-    map<proto::ServerContract>(lambda);
+    map<proto::ServerContract>(lambda, filter);
 }
 
 bool Servers::save(const std::unique_lock<std::mutex>& lock) const
@@ -168,7 +168,7 @@ std::string Thread::Alias() const
 
 void Thread::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageThread> serialized;
+    std::shared_ptr<const proto::StorageThread> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (false == bool(serialized)) {
@@ -216,9 +216,9 @@ proto::StorageThread Thread::Items() const
     return serialize(lock);
 }
 
-bool Thread::Migrate(const StorageDriver& to) const
+bool Thread::Migrate(const StorageDriver& to, const bool incremental) const
 {
-    return Node::migrate(root_, to);
+    return Node::migrate(root_, to, incremental);
 }
 
 bool Thread::Read(const std::string& id, const bool unread)
@@ -148,7 +148,7 @@ bool Threads::FindAndDeleteItem(const std::string& itemID)
 
 void Threads::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageNymList> serialized;
+    std::shared_ptr<const proto::StorageNymList> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -170,17 +170,21 @@ void Threads::init(const std::string& hash)
     }
 }
 
-bool Threads::Migrate(const StorageDriver& to) const
+bool Threads::Migrate(const StorageDriver& to, const bool incremental) const
 {
+    if (incremental && migrated(root_, to)) {
+        return true;
+    }
+
     bool output{true};
 
     for (const auto index : item_map_) {
         const auto& id = index.first;
         const auto& node = *thread(id);
-        output &= node.Migrate(to);
+        output &= node.Migrate(to, incremental);
     }
 
-    output &= migrate(root_, to);
+    output &= migrate(root_, to, incremental);
 
     return output;
 }
@@ -199,7 +199,7 @@ Credentials* Tree::credentials() const
 
 void Tree::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageItems> serialized{nullptr};
+    std::shared_ptr<const proto::StorageItems> serialized{nullptr};
     driver_.LoadProto(hash, serialized);
 
     if (false == bool(serialized)) {
@@ -225,17 +225,21 @@ void Tree::init(const std::string& hash)
     unit_root_ = normalize_hash(serialized->units());
 }
 
-bool Tree::Migrate(const StorageDriver& to) const
+bool Tree::Migrate(const StorageDriver& to, const bool incremental) const
 {
+    if (incremental && migrated(root_, to)) {
+        return true;
+    }
+
     bool output{true};
-    output &= blockchain()->Migrate(to);
-    output &= contacts()->Migrate(to);
-    output &= credentials()->Migrate(to);
-    output &= nyms()->Migrate(to);
-    output &= seeds()->Migrate(to);
-    output &= servers()->Migrate(to);
-    output &= units()->Migrate(to);
-    output &= migrate(root_, to);
+    output &= blockchain()->Migrate(to, incremental);
+    output &= contacts()->Migrate(to, incremental);
+    output &= credentials()->Migrate(to, incremental);
+    output &= nyms()->Migrate(to, incremental);
+    output &= seeds()->Migrate(to, incremental);
+    output &= servers()->Migrate(to, incremental);
+    output &= units()->Migrate(to, incremental);
+    output &= migrate(root_, to, incremental);
 
     return output;
 }
@@ -64,7 +64,7 @@ bool Units::Delete(const std::string& id) { return delete_item(id); }
 
 void Units::init(const std::string& hash)
 {
-    std::shared_ptr<proto::StorageUnits> serialized;
+    std::shared_ptr<const proto::StorageUnits> serialized;
     driver_.LoadProto(hash, serialized);
 
     if (!serialized) {
@@ -95,7 +95,10 @@ bool Units::Load(
     return load_proto<proto::UnitDefinition>(id, output, alias, checking);
 }
 
-void Units::Map(UnitLambda lambda) const { map<proto::UnitDefinition>(lambda); }
+void Units::Map(UnitLambda lambda, const MapFilter& filter) const
+{
+    map<proto::UnitDefinition>(lambda, filter);
+}
 
 bool Units::save(const std::unique_lock<std::mutex>& lock) const
 {
@@ -0,0 +1,763 @@
+// opentxs-bench: end-to-end notary benchmark.
+//
+// The OT singleton runs either in server mode or in client mode, so a single
+// process cannot host both halves. The bench therefore forks: the child
+// becomes a notary (ServerLoader + MessageProcessor) bound to 127.0.0.1, the
+// parent becomes a client wallet, and both keep their data under a temporary
+// folder. Every command travels over loopback ZMQ exactly as it would in
+// production. Results are written as JSON.
+//
+// Usage: opentxs-bench [--nyms N] [--rounds N] [--port N] [--output FILE]
+//                      [--no-cash] [--keep]
+
+#include "opentxs/api/Api.hpp"
+#include "opentxs/api/OT.hpp"
+#include "opentxs/cash/Mint.hpp"
+#include "opentxs/client/OT_ME.hpp"
+#include "opentxs/client/OTAPI_Wrap.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/crypto/OTCallback.hpp"
+#include "opentxs/core/crypto/OTCaller.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/server/MessageProcessor.hpp"
+#include "opentxs/server/OTServer.hpp"
+#include "opentxs/server/ServerLoader.hpp"
+
+#include <ftw.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+const std::string BENCH_PASSWORD = "test";
+const std::int64_t FUNDING_AMOUNT = 1000000;
+const std::int64_t OFFER_PRICE = 10;
+const std::int64_t OFFER_LIFESPAN = 60 * 60 * 24;
+const std::int64_t CASH_AMOUNT = 11;
+const std::int32_t TRANSACTION_NUMBERS = 20;
+
+struct Options {
+    std::int32_t nyms_{4};
+    std::int32_t rounds_{10};
+    std::int32_t port_{17085};
+    std::string output_{"opentxs-bench.json"};
+    bool cash_{true};
+    bool keep_{false};
+};
+
+struct Sample {
+    std::vector<double> latency_{};
+    double clientCpu_{0};
+    double serverCpu_{0};
+    std::int64_t failures_{0};
+};
+
+struct BenchNym {
+    std::string nym_{};
+    std::string asset_{};
+    std::string currency_{};
+};
+
+class BenchPassword : public OTCallback
+{
+public:
+    void runOne(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+
+    void runTwo(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+};
+
+// Length-prefixed messages between the notary and the client process.
+bool write_message(int fd, const std::string& message)
+{
+    const std::string frame = std::to_string(message.size()) + "\n" + message;
+    std::size_t written = 0;
+
+    while (written < frame.size()) {
+        const auto result =
+            ::write(fd, frame.data() + written, frame.size() - written);
+
+        if (0 >= result) { return false; }
+
+        written += result;
+    }
+
+    return true;
+}
+
+bool read_message(int fd, std::string& message)
+{
+    std::string header{};
+    char c = 0;
+
+    while (true) {
+        if (1 != ::read(fd, &c, 1)) { return false; }
+        if ('\n' == c) { break; }
+
+        header.push_back(c);
+    }
+
+    std::size_t size = 0;
+
+    try {
+        size = std::stoul(header);
+    } catch (...) {
+        return false;
+    }
+
+    message.assign(size, '\0');
+    std::size_t received = 0;
+
+    while (received < size) {
+        const auto result = ::read(fd, &message[received], size - received);
+
+        if (0 >= result) { return false; }
+
+        received += result;
+    }
+
+    return true;
+}
+
+double cpu_ms(clockid_t clock)
+{
+    timespec ts{};
+
+    if (0 != clock_gettime(clock, &ts)) { return 0; }
+
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int remove_entry(const char* path, const struct stat*, int, struct FTW*)
+{
+    return ::remove(path);
+}
+
+void set_password_callback(OTCaller& caller, BenchPassword& callback)
+{
+    caller.setCallback(&callback);
+    OT_API_Set_PasswordCallback(caller);
+}
+
+// The notary does not generate mints itself (that is the operator's job), so
+// the bench does what the mint tool would do for each issued unit. The client
+// process is blocked waiting for the reply while this runs, so the message
+// loop is idle.
+bool generate_mint(const std::string& unitID)
+{
+    auto* server = ServerLoader::getServer();
+
+    if (nullptr == server) { return false; }
+
+    auto& serverNym = const_cast<Nym&>(server->GetServerNym());
+    const String notaryID(server->GetServerID());
+    String serverNymID;
+    serverNym.GetIdentifier(serverNymID);
+    std::unique_ptr<Mint> mint(
+        Mint::MintFactory(notaryID, serverNymID, String(unitID.c_str())));
+
+    if (!mint) { return false; }
+
+    const std::int64_t year = 60 * 60 * 24 * 365;
+    const auto now = OTTimeGetCurrentTime();
+    mint->GenerateNewMint(
+        0,
+        now,
+        OTTimeAddTimeInterval(now, year),
+        OTTimeAddTimeInterval(now, 2 * year),
+        Identifier(unitID),
+        server->GetServerID(),
+        serverNym,
+        1,
+        10,
+        100,
+        1000,
+        0,
+        0,
+        0,
+        0,
+        0,
+        0);
+    mint->SetSavePrivateKeys();
+    mint->SignContract(serverNym);
+    mint->SaveContract();
+
+    if (!mint->SaveMint(".0")) { return false; }
+
+    mint->ReleaseSignatures();
+    mint->SignContract(serverNym);
+    mint->SaveContract();
+
+    return mint->SaveMint(".PUBLIC");
+}
+
+void mint_requests(int input, int output)
+{
+    std::string unitID{};
+
+    while (read_message(input, unitID)) {
+        write_message(output, generate_mint(unitID) ? "1" : "0");
+    }
+}
+
+int run_notary(const Options& options, int input, int output)
+{
+    BenchPassword callback;
+    OTCaller caller;
+    set_password_callback(caller, callback);
+
+    const std::string port = std::to_string(options.port_);
+    std::map<std::string, std::string> args{
+        {"name", "opentxs-bench"},
+        {"externalip", "127.0.0.1"},
+        {"bindip", "127.0.0.1"},
+        {"commandport", port},
+        {"listencommand", port},
+        {"listennotify", std::to_string(options.port_ + 1)}};
+    ServerLoader loader(args);
+    MessageProcessor processor(loader);
+
+    const auto contract = OTDB::QueryPlainString("NEW_SERVER_CONTRACT.otc");
+
+    if (!write_message(output, contract)) { return 1; }
+
+    std::thread mints(mint_requests, input, output);
+    mints.detach();
+    processor.run();
+
+    return 0;
+}
+
+class Client
+{
+public:
+    Client(pid_t notary, const std::string& notaryID)
+        : notary_id_(notaryID)
+        , server_clock_(CLOCK_PROCESS_CPUTIME_ID)
+        , has_server_clock_(0 == clock_getcpuclockid(notary, &server_clock_))
+        , ot_me_(OT::App().API().OTME())
+    {
+    }
+
+    // Times one command. The callable returns whether the command succeeded.
+    bool run(const std::string& command, const std::function<bool()>& f)
+    {
+        const double clientStart = cpu_ms(CLOCK_PROCESS_CPUTIME_ID);
+        const double serverStart =
+            has_server_clock_ ? cpu_ms(server_clock_) : 0;
+        const auto start = std::chrono::steady_clock::now();
+        const bool success = f();
+        const auto stop = std::chrono::steady_clock::now();
+        auto& sample = samples_[command];
+        sample.latency_.push_back(
+            std::chrono::duration<double, std::milli>(stop - start).count());
+        sample.clientCpu_ += cpu_ms(CLOCK_PROCESS_CPUTIME_ID) - clientStart;
+
+        if (has_server_clock_) {
+            sample.serverCpu_ += cpu_ms(server_clock_) - serverStart;
+        }
+
+        if (!success) { ++sample.failures_; }
+
+        return success;
+    }
+
+    std::string create_nym(const std::string& name)
+    {
+        std::string output{};
+        run("createNym", [&]() {
+            output = OTAPI_Wrap::CreateIndividualNym(name, "", 0);
+
+            return !output.empty();
+        });
+
+        return output;
+    }
+
+    bool register_nym(const std::string& nym)
+    {
+        return run("registerNym", [&]() {
+            return 1 == ot_me_.VerifyMessageSuccess(
+                            ot_me_.register_nym(notary_id_, nym));
+        });
+    }
+
+    std::string issue_unit(
+        const std::string& issuer,
+        const std::string& name,
+        const std::string& tla,
+        std::string& issuerAccount)
+    {
+        const auto unitID = OTAPI_Wrap::CreateCurrencyContract(
+            issuer, name, "opentxs-bench unit", name, tla, tla, 2, "cents");
+
+        if (unitID.empty()) { return ""; }
+
+        const auto contract = OTAPI_Wrap::GetAssetType_Contract(unitID);
+        run("issueAssetType", [&]() {
+            const auto reply =
+                ot_me_.issue_asset_type(notary_id_, issuer, contract);
+            issuerAccount = OTAPI_Wrap::Message_GetNewIssuerAcctID(reply);
+
+            return 1 == ot_me_.VerifyMessageSuccess(reply) &&
+                   !issuerAccount.empty();
+        });
+
+        return issuerAccount.empty() ? "" : unitID;
+    }
+
+    std::string create_account(const std::string& nym, const std::string& unit)
+    {
+        std::string output{};
+        run("registerAccount", [&]() {
+            const auto reply = ot_me_.create_asset_acct(notary_id_, nym, unit);
+            output = OTAPI_Wrap::Message_GetNewAcctID(reply);
+
+            return 1 == ot_me_.VerifyMessageSuccess(reply) && !output.empty();
+        });
+
+        return output;
+    }
+
+    bool numbers(const std::string& nym)
+    {
+        return run("getTransactionNumbers", [&]() {
+            return ot_me_.make_sure_enough_trans_nums(
+                TRANSACTION_NUMBERS, notary_id_, nym);
+        });
+    }
+
+    bool transfer(
+        const std::string& nym,
+        const std::string& from,
+        const std::string& to,
+        std::int64_t amount)
+    {
+        return run("notarizeTransfer", [&]() {
+            const auto reply = ot_me_.send_transfer(
+                notary_id_, nym, from, to, amount, "opentxs-bench");
+
+            return 1 == ot_me_.InterpretTransactionMsgReply(
+                            notary_id_, nym, from, "send_transfer", reply);
+        });
+    }
+
+    // Downloads the account and accepts everything in its inbox, skipping
+    // processInbox when there is nothing to accept.
+    bool process_inbox(const std::string& nym, const std::string& account)
+    {
+        const bool retrieved = run("getAccountData", [&]() {
+            return ot_me_.retrieve_account(notary_id_, nym, account, true);
+        });
+
+        if (!retrieved) { return false; }
+
+        const auto inbox = OTAPI_Wrap::LoadInbox(notary_id_, nym, account);
+
+        if (inbox.empty() ||
+            1 > OTAPI_Wrap::Ledger_GetCount(notary_id_, nym, account, inbox)) {
+            return true;
+        }
+
+        return run("processInbox", [&]() {
+            return ot_me_.accept_inbox_items(account, 0, "all");
+        });
+    }
+
+    bool market_offer(const BenchNym& nym, bool selling)
+    {
+        return run("marketOffer", [&]() {
+            const auto reply = ot_me_.create_market_offer(
+                nym.asset_,
+                nym.currency_,
+                1,
+                1,
+                1,
+                OFFER_PRICE,
+                selling,
+                OFFER_LIFESPAN,
+                "",
+                0);
+
+            return 1 == ot_me_.InterpretTransactionMsgReply(
+                            notary_id_,
+                            nym.nym_,
+                            nym.asset_,
+                            "create_market_offer",
+                            reply);
+        });
+    }
+
+    bool cash(const BenchNym& nym)
+    {
+        const bool withdrew = run("withdrawCash", [&]() {
+            return ot_me_.easy_withdraw_cash(nym.asset_, CASH_AMOUNT);
+        });
+
+        if (!withdrew) { return false; }
+
+        return run("depositCash", [&]() {
+            return ot_me_.deposit_local_purse(
+                notary_id_, nym.nym_, nym.asset_, "");
+        });
+    }
+
+    const std::map<std::string, Sample>& Samples() const { return samples_; }
+
+private:
+    const std::string notary_id_;
+    clockid_t server_clock_;
+    const bool has_server_clock_;
+    OT_ME& ot_me_;
+    std::map<std::string, Sample> samples_{};
+};
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) { return 0; }
+
+    const auto rank = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+std::string report(
+    const Options& options,
+    const std::map<std::string, Sample>& samples,
+    double elapsed,
+    const std::vector<std::string>& phases,
+    const std::map<std::string, Sample>& setup)
+{
+    std::ostringstream json;
+    std::int64_t total = 0;
+    json << "{\n";
+    json << "  \"nyms\": " << options.nyms_ << ",\n";
+    json << "  \"rounds\": " << options.rounds_ << ",\n";
+    json << "  \"cash\": " << (options.cash_ ? "true" : "false") << ",\n";
+    json << "  \"elapsed_ms\": " << elapsed << ",\n";
+
+    for (const auto& sample : samples) {
+        total += sample.second.latency_.size();
+    }
+
+    json << "  \"commands\": " << total << ",\n";
+    json << "  \"throughput_per_sec\": "
+         << ((0 < elapsed) ? (total * 1000.0 / elapsed) : 0) << ",\n";
+
+    using Samples = std::map<std::string, Sample>;
+    const std::vector<std::pair<std::string, const Samples*>> sections{
+        {"setup", &setup}, {"mix", &samples}};
+
+    for (const auto& section : sections) {
+        json << "  \"" << section.first << "\": {";
+        bool first = true;
+
+        for (const auto& item : *section.second) {
+            auto latency = item.second.latency_;
+            std::sort(latency.begin(), latency.end());
+            double sum = 0;
+
+            for (const auto& value : latency) { sum += value; }
+
+            const auto count = latency.size();
+            json << (first ? "\n" : ",\n");
+            json << "    \"" << item.first << "\": {"
+                 << "\"count\": " << count
+                 << ", \"failures\": " << item.second.failures_
+                 << ", \"mean_ms\": " << ((0 < count) ? sum / count : 0)
+                 << ", \"p50_ms\": " << percentile(latency, 0.50)
+                 << ", \"p90_ms\": " << percentile(latency, 0.90)
+                 << ", \"p99_ms\": " << percentile(latency, 0.99)
+                 << ", \"max_ms\": " << (latency.empty() ? 0 : latency.back())
+                 << ", \"client_cpu_ms\": " << item.second.clientCpu_
+                 << ", \"server_cpu_ms\": " << item.second.serverCpu_ << "}";
+            first = false;
+        }
+
+        json << (first ? "}" : "\n  }") << ",\n";
+    }
+
+    json << "  \"notes\": [";
+
+    for (std::size_t i = 0; i < phases.size(); ++i) {
+        json << (0 == i ? "" : ", ") << "\"" << phases[i] << "\"";
+    }
+
+    json << "]\n}\n";
+
+    return json.str();
+}
+
+int run_client(
+    const Options& options,
+    pid_t notary,
+    int input,
+    int output,
+    std::string& json)
+{
+    BenchPassword callback;
+    OTCaller caller;
+    set_password_callback(caller, callback);
+    OTAPI_Wrap::AppInit();
+
+    std::string contract{};
+
+    if (!read_message(input, contract) || contract.empty()) {
+        std::cerr << "opentxs-bench: notary failed to start" << std::endl;
+
+        return 1;
+    }
+
+    const auto notaryID = OTAPI_Wrap::AddServerContract(contract);
+
+    if (notaryID.empty()) {
+        std::cerr << "opentxs-bench: invalid server contract" << std::endl;
+
+        return 1;
+    }
+
+    Client client(notary, notaryID);
+    std::vector<std::string> notes{};
+
+    // Setup: an issuer with two units and N funded user nyms.
+    const auto issuer = client.create_nym("issuer");
+
+    if (issuer.empty() || !client.register_nym(issuer)) {
+        std::cerr << "opentxs-bench: unable to register issuer" << std::endl;
+
+        return 1;
+    }
+
+    std::string assetIssuer{};
+    std::string currencyIssuer{};
+    const auto asset =
+        client.issue_unit(issuer, "Bench Asset", "BNA", assetIssuer);
+    const auto currency =
+        client.issue_unit(issuer, "Bench Currency", "BNC", currencyIssuer);
+
+    if (asset.empty() || currency.empty()) {
+        std::cerr << "opentxs-bench: unable to issue units" << std::endl;
+
+        return 1;
+    }
+
+    bool cash = options.cash_;
+
+    if (cash) {
+        std::string reply{};
+
+        if (!write_message(output, asset) || !read_message(input, reply) ||
+            "1" != reply) {
+            notes.push_back("mint generation failed, cash commands skipped");
+            cash = false;
+        }
+    }
+
+    std::vector<BenchNym> nyms{};
+
+    for (std::int32_t i = 0; i < options.nyms_; ++i) {
+        BenchNym nym{};
+        nym.nym_ = client.create_nym("nym " + std::to_string(i));
+
+        if (nym.nym_.empty() || !client.register_nym(nym.nym_)) { continue; }
+
+        nym.asset_ = client.create_account(nym.nym_, asset);
+        nym.currency_ = client.create_account(nym.nym_, currency);
+
+        if (nym.asset_.empty() || nym.currency_.empty()) { continue; }
+
+        nyms.push_back(nym);
+    }
+
+    if (2 > nyms.size()) {
+        std::cerr << "opentxs-bench: need at least two nyms" << std::endl;
+
+        return 1;
+    }
+
+    client.numbers(issuer);
+
+    for (const auto& nym : nyms) {
+        client.transfer(issuer, assetIssuer, nym.asset_, FUNDING_AMOUNT);
+        client.transfer(issuer, currencyIssuer, nym.currency_, FUNDING_AMOUNT);
+    }
+
+    for (const auto& nym : nyms) {
+        client.process_inbox(nym.nym_, nym.asset_);
+        client.process_inbox(nym.nym_, nym.currency_);
+    }
+
+    const auto setup = client.Samples();
+    Client mix(notary, notaryID);
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::int32_t round = 0; round < options.rounds_; ++round) {
+        for (std::size_t i = 0; i < nyms.size(); ++i) {
+            const auto& nym = nyms[i];
+            const auto& next = nyms[(i + 1) % nyms.size()];
+            mix.numbers(nym.nym_);
+            mix.transfer(nym.nym_, nym.asset_, next.asset_, 1);
+            mix.market_offer(nym, 0 == (i + round) % 2);
+
+            if (cash) { mix.cash(nym); }
+        }
+
+        for (const auto& nym : nyms) {
+            mix.process_inbox(nym.nym_, nym.asset_);
+            mix.process_inbox(nym.nym_, nym.currency_);
+        }
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+    const auto elapsed =
+        std::chrono::duration<double, std::milli>(stop - start).count();
+
+    if (!options.cash_) { notes.push_back("cash commands disabled"); }
+
+    json = report(options, mix.Samples(), elapsed, notes, setup);
+    OTAPI_Wrap::AppCleanup();
+
+    return 0;
+}
+
+bool parse(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const bool hasValue = (i + 1 < argc);
+
+        try {
+            if ("--nyms" == arg && hasValue) {
+                options.nyms_ = std::stoi(argv[++i]);
+            } else if ("--rounds" == arg && hasValue) {
+                options.rounds_ = std::stoi(argv[++i]);
+            } else if ("--port" == arg && hasValue) {
+                options.port_ = std::stoi(argv[++i]);
+            } else if ("--output" == arg && hasValue) {
+                options.output_ = argv[++i];
+            } else if ("--no-cash" == arg) {
+                options.cash_ = false;
+            } else if ("--keep" == arg) {
+                options.keep_ = true;
+            } else {
+                return false;
+            }
+        } catch (...) {
+            return false;
+        }
+    }
+
+    return (1 < options.nyms_) && (0 < options.rounds_) &&
+           (1024 <= options.port_) && (65535 > options.port_);
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Options options{};
+
+    if (!parse(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--nyms N] [--rounds N] [--port N] [--output FILE]"
+                     " [--no-cash] [--keep]"
+                  << std::endl;
+
+        return 1;
+    }
+
+    const char* tmp = std::getenv("TMPDIR");
+    std::string root = std::string((nullptr == tmp) ? "/tmp" : tmp) +
+                       "/opentxs-bench-XXXXXX";
+
+    if (nullptr == ::mkdtemp(&root[0])) {
+        std::cerr << "opentxs-bench: unable to create " << root << std::endl;
+
+        return 1;
+    }
+
+    const std::string serverHome = root + "/server";
+    const std::string clientHome = root + "/client";
+    ::mkdir(serverHome.c_str(), 0700);
+    ::mkdir(clientHome.c_str(), 0700);
+
+    int toClient[2]{};
+    int toNotary[2]{};
+
+    if (0 != ::pipe(toClient) || 0 != ::pipe(toNotary)) { return 1; }
+
+    const pid_t notary = ::fork();
+
+    if (0 > notary) { return 1; }
+
+    if (0 == notary) {
+        ::close(toClient[0]);
+        ::close(toNotary[1]);
+        ::setenv("HOME", serverHome.c_str(), 1);
+
+        ::_exit(run_notary(options, toNotary[0], toClient[1]));
+    }
+
+    ::close(toClient[1]);
+    ::close(toNotary[0]);
+    ::setenv("HOME", clientHome.c_str(), 1);
+    std::string json{};
+    const int result =
+        run_client(options, notary, toClient[0], toNotary[1], json);
+    ::close(toNotary[1]);
+    ::close(toClient[0]);
+    ::kill(notary, SIGTERM);
+    ::waitpid(notary, nullptr, 0);
+
+    if (!options.keep_) {
+        ::nftw(root.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+    }
+
+    if (0 != result) { return result; }
+
+    if ("-" == options.output_) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.output_);
+        file << json;
+
+        if (!file) {
+            std::cerr << "opentxs-bench: unable to write " << options.output_
+                      << std::endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
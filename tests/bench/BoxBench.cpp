@@ -0,0 +1,320 @@
+// opentxs-box-bench: abbreviated box record throughput.
+//
+// Creates a client wallet under a temporary folder and one nym, then fills an
+// inbox with signed market receipts. The inbox is saved and reloaded once with
+// its abbreviated records written as XML elements and once with them packed
+// into a single binary field, so the two forms can be compared at the same
+// size. Building the receipts is setup and is not part of the timings. Results
+// are written as JSON.
+//
+// Usage: opentxs-box-bench [--records N] [--rounds N] [--output FILE]
+
+#include "opentxs/client/OT_API.hpp"
+#include "opentxs/client/OTAPI_Wrap.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/crypto/OTCallback.hpp"
+#include "opentxs/core/crypto/OTCaller.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Item.hpp"
+#include "opentxs/core/Ledger.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/OTTransaction.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <ftw.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+const std::string BENCH_PASSWORD = "test";
+
+struct Options {
+    std::int32_t records_{10000};
+    std::int32_t rounds_{5};
+    std::string output_{"opentxs-box-bench.json"};
+};
+
+struct Result {
+    std::size_t bytes_{0};
+    double save_ms_{0};
+    std::vector<double> load_ms_{};
+};
+
+class BenchPassword : public OTCallback
+{
+public:
+    void runOne(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+
+    void runTwo(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+};
+
+int remove_entry(const char* path, const struct stat*, int, struct FTW*)
+{
+    return ::remove(path);
+}
+
+double percentile(std::vector<double>& values, const double p)
+{
+    if (values.empty()) { return 0; }
+
+    std::sort(values.begin(), values.end());
+    const auto index = static_cast<std::size_t>(p * (values.size() - 1));
+
+    return values[index];
+}
+
+double ms_since(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+Identifier make_id(const std::string& seed)
+{
+    Identifier output;
+    output.CalculateDigest(String(seed));
+
+    return output;
+}
+
+bool parse(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const bool hasValue = (i + 1 < argc);
+
+        try {
+            if ("--records" == arg && hasValue) {
+                options.records_ = std::stoi(argv[++i]);
+            } else if ("--rounds" == arg && hasValue) {
+                options.rounds_ = std::stoi(argv[++i]);
+            } else if ("--output" == arg && hasValue) {
+                options.output_ = argv[++i];
+            } else {
+                return false;
+            }
+        } catch (...) {
+            return false;
+        }
+    }
+
+    return (0 < options.records_) && (0 < options.rounds_);
+}
+
+// Adds one signed market receipt, whose amount is on its marketReceipt item.
+bool add_receipt(const Nym& nym, Ledger& inbox, const std::int64_t number)
+{
+    std::unique_ptr<OTTransaction> receipt(OTTransaction::GenerateTransaction(
+        inbox,
+        OTTransaction::marketReceipt,
+        originType::origin_market_offer,
+        number));
+
+    if (!receipt) { return false; }
+
+    auto* item = Item::CreateItemFromTransaction(*receipt, Item::marketReceipt);
+
+    if (nullptr == item) { return false; }
+
+    item->SetAmount(number);
+    item->SignContract(nym);
+    item->SaveContract();
+    receipt->AddItem(*item);
+    receipt->SetReferenceToNum(number);
+
+    if (!receipt->SignContract(nym) || !receipt->SaveContract()) {
+        return false;
+    }
+
+    if (!inbox.AddTransaction(*receipt)) { return false; }
+
+    receipt.release();
+
+    return true;
+}
+
+bool measure(
+    const Nym& nym,
+    Ledger& inbox,
+    const Options& options,
+    const bool packed,
+    Result& result)
+{
+    Ledger::SetPackedRecords(packed);
+    String raw;
+    const auto save = std::chrono::steady_clock::now();
+    inbox.ReleaseSignatures();
+
+    if (!inbox.SignContract(nym) || !inbox.SaveContract() ||
+        !inbox.SaveContractRaw(raw)) {
+        return false;
+    }
+
+    result.save_ms_ = ms_since(save);
+    result.bytes_ = raw.GetLength();
+
+    for (std::int32_t i = 0; i < options.rounds_; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        Ledger loaded(
+            inbox.GetNymID(),
+            inbox.GetPurportedAccountID(),
+            inbox.GetPurportedNotaryID());
+
+        if (!loaded.LoadLedgerFromString(raw) ||
+            (options.records_ != loaded.GetTransactionCount())) {
+            return false;
+        }
+
+        result.load_ms_.push_back(ms_since(start));
+    }
+
+    return true;
+}
+
+void report(std::stringstream& output, const char* name, Result& result)
+{
+    output << "  \"" << name << "\": {"
+           << "\"bytes\": " << result.bytes_
+           << ", \"save_ms\": " << result.save_ms_
+           << ", \"load_p50_ms\": " << percentile(result.load_ms_, 0.5)
+           << ", \"load_max_ms\": " << percentile(result.load_ms_, 1.0) << "}";
+}
+
+int run(const Options& options, std::string& json)
+{
+    auto* api = OTAPI_Wrap::OTAPI();
+
+    if (nullptr == api) { return 1; }
+
+    NymParameters parameters(proto::CREDTYPE_LEGACY);
+    auto* nym = api->CreateNym(parameters);
+
+    if (nullptr == nym) {
+        std::cerr << "opentxs-box-bench: unable to create nym" << std::endl;
+
+        return 1;
+    }
+
+    Identifier nymID;
+    nym->GetIdentifier(nymID);
+    const auto account = make_id("opentxs-box-bench account");
+    const auto notary = make_id("opentxs-box-bench notary");
+    Ledger inbox(nymID, account, notary);
+
+    if (!inbox.GenerateLedger(account, notary, Ledger::inbox)) {
+        std::cerr << "opentxs-box-bench: unable to create inbox" << std::endl;
+
+        return 1;
+    }
+
+    for (std::int32_t i = 0; i < options.records_; ++i) {
+        if (!add_receipt(*nym, inbox, i + 1)) {
+            std::cerr << "opentxs-box-bench: unable to create receipt"
+                      << std::endl;
+
+            return 1;
+        }
+    }
+
+    const bool wasPacked = Ledger::GetPackedRecords();
+    Result xml{};
+    Result packed{};
+    const bool measured = measure(*nym, inbox, options, false, xml) &&
+                          measure(*nym, inbox, options, true, packed);
+    Ledger::SetPackedRecords(wasPacked);
+
+    if (!measured) {
+        std::cerr << "opentxs-box-bench: unable to save or load the inbox"
+                  << std::endl;
+
+        return 1;
+    }
+
+    std::stringstream output{};
+    output << "{\n"
+           << "  \"records\": " << options.records_ << ",\n"
+           << "  \"rounds\": " << options.rounds_ << ",\n";
+    report(output, "xml", xml);
+    output << ",\n";
+    report(output, "packed", packed);
+    output << "\n}\n";
+    json = output.str();
+
+    return 0;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Options options{};
+
+    if (!parse(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--records N] [--rounds N] [--output FILE]"
+                  << std::endl;
+
+        return 1;
+    }
+
+    const char* tmp = std::getenv("TMPDIR");
+    std::string root = std::string((nullptr == tmp) ? "/tmp" : tmp) +
+                       "/opentxs-box-bench-XXXXXX";
+
+    if (nullptr == ::mkdtemp(&root[0])) {
+        std::cerr << "opentxs-box-bench: unable to create " << root
+                  << std::endl;
+
+        return 1;
+    }
+
+    ::setenv("HOME", root.c_str(), 1);
+    BenchPassword callback;
+    OTCaller caller;
+    caller.setCallback(&callback);
+    OT_API_Set_PasswordCallback(caller);
+    OTAPI_Wrap::AppInit();
+    std::string json{};
+    const int result = run(options, json);
+    OTAPI_Wrap::AppCleanup();
+    ::nftw(root.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+
+    if (0 != result) { return result; }
+
+    if ("-" == options.output_) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.output_);
+        file << json;
+
+        if (!file) {
+            std::cerr << "opentxs-box-bench: unable to write "
+                      << options.output_ << std::endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
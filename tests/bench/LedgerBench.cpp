@@ -0,0 +1,302 @@
+// opentxs-ledger-bench: ledger parsing throughput.
+//
+// Creates a client wallet under a temporary folder and one nym, then builds a
+// message ledger of signed transfer transactions, each carrying one signed
+// item, until the ledger is at least the requested size. The signed ledger is
+// then loaded from its string form repeatedly, which parses the ledger and
+// every transaction and item inside it. Building the ledger is setup and is
+// not part of the timings. Results are written as JSON.
+//
+// Usage: opentxs-ledger-bench [--size BYTES] [--rounds N] [--output FILE]
+
+#include "opentxs/client/OT_API.hpp"
+#include "opentxs/client/OTAPI_Wrap.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/crypto/OTCallback.hpp"
+#include "opentxs/core/crypto/OTCaller.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Item.hpp"
+#include "opentxs/core/Ledger.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/OTTransaction.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <ftw.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+const std::string BENCH_PASSWORD = "test";
+const std::size_t NOTE_SIZE = 256;
+
+struct Options {
+    std::int32_t size_{1024 * 1024};
+    std::int32_t rounds_{20};
+    std::string output_{"opentxs-ledger-bench.json"};
+};
+
+class BenchPassword : public OTCallback
+{
+public:
+    void runOne(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+
+    void runTwo(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+};
+
+int remove_entry(const char* path, const struct stat*, int, struct FTW*)
+{
+    return ::remove(path);
+}
+
+double percentile(std::vector<double>& values, const double p)
+{
+    if (values.empty()) { return 0; }
+
+    std::sort(values.begin(), values.end());
+    const auto index = static_cast<std::size_t>(p * (values.size() - 1));
+
+    return values[index];
+}
+
+Identifier make_id(const std::string& seed)
+{
+    Identifier output;
+    output.CalculateDigest(String(seed));
+
+    return output;
+}
+
+bool parse(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const bool hasValue = (i + 1 < argc);
+
+        try {
+            if ("--size" == arg && hasValue) {
+                options.size_ = std::stoi(argv[++i]);
+            } else if ("--rounds" == arg && hasValue) {
+                options.rounds_ = std::stoi(argv[++i]);
+            } else if ("--output" == arg && hasValue) {
+                options.output_ = argv[++i];
+            } else {
+                return false;
+            }
+        } catch (...) {
+            return false;
+        }
+    }
+
+    return (0 < options.size_) && (0 < options.rounds_);
+}
+
+// Adds one signed transfer transaction, and returns the size of its signed
+// form.
+std::size_t add_transaction(
+    const Nym& nym,
+    Ledger& ledger,
+    const std::int64_t number)
+{
+    std::unique_ptr<OTTransaction> transaction(
+        OTTransaction::GenerateTransaction(
+            ledger,
+            OTTransaction::transfer,
+            originType::not_applicable,
+            number));
+
+    if (!transaction) { return 0; }
+
+    auto* item =
+        Item::CreateItemFromTransaction(*transaction, Item::transfer);
+
+    if (nullptr == item) { return 0; }
+
+    item->SetAmount(number);
+    item->SetNote(String(std::string(NOTE_SIZE, 'x')));
+    item->SignContract(nym);
+    item->SaveContract();
+    transaction->AddItem(*item);
+
+    if (!transaction->SignContract(nym) || !transaction->SaveContract()) {
+        return 0;
+    }
+
+    String raw;
+    transaction->SaveContractRaw(raw);
+
+    if (!ledger.AddTransaction(*transaction)) { return 0; }
+
+    transaction.release();
+
+    return raw.GetLength();
+}
+
+int run(const Options& options, std::string& json)
+{
+    auto* api = OTAPI_Wrap::OTAPI();
+
+    if (nullptr == api) { return 1; }
+
+    NymParameters parameters(proto::CREDTYPE_LEGACY);
+    auto* nym = api->CreateNym(parameters);
+
+    if (nullptr == nym) {
+        std::cerr << "opentxs-ledger-bench: unable to create nym" << std::endl;
+
+        return 1;
+    }
+
+    Identifier nymID;
+    nym->GetIdentifier(nymID);
+    const auto account = make_id("opentxs-ledger-bench account");
+    const auto notary = make_id("opentxs-ledger-bench notary");
+    Ledger ledger(nymID, account, notary);
+
+    if (!ledger.GenerateLedger(account, notary, Ledger::message)) {
+        std::cerr << "opentxs-ledger-bench: unable to create ledger"
+                  << std::endl;
+
+        return 1;
+    }
+
+    // Each transaction is armored inside the ledger, which adds a third.
+    std::size_t estimate = 0;
+    std::int64_t transactions = 0;
+
+    while (estimate < static_cast<std::size_t>(options.size_)) {
+        const auto size = add_transaction(*nym, ledger, transactions + 1);
+
+        if (0 == size) {
+            std::cerr << "opentxs-ledger-bench: unable to create transaction"
+                      << std::endl;
+
+            return 1;
+        }
+
+        estimate += size * 4 / 3;
+        ++transactions;
+    }
+
+    String raw;
+
+    if (!ledger.SignContract(*nym) || !ledger.SaveContract() ||
+        !ledger.SaveContractRaw(raw)) {
+        std::cerr << "opentxs-ledger-bench: unable to sign ledger"
+                  << std::endl;
+
+        return 1;
+    }
+
+    std::vector<double> latency{};
+    const auto begin = std::chrono::steady_clock::now();
+
+    for (std::int32_t i = 0; i < options.rounds_; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        Ledger loaded(nymID, account, notary);
+
+        if (!loaded.LoadLedgerFromString(raw) ||
+            (transactions != loaded.GetTransactionCount())) {
+            std::cerr << "opentxs-ledger-bench: unable to load ledger"
+                      << std::endl;
+
+            return 1;
+        }
+
+        latency.push_back(std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - start)
+                              .count());
+    }
+
+    const double elapsed = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - begin)
+                               .count();
+    const double megabytes = raw.GetLength() / (1024.0 * 1024.0);
+    std::stringstream output{};
+    output << "{\n"
+           << "  \"ledger_bytes\": " << raw.GetLength() << ",\n"
+           << "  \"transactions\": " << transactions << ",\n"
+           << "  \"rounds\": " << options.rounds_ << ",\n"
+           << "  \"mb_per_second\": "
+           << (megabytes * options.rounds_ / elapsed) << ",\n"
+           << "  \"p50_ms\": " << percentile(latency, 0.5) << ",\n"
+           << "  \"max_ms\": " << percentile(latency, 1.0) << "\n"
+           << "}\n";
+    json = output.str();
+
+    return 0;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Options options{};
+
+    if (!parse(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--size BYTES] [--rounds N] [--output FILE]"
+                  << std::endl;
+
+        return 1;
+    }
+
+    const char* tmp = std::getenv("TMPDIR");
+    std::string root = std::string((nullptr == tmp) ? "/tmp" : tmp) +
+                       "/opentxs-ledger-bench-XXXXXX";
+
+    if (nullptr == ::mkdtemp(&root[0])) {
+        std::cerr << "opentxs-ledger-bench: unable to create " << root
+                  << std::endl;
+
+        return 1;
+    }
+
+    ::setenv("HOME", root.c_str(), 1);
+    BenchPassword callback;
+    OTCaller caller;
+    caller.setCallback(&callback);
+    OT_API_Set_PasswordCallback(caller);
+    OTAPI_Wrap::AppInit();
+    std::string json{};
+    const int result = run(options, json);
+    OTAPI_Wrap::AppCleanup();
+    ::nftw(root.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+
+    if (0 != result) { return result; }
+
+    if ("-" == options.output_) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.output_);
+        file << json;
+
+        if (!file) {
+            std::cerr << "opentxs-ledger-bench: unable to write "
+                      << options.output_ << std::endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
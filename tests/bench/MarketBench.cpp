@@ -0,0 +1,300 @@
+// opentxs-market-bench: order book throughput.
+//
+// Creates a client wallet under a temporary folder and one nym, signs a set
+// of offers alternating between bids and asks over a spread of prices, and
+// then times each stage of an OTMarket's life cycle over the whole book:
+// adding the offers, building the offer list twice (the second call is
+// served from the cache), querying the best prices, serializing the market
+// twice (the second pass reuses each offer's armored form), and removing
+// every offer. Signing the offers is setup and is not part of the timings.
+// Results are written as JSON.
+//
+// Usage: opentxs-market-bench [--offers N] [--levels N] [--output FILE]
+
+#include "opentxs/client/OT_API.hpp"
+#include "opentxs/client/OTAPI_Wrap.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/crypto/OTASCIIArmor.hpp"
+#include "opentxs/core/crypto/OTCallback.hpp"
+#include "opentxs/core/crypto/OTCaller.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/trade/OTMarket.hpp"
+#include "opentxs/core/trade/OTOffer.hpp"
+#include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <ftw.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+const std::string BENCH_PASSWORD = "test";
+const std::int64_t OFFER_AMOUNT = 1000;
+const std::int64_t BASE_PRICE = 10000;
+const std::int32_t PRICE_QUERIES = 10000;
+
+struct Options {
+    std::int32_t offers_{100000};
+    std::int32_t levels_{1000};
+    std::string output_{"opentxs-market-bench.json"};
+};
+
+class BenchPassword : public OTCallback
+{
+public:
+    void runOne(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+
+    void runTwo(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+};
+
+int remove_entry(const char* path, const struct stat*, int, struct FTW*)
+{
+    return ::remove(path);
+}
+
+double time_ms(const std::function<bool()>& f, bool& success)
+{
+    const auto start = std::chrono::steady_clock::now();
+    success = f() && success;
+
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+Identifier make_id(const std::string& seed)
+{
+    Identifier output;
+    output.CalculateDigest(String(seed));
+
+    return output;
+}
+
+bool parse(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const bool hasValue = (i + 1 < argc);
+
+        try {
+            if ("--offers" == arg && hasValue) {
+                options.offers_ = std::stoi(argv[++i]);
+            } else if ("--levels" == arg && hasValue) {
+                options.levels_ = std::stoi(argv[++i]);
+            } else if ("--output" == arg && hasValue) {
+                options.output_ = argv[++i];
+            } else {
+                return false;
+            }
+        } catch (...) {
+            return false;
+        }
+    }
+
+    return (0 < options.offers_) && (0 < options.levels_);
+}
+
+int run(const Options& options, std::string& json)
+{
+    auto* api = OTAPI_Wrap::OTAPI();
+
+    if (nullptr == api) { return 1; }
+
+    NymParameters parameters(proto::CREDTYPE_LEGACY);
+    auto* nym = api->CreateNym(parameters);
+
+    if (nullptr == nym) {
+        std::cerr << "opentxs-market-bench: unable to create nym" << std::endl;
+
+        return 1;
+    }
+
+    const auto notary = make_id("opentxs-market-bench notary");
+    const auto asset = make_id("opentxs-market-bench asset");
+    const auto currency = make_id("opentxs-market-bench currency");
+    std::vector<OTOffer*> offers{};
+    offers.reserve(options.offers_);
+
+    // Asks rest above the base price and bids below it, so nothing would
+    // cross if the book were processed.
+    const auto setup = std::chrono::steady_clock::now();
+
+    for (std::int32_t i = 0; i < options.offers_; ++i) {
+        const bool selling = (0 == i % 2);
+        const std::int64_t level = 1 + (i / 2) % options.levels_;
+        const std::int64_t price =
+            selling ? (BASE_PRICE + level) : (BASE_PRICE - level);
+        auto* offer = new OTOffer(notary, asset, currency, 1);
+
+        if (!offer->MakeOffer(selling, price, OFFER_AMOUNT, 1, i + 1) ||
+            !offer->SignContract(*nym) || !offer->SaveContract()) {
+            std::cerr << "opentxs-market-bench: unable to create offer"
+                      << std::endl;
+            delete offer;
+
+            for (auto* item : offers) { delete item; }
+
+            return 1;
+        }
+
+        offers.push_back(offer);
+    }
+
+    const double setupMs = std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - setup)
+                               .count();
+    OTMarket market(notary, asset, currency, 1);
+    std::vector<std::pair<std::string, double>> stages{};
+    bool success = true;
+    std::size_t added = 0;
+
+    stages.emplace_back("add", time_ms([&]() -> bool {
+        const auto now = OTTimeGetCurrentTime();
+
+        for (auto* offer : offers) {
+            if (!market.AddOffer(nullptr, *offer, false, now)) {
+                return false;
+            }
+
+            ++added;
+        }
+
+        return true;
+    }, success));
+
+    // The market owns whatever it accepted.
+    for (std::size_t i = added; i < offers.size(); ++i) { delete offers[i]; }
+
+    for (const auto& name : {"offer_list", "offer_list_cached"}) {
+        stages.emplace_back(name, time_ms([&]() -> bool {
+            OTASCIIArmor list;
+            std::int32_t count = 0;
+
+            return market.GetOfferList(list, 0, count) && (0 < count);
+        }, success));
+    }
+
+    stages.emplace_back("best_price", time_ms([&]() -> bool {
+        std::int64_t total = 0;
+
+        for (std::int32_t i = 0; i < PRICE_QUERIES; ++i) {
+            total += market.GetLowestAskPrice() + market.GetHighestBidPrice();
+        }
+
+        return 0 < total;
+    }, success));
+
+    for (const auto& name : {"serialize", "serialize_unchanged"}) {
+        stages.emplace_back(name, time_ms([&]() -> bool {
+            market.UpdateContents();
+
+            return true;
+        }, success));
+    }
+
+    stages.emplace_back("remove", time_ms([&]() -> bool {
+        for (std::int32_t i = 0; i < options.offers_; ++i) {
+            if (!market.RemoveOffer(i + 1)) { return false; }
+        }
+
+        return true;
+    }, success));
+
+    if (!success || (added != offers.size())) {
+        std::cerr << "opentxs-market-bench: a stage failed" << std::endl;
+
+        return 1;
+    }
+
+    std::stringstream output{};
+    output << "{\n"
+           << "  \"offers\": " << options.offers_ << ",\n"
+           << "  \"levels\": " << options.levels_ << ",\n"
+           << "  \"setup_ms\": " << setupMs << ",\n"
+           << "  \"stages\": {";
+
+    for (std::size_t i = 0; i < stages.size(); ++i) {
+        output << ((0 == i) ? "\n" : ",\n") << "    \"" << stages[i].first
+               << "_ms\": " << stages[i].second;
+    }
+
+    output << "\n  }\n}\n";
+    json = output.str();
+
+    return 0;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Options options{};
+
+    if (!parse(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--offers N] [--levels N] [--output FILE]" << std::endl;
+
+        return 1;
+    }
+
+    const char* tmp = std::getenv("TMPDIR");
+    std::string root = std::string((nullptr == tmp) ? "/tmp" : tmp) +
+                       "/opentxs-market-bench-XXXXXX";
+
+    if (nullptr == ::mkdtemp(&root[0])) {
+        std::cerr << "opentxs-market-bench: unable to create " << root
+                  << std::endl;
+
+        return 1;
+    }
+
+    ::setenv("HOME", root.c_str(), 1);
+    BenchPassword callback;
+    OTCaller caller;
+    caller.setCallback(&callback);
+    OT_API_Set_PasswordCallback(caller);
+    OTAPI_Wrap::AppInit();
+    std::string json{};
+    const int result = run(options, json);
+    OTAPI_Wrap::AppCleanup();
+    ::nftw(root.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+
+    if (0 != result) { return result; }
+
+    if ("-" == options.output_) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.output_);
+        file << json;
+
+        if (!file) {
+            std::cerr << "opentxs-market-bench: unable to write "
+                      << options.output_ << std::endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
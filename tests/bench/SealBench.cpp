@@ -0,0 +1,259 @@
+// opentxs-seal-bench: envelope sealing throughput.
+//
+// Creates a client wallet under a temporary folder with a set of recipient
+// nyms on one curve, then seals the same payload to all of them in a loop for
+// a fixed time. The first envelope is opened by every recipient before timing
+// starts, so a broken multi-recipient seal fails the run instead of being
+// measured. Results are written as JSON.
+//
+// Usage: opentxs-seal-bench [--curve ed25519|secp256k1] [--recipients N]
+//                           [--seconds N] [--size BYTES] [--output FILE]
+
+#include "opentxs/client/OT_API.hpp"
+#include "opentxs/client/OTAPI_Wrap.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/crypto/OTCallback.hpp"
+#include "opentxs/core/crypto/OTCaller.hpp"
+#include "opentxs/core/crypto/OTEnvelope.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <ftw.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+const std::string BENCH_PASSWORD = "test";
+
+struct Options {
+    std::string curve_{"ed25519"};
+    std::int32_t recipients_{1};
+    std::int32_t seconds_{5};
+    std::int32_t size_{1024};
+    std::string output_{"opentxs-seal-bench.json"};
+};
+
+class BenchPassword : public OTCallback
+{
+public:
+    void runOne(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+
+    void runTwo(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+};
+
+int remove_entry(const char* path, const struct stat*, int, struct FTW*)
+{
+    return ::remove(path);
+}
+
+double percentile(std::vector<double>& values, const double p)
+{
+    if (values.empty()) { return 0; }
+
+    std::sort(values.begin(), values.end());
+    const auto index = static_cast<std::size_t>(p * (values.size() - 1));
+
+    return values[index];
+}
+
+bool parse(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const bool hasValue = (i + 1 < argc);
+
+        try {
+            if ("--curve" == arg && hasValue) {
+                options.curve_ = argv[++i];
+            } else if ("--recipients" == arg && hasValue) {
+                options.recipients_ = std::stoi(argv[++i]);
+            } else if ("--seconds" == arg && hasValue) {
+                options.seconds_ = std::stoi(argv[++i]);
+            } else if ("--size" == arg && hasValue) {
+                options.size_ = std::stoi(argv[++i]);
+            } else if ("--output" == arg && hasValue) {
+                options.output_ = argv[++i];
+            } else {
+                return false;
+            }
+        } catch (...) {
+            return false;
+        }
+    }
+
+    return ("ed25519" == options.curve_ || "secp256k1" == options.curve_) &&
+           (0 < options.recipients_) && (0 < options.seconds_) &&
+           (0 < options.size_);
+}
+
+int run(const Options& options, std::string& json)
+{
+    auto* api = OTAPI_Wrap::OTAPI();
+
+    if (nullptr == api) { return 1; }
+
+    NymParameters parameters(proto::CREDTYPE_LEGACY);
+    parameters.setNymParameterType(
+        ("secp256k1" == options.curve_) ? NymParameterType::SECP256K1
+                                        : NymParameterType::ED25519);
+    std::vector<Nym*> nyms{};
+    setOfNyms recipients{};
+
+    for (std::int32_t i = 0; i < options.recipients_; ++i) {
+        auto* nym = api->CreateNym(parameters);
+
+        if (nullptr == nym) {
+            std::cerr << "opentxs-seal-bench: unable to create nym"
+                      << std::endl;
+
+            return 1;
+        }
+
+        nyms.push_back(nym);
+        recipients.insert(nym);
+    }
+
+    const String payload(std::string(options.size_, 'x'));
+    std::vector<double> latency{};
+
+    {
+        const auto start = std::chrono::steady_clock::now();
+        OTEnvelope envelope;
+
+        if (!envelope.Seal(recipients, payload)) {
+            std::cerr << "opentxs-seal-bench: seal failed" << std::endl;
+
+            return 1;
+        }
+
+        latency.push_back(
+            std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+
+        for (const auto* nym : nyms) {
+            String opened;
+
+            if (!envelope.Open(*nym, opened) || !(opened == payload)) {
+                std::cerr << "opentxs-seal-bench: recipient could not open "
+                          << "the envelope" << std::endl;
+
+                return 1;
+            }
+        }
+    }
+
+    const double first = latency.front();
+    latency.clear();
+    const auto begin = std::chrono::steady_clock::now();
+    const auto end = begin + std::chrono::seconds(options.seconds_);
+    auto now = begin;
+
+    while (now < end) {
+        OTEnvelope envelope;
+
+        if (!envelope.Seal(recipients, payload)) {
+            std::cerr << "opentxs-seal-bench: seal failed" << std::endl;
+
+            return 1;
+        }
+
+        const auto finished = std::chrono::steady_clock::now();
+        latency.push_back(
+            std::chrono::duration<double, std::micro>(finished - now).count());
+        now = finished;
+    }
+
+    const double elapsed = std::chrono::duration<double>(now - begin).count();
+    std::stringstream output{};
+    output << "{\n"
+           << "  \"curve\": \"" << options.curve_ << "\",\n"
+           << "  \"recipients\": " << options.recipients_ << ",\n"
+           << "  \"payload_bytes\": " << options.size_ << ",\n"
+           << "  \"seals\": " << latency.size() << ",\n"
+           << "  \"seconds\": " << elapsed << ",\n"
+           << "  \"seals_per_second\": " << (latency.size() / elapsed) << ",\n"
+           << "  \"first_us\": " << first << ",\n"
+           << "  \"p50_us\": " << percentile(latency, 0.5) << ",\n"
+           << "  \"p99_us\": " << percentile(latency, 0.99) << "\n"
+           << "}\n";
+    json = output.str();
+
+    return 0;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Options options{};
+
+    if (!parse(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--curve ed25519|secp256k1] [--recipients N]"
+                     " [--seconds N] [--size BYTES] [--output FILE]"
+                  << std::endl;
+
+        return 1;
+    }
+
+    const char* tmp = std::getenv("TMPDIR");
+    std::string root = std::string((nullptr == tmp) ? "/tmp" : tmp) +
+                       "/opentxs-seal-bench-XXXXXX";
+
+    if (nullptr == ::mkdtemp(&root[0])) {
+        std::cerr << "opentxs-seal-bench: unable to create " << root
+                  << std::endl;
+
+        return 1;
+    }
+
+    ::setenv("HOME", root.c_str(), 1);
+    BenchPassword callback;
+    OTCaller caller;
+    caller.setCallback(&callback);
+    OT_API_Set_PasswordCallback(caller);
+    OTAPI_Wrap::AppInit();
+    std::string json{};
+    const int result = run(options, json);
+    OTAPI_Wrap::AppCleanup();
+    ::nftw(root.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+
+    if (0 != result) { return result; }
+
+    if ("-" == options.output_) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.output_);
+        file << json;
+
+        if (!file) {
+            std::cerr << "opentxs-seal-bench: unable to write "
+                      << options.output_ << std::endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
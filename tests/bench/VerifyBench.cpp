@@ -0,0 +1,260 @@
+// opentxs-verify-bench: signature verification throughput.
+//
+// Creates a client wallet under a temporary folder with a set of signer nyms
+// on one curve, and has them sign distinct messages in turn. The signatures
+// are then checked three ways: one at a time through the key's engine, as a
+// single CryptoAsymmetric::BatchVerify() call with an empty SignatureMemo, and
+// the same batch again once the memo holds every result. Results are written
+// as JSON, as verifications per second for each pass.
+//
+// Usage: opentxs-verify-bench [--curve ed25519|secp256k1] [--signers N]
+//                             [--signatures N] [--output FILE]
+
+#include "opentxs/client/OT_API.hpp"
+#include "opentxs/client/OTAPI_Wrap.hpp"
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/crypto/OTCallback.hpp"
+#include "opentxs/core/crypto/OTCaller.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/crypto/SignatureMemo.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Nym.hpp"
+
+#include <ftw.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+const std::string BENCH_PASSWORD = "test";
+
+struct Options {
+    std::string curve_{"ed25519"};
+    std::int32_t signers_{4};
+    std::int32_t signatures_{10000};
+    std::string output_{"opentxs-verify-bench.json"};
+};
+
+class BenchPassword : public OTCallback
+{
+public:
+    void runOne(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+
+    void runTwo(const char*, OTPassword& output) const override
+    {
+        output.setPassword(BENCH_PASSWORD);
+    }
+};
+
+int remove_entry(const char* path, const struct stat*, int, struct FTW*)
+{
+    return ::remove(path);
+}
+
+double seconds_since(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+bool parse(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const bool hasValue = (i + 1 < argc);
+
+        try {
+            if ("--curve" == arg && hasValue) {
+                options.curve_ = argv[++i];
+            } else if ("--signers" == arg && hasValue) {
+                options.signers_ = std::stoi(argv[++i]);
+            } else if ("--signatures" == arg && hasValue) {
+                options.signatures_ = std::stoi(argv[++i]);
+            } else if ("--output" == arg && hasValue) {
+                options.output_ = argv[++i];
+            } else {
+                return false;
+            }
+        } catch (...) {
+            return false;
+        }
+    }
+
+    return ("ed25519" == options.curve_ || "secp256k1" == options.curve_) &&
+           (0 < options.signers_) && (0 < options.signatures_);
+}
+
+int run(const Options& options, std::string& json)
+{
+    auto* api = OTAPI_Wrap::OTAPI();
+
+    if (nullptr == api) { return 1; }
+
+    NymParameters parameters(proto::CREDTYPE_LEGACY);
+    parameters.setNymParameterType(
+        ("secp256k1" == options.curve_) ? NymParameterType::SECP256K1
+                                        : NymParameterType::ED25519);
+    std::vector<Nym*> nyms{};
+
+    for (std::int32_t i = 0; i < options.signers_; ++i) {
+        auto* nym = api->CreateNym(parameters);
+
+        if (nullptr == nym) {
+            std::cerr << "opentxs-verify-bench: unable to create nym"
+                      << std::endl;
+
+            return 1;
+        }
+
+        nyms.push_back(nym);
+    }
+
+    CryptoAsymmetric::VerificationBatch batch(options.signatures_);
+
+    for (std::int32_t i = 0; i < options.signatures_; ++i) {
+        const auto& nym = *nyms[i % nyms.size()];
+        const auto& privateKey = nym.GetPrivateSignKey();
+        const auto& publicKey = nym.GetPublicSignKey();
+        const std::string message =
+            "opentxs-verify-bench message " + std::to_string(i);
+        auto& item = batch[i];
+        item.key_ = &publicKey;
+        item.plaintext_ = Data(message.data(), message.size());
+        item.hash_ = privateKey.SigHashType();
+
+        if (false == privateKey.engine().Sign(
+                         item.plaintext_,
+                         privateKey,
+                         item.hash_,
+                         item.signature_)) {
+            std::cerr << "opentxs-verify-bench: unable to sign" << std::endl;
+
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (const auto& item : batch) {
+        if (false == item.key_->engine().Verify(
+                         item.plaintext_,
+                         *item.key_,
+                         item.signature_,
+                         item.hash_)) {
+            std::cerr << "opentxs-verify-bench: serial verify failed"
+                      << std::endl;
+
+            return 1;
+        }
+    }
+
+    const double serial = seconds_since(start);
+    SignatureMemo::Clear();
+    start = std::chrono::steady_clock::now();
+
+    if (!CryptoAsymmetric::BatchVerify(batch)) {
+        std::cerr << "opentxs-verify-bench: batch verify failed" << std::endl;
+
+        return 1;
+    }
+
+    const double cold = seconds_since(start);
+    start = std::chrono::steady_clock::now();
+
+    if (!CryptoAsymmetric::BatchVerify(batch)) {
+        std::cerr << "opentxs-verify-bench: memoized verify failed"
+                  << std::endl;
+
+        return 1;
+    }
+
+    const double memoized = seconds_since(start);
+    const double count = options.signatures_;
+    std::stringstream output{};
+    output << "{\n"
+           << "  \"curve\": \"" << options.curve_ << "\",\n"
+           << "  \"signers\": " << options.signers_ << ",\n"
+           << "  \"signatures\": " << options.signatures_ << ",\n"
+           << "  \"serial_seconds\": " << serial << ",\n"
+           << "  \"serial_per_second\": " << (count / serial) << ",\n"
+           << "  \"batch_seconds\": " << cold << ",\n"
+           << "  \"batch_per_second\": " << (count / cold) << ",\n"
+           << "  \"memoized_seconds\": " << memoized << ",\n"
+           << "  \"memoized_per_second\": " << (count / memoized) << "\n"
+           << "}\n";
+    json = output.str();
+
+    return 0;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Options options{};
+
+    if (!parse(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--curve ed25519|secp256k1] [--signers N]"
+                     " [--signatures N] [--output FILE]"
+                  << std::endl;
+
+        return 1;
+    }
+
+    const char* tmp = std::getenv("TMPDIR");
+    std::string root = std::string((nullptr == tmp) ? "/tmp" : tmp) +
+                       "/opentxs-verify-bench-XXXXXX";
+
+    if (nullptr == ::mkdtemp(&root[0])) {
+        std::cerr << "opentxs-verify-bench: unable to create " << root
+                  << std::endl;
+
+        return 1;
+    }
+
+    ::setenv("HOME", root.c_str(), 1);
+    BenchPassword callback;
+    OTCaller caller;
+    caller.setCallback(&callback);
+    OT_API_Set_PasswordCallback(caller);
+    OTAPI_Wrap::AppInit();
+    std::string json{};
+    const int result = run(options, json);
+    OTAPI_Wrap::AppCleanup();
+    ::nftw(root.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+
+    if (0 != result) { return result; }
+
+    if ("-" == options.output_) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.output_);
+        file << json;
+
+        if (!file) {
+            std::cerr << "opentxs-verify-bench: unable to write "
+                      << options.output_ << std::endl;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Starts the client API once for the whole test binary, with its data folder
+// under a temporary HOME, for the tests which need storage or crypto.
+
+#include <gtest/gtest.h>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "opentxs/client/OTAPI_Wrap.hpp"
+#include "opentxs/core/crypto/OTAsymmetricKey.hpp"
+#include "opentxs/core/crypto/OTCallback.hpp"
+#include "opentxs/core/crypto/OTCaller.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+
+const std::string TEST_PASSWORD = "test";
+
+class TestPassword : public OTCallback
+{
+public:
+    void runOne(const char*, OTPassword& output) const override
+    {
+        output.setPassword(TEST_PASSWORD);
+    }
+
+    void runTwo(const char*, OTPassword& output) const override
+    {
+        output.setPassword(TEST_PASSWORD);
+    }
+};
+
+int remove_entry(const char* path, const struct stat*, int, struct FTW*)
+{
+    return ::remove(path);
+}
+
+class Environment : public ::testing::Environment
+{
+public:
+    void SetUp() override
+    {
+        const char* tmp = std::getenv("TMPDIR");
+        home_ = std::string((nullptr == tmp) ? "/tmp" : tmp) +
+                "/unittests-opentxs-XXXXXX";
+
+        ASSERT_TRUE(nullptr != ::mkdtemp(&home_[0]));
+
+        ::setenv("HOME", home_.c_str(), 1);
+        caller_.setCallback(&callback_);
+
+        ASSERT_TRUE(OT_API_Set_PasswordCallback(caller_));
+        ASSERT_TRUE(OTAPI_Wrap::AppInit());
+    }
+
+    void TearDown() override
+    {
+        OTAPI_Wrap::AppCleanup();
+        ::nftw(home_.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+    }
+
+private:
+    std::string home_;
+    TestPassword callback_;
+    OTCaller caller_;
+};
+
+::testing::Environment* const environment =
+    ::testing::AddGlobalTestEnvironment(new Environment);
+
+}  // namespace
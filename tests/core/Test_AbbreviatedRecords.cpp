@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/transaction/Helpers.hpp"
+#include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/util/Tag.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/NumList.hpp"
+#include "opentxs/core/OTTransaction.hpp"
+#include "opentxs/core/OTTransactionType.hpp"
+#include "opentxs/core/String.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+
+const time64_t DATE_SIGNED = OTTimeGetTimeFromSeconds(1500000000);
+
+struct Record {
+    int64_t numberOfOrigin_{0};
+    int originType_{0};
+    int64_t transactionNum_{0};
+    int64_t inRefTo_{0};
+    int64_t inRefDisplay_{0};
+    time64_t dateSigned_{OT_TIME_ZERO};
+    int type_{0};
+    String hash_{};
+    int64_t adjustment_{0};
+    int64_t displayValue_{0};
+    int64_t closingNum_{0};
+    int64_t requestNum_{0};
+    bool transSuccess_{false};
+    NumList numbers_{};
+};
+
+// The attributes every abbreviated record carries.
+TagPtr make_record(
+    const std::string& type,
+    const int64_t number,
+    const std::string& hash)
+{
+    TagPtr output = std::make_shared<Tag>("inboxRecord");
+    output->add_attribute("type", type);
+    output->add_attribute("transactionNum", std::to_string(number));
+    output->add_attribute("inReferenceTo", std::to_string(number - 1));
+    output->add_attribute("inRefDisplay", std::to_string(number - 2));
+    output->add_attribute("dateSigned", formatTimestamp(DATE_SIGNED));
+    output->add_attribute("receiptHash", hash);
+
+    return output;
+}
+
+struct Abbreviated_Records : public ::testing::Test {
+    Tag records_{"records"};
+
+    Abbreviated_Records()
+    {
+        auto market = make_record("marketReceipt", 100, "hash-market");
+        market->add_attribute("numberOfOrigin", "7");
+        market->add_attribute("originType", "origin_market_offer");
+        market->add_attribute("adjustment", "-25");
+        market->add_attribute("displayValue", "25");
+        records_.add_tag(market);
+
+        auto closing = make_record("finalReceipt", 200, "hash-closing");
+        closing->add_attribute("closingNum", "190");
+        records_.add_tag(closing);
+
+        auto reply = make_record("replyNotice", 300, "hash-reply");
+        reply->add_attribute("requestNumber", "12");
+        reply->add_attribute("transSuccess", "true");
+        records_.add_tag(reply);
+
+        auto blank = make_record("blank", 400, "hash-blank");
+        blank->add_attribute("totalListOfNumbers", "401,402,403");
+        records_.add_tag(blank);
+    }
+
+    static int32_t unpack(const Data& input, std::size_t& offset, Record& out)
+    {
+        return UnpackAbbreviatedRecord(
+            input,
+            offset,
+            out.numberOfOrigin_,
+            out.originType_,
+            out.transactionNum_,
+            out.inRefTo_,
+            out.inRefDisplay_,
+            out.dateSigned_,
+            out.type_,
+            out.hash_,
+            out.adjustment_,
+            out.displayValue_,
+            out.closingNum_,
+            out.requestNum_,
+            out.transSuccess_,
+            &out.numbers_);
+    }
+};
+
+}  // namespace
+
+TEST_F(Abbreviated_Records, round_trip)
+{
+    Data packed;
+    ASSERT_TRUE(PackAbbreviatedRecords(records_, packed));
+
+    std::size_t offset = 0;
+    std::vector<Record> unpacked(records_.tags().size());
+
+    for (auto& record : unpacked) {
+        ASSERT_EQ(1, unpack(packed, offset, record));
+    }
+
+    ASSERT_EQ(packed.GetSize(), offset);
+
+    const auto& market = unpacked[0];
+    ASSERT_EQ(OTTransaction::marketReceipt, market.type_);
+    ASSERT_EQ(
+        static_cast<int>(originType::origin_market_offer), market.originType_);
+    ASSERT_EQ(7, market.numberOfOrigin_);
+    ASSERT_EQ(100, market.transactionNum_);
+    ASSERT_EQ(99, market.inRefTo_);
+    ASSERT_EQ(98, market.inRefDisplay_);
+    ASSERT_EQ(DATE_SIGNED, market.dateSigned_);
+    ASSERT_TRUE(market.hash_.Compare("hash-market"));
+    ASSERT_EQ(-25, market.adjustment_);
+    ASSERT_EQ(25, market.displayValue_);
+    ASSERT_EQ(0, market.closingNum_);
+    ASSERT_EQ(0, market.requestNum_);
+    ASSERT_FALSE(market.transSuccess_);
+
+    const auto& closing = unpacked[1];
+    ASSERT_EQ(OTTransaction::finalReceipt, closing.type_);
+    ASSERT_EQ(
+        static_cast<int>(originType::not_applicable), closing.originType_);
+    ASSERT_EQ(200, closing.transactionNum_);
+    ASSERT_EQ(190, closing.closingNum_);
+    ASSERT_TRUE(closing.hash_.Compare("hash-closing"));
+
+    const auto& reply = unpacked[2];
+    ASSERT_EQ(OTTransaction::replyNotice, reply.type_);
+    ASSERT_EQ(300, reply.transactionNum_);
+    ASSERT_EQ(12, reply.requestNum_);
+    ASSERT_TRUE(reply.transSuccess_);
+
+    const auto& blank = unpacked[3];
+    ASSERT_EQ(OTTransaction::blank, blank.type_);
+    ASSERT_EQ(400, blank.transactionNum_);
+    ASSERT_TRUE(blank.numbers_.Verify(std::set<int64_t>{401, 402, 403}));
+    ASSERT_EQ(3, blank.numbers_.Count());
+}
+
+TEST_F(Abbreviated_Records, same_records_pack_the_same)
+{
+    Data one;
+    Data two;
+    ASSERT_TRUE(PackAbbreviatedRecords(records_, one));
+    ASSERT_TRUE(PackAbbreviatedRecords(records_, two));
+    ASSERT_TRUE(one == two);
+}
+
+TEST_F(Abbreviated_Records, truncated_record_fails)
+{
+    Data packed;
+    ASSERT_TRUE(PackAbbreviatedRecords(records_, packed));
+
+    const Data truncated(packed.GetPointer(), packed.GetSize() - 1);
+    std::size_t offset = 0;
+    Record record;
+
+    for (std::size_t i = 1; i < records_.tags().size(); ++i) {
+        ASSERT_EQ(1, unpack(truncated, offset, record));
+    }
+
+    ASSERT_EQ(-1, unpack(truncated, offset, record));
+}
+
+TEST_F(Abbreviated_Records, unknown_version_fails)
+{
+    Data packed;
+    ASSERT_TRUE(PackAbbreviatedRecords(records_, packed));
+
+    const auto* begin = static_cast<const std::uint8_t*>(packed.GetPointer());
+    std::vector<unsigned char> bytes(begin, begin + packed.GetSize());
+    bytes[0] = 0xff;
+    std::size_t offset = 0;
+    Record record;
+    ASSERT_EQ(-1, unpack(Data(bytes), offset, record));
+}
+
+TEST_F(Abbreviated_Records, missing_hash_fails)
+{
+    auto broken = make_record("marketReceipt", 500, "");
+    records_.add_tag(broken);
+    Data packed;
+    ASSERT_FALSE(PackAbbreviatedRecords(records_, packed));
+}
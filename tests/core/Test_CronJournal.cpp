@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/client/OT_API.hpp"
+#include "opentxs/client/OTAPI_Wrap.hpp"
+#include "opentxs/core/cron/CronJournal.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/String.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+
+struct Cron_Journal : public ::testing::Test {
+    static Nym* signer_;
+
+    static void SetUpTestCase()
+    {
+        NymParameters parameters(proto::CREDTYPE_LEGACY);
+        signer_ = OTAPI_Wrap::OTAPI()->CreateNym(parameters);
+    }
+
+    const std::string folder_{OTFolders::Cron().Get()};
+
+    void SetUp() override { ASSERT_TRUE(nullptr != signer_); }
+
+    std::string path(const std::string& file) const
+    {
+        std::string output;
+        OTDB::FormPathString(output, folder_, file);
+
+        return output;
+    }
+
+    std::string read_file(const std::string& file) const
+    {
+        std::ifstream stream(path(file), std::ios::binary);
+
+        return std::string(
+            std::istreambuf_iterator<char>(stream),
+            std::istreambuf_iterator<char>());
+    }
+
+    void write_file(const std::string& file, const std::string& contents)
+        const
+    {
+        std::ofstream stream(path(file), std::ios::binary | std::ios::trunc);
+        stream << contents;
+    }
+
+    std::vector<std::string> replay(
+        const std::string& file,
+        const std::int64_t generation,
+        bool& success) const
+    {
+        std::vector<std::string> output;
+        CronJournal journal(folder_, file, *signer_);
+        success = journal.Replay(
+            generation, [&](const std::string& record) -> bool {
+                output.push_back(record);
+
+                return true;
+            });
+
+        return output;
+    }
+};
+
+Nym* Cron_Journal::signer_{nullptr};
+
+}  // namespace
+
+TEST_F(Cron_Journal, missing_journal_replays_nothing)
+{
+    bool success = false;
+    ASSERT_TRUE(replay("unittests-missing.journal", 1, success).empty());
+    ASSERT_TRUE(success);
+}
+
+TEST_F(Cron_Journal, replays_only_the_current_generation)
+{
+    const std::string file = "unittests-generation.journal";
+
+    {
+        CronJournal journal(folder_, file, *signer_);
+        ASSERT_TRUE(journal.Append(1, "old"));
+        ASSERT_TRUE(journal.Append(2, "first record"));
+        ASSERT_TRUE(journal.Append(2, "second record"));
+        ASSERT_EQ(3u, journal.Size());
+    }
+
+    bool success = false;
+    const std::vector<std::string> expected{"first record", "second record"};
+    ASSERT_EQ(expected, replay(file, 2, success));
+    ASSERT_TRUE(success);
+
+    CronJournal journal(folder_, file, *signer_);
+    ASSERT_TRUE(journal.Clear());
+    ASSERT_EQ(0u, journal.Size());
+    ASSERT_TRUE(replay(file, 2, success).empty());
+    ASSERT_TRUE(success);
+}
+
+TEST_F(Cron_Journal, torn_line_is_removed)
+{
+    const std::string file = "unittests-torn.journal";
+
+    {
+        CronJournal journal(folder_, file, *signer_);
+        ASSERT_TRUE(journal.Append(1, "first"));
+    }
+
+    const auto contents = read_file(file);
+    write_file(file, contents + "1 seco");
+
+    bool success = false;
+    std::vector<std::string> expected{"first"};
+    ASSERT_EQ(expected, replay(file, 1, success));
+    ASSERT_TRUE(success);
+    ASSERT_EQ(contents, read_file(file));
+
+    {
+        CronJournal journal(folder_, file, *signer_);
+        ASSERT_TRUE(journal.Append(1, "third"));
+        ASSERT_EQ(2u, journal.Size());
+    }
+
+    expected.push_back("third");
+    ASSERT_EQ(expected, replay(file, 1, success));
+    ASSERT_TRUE(success);
+}
+
+TEST_F(Cron_Journal, altered_line_stops_the_replay)
+{
+    const std::string file = "unittests-altered.journal";
+
+    {
+        CronJournal journal(folder_, file, *signer_);
+        ASSERT_TRUE(journal.Append(1, "amount=10"));
+        ASSERT_TRUE(journal.Append(1, "after"));
+    }
+
+    auto contents = read_file(file);
+    const auto position = contents.find("amount=10");
+
+    ASSERT_NE(std::string::npos, position);
+
+    contents.replace(position, 9, "amount=99");
+    write_file(file, contents);
+
+    bool success = true;
+    ASSERT_TRUE(replay(file, 1, success).empty());
+    ASSERT_FALSE(success);
+    ASSERT_EQ(contents, read_file(file + ".failed"));
+}
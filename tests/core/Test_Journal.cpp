@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/contract/AccountIndex.hpp"
+#include "opentxs/core/util/Journal.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/String.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+
+int remove_entry(const char* path, const struct stat*, int, struct FTW*)
+{
+    return ::remove(path);
+}
+
+// Writes the start of a record which never got its line break, as left by a
+// process which stopped in the middle of an append.
+void append_torn(const std::string& path, const std::string& partial)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file << partial;
+}
+
+std::string read_file(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    return std::string(
+        std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+std::vector<std::string> read_records(Journal& journal)
+{
+    std::vector<std::string> output;
+    journal.Read([&](const std::string& record) -> bool {
+        output.push_back(record);
+
+        return true;
+    });
+
+    return output;
+}
+
+struct Journal_File : public ::testing::Test {
+    std::string folder_;
+    std::string path_;
+
+    void SetUp() override
+    {
+        const char* tmp = std::getenv("TMPDIR");
+        folder_ = std::string((nullptr == tmp) ? "/tmp" : tmp) +
+                  "/opentxs-journal-XXXXXX";
+
+        ASSERT_TRUE(nullptr != ::mkdtemp(&folder_[0]));
+
+        path_ = folder_ + "/test.journal";
+    }
+
+    void TearDown() override
+    {
+        ::nftw(folder_.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+    }
+};
+
+std::string index_path(const std::string& unitID)
+{
+    std::string output;
+    OTDB::FormPathString(output, OTFolders::Contract().Get(), unitID + ".ai");
+
+    return output;
+}
+
+std::vector<std::string> index_accounts(const AccountIndex& index)
+{
+    std::vector<std::string> output;
+    index.Visit([&](const std::string& accountID) -> bool {
+        output.push_back(accountID);
+
+        return true;
+    });
+
+    return output;
+}
+
+}  // namespace
+
+TEST_F(Journal_File, append_and_read)
+{
+    {
+        Journal journal(path_);
+        ASSERT_TRUE(journal.Append("first"));
+        ASSERT_TRUE(journal.Append("second"));
+        ASSERT_TRUE(journal.Append(""));
+        ASSERT_EQ(3u, journal.Size());
+    }
+
+    Journal journal(path_);
+    const std::vector<std::string> expected{"first", "second", ""};
+    ASSERT_EQ(expected, read_records(journal));
+    ASSERT_EQ(3u, journal.Size());
+    ASSERT_EQ("first\nsecond\n\n", read_file(path_));
+}
+
+TEST_F(Journal_File, rejects_line_breaks)
+{
+    Journal journal(path_);
+    ASSERT_TRUE(journal.Append("first"));
+    ASSERT_FALSE(journal.Append("two\nlines"));
+    ASSERT_FALSE(journal.Rewrite({"one", "two\nlines"}));
+    ASSERT_EQ(1u, journal.Size());
+    ASSERT_EQ("first\n", read_file(path_));
+}
+
+TEST_F(Journal_File, torn_line_is_removed)
+{
+    {
+        Journal journal(path_);
+        ASSERT_TRUE(journal.Append("first"));
+        ASSERT_TRUE(journal.Append("second"));
+    }
+
+    append_torn(path_, "thi");
+
+    Journal journal(path_);
+    const std::vector<std::string> expected{"first", "second"};
+    ASSERT_EQ(expected, read_records(journal));
+    ASSERT_EQ(2u, journal.Size());
+    ASSERT_EQ("first\nsecond\n", read_file(path_));
+}
+
+TEST_F(Journal_File, append_after_torn_line_starts_new_line)
+{
+    {
+        Journal journal(path_);
+        ASSERT_TRUE(journal.Append("first"));
+    }
+
+    append_torn(path_, "sec");
+
+    {
+        Journal journal(path_);
+        ASSERT_TRUE(journal.Append("third"));
+        ASSERT_EQ(2u, journal.Size());
+    }
+
+    Journal journal(path_);
+    const std::vector<std::string> expected{"first", "third"};
+    ASSERT_EQ(expected, read_records(journal));
+}
+
+TEST_F(Journal_File, torn_first_line)
+{
+    append_torn(path_, "fir");
+
+    Journal journal(path_);
+    ASSERT_EQ(0u, journal.Size());
+    ASSERT_TRUE(read_records(journal).empty());
+    ASSERT_TRUE(journal.Append("first"));
+    ASSERT_EQ("first\n", read_file(path_));
+}
+
+TEST_F(Journal_File, rewrite_replaces_records)
+{
+    Journal journal(path_);
+    ASSERT_TRUE(journal.Append("first"));
+    ASSERT_TRUE(journal.Append("second"));
+    ASSERT_TRUE(journal.Rewrite({"replaced"}));
+    ASSERT_EQ(1u, journal.Size());
+    ASSERT_TRUE(journal.Append("after"));
+
+    const std::vector<std::string> expected{"replaced", "after"};
+    ASSERT_EQ(expected, read_records(journal));
+    ASSERT_EQ(2u, journal.Size());
+
+    Journal reopened(path_);
+    ASSERT_EQ(expected, read_records(reopened));
+}
+
+TEST_F(Journal_File, read_stops_at_reader_failure)
+{
+    Journal journal(path_);
+    ASSERT_TRUE(journal.Append("first"));
+    ASSERT_TRUE(journal.Append("second"));
+    ASSERT_TRUE(journal.Append("third"));
+
+    std::vector<std::string> records;
+    ASSERT_FALSE(journal.Read([&](const std::string& record) -> bool {
+        records.push_back(record);
+
+        return ("second" != record);
+    }));
+
+    const std::vector<std::string> expected{"first", "second"};
+    ASSERT_EQ(expected, records);
+    ASSERT_TRUE(journal.Append("fourth"));
+    ASSERT_EQ(4u, journal.Size());
+}
+
+TEST(AccountIndex, replays_additions_and_removals)
+{
+    const std::string unit = "unittests-account-index-replay";
+
+    {
+        auto index = AccountIndex::Get(unit);
+        ASSERT_TRUE(index->Add("account-c"));
+        ASSERT_TRUE(index->Add("account-a"));
+        ASSERT_TRUE(index->Add("account-b"));
+        ASSERT_TRUE(index->Erase("account-b"));
+        ASSERT_EQ(2u, index->Size());
+    }
+
+    auto index = AccountIndex::Get(unit);
+    const std::vector<std::string> expected{"account-a", "account-c"};
+    ASSERT_EQ(expected, index_accounts(*index));
+    ASSERT_FALSE(index->Exists("account-b"));
+}
+
+TEST(AccountIndex, torn_line_is_removed)
+{
+    const std::string unit = "unittests-account-index-torn";
+
+    {
+        auto index = AccountIndex::Get(unit);
+        ASSERT_TRUE(index->Add("account-a"));
+        ASSERT_TRUE(index->Add("account-b"));
+    }
+
+    append_torn(index_path(unit), "-account-a");
+
+    {
+        auto index = AccountIndex::Get(unit);
+        ASSERT_TRUE(index->Exists("account-a"));
+        ASSERT_TRUE(index->Exists("account-b"));
+        ASSERT_EQ(2u, index->Size());
+        ASSERT_TRUE(index->Add("account-c"));
+    }
+
+    auto index = AccountIndex::Get(unit);
+    const std::vector<std::string> expected{
+        "account-a", "account-b", "account-c"};
+    ASSERT_EQ(expected, index_accounts(*index));
+    ASSERT_EQ("+account-a\n+account-b\n+account-c\n",
+              read_file(index_path(unit)));
+}
+
+TEST(AccountIndex, invalid_line_fails_the_load)
+{
+    const std::string unit = "unittests-account-index-invalid";
+
+    {
+        auto index = AccountIndex::Get(unit);
+        ASSERT_TRUE(index->Loaded());
+        ASSERT_TRUE(index->Add("account-a"));
+    }
+
+    {
+        std::ofstream file(index_path(unit), std::ios::binary | std::ios::app);
+        file << "*account-b\n+account-c\n";
+    }
+
+    const auto contents = read_file(index_path(unit));
+
+    {
+        auto index = AccountIndex::Get(unit);
+        ASSERT_FALSE(index->Loaded());
+        ASSERT_EQ(0u, index->Size());
+        ASSERT_FALSE(index->Exists("account-a"));
+        ASSERT_FALSE(index->Add("account-d"));
+        ASSERT_FALSE(index->Erase("account-a"));
+        ASSERT_FALSE(
+            index->Visit([](const std::string&) -> bool { return true; }));
+    }
+
+    ASSERT_EQ(contents, read_file(index_path(unit)));
+}
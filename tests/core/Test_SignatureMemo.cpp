@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/crypto/SignatureMemo.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/String.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+
+Identifier make_id(const std::string& seed)
+{
+    Identifier output;
+    output.CalculateDigest(String(seed));
+
+    return output;
+}
+
+struct Signature_Memo : public ::testing::Test {
+    const Identifier contract_{make_id("contract")};
+    const Identifier signature_{make_id("signature")};
+
+    void SetUp() override { SignatureMemo::Clear(); }
+    void TearDown() override { SignatureMemo::Clear(); }
+};
+
+}  // namespace
+
+TEST_F(Signature_Memo, insert_then_check)
+{
+    ASSERT_FALSE(SignatureMemo::Check(contract_, signature_));
+
+    SignatureMemo::Insert(contract_, signature_);
+
+    ASSERT_TRUE(SignatureMemo::Check(contract_, signature_));
+    ASSERT_EQ(1u, SignatureMemo::Size());
+}
+
+TEST_F(Signature_Memo, different_signature_misses)
+{
+    SignatureMemo::Insert(contract_, signature_);
+
+    ASSERT_FALSE(SignatureMemo::Check(contract_, make_id("other signature")));
+    ASSERT_FALSE(SignatureMemo::Check(make_id("other contract"), signature_));
+}
+
+TEST_F(Signature_Memo, empty_identifiers_are_ignored)
+{
+    const Identifier empty;
+    SignatureMemo::Insert(empty, signature_);
+    SignatureMemo::Insert(contract_, empty);
+
+    ASSERT_EQ(0u, SignatureMemo::Size());
+    ASSERT_FALSE(SignatureMemo::Check(empty, signature_));
+    ASSERT_FALSE(SignatureMemo::Check(contract_, empty));
+}
+
+TEST_F(Signature_Memo, duplicate_insert_counts_once)
+{
+    SignatureMemo::Insert(contract_, signature_);
+    SignatureMemo::Insert(contract_, signature_);
+
+    ASSERT_EQ(1u, SignatureMemo::Size());
+}
+
+TEST_F(Signature_Memo, clear_forgets_everything)
+{
+    SignatureMemo::Insert(contract_, signature_);
+    SignatureMemo::Insert(contract_, make_id("other signature"));
+    SignatureMemo::Clear();
+
+    ASSERT_EQ(0u, SignatureMemo::Size());
+    ASSERT_FALSE(SignatureMemo::Check(contract_, signature_));
+}
+
+TEST_F(Signature_Memo, oldest_entry_is_evicted)
+{
+    std::vector<Identifier> signatures;
+
+    for (std::size_t i = 0; i <= OT_SIGNATURE_MEMO_SIZE; ++i) {
+        signatures.push_back(make_id("signature " + std::to_string(i)));
+        SignatureMemo::Insert(contract_, signatures.back());
+    }
+
+    ASSERT_EQ(static_cast<std::size_t>(OT_SIGNATURE_MEMO_SIZE),
+              SignatureMemo::Size());
+    ASSERT_FALSE(SignatureMemo::Check(contract_, signatures.front()));
+    ASSERT_TRUE(SignatureMemo::Check(contract_, signatures[1]));
+    ASSERT_TRUE(SignatureMemo::Check(contract_, signatures.back()));
+}
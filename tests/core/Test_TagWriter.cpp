@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/util/Tag.hpp"
+
+using namespace opentxs;
+
+TEST(TagWriter, empty_element)
+{
+    std::string expected;
+    Tag("empty").outputXML(expected);
+
+    std::string written;
+    {
+        TagWriter writer(written);
+        writer.Open("empty");
+        writer.Close();
+    }
+
+    ASSERT_EQ(expected, written);
+}
+
+TEST(TagWriter, attributes_are_sorted)
+{
+    Tag tag("element");
+    tag.add_attribute("zulu", "1");
+    tag.add_attribute("alpha", "2");
+    tag.add_attribute("mike", std::string("3"));
+    std::string expected;
+    tag.outputXML(expected);
+
+    std::string written;
+    {
+        TagWriter writer(written);
+        writer.Open("element");
+        writer.Attribute("zulu", "1");
+        writer.Attribute("alpha", "2");
+        writer.Attribute("mike", std::string("3"));
+        writer.Close();
+    }
+
+    ASSERT_EQ(expected, written);
+}
+
+TEST(TagWriter, first_duplicate_attribute_wins)
+{
+    Tag tag("element");
+    tag.add_attribute("name", "first");
+    tag.add_attribute("other", "value");
+    tag.add_attribute("name", "second");
+    std::string expected;
+    tag.outputXML(expected);
+
+    std::string written;
+    {
+        TagWriter writer(written);
+        writer.Open("element");
+        writer.Attribute("name", "first");
+        writer.Attribute("other", "value");
+        writer.Attribute("name", "second");
+        writer.Close();
+    }
+
+    ASSERT_EQ(expected, written);
+    ASSERT_EQ(std::string::npos, written.find("second"));
+}
+
+TEST(TagWriter, text_and_leaves)
+{
+    Tag tag("parent");
+    tag.add_attribute("version", "2.0");
+    tag.add_tag("leaf", "text");
+    tag.add_tag("emptyLeaf", "");
+    TagPtr child = std::make_shared<Tag>("child", "child text");
+    child->add_attribute("id", "7");
+    tag.add_tag(child);
+    std::string expected;
+    tag.outputXML(expected);
+
+    std::string written;
+    {
+        TagWriter writer(written);
+        writer.Open("parent");
+        writer.Attribute("version", "2.0");
+        writer.Leaf("leaf", "text");
+        writer.Leaf("emptyLeaf", "");
+        writer.Open("child");
+        writer.Attribute("id", "7");
+        writer.Text("child text");
+        writer.Close();
+        writer.Close();
+    }
+
+    ASSERT_EQ(expected, written);
+}
+
+TEST(TagWriter, nested_elements_and_existing_trees)
+{
+    TagPtr inner = std::make_shared<Tag>("inner");
+    inner->add_attribute("b", "2");
+    inner->add_attribute("a", "1");
+    inner->add_tag("value", "42");
+    TagPtr middle = std::make_shared<Tag>("middle");
+    middle->add_tag(inner);
+    Tag tag("outer");
+    tag.add_tag(middle);
+    tag.add_tag("after", "done");
+    std::string expected;
+    tag.outputXML(expected);
+
+    std::string written;
+    {
+        TagWriter writer(written);
+        writer.Open("outer");
+        writer.Open("middle");
+        writer.Write(*inner);
+        writer.Close();
+        writer.Leaf("after", "done");
+        writer.Close();
+    }
+
+    ASSERT_EQ(expected, written);
+}
+
+TEST(TagWriter, destructor_closes_open_elements)
+{
+    Tag tag("outer");
+    TagPtr inner = std::make_shared<Tag>("inner");
+    inner->add_attribute("key", "value");
+    tag.add_tag(inner);
+    std::string expected;
+    tag.outputXML(expected);
+
+    std::string written;
+    {
+        TagWriter writer(written);
+        writer.Open("outer");
+        writer.Open("inner");
+        writer.Attribute("key", "value");
+    }
+
+    ASSERT_EQ(expected, written);
+}
+
+TEST(TagWriter, appends_to_existing_output)
+{
+    Tag tag("element", "text");
+    tag.add_attribute("key", "value");
+    std::string expected("prefix\n");
+    tag.outputXML(expected);
+    ASSERT_EQ(expected.size(), tag.size() + 7);
+
+    std::string written("prefix\n");
+    {
+        TagWriter writer(written, tag.size());
+        writer.Open("element");
+        writer.Attribute("key", "value");
+        writer.Text("text");
+    }
+
+    ASSERT_EQ(expected, written);
+}